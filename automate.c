@@ -0,0 +1,774 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "automate.h"
+
+// Compilation d'une grammaire régulière en automate minimal, voir automate.h.
+//
+// Les productions inutiles (non productives, ou de membre gauche inaccessible depuis
+// l'axiome) sont écartées. Chaque composante reçoit un sens : à droite, l'état d'un
+// non-terminal B lit une production B -> w C (C de la composante) jusqu'à l'état de C, et
+// B -> w jusqu'à la sortie ; à gauche, B -> C w va de l'état de C à celui de B, et B -> w
+// de l'entrée à l'état de B. Un non-terminal d'une composante inférieure rencontré dans w
+// est remplacé par une copie de son propre automate, entre les deux états qui l'entourent.
+
+#define DROITE 1
+#define GAUCHE 2
+#define EPSILON_AUTOMATE (-1)          // Étiquette d'une transition spontanée
+#define MAX_ETATS_NON_DETERMINISTES (1 << 18)
+
+typedef struct {
+    const GrammaireSymboles *grammaire;
+    int lettre[256];
+
+    // Productions gardées, rangées par membre gauche
+    int *debut_nt;                 // nb_non_terminaux + 1
+    int *productions_nt;
+
+    // Composantes fortement connexes (Tarjan)
+    int *composante;               // Par non-terminal, -1 si inaccessible
+    int nb_composantes;
+    int *indice, *bas, *pile;
+    unsigned char *sur_pile;
+    int sommet, compteur;
+    unsigned char *sens;           // Par composante : DROITE, GAUCHE ou les deux
+    int *debut_membres, *membres;
+    int *rang;                     // Rang d'un non-terminal parmi les membres de sa composante
+
+    // Automate non déterministe : l'état 0 est initial, l'état 1 final
+    int nb_etats;
+    int *origine, *etiquette, *cible;
+    int nb_arcs, capacite_arcs;
+    int trop_grand;
+} Compilation;
+
+static void liberer_compilation(Compilation *c) {
+    free(c->debut_nt);
+    free(c->productions_nt);
+    free(c->composante);
+    free(c->indice);
+    free(c->bas);
+    free(c->pile);
+    free(c->sur_pile);
+    free(c->sens);
+    free(c->debut_membres);
+    free(c->membres);
+    free(c->rang);
+    free(c->origine);
+    free(c->etiquette);
+    free(c->cible);
+}
+
+// Garder les productions productives dont le membre gauche est accessible, et fixer l'alphabet
+static int garder_utiles(Compilation *c) {
+    const GrammaireSymboles *g = c->grammaire;
+    int n = g->nb_non_terminaux;
+    unsigned char *productif = calloc(n + 1, 1), *accessible = calloc(n + 1, 1), *garde = calloc(g->nb_productions + 1, 1);
+    int *a_visiter = malloc((n + 1) * sizeof(int));
+    c->debut_nt = calloc(n + 1, sizeof(int));
+    c->productions_nt = malloc((g->nb_productions + 1) * sizeof(int));
+    if (!productif || !accessible || !garde || !a_visiter || !c->debut_nt || !c->productions_nt) {
+        free(productif);
+        free(accessible);
+        free(garde);
+        free(a_visiter);
+        return -1;
+    }
+
+    for (int change = 1; change; ) {
+        change = 0;
+        for (int p = 0; p < g->nb_productions; p++) {
+            if (productif[g->gauche[p]]) continue;
+            int k = 0;
+            while (k < g->longueur[p] && (g->symboles[g->debut[p] + k] < 0 || productif[g->symboles[g->debut[p] + k]])) k++;
+            if (k == g->longueur[p]) productif[g->gauche[p]] = change = 1;
+        }
+    }
+    for (int p = 0; p < g->nb_productions; p++) {
+        garde[p] = 1;
+        for (int k = 0; k < g->longueur[p] && garde[p]; k++) {
+            int s = g->symboles[g->debut[p] + k];
+            garde[p] = s < 0 || productif[s];
+        }
+    }
+
+    int nb = 0;
+    if (productif[g->axiome]) {
+        accessible[g->axiome] = 1;
+        a_visiter[nb++] = g->axiome;
+    }
+    while (nb > 0) {
+        int a = a_visiter[--nb];
+        for (int p = 0; p < g->nb_productions; p++) {
+            if (g->gauche[p] != a || !garde[p]) continue;
+            for (int k = 0; k < g->longueur[p]; k++) {
+                int s = g->symboles[g->debut[p] + k];
+                if (s >= 0 && !accessible[s]) {
+                    accessible[s] = 1;
+                    a_visiter[nb++] = s;
+                }
+            }
+        }
+    }
+
+    unsigned char present[256] = {0};
+    for (int p = 0; p < g->nb_productions; p++) {
+        if (!garde[p] || !accessible[g->gauche[p]]) continue;
+        c->debut_nt[g->gauche[p] + 1]++;
+        for (int k = 0; k < g->longueur[p]; k++) {
+            int s = g->symboles[g->debut[p] + k];
+            if (s < 0) present[(unsigned char)(-1 - s)] = 1;
+        }
+    }
+    for (int a = 0; a < n; a++) c->debut_nt[a + 1] += c->debut_nt[a];
+    // a_visiter sert de curseur de rangement, par non-terminal
+    memcpy(a_visiter, c->debut_nt, n * sizeof(int));
+    for (int p = 0; p < g->nb_productions; p++) {
+        if (garde[p] && accessible[g->gauche[p]]) c->productions_nt[a_visiter[g->gauche[p]]++] = p;
+    }
+    for (int k = 0, nb_lettres = 0; k < 256; k++) c->lettre[k] = present[k] ? nb_lettres++ : -1;
+
+    free(productif);
+    free(accessible);
+    free(garde);
+    free(a_visiter);
+    return 0;
+}
+
+static void tarjan(Compilation *c, int a) {
+    const GrammaireSymboles *g = c->grammaire;
+    c->indice[a] = c->bas[a] = c->compteur++;
+    c->pile[c->sommet++] = a;
+    c->sur_pile[a] = 1;
+    for (int i = c->debut_nt[a]; i < c->debut_nt[a + 1]; i++) {
+        int p = c->productions_nt[i];
+        for (int k = 0; k < g->longueur[p]; k++) {
+            int s = g->symboles[g->debut[p] + k];
+            if (s < 0) continue;
+            if (c->indice[s] == -1) {
+                tarjan(c, s);
+                if (c->bas[s] < c->bas[a]) c->bas[a] = c->bas[s];
+            } else if (c->sur_pile[s] && c->indice[s] < c->bas[a]) {
+                c->bas[a] = c->indice[s];
+            }
+        }
+    }
+    if (c->bas[a] != c->indice[a]) return;
+    int b;
+    do {
+        b = c->pile[--c->sommet];
+        c->sur_pile[b] = 0;
+        c->composante[b] = c->nb_composantes;
+    } while (b != a);
+    c->nb_composantes++;
+}
+
+// Composantes, membres et sens ; 0 si une composante n'est linéaire dans aucun sens
+static int orienter(Compilation *c) {
+    const GrammaireSymboles *g = c->grammaire;
+    int n = g->nb_non_terminaux;
+    c->composante = malloc((n + 1) * sizeof(int));
+    c->indice = malloc((n + 1) * sizeof(int));
+    c->bas = malloc((n + 1) * sizeof(int));
+    c->pile = malloc((n + 1) * sizeof(int));
+    c->sur_pile = calloc(n + 1, 1);
+    c->sens = malloc(n + 1);
+    c->debut_membres = calloc(n + 2, sizeof(int));
+    c->membres = malloc((n + 1) * sizeof(int));
+    c->rang = malloc((n + 1) * sizeof(int));
+    if (!c->composante || !c->indice || !c->bas || !c->pile || !c->sur_pile || !c->sens || !c->debut_membres ||
+        !c->membres || !c->rang) {
+        return -1;
+    }
+    for (int a = 0; a < n; a++) c->composante[a] = c->indice[a] = -1;
+    if (c->debut_nt[g->axiome + 1] > c->debut_nt[g->axiome]) tarjan(c, g->axiome);
+
+    for (int a = 0; a < n; a++) {
+        if (c->composante[a] >= 0) c->debut_membres[c->composante[a] + 1]++;
+    }
+    for (int k = 0; k < c->nb_composantes; k++) c->debut_membres[k + 1] += c->debut_membres[k];
+    for (int k = 0; k < c->nb_composantes; k++) c->sens[k] = DROITE | GAUCHE;
+    int *rempli = calloc(c->nb_composantes + 1, sizeof(int));
+    if (!rempli) return -1;
+    for (int a = 0; a < n; a++) {
+        int k = c->composante[a];
+        if (k < 0) continue;
+        c->rang[a] = rempli[k]++;
+        c->membres[c->debut_membres[k] + c->rang[a]] = a;
+    }
+    free(rempli);
+
+    for (int a = 0; a < n; a++) {
+        int k = c->composante[a];
+        if (k < 0) continue;
+        for (int i = c->debut_nt[a]; i < c->debut_nt[a + 1]; i++) {
+            int p = c->productions_nt[i], internes = 0, position = -1;
+            for (int j = 0; j < g->longueur[p]; j++) {
+                int s = g->symboles[g->debut[p] + j];
+                if (s >= 0 && c->composante[s] == k) {
+                    internes++;
+                    position = j;
+                }
+            }
+            if (internes == 0) continue;
+            unsigned char permis = 0;
+            if (internes == 1 && position == g->longueur[p] - 1) permis |= DROITE;
+            if (internes == 1 && position == 0) permis |= GAUCHE;
+            c->sens[k] &= permis;
+            if (!c->sens[k]) return 0;
+        }
+    }
+    return 1;
+}
+
+// Réserver nombre états consécutifs ; -1 si la mémoire ou la limite est dépassée
+static int nouveaux_etats(Compilation *c, int nombre) {
+    if (c->nb_etats + nombre > MAX_ETATS_NON_DETERMINISTES) {
+        c->trop_grand = 1;
+        return -1;
+    }
+    c->nb_etats += nombre;
+    return c->nb_etats - nombre;
+}
+
+static int ajouter_arc(Compilation *c, int origine, int etiquette, int cible) {
+    if (c->nb_arcs == c->capacite_arcs) {
+        int capacite = c->capacite_arcs ? 2 * c->capacite_arcs : 256;
+        int *origines = realloc(c->origine, capacite * sizeof(int));
+        if (!origines) return -1;
+        c->origine = origines;
+        int *etiquettes = realloc(c->etiquette, capacite * sizeof(int));
+        if (!etiquettes) return -1;
+        c->etiquette = etiquettes;
+        int *cibles = realloc(c->cible, capacite * sizeof(int));
+        if (!cibles) return -1;
+        c->cible = cibles;
+        c->capacite_arcs = capacite;
+    }
+    c->origine[c->nb_arcs] = origine;
+    c->etiquette[c->nb_arcs] = etiquette;
+    c->cible[c->nb_arcs++] = cible;
+    return 0;
+}
+
+static int instancier(Compilation *c, int a, int entree, int sortie);
+
+// Lire les symboles s[0 .. n - 1] de l'état de à l'état vers
+static int chainer(Compilation *c, const int *s, int n, int de, int vers) {
+    if (n == 0) return ajouter_arc(c, de, EPSILON_AUTOMATE, vers);
+    for (int i = 0, courant = de; i < n; i++) {
+        int suivant = i == n - 1 ? vers : nouveaux_etats(c, 1);
+        if (suivant == -1) return -1;
+        int statut = s[i] < 0 ? ajouter_arc(c, courant, c->lettre[(unsigned char)(-1 - s[i])], suivant)
+                              : instancier(c, s[i], courant, suivant);
+        if (statut == -1) return -1;
+        courant = suivant;
+    }
+    return 0;
+}
+
+// Copie de l'automate du non-terminal a, de l'état entree à l'état sortie
+static int instancier(Compilation *c, int a, int entree, int sortie) {
+    const GrammaireSymboles *g = c->grammaire;
+    int k = c->composante[a];
+    int base = nouveaux_etats(c, c->debut_membres[k + 1] - c->debut_membres[k]);
+    if (base == -1) return -1;
+    int droite = c->sens[k] & DROITE;
+    if (ajouter_arc(c, droite ? entree : base + c->rang[a], EPSILON_AUTOMATE, droite ? base + c->rang[a] : sortie) == -1) {
+        return -1;
+    }
+    for (int m = c->debut_membres[k]; m < c->debut_membres[k + 1]; m++) {
+        int b = c->membres[m], etat = base + c->rang[b];
+        for (int i = c->debut_nt[b]; i < c->debut_nt[b + 1]; i++) {
+            int p = c->productions_nt[i], n = g->longueur[p];
+            const int *s = &g->symboles[g->debut[p]];
+            int statut;
+            if (droite) {
+                int interne = n > 0 && s[n - 1] >= 0 && c->composante[s[n - 1]] == k;
+                statut = interne ? chainer(c, s, n - 1, etat, base + c->rang[s[n - 1]]) : chainer(c, s, n, etat, sortie);
+            } else {
+                int interne = n > 0 && s[0] >= 0 && c->composante[s[0]] == k;
+                statut = interne ? chainer(c, s + 1, n - 1, base + c->rang[s[0]], etat) : chainer(c, s, n, entree, etat);
+            }
+            if (statut == -1) return -1;
+        }
+    }
+    return 0;
+}
+
+// Déterminisation par sous-ensembles : chaque état est un ensemble trié d'états non
+// déterministes, clos par transitions spontanées
+typedef struct {
+    int nb_lettres;
+    int *debut_arcs;               // Arcs de l'automate non déterministe, rangés par origine
+    int *etiquette_arc, *cible_arc;
+    int *marque, tour;
+
+    int nb_etats, capacite_etats;
+    int *debut_ensemble;
+    int *elements;
+    size_t taille_elements, capacite_elements;
+    unsigned *hachage;
+    int *seau, nb_seaux, *etat_suivant;
+    int *transitions;              // nb_etats × nb_lettres, -1 sans transition
+    unsigned char *final;
+    int trop_grand;
+} Determinisation;
+
+static void liberer_determinisation(Determinisation *d) {
+    free(d->debut_arcs);
+    free(d->etiquette_arc);
+    free(d->cible_arc);
+    free(d->marque);
+    free(d->debut_ensemble);
+    free(d->elements);
+    free(d->hachage);
+    free(d->seau);
+    free(d->etat_suivant);
+    free(d->transitions);
+    free(d->final);
+}
+
+static int comparer_entiers(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Clore l'ensemble (sans doublon) par transitions spontanées puis le trier ; renvoie sa taille
+static int clore(Determinisation *d, int *ensemble, int taille) {
+    d->tour++;
+    for (int i = 0; i < taille; i++) d->marque[ensemble[i]] = d->tour;
+    for (int i = 0; i < taille; i++) {
+        for (int k = d->debut_arcs[ensemble[i]]; k < d->debut_arcs[ensemble[i] + 1]; k++) {
+            int q = d->cible_arc[k];
+            if (d->etiquette_arc[k] != EPSILON_AUTOMATE || d->marque[q] == d->tour) continue;
+            d->marque[q] = d->tour;
+            ensemble[taille++] = q;
+        }
+    }
+    qsort(ensemble, taille, sizeof(int), comparer_entiers);
+    return taille;
+}
+
+// État de cet ensemble, créé au besoin ; -1 si la mémoire ou la limite est dépassée
+static int etat_ensemble(Determinisation *d, const int *ensemble, int taille) {
+    unsigned h = 2166136261u;
+    for (int i = 0; i < taille; i++) h = (h ^ (unsigned)ensemble[i]) * 16777619u;
+    for (int e = d->nb_seaux ? d->seau[h & (d->nb_seaux - 1)] : -1; e != -1; e = d->etat_suivant[e]) {
+        int debut = d->debut_ensemble[e];
+        if (d->hachage[e] == h && d->debut_ensemble[e + 1] - debut == taille &&
+            memcmp(&d->elements[debut], ensemble, taille * sizeof(int)) == 0) {
+            return e;
+        }
+    }
+    if (d->nb_etats == AUTOMATE_MAX_SOUS_ENSEMBLES) {
+        d->trop_grand = 1;
+        return -1;
+    }
+    if (d->nb_etats + 1 >= d->capacite_etats) {
+        int capacite = d->capacite_etats ? 2 * d->capacite_etats : 64;
+        int *debut = realloc(d->debut_ensemble, (capacite + 1) * sizeof(int));
+        if (!debut) return -1;
+        d->debut_ensemble = debut;
+        unsigned *hachage = realloc(d->hachage, capacite * sizeof(unsigned));
+        if (!hachage) return -1;
+        d->hachage = hachage;
+        int *etat_suivant = realloc(d->etat_suivant, capacite * sizeof(int));
+        if (!etat_suivant) return -1;
+        d->etat_suivant = etat_suivant;
+        int *transitions = realloc(d->transitions, (size_t)capacite * (d->nb_lettres ? d->nb_lettres : 1) * sizeof(int));
+        if (!transitions) return -1;
+        d->transitions = transitions;
+        unsigned char *final = realloc(d->final, capacite);
+        if (!final) return -1;
+        d->final = final;
+        int *seau = malloc(2 * capacite * sizeof(int));
+        if (!seau) return -1;
+        free(d->seau);
+        d->seau = seau;
+        d->nb_seaux = 2 * capacite;
+        for (int k = 0; k < d->nb_seaux; k++) d->seau[k] = -1;
+        for (int e = 0; e < d->nb_etats; e++) {
+            d->etat_suivant[e] = d->seau[d->hachage[e] & (d->nb_seaux - 1)];
+            d->seau[d->hachage[e] & (d->nb_seaux - 1)] = e;
+        }
+        d->capacite_etats = capacite;
+    }
+    if (d->taille_elements + taille > d->capacite_elements) {
+        size_t capacite = 2 * (d->taille_elements + taille) + 256;
+        int *elements = realloc(d->elements, capacite * sizeof(int));
+        if (!elements) return -1;
+        d->elements = elements;
+        d->capacite_elements = capacite;
+    }
+    int e = d->nb_etats++;
+    if (e == 0) d->debut_ensemble[0] = 0;
+    memcpy(&d->elements[d->taille_elements], ensemble, taille * sizeof(int));
+    d->taille_elements += taille;
+    d->debut_ensemble[e + 1] = (int)d->taille_elements;
+    d->hachage[e] = h;
+    d->etat_suivant[e] = d->seau[h & (d->nb_seaux - 1)];
+    d->seau[h & (d->nb_seaux - 1)] = e;
+    // L'état final non déterministe est 1 : il vient en tête s'il est présent (après 0)
+    d->final[e] = 0;
+    for (int i = 0; i < taille && i < 2; i++) d->final[e] |= ensemble[i] == 1;
+    for (int k = 0; k < d->nb_lettres; k++) d->transitions[(size_t)e * d->nb_lettres + k] = -1;
+    return e;
+}
+
+static int determiniser(const Compilation *c, int nb_lettres, Determinisation *d) {
+    memset(d, 0, sizeof(*d));
+    d->nb_lettres = nb_lettres;
+    int n = c->nb_etats;
+    d->debut_arcs = calloc(n + 1, sizeof(int));
+    d->etiquette_arc = malloc((c->nb_arcs + 1) * sizeof(int));
+    d->cible_arc = malloc((c->nb_arcs + 1) * sizeof(int));
+    d->marque = calloc(n, sizeof(int));
+    int *ensemble = malloc((n + 1) * sizeof(int));
+    int *paires_lettre = malloc((c->nb_arcs + 1) * sizeof(int)), *paires_cible = malloc((c->nb_arcs + 1) * sizeof(int));
+    int *compte = malloc((nb_lettres + 1) * sizeof(int)), *triees = malloc((c->nb_arcs + 1) * sizeof(int));
+    int statut = d->debut_arcs && d->etiquette_arc && d->cible_arc && d->marque && ensemble && paires_lettre &&
+                 paires_cible && compte && triees ? 0 : -1;
+
+    if (statut == 0) {
+        for (int k = 0; k < c->nb_arcs; k++) d->debut_arcs[c->origine[k] + 1]++;
+        for (int q = 0; q < n; q++) d->debut_arcs[q + 1] += d->debut_arcs[q];
+        for (int k = 0; k < c->nb_arcs; k++) {
+            int place = d->debut_arcs[c->origine[k]]++;
+            d->etiquette_arc[place] = c->etiquette[k];
+            d->cible_arc[place] = c->cible[k];
+        }
+        for (int q = n; q > 0; q--) d->debut_arcs[q] = d->debut_arcs[q - 1];
+        d->debut_arcs[0] = 0;
+
+        ensemble[0] = 0;
+        if (etat_ensemble(d, ensemble, clore(d, ensemble, 1)) == -1) statut = -1;
+    }
+    for (int e = 0; statut == 0 && e < d->nb_etats; e++) {
+        // Transitions étiquetées des états de l'ensemble, rangées par lettre
+        int nb_paires = 0;
+        for (int i = d->debut_ensemble[e]; i < d->debut_ensemble[e + 1]; i++) {
+            int q = d->elements[i];
+            for (int k = d->debut_arcs[q]; k < d->debut_arcs[q + 1]; k++) {
+                if (d->etiquette_arc[k] == EPSILON_AUTOMATE) continue;
+                paires_lettre[nb_paires] = d->etiquette_arc[k];
+                paires_cible[nb_paires++] = d->cible_arc[k];
+            }
+        }
+        for (int k = 0; k <= nb_lettres; k++) compte[k] = 0;
+        for (int i = 0; i < nb_paires; i++) compte[paires_lettre[i] + 1]++;
+        for (int k = 0; k < nb_lettres; k++) compte[k + 1] += compte[k];
+        for (int i = 0; i < nb_paires; i++) triees[compte[paires_lettre[i]]++] = paires_cible[i];
+        for (int k = 0, debut = 0; k < nb_lettres && statut == 0; debut = compte[k++]) {
+            if (compte[k] == debut) continue;
+            int taille = 0;
+            d->tour++;
+            for (int i = debut; i < compte[k]; i++) {
+                if (d->marque[triees[i]] == d->tour) continue;
+                d->marque[triees[i]] = d->tour;
+                ensemble[taille++] = triees[i];
+            }
+            int cible = etat_ensemble(d, ensemble, clore(d, ensemble, taille));
+            if (cible == -1) statut = -1;
+            else d->transitions[(size_t)e * nb_lettres + k] = cible;
+        }
+    }
+
+    free(ensemble);
+    free(paires_lettre);
+    free(paires_cible);
+    free(compte);
+    free(triees);
+    return statut;
+}
+
+// Minimisation de Hopcroft de l'automate déterministe complété par un état puits, puis
+// renumérotation en largeur depuis l'état initial ; la classe du puits (les états d'où
+// aucun mot n'est accepté) disparaît
+static int minimiser(const Determinisation *d, int max_etats, Automate *automate) {
+    int n = d->nb_etats + 1, puits = d->nb_etats, nb_lettres = d->nb_lettres;
+    size_t nb_inverses = (size_t)nb_lettres * n;
+    int *debut_inverse = calloc(nb_inverses + 1, sizeof(int)), *inverse = malloc((nb_inverses + 1) * sizeof(int));
+    int *elements = malloc(n * sizeof(int)), *position = malloc(n * sizeof(int)), *bloc = malloc(n * sizeof(int));
+    int *debut_bloc = malloc((n + 1) * sizeof(int)), *fin_bloc = malloc((n + 1) * sizeof(int));
+    int *marques = calloc(n + 1, sizeof(int)), *touches = malloc((n + 1) * sizeof(int));
+    int *file = malloc((n + 1) * sizeof(int)), *copie = malloc(n * sizeof(int));
+    unsigned char *en_file = calloc(n + 1, 1);
+    int *numero = malloc((n + 1) * sizeof(int)), *ordre = malloc((n + 1) * sizeof(int));
+    int statut = debut_inverse && inverse && elements && position && bloc && debut_bloc && fin_bloc && marques &&
+                 touches && file && copie && en_file && numero && ordre ? 1 : -1;
+
+#define CIBLE(q, k) ((q) == puits || d->transitions[(size_t)(q) * nb_lettres + (k)] == -1 \
+                         ? puits : d->transitions[(size_t)(q) * nb_lettres + (k)])
+    if (statut == 1) {
+        for (int q = 0; q < n; q++) {
+            for (int k = 0; k < nb_lettres; k++) debut_inverse[(size_t)k * n + CIBLE(q, k) + 1]++;
+        }
+        for (size_t i = 0; i < nb_inverses; i++) debut_inverse[i + 1] += debut_inverse[i];
+        for (int q = 0; q < n; q++) {
+            for (int k = 0; k < nb_lettres; k++) inverse[debut_inverse[(size_t)k * n + CIBLE(q, k)]++] = q;
+        }
+        for (size_t i = nb_inverses; i > 0; i--) debut_inverse[i] = debut_inverse[i - 1];
+        debut_inverse[0] = 0;
+
+        // Partition initiale : états finals, puis les autres
+        int nb_elements = 0, nb_blocs = 0, nb_file = 0;
+        for (int passe = 1; passe >= 0; passe--) {
+            int debut = nb_elements;
+            for (int q = 0; q < n; q++) {
+                if ((q != puits && d->final[q]) != passe) continue;
+                position[q] = nb_elements;
+                elements[nb_elements++] = q;
+                bloc[q] = nb_blocs;
+            }
+            if (nb_elements == debut) continue;
+            debut_bloc[nb_blocs] = debut;
+            fin_bloc[nb_blocs] = nb_elements;
+            en_file[nb_blocs] = 1;
+            file[nb_file++] = nb_blocs++;
+        }
+
+        while (nb_file > 0) {
+            int separateur = file[--nb_file];
+            en_file[separateur] = 0;
+            int taille = fin_bloc[separateur] - debut_bloc[separateur];
+            memcpy(copie, &elements[debut_bloc[separateur]], taille * sizeof(int));
+            for (int k = 0; k < nb_lettres; k++) {
+                int nb_touches = 0;
+                for (int i = 0; i < taille; i++) {
+                    size_t cle = (size_t)k * n + copie[i];
+                    for (int j = debut_inverse[cle]; j < debut_inverse[cle + 1]; j++) {
+                        int p = inverse[j], b = bloc[p], place = debut_bloc[b] + marques[b];
+                        if (position[p] < place) continue;
+                        // p passe en tête de son bloc, parmi les états marqués
+                        int autre = elements[place];
+                        elements[position[p]] = autre;
+                        position[autre] = position[p];
+                        elements[place] = p;
+                        position[p] = place;
+                        if (marques[b]++ == 0) touches[nb_touches++] = b;
+                    }
+                }
+                for (int t = 0; t < nb_touches; t++) {
+                    int b = touches[t];
+                    if (marques[b] == fin_bloc[b] - debut_bloc[b]) {
+                        marques[b] = 0;
+                        continue;
+                    }
+                    int nouveau = nb_blocs++;
+                    debut_bloc[nouveau] = debut_bloc[b];
+                    fin_bloc[nouveau] = debut_bloc[b] + marques[b];
+                    debut_bloc[b] = fin_bloc[nouveau];
+                    marques[b] = 0;
+                    for (int i = debut_bloc[nouveau]; i < fin_bloc[nouveau]; i++) bloc[elements[i]] = nouveau;
+                    if (en_file[b] || fin_bloc[nouveau] - debut_bloc[nouveau] <= fin_bloc[b] - debut_bloc[b]) {
+                        en_file[nouveau] = 1;
+                        file[nb_file++] = nouveau;
+                    } else {
+                        en_file[b] = 1;
+                        file[nb_file++] = b;
+                    }
+                }
+            }
+        }
+
+        // Numérotation en largeur des blocs atteints, sans celui du puits
+        for (int b = 0; b < nb_blocs; b++) numero[b] = -1;
+        int nb_etats = 0;
+        numero[bloc[0]] = nb_etats;
+        ordre[nb_etats++] = bloc[0];
+        for (int i = 0; i < nb_etats && nb_etats <= max_etats; i++) {
+            int representant = elements[debut_bloc[ordre[i]]];
+            for (int k = 0; k < nb_lettres; k++) {
+                int b = bloc[CIBLE(representant, k)];
+                if (b == bloc[puits] || numero[b] != -1) continue;
+                numero[b] = nb_etats;
+                ordre[nb_etats++] = b;
+            }
+        }
+        if (nb_etats > max_etats) {
+            statut = 0;
+        } else {
+            automate->nb_etats = nb_etats;
+            automate->transitions = malloc((size_t)nb_etats * (nb_lettres ? nb_lettres : 1) * sizeof(int));
+            automate->final = malloc(nb_etats);
+            if (!automate->transitions || !automate->final) statut = -1;
+            for (int e = 0; statut == 1 && e < nb_etats; e++) {
+                int representant = elements[debut_bloc[ordre[e]]];
+                automate->final[e] = representant != puits && d->final[representant];
+                for (int k = 0; k < nb_lettres; k++) {
+                    int b = bloc[CIBLE(representant, k)];
+                    automate->transitions[(size_t)e * nb_lettres + k] = b == bloc[puits] ? -1 : numero[b];
+                }
+            }
+        }
+    }
+#undef CIBLE
+
+    free(debut_inverse);
+    free(inverse);
+    free(elements);
+    free(position);
+    free(bloc);
+    free(debut_bloc);
+    free(fin_bloc);
+    free(marques);
+    free(touches);
+    free(file);
+    free(copie);
+    free(en_file);
+    free(numero);
+    free(ordre);
+    return statut;
+}
+
+int compiler_automate(const GrammaireSymboles *grammaire, int max_etats, Automate *automate) {
+    memset(automate, 0, sizeof(*automate));
+    Compilation c;
+    memset(&c, 0, sizeof(c));
+    c.grammaire = grammaire;
+    int statut = garder_utiles(&c);
+    if (statut == 0) statut = orienter(&c);
+    if (statut == 1) {
+        // 0 initial, 1 final ; un langage vide n'a aucune production gardée pour l'axiome
+        c.nb_etats = 2;
+        if (c.composante[grammaire->axiome] >= 0 && instancier(&c, grammaire->axiome, 0, 1) == -1) {
+            statut = c.trop_grand ? 0 : -1;
+        }
+    }
+
+    for (int k = 0; statut == 1 && k < 256; k++) {
+        automate->lettre[k] = c.lettre[k];
+        if (c.lettre[k] >= 0) automate->lettres[automate->nb_lettres++] = (char)k;
+    }
+
+    Determinisation d;
+    memset(&d, 0, sizeof(d));
+    if (statut == 1 && determiniser(&c, automate->nb_lettres, &d) == -1) statut = d.trop_grand ? 0 : -1;
+    if (statut == 1) statut = minimiser(&d, max_etats, automate);
+    liberer_determinisation(&d);
+    liberer_compilation(&c);
+    if (statut != 1) liberer_automate(automate);
+    return statut;
+}
+
+void liberer_automate(Automate *automate) {
+    free(automate->transitions);
+    free(automate->final);
+    automate->transitions = NULL;
+    automate->final = NULL;
+    automate->nb_etats = 0;
+}
+
+int automate_reconnait(const Automate *automate, const char *mot, size_t longueur) {
+    int etat = 0;
+    for (size_t i = 0; i < longueur && etat != -1; i++) {
+        int k = automate->lettre[(unsigned char)mot[i]];
+        etat = k < 0 ? -1 : automate->transitions[(size_t)etat * automate->nb_lettres + k];
+    }
+    return etat != -1 && automate->final[etat];
+}
+
+int parcours_automate_ouvrir(ParcoursAutomate *parcours, const Automate *automate, int longueur_max) {
+    memset(parcours, 0, sizeof(*parcours));
+    parcours->automate = automate;
+    parcours->longueur_max = longueur_max;
+    parcours->profondeur = -1;
+    int n = automate->nb_etats, nb_lettres = automate->nb_lettres;
+    parcours->atteint = malloc((size_t)(longueur_max + 1) * n);
+    parcours->etats = malloc((longueur_max + 2) * sizeof(int));
+    parcours->choix = malloc((longueur_max + 2) * sizeof(int));
+    parcours->mot = malloc(longueur_max + 2);
+    if (!parcours->atteint || !parcours->etats || !parcours->choix || !parcours->mot) {
+        parcours_automate_fermer(parcours);
+        return -1;
+    }
+    for (int q = 0; q < n; q++) parcours->atteint[q] = automate->final[q];
+    for (int r = 1; r <= longueur_max; r++) {
+        const unsigned char *avant = &parcours->atteint[(size_t)(r - 1) * n];
+        for (int q = 0; q < n; q++) {
+            unsigned char atteint = 0;
+            for (int k = 0; k < nb_lettres && !atteint; k++) {
+                int suivant = automate->transitions[(size_t)q * nb_lettres + k];
+                atteint = suivant != -1 && avant[suivant];
+            }
+            parcours->atteint[(size_t)r * n + q] = atteint;
+        }
+    }
+    return 0;
+}
+
+int parcours_automate_suivant(ParcoursAutomate *parcours, const char **mot, size_t *longueur) {
+    const Automate *automate = parcours->automate;
+    int n = automate->nb_etats, nb_lettres = automate->nb_lettres;
+    for (; parcours->longueur <= parcours->longueur_max; parcours->longueur++, parcours->profondeur = -1) {
+        int l = parcours->longueur, i = parcours->profondeur;
+        if (i == -1) {
+            // Nouvelle longueur : l'état initial doit mener à un état final en l lettres
+            if (!parcours->atteint[(size_t)l * n]) continue;
+            i = 0;
+            parcours->etats[0] = 0;
+            parcours->choix[0] = -1;
+        } else if (l == 0) {
+            continue;
+        } else {
+            i--;               // Après un mot : essayer la lettre suivante de la dernière position
+        }
+        while (i < l) {
+            int etat = parcours->etats[i], k = parcours->choix[i] + 1, suivant = -1;
+            for (; k < nb_lettres; k++) {
+                suivant = automate->transitions[(size_t)etat * nb_lettres + k];
+                if (suivant != -1 && parcours->atteint[(size_t)(l - i - 1) * n + suivant]) break;
+            }
+            if (k < nb_lettres) {
+                parcours->choix[i] = k;
+                parcours->mot[i] = automate->lettres[k];
+                parcours->etats[++i] = suivant;
+                parcours->choix[i] = -1;
+            } else if (i == 0) {
+                break;
+            } else {
+                i--;
+            }
+        }
+        if (i < l) continue;
+        parcours->profondeur = l;
+        parcours->mot[l] = '\0';
+        *mot = parcours->mot;
+        *longueur = (size_t)l;
+        return 1;
+    }
+    return 0;
+}
+
+// Placer le parcours sur un mot accepté : parcours_automate_suivant donne ensuite le mot
+// qui le suit. Renvoie 1, 0 si le mot n'est pas accepté ou dépasse longueur_max.
+int parcours_automate_placer(ParcoursAutomate *parcours, const char *mot, size_t longueur) {
+    const Automate *automate = parcours->automate;
+    if (longueur > (size_t)parcours->longueur_max || !automate_reconnait(automate, mot, longueur)) return 0;
+    int l = (int)longueur;
+    parcours->etats[0] = 0;
+    for (int i = 0; i < l; i++) {
+        int k = automate->lettre[(unsigned char)mot[i]];
+        parcours->choix[i] = k;
+        parcours->mot[i] = mot[i];
+        parcours->etats[i + 1] = automate->transitions[(size_t)parcours->etats[i] * automate->nb_lettres + k];
+    }
+    parcours->choix[l] = -1;
+    parcours->mot[l] = '\0';
+    parcours->longueur = l;
+    parcours->profondeur = l;
+    return 1;
+}
+
+void parcours_automate_fermer(ParcoursAutomate *parcours) {
+    free(parcours->atteint);
+    free(parcours->etats);
+    free(parcours->choix);
+    free(parcours->mot);
+    parcours->atteint = NULL;
+    parcours->etats = NULL;
+    parcours->choix = NULL;
+    parcours->mot = NULL;
+}
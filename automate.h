@@ -0,0 +1,66 @@
+#ifndef AUTOMATE_H
+#define AUTOMATE_H
+
+#include <stddef.h>
+
+// Grammaires régulières (automate.c). Une grammaire dont chaque composante fortement
+// connexe de non-terminaux est linéaire à droite (A -> w B) ou à gauche (A -> B w), w ne
+// contenant que des terminaux et des non-terminaux de composantes inférieures, est sans
+// auto-enchâssement : son langage est régulier. Elle est compilée en automate fini non
+// déterministe, déterminisé par sous-ensembles, puis minimisé par l'algorithme de Hopcroft.
+// L'automate minimal reconnaît un mot en temps linéaire et énumère les mots d'une longueur
+// donnée sans jamais s'engager dans une impasse.
+// Le module ne dépend d'aucun format de grammaire : l'appelant décrit ses productions par
+// des symboles numérotés, comme ceux de GrammaireIndexee ou de TableLL1.
+
+// Un symbole >= 0 est un non-terminal, -1 - c le terminal c
+typedef struct {
+    int nb_non_terminaux;
+    int axiome;
+    int nb_productions;
+    const int *gauche, *debut, *longueur;
+    const int *symboles;           // Production p : symboles[debut[p]] .. symboles[debut[p] + longueur[p] - 1]
+} GrammaireSymboles;
+
+typedef struct {
+    int nb_etats;                  // L'état 0 est initial ; aucun état ne mène à une impasse
+    int nb_lettres;
+    char lettres[257];             // Alphabet, dans l'ordre de strcmp
+    int lettre[256];               // Indice d'un caractère dans lettres, -1 hors de l'alphabet
+    int *transitions;              // nb_etats × nb_lettres : état suivant, ou -1
+    unsigned char *final;
+} Automate;
+
+// Sous-ensembles explorés au plus pendant la déterminisation
+#define AUTOMATE_MAX_SOUS_ENSEMBLES (1 << 16)
+
+// 1 si la grammaire est reconnue régulière et que son automate minimal a au plus
+// max_etats états, 0 sinon (l'automate n'est alors pas rempli), -1 si la mémoire manque.
+// Un langage vide donne un seul état, non final et sans transition.
+int compiler_automate(const GrammaireSymboles *grammaire, int max_etats, Automate *automate);
+void liberer_automate(Automate *automate);
+// 1 si le mot est accepté, 0 sinon
+int automate_reconnait(const Automate *automate, const char *mot, size_t longueur);
+
+// Parcours des mots acceptés de longueur <= longueur_max : par longueur, puis dans l'ordre
+// de strcmp, chacun une fois. Seuls les préfixes qui se prolongent en un mot de la longueur
+// en cours sont visités.
+typedef struct {
+    const Automate *automate;
+    int longueur_max;
+    unsigned char *atteint;        // [r × nb_etats + q] : un mot de r lettres mène de q à un état final
+    int longueur;                  // Longueur en cours
+    int profondeur;                // Lettres placées, -1 si la longueur n'est pas commencée
+    int *etats;                    // etats[i] : état après i lettres
+    int *choix;                    // choix[i] : indice de la i-ième lettre
+    char *mot;
+} ParcoursAutomate;
+
+int parcours_automate_ouvrir(ParcoursAutomate *parcours, const Automate *automate, int longueur_max);
+// 1 et le mot suivant (valable jusqu'à l'appel suivant), 0 à la fin
+int parcours_automate_suivant(ParcoursAutomate *parcours, const char **mot, size_t *longueur);
+// Placer le parcours sur un mot accepté (reprise) : 1, 0 si le mot n'est pas accepté
+int parcours_automate_placer(ParcoursAutomate *parcours, const char *mot, size_t longueur);
+void parcours_automate_fermer(ParcoursAutomate *parcours);
+
+#endif
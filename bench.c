@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/wait.h>
+
+#include "libgrammaire.h"
+#include "synthese.h"
+
+// Mesures de performance sur des grammaires synthétiques (make bench).
+// Chaque mesure est répétée et la plus courte durée est gardée. Une ligne par mesure,
+// champs séparés par des tabulations, dans un ordre fixe :
+//   scenario  mesure  secondes  regles  productions  symboles  mots
+// Les mesures sont "lecture" (lire_grammaire et rewriter_grammaire), "<forme>" (conversion
+// complète), "<forme>.NN" (étape NN de la conversion, voir les commentaires "# etape" de
+// l'en-tête) et "generate_words.<forme>.nN" ; un champ sans objet vaut "-". Une mesure
+// en échec donne une ligne "echec" avec le message à la place des mesures ; generate_words
+// est arrêté au-delà du délai (--delai, en secondes).
+
+typedef struct {
+    const char *nom;
+    ParametresSynthese parametres;
+} Scenario;
+
+// graine, règles, productions, longueur, terminaux, ε, unités, récursivité gauche
+static const Scenario scenarios[] = {
+    { "petite",     { 1, 4, 2, 3, 3, 0.25, 1, 1 } },
+    { "moyenne",    { 2, 8, 3, 4, 3, 0.2, 2, 2 } },
+    { "epsilon",    { 3, 8, 2, 3, 3, 0.6, 1, 1 } },
+    { "unites",     { 4, 10, 2, 3, 3, 0.0, 6, 0 } },
+    { "recursive",  { 5, 8, 2, 3, 3, 0.1, 0, 4 } },
+    { "large",      { 6, 16, 3, 3, 2, 0.1, 2, 2 } },
+};
+
+static const int longueurs_mots[] = { 3, 5, 7 };
+
+typedef struct {
+    double secondes[32];
+    MesureEtape derniere[32];
+    int nb;
+} MesuresBench;
+
+static void noter_mesure(void *donnees, const MesureEtape *mesure) {
+    MesuresBench *mesures = donnees;
+    int i = mesure->numero - 1;
+    if (i < 0 || i >= 32) return;
+    if (i >= mesures->nb) mesures->nb = i + 1;
+    if (mesures->derniere[i].etape == NULL || mesure->secondes < mesures->secondes[i]) mesures->secondes[i] = mesure->secondes;
+    mesures->derniere[i] = *mesure;
+}
+
+static void ecrire_ligne(const char *scenario, const char *mesure, double secondes, const Grammaire *grammaire, long mots) {
+    printf("%s\t%s\t%.6f\t", scenario, mesure, secondes);
+    if (grammaire) {
+        int regles, productions;
+        long symboles;
+        mesurer_grammaire(grammaire, &regles, &productions, &symboles);
+        printf("%d\t%d\t%ld\t", regles, productions, symboles);
+    } else {
+        printf("-\t-\t-\t");
+    }
+    if (mots >= 0) printf("%ld\n", mots); else printf("-\n");
+}
+
+// Lire et regrouper la grammaire ; renvoie la meilleure durée, ou -1
+static double mesurer_lecture(const char *fichier, Grammaire *grammaire, int repetitions, char *message, size_t taille) {
+    double meilleure = -1;
+    for (int r = 0; r < repetitions; r++) {
+        ContexteGrammaire ctx;
+        contexte_grammaire_init(&ctx);
+        double depart = horloge_grammaire();
+        if (lire_grammaire(&ctx, grammaire, fichier) != GRAMMAIRE_OK || rewriter_grammaire(&ctx, grammaire) != GRAMMAIRE_OK) {
+            snprintf(message, taille, "%s", contexte_grammaire_message(&ctx));
+            return -1;
+        }
+        double duree = horloge_grammaire() - depart;
+        if (meilleure < 0 || duree < meilleure) meilleure = duree;
+    }
+    return meilleure;
+}
+
+static long compter_lignes(const char *fichier) {
+    FILE *file = fopen(fichier, "r");
+    if (!file) return -1;
+    long lignes = 0;
+    int c;
+    while ((c = getc(file)) != EOF) lignes += c == '\n';
+    fclose(file);
+    return lignes;
+}
+
+// Lancer generate_words --threads=1 grammaire n sortie ; renvoie la durée, -1 en cas
+// d'échec ou -2 si le délai est dépassé
+static double lancer_generate_words(const char *programme, const char *grammaire, int n, const char *sortie, double delai) {
+    char longueur[16];
+    snprintf(longueur, sizeof(longueur), "%d", n);
+    double depart = horloge_grammaire();
+    pid_t pid = fork();
+    if (pid == -1) return -1;
+    if (pid == 0) {
+        int nul = open("/dev/null", O_WRONLY);
+        if (nul != -1) {
+            dup2(nul, STDOUT_FILENO);
+            dup2(nul, STDERR_FILENO);
+        }
+        execl(programme, programme, "--threads=1", grammaire, longueur, sortie, (char *)NULL);
+        _exit(127);
+    }
+    int statut;
+    pid_t fini;
+    struct timespec pause = { 0, 1000000 };
+    while ((fini = waitpid(pid, &statut, WNOHANG)) == 0) {
+        if (horloge_grammaire() - depart > delai) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &statut, 0);
+            return -2;
+        }
+        nanosleep(&pause, NULL);
+    }
+    double duree = horloge_grammaire() - depart;
+    if (fini == -1 || !WIFEXITED(statut) || WEXITSTATUS(statut) != 0) return -1;
+    return duree;
+}
+
+static void mesurer_forme(const Scenario *scenario, const char *repertoire, const Grammaire *lue, FormeNormale forme,
+                          int repetitions, const char *generate_words, double delai, Grammaire *grammaire) {
+    const char *nom_forme = forme == FORME_GREIBACH ? "greibach" : "chomsky";
+    MesuresBench mesures;
+    memset(&mesures, 0, sizeof(mesures));
+    double meilleure = -1;
+    for (int r = 0; r < repetitions; r++) {
+        *grammaire = *lue;
+        ContexteGrammaire ctx;
+        contexte_grammaire_init(&ctx);
+        ctx.mesure = noter_mesure;
+        ctx.donnees_mesure = &mesures;
+        char axiome[MAX_SYMBOLS];
+        strcpy(axiome, grammaire->rules[0].non_terminal);
+        double depart = horloge_grammaire();
+        int statut = forme == FORME_GREIBACH ? greibach(&ctx, grammaire, axiome) : transformer_en_chomsky(&ctx, grammaire, axiome);
+        double duree = horloge_grammaire() - depart;
+        if (statut != GRAMMAIRE_OK) {
+            printf("%s\t%s\techec\t%s\n", scenario->nom, nom_forme, contexte_grammaire_message(&ctx));
+            return;
+        }
+        if (meilleure < 0 || duree < meilleure) meilleure = duree;
+    }
+    ecrire_ligne(scenario->nom, nom_forme, meilleure, grammaire, -1);
+    for (int i = 0; i < mesures.nb; i++) {
+        const MesureEtape *m = &mesures.derniere[i];
+        char nom[64];
+        snprintf(nom, sizeof(nom), "%s.%02d", nom_forme, i + 1);
+        printf("%s\t%s\t%.6f\t%d\t%d\t%ld\t-\n", scenario->nom, nom, mesures.secondes[i], m->regles, m->productions, m->symboles);
+    }
+
+    char base[4096], sortie[4200], mots[4200];
+    snprintf(base, sizeof(base), "%s/%s", repertoire, scenario->nom);
+    snprintf(sortie, sizeof(sortie), "%s.%s", base, nom_forme);
+    snprintf(mots, sizeof(mots), "%s.%s.mots", base, nom_forme);
+    ContexteGrammaire ctx;
+    contexte_grammaire_init(&ctx);
+    if (sauvegarder_grammaire(&ctx, grammaire, base, forme == FORME_GREIBACH ? 'g' : 'c') != GRAMMAIRE_OK) {
+        printf("%s\tgenerate_words.%s\techec\t%s\n", scenario->nom, nom_forme, contexte_grammaire_message(&ctx));
+        return;
+    }
+    for (size_t k = 0; k < sizeof(longueurs_mots) / sizeof(longueurs_mots[0]); k++) {
+        char nom[64];
+        snprintf(nom, sizeof(nom), "generate_words.%s.n%d", nom_forme, longueurs_mots[k]);
+        double meilleure_generation = -1;
+        for (int r = 0; r < repetitions; r++) {
+            double duree = lancer_generate_words(generate_words, sortie, longueurs_mots[k], mots, delai);
+            if (duree < 0) {
+                meilleure_generation = duree;
+                break;
+            }
+            if (meilleure_generation < 0 || duree < meilleure_generation) meilleure_generation = duree;
+        }
+        if (meilleure_generation == -2) {
+            printf("%s\t%s\techec\tdélai de %g s dépassé\n", scenario->nom, nom, delai);
+        } else if (meilleure_generation < 0) {
+            printf("%s\t%s\techec\t%s a échoué\n", scenario->nom, nom, generate_words);
+        } else {
+            ecrire_ligne(scenario->nom, nom, meilleure_generation, NULL, compter_lignes(mots));
+        }
+        unlink(mots);
+    }
+    unlink(sortie);
+}
+
+void afficher_usage(const char *programme) {
+    fprintf(stderr, "Usage : %s [--repetitions=N] [--delai=secondes] [--generate-words=chemin] [--scenario=nom]\n", programme);
+}
+
+int main(int argc, char *argv[]) {
+    int repetitions = 5;
+    double delai = 5;
+    const char *generate_words = "./generate_words";
+    const char *seul = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--repetitions=", 14) == 0) {
+            repetitions = atoi(argv[i] + 14);
+        } else if (strncmp(argv[i], "--delai=", 8) == 0) {
+            delai = atof(argv[i] + 8);
+        } else if (strncmp(argv[i], "--generate-words=", 17) == 0) {
+            generate_words = argv[i] + 17;
+        } else if (strncmp(argv[i], "--scenario=", 11) == 0) {
+            seul = argv[i] + 11;
+        } else {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (repetitions < 1) repetitions = 1;
+
+    char repertoire[] = "/tmp/bench_grammaire.XXXXXX";
+    if (!mkdtemp(repertoire)) {
+        perror("Erreur lors de la création du répertoire temporaire");
+        return -1;
+    }
+    Grammaire *grammaires = malloc(2 * sizeof(Grammaire));
+    if (!grammaires) {
+        perror("Erreur d'allocation");
+        rmdir(repertoire);
+        return -1;
+    }
+    Grammaire *lue = &grammaires[0], *grammaire = &grammaires[1];
+
+    printf("# bench libgrammaire %s repetitions=%d delai=%g\n", LIBGRAMMAIRE_VERSION, repetitions, delai);
+    for (int f = 0; f < 2; f++) {
+        const EtapeConversion *etapes;
+        FormeNormale forme = f == 0 ? FORME_GREIBACH : FORME_CHOMSKY;
+        int nb_etapes = etapes_conversion(forme, &etapes);
+        for (int i = 0; i < nb_etapes; i++) {
+            printf("# etape %s.%02d %s\n", f == 0 ? "greibach" : "chomsky", i + 1, etapes[i].nom);
+        }
+    }
+    printf("scenario\tmesure\tsecondes\tregles\tproductions\tsymboles\tmots\n");
+
+    int echecs = 0;
+    for (size_t s = 0; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+        const Scenario *scenario = &scenarios[s];
+        if (seul && strcmp(seul, scenario->nom) != 0) continue;
+        char fichier[4096];
+        snprintf(fichier, sizeof(fichier), "%s/%s.general", repertoire, scenario->nom);
+        FILE *sortie = fopen(fichier, "w");
+        if (!sortie) {
+            perror("Erreur lors de l'ouverture du fichier");
+            echecs++;
+            continue;
+        }
+        int statut = generer_grammaire_synthetique(sortie, &scenario->parametres);
+        if (fclose(sortie) != 0 || statut != 0) {
+            unlink(fichier);
+            echecs++;
+            continue;
+        }
+
+        char message[256];
+        double lecture = mesurer_lecture(fichier, lue, repetitions, message, sizeof(message));
+        unlink(fichier);
+        if (lecture < 0) {
+            printf("%s\tlecture\techec\t%s\n", scenario->nom, message);
+            echecs++;
+            continue;
+        }
+        ecrire_ligne(scenario->nom, "lecture", lecture, lue, -1);
+        mesurer_forme(scenario, repertoire, lue, FORME_GREIBACH, repetitions, generate_words, delai, grammaire);
+        mesurer_forme(scenario, repertoire, lue, FORME_CHOMSKY, repetitions, generate_words, delai, grammaire);
+        fflush(stdout);
+    }
+    free(grammaires);
+    rmdir(repertoire);
+    return echecs == 0 ? 0 : 1;
+}
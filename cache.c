@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include "cache.h"
+
+// Deux hachages de 64 bits indépendants : FNV-1a, et un mélange par mots de 8 octets
+// avec la finalisation de splitmix64
+static uint64_t melanger(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static void hacher(const char *donnees, size_t taille, uint64_t *h1, uint64_t *h2) {
+    uint64_t fnv = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < taille; i++) {
+        fnv ^= (unsigned char)donnees[i];
+        fnv *= 0x100000001b3ULL;
+    }
+    uint64_t m = 0x9e3779b97f4a7c15ULL ^ taille;
+    for (size_t i = 0; i < taille; i += 8) {
+        uint64_t mot = 0;
+        size_t n = taille - i < 8 ? taille - i : 8;
+        memcpy(&mot, donnees + i, n);
+        m = melanger(m ^ mot) + 0x9e3779b97f4a7c15ULL;
+    }
+    *h1 = fnv;
+    *h2 = melanger(m);
+}
+
+// Clé d'une grammaire déjà lue et regroupée par rewriter_grammaire ; la variante distingue
+// les modes de conversion qui donnent des sorties différentes (NULL pour le mode par défaut)
+int cache_calculer_cle(const Grammaire *grammaire, const char *variante, CleCache *cle) {
+    cle->canonique = NULL;
+    cle->taille = 0;
+    FILE *flux = open_memstream(&cle->canonique, &cle->taille);
+    if (!flux) {
+        perror("Erreur d'allocation");
+        return -1;
+    }
+    fprintf(flux, "libgrammaire %s%s%s\n", LIBGRAMMAIRE_VERSION, variante ? " " : "", variante ? variante : "");
+    int statut = ecrire_grammaire(flux, grammaire);
+    if (fclose(flux) != 0 || statut != GRAMMAIRE_OK) {
+        free(cle->canonique);
+        cle->canonique = NULL;
+        return -1;
+    }
+    uint64_t h1, h2;
+    hacher(cle->canonique, cle->taille, &h1, &h2);
+    snprintf(cle->cle, sizeof(cle->cle), "%016llx%016llx", (unsigned long long)h1, (unsigned long long)h2);
+    return 0;
+}
+
+// Clé d'un texte quelconque (copié dans la clé)
+int cache_cle_texte(const char *texte, CleCache *cle) {
+    cle->taille = strlen(texte);
+    cle->canonique = strdup(texte);
+    if (!cle->canonique) {
+        perror("Erreur d'allocation");
+        return -1;
+    }
+    uint64_t h1, h2;
+    hacher(cle->canonique, cle->taille, &h1, &h2);
+    snprintf(cle->cle, sizeof(cle->cle), "%016llx%016llx", (unsigned long long)h1, (unsigned long long)h2);
+    return 0;
+}
+
+void cache_liberer_cle(CleCache *cle) {
+    free(cle->canonique);
+    cle->canonique = NULL;
+}
+
+static void chemin_entree(const CacheGrammaires *cache, const CleCache *cle, const char *extension, char *chemin, size_t taille) {
+    snprintf(chemin, taille, "%s/%s.%s", cache->repertoire, cle->cle, extension);
+}
+
+// Le fichier contient-il exactement ces octets ?
+static int contenu_egal(const char *chemin, const char *donnees, size_t taille) {
+    FILE *file = fopen(chemin, "rb");
+    if (!file) return 0;
+    char tampon[4096];
+    size_t position = 0, lus;
+    int egal = 1;
+    while (egal && (lus = fread(tampon, 1, sizeof(tampon), file)) > 0) {
+        if (position + lus > taille || memcmp(tampon, donnees + position, lus) != 0) egal = 0;
+        position += lus;
+    }
+    fclose(file);
+    return egal && position == taille;
+}
+
+// Écrire `destination` sous un nom temporaire voisin puis le renommer ; la source est
+// soit un fichier (source != NULL), soit des octets en mémoire
+static int ecrire_atomique(const char *destination, const char *source, const char *donnees, size_t taille) {
+    char temporaire[4200];
+    snprintf(temporaire, sizeof(temporaire), "%s.XXXXXX", destination);
+    int fd = mkstemp(temporaire);
+    if (fd == -1) return -1;
+    fchmod(fd, 0644);
+    FILE *sortie = fdopen(fd, "wb");
+    if (!sortie) {
+        close(fd);
+        unlink(temporaire);
+        return -1;
+    }
+
+    int statut = 0;
+    if (source) {
+        FILE *entree = fopen(source, "rb");
+        if (!entree) {
+            statut = -1;
+        } else {
+            char tampon[65536];
+            size_t lus;
+            while ((lus = fread(tampon, 1, sizeof(tampon), entree)) > 0) {
+                if (fwrite(tampon, 1, lus, sortie) != lus) {
+                    statut = -1;
+                    break;
+                }
+            }
+            if (ferror(entree)) statut = -1;
+            fclose(entree);
+        }
+    } else if (fwrite(donnees, 1, taille, sortie) != taille) {
+        statut = -1;
+    }
+    if (fclose(sortie) != 0) statut = -1;
+    if (statut == 0 && rename(temporaire, destination) != 0) statut = -1;
+    if (statut != 0) unlink(temporaire);
+    return statut;
+}
+
+// Chercher la sortie `forme` ("greibach" ou "chomsky") de la grammaire et la placer dans
+// destination. Renvoie 1 en cas de succès, 0 si l'entrée est absente, -1 en cas d'erreur.
+int cache_chercher(const CacheGrammaires *cache, const CleCache *cle, const char *forme, const char *destination) {
+    char chemin[4096];
+    chemin_entree(cache, cle, "entree", chemin, sizeof(chemin));
+    if (!contenu_egal(chemin, cle->canonique, cle->taille)) return 0;
+    chemin_entree(cache, cle, forme, chemin, sizeof(chemin));
+    if (access(chemin, R_OK) != 0) return 0;
+
+    if (cache->liens) {
+        // Le lien remplace la destination ; sauvegarder_grammaire fait de même avant
+        // d'écrire, si bien que le cache n'est jamais modifié à travers un lien
+        if (unlink(destination) != 0 && errno != ENOENT) return -1;
+        if (link(chemin, destination) == 0) return 1;
+    }
+    return ecrire_atomique(destination, chemin, NULL, 0) == 0 ? 1 : -1;
+}
+
+// Ranger dans le cache la sortie `forme` déjà écrite dans source
+int cache_ranger(const CacheGrammaires *cache, const CleCache *cle, const char *forme, const char *source) {
+    char chemin[4096];
+    if (mkdir(cache->repertoire, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Erreur : impossible de créer le cache %s : %s\n", cache->repertoire, strerror(errno));
+        return -1;
+    }
+    chemin_entree(cache, cle, "entree", chemin, sizeof(chemin));
+    if (!contenu_egal(chemin, cle->canonique, cle->taille) &&
+        ecrire_atomique(chemin, NULL, cle->canonique, cle->taille) != 0) {
+        fprintf(stderr, "Erreur : écriture impossible dans le cache %s\n", chemin);
+        return -1;
+    }
+    chemin_entree(cache, cle, forme, chemin, sizeof(chemin));
+    if (ecrire_atomique(chemin, source, NULL, 0) != 0) {
+        fprintf(stderr, "Erreur : écriture impossible dans le cache %s\n", chemin);
+        return -1;
+    }
+    return 0;
+}
+
+// Mémo des composantes de normaliser_modulaire : <clé>.entree garde la clé de la
+// composante, <clé>.composante son résultat
+static char *chercher_composante(void *donnees, const char *texte) {
+    const CacheGrammaires *cache = donnees;
+    CleCache cle;
+    if (cache_cle_texte(texte, &cle) != 0) return NULL;
+    char chemin[4096];
+    chemin_entree(cache, &cle, "entree", chemin, sizeof(chemin));
+    char *resultat = NULL;
+    if (contenu_egal(chemin, cle.canonique, cle.taille)) {
+        chemin_entree(cache, &cle, "composante", chemin, sizeof(chemin));
+        FILE *file = fopen(chemin, "rb");
+        if (file) {
+            size_t taille = 0, capacite = 4096, lus;
+            resultat = malloc(capacite);
+            while (resultat && (lus = fread(resultat + taille, 1, capacite - taille - 1, file)) > 0) {
+                taille += lus;
+                if (capacite - taille == 1) {
+                    char *plus = realloc(resultat, capacite *= 2);
+                    if (!plus) {
+                        free(resultat);
+                        resultat = NULL;
+                    } else {
+                        resultat = plus;
+                    }
+                }
+            }
+            if (resultat) resultat[taille] = '\0';
+            if (ferror(file)) {
+                free(resultat);
+                resultat = NULL;
+            }
+            fclose(file);
+        }
+    }
+    cache_liberer_cle(&cle);
+    return resultat;
+}
+
+static void ranger_composante(void *donnees, const char *texte, const char *resultat) {
+    const CacheGrammaires *cache = donnees;
+    CleCache cle;
+    if (cache_cle_texte(texte, &cle) != 0) return;
+    char chemin[4096];
+    if (mkdir(cache->repertoire, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "Erreur : impossible de créer le cache %s : %s\n", cache->repertoire, strerror(errno));
+    } else {
+        chemin_entree(cache, &cle, "composante", chemin, sizeof(chemin));
+        // Le résultat d'abord : une entrée visible a toujours son résultat
+        if (ecrire_atomique(chemin, NULL, resultat, strlen(resultat)) != 0) {
+            fprintf(stderr, "Erreur : écriture impossible dans le cache %s\n", chemin);
+        } else {
+            chemin_entree(cache, &cle, "entree", chemin, sizeof(chemin));
+            if (!contenu_egal(chemin, cle.canonique, cle.taille) &&
+                ecrire_atomique(chemin, NULL, cle.canonique, cle.taille) != 0) {
+                fprintf(stderr, "Erreur : écriture impossible dans le cache %s\n", chemin);
+            }
+        }
+    }
+    cache_liberer_cle(&cle);
+}
+
+MemoComposantes cache_memo_composantes(const CacheGrammaires *cache) {
+    MemoComposantes memo = { chercher_composante, ranger_composante, (void *)cache };
+    return memo;
+}
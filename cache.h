@@ -0,0 +1,40 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stddef.h>
+
+#include "libgrammaire.h"
+
+// Cache des grammaires normalisées, adressé par le contenu.
+// La clé est un hachage de 128 bits de la grammaire canonique (après lecture et
+// regroupement des règles, écrite par ecrire_grammaire) précédée de LIBGRAMMAIRE_VERSION.
+// Une entrée est un ensemble de fichiers dans le répertoire du cache :
+//   <clé>.entree    la grammaire canonique (vérifiée à chaque succès : une collision
+//                   de hachage ne peut donner qu'un défaut de cache)
+//   <clé>.greibach  et <clé>.chomsky, les sorties déjà calculées
+// La variante "modulaire" a sa propre clé : ses sorties ont d'autres noms de non-terminaux.
+// Les fichiers sont écrits sous un nom temporaire puis renommés : plusieurs threads ou
+// processus peuvent partager un même répertoire.
+
+typedef struct {
+    const char *repertoire;
+    int liens;          // 1 : servir les succès par lien physique plutôt que par copie
+} CacheGrammaires;
+
+typedef struct {
+    char cle[33];       // 32 chiffres hexadécimaux
+    char *canonique;    // Grammaire canonique (à libérer avec cache_liberer_cle)
+    size_t taille;
+} CleCache;
+
+int cache_calculer_cle(const Grammaire *grammaire, const char *variante, CleCache *cle);
+int cache_cle_texte(const char *texte, CleCache *cle);
+void cache_liberer_cle(CleCache *cle);
+int cache_chercher(const CacheGrammaires *cache, const CleCache *cle, const char *forme, const char *destination);
+int cache_ranger(const CacheGrammaires *cache, const CleCache *cle, const char *forme, const char *source);
+
+// Mémo des composantes de normaliser_modulaire dans le même répertoire
+// (<clé>.entree et <clé>.composante)
+MemoComposantes cache_memo_composantes(const CacheGrammaires *cache);
+
+#endif
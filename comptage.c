@@ -0,0 +1,319 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "generate_words.h"
+
+// Comptage par (non-terminal, longueur) et tirage aléatoire de mots.
+// Pour une longueur l fixée, un non-terminal ne dépend de lui-même à la même longueur
+// qu'à travers des règles unité ou des symboles effaçables : on itère donc jusqu'au
+// point fixe, et l'absence de point fixe signale une infinité de dérivations.
+
+#define SUFFIXE(table, p, j, l) \
+    ((table)->suffixes[(table)->offset_suffixes[p] + (size_t)(j) * ((table)->longueur_max + 1) + (l)])
+
+// Nombre (pondéré) de façons dont un symbole dérive un mot de longueur l
+static double compte_symbole(const TableComptage *table, int symbole, int l) {
+    if (EST_TERMINAL_IDX(symbole)) return l == 1 ? 1.0 : 0.0;
+    return table->non_terminaux[(size_t)symbole * (table->longueur_max + 1) + l];
+}
+
+double comptage_non_terminal(const TableComptage *table, int non_terminal, int longueur) {
+    if (longueur < 0 || longueur > table->longueur_max) return 0.0;
+    return compte_symbole(table, non_terminal, longueur);
+}
+
+int comptage_construire(TableComptage *table, const GrammaireIndexee *grammaire, int longueur_max) {
+    int n1 = longueur_max + 1;
+    memset(table, 0, sizeof(*table));
+    table->grammaire = grammaire;
+    table->longueur_max = longueur_max;
+
+    table->offset_suffixes = malloc((grammaire->nb_productions + 1) * sizeof(size_t));
+    if (!table->offset_suffixes) return -1;
+    size_t total = 0;
+    for (int p = 0; p < grammaire->nb_productions; p++) {
+        table->offset_suffixes[p] = total;
+        total += (size_t)(grammaire->productions[p].longueur + 1) * n1;
+    }
+    table->offset_suffixes[grammaire->nb_productions] = total;
+    table->suffixes = calloc(total ? total : 1, sizeof(double));
+    table->non_terminaux = calloc((size_t)grammaire->nb_non_terminaux * n1, sizeof(double));
+    if (!table->suffixes || !table->non_terminaux) {
+        comptage_liberer(table);
+        return -1;
+    }
+
+    // Le suffixe vide dérive uniquement le mot vide
+    for (int p = 0; p < grammaire->nb_productions; p++) {
+        SUFFIXE(table, p, grammaire->productions[p].longueur, 0) = 1.0;
+    }
+
+    for (int l = 0; l <= longueur_max; l++) {
+        int stable = 0;
+        for (int passe = 0; passe <= grammaire->nb_non_terminaux + 1 && !stable; passe++) {
+            for (int p = 0; p < grammaire->nb_productions; p++) {
+                const ProductionIndexee *production = &grammaire->productions[p];
+                for (int j = production->longueur - 1; j >= 0; j--) {
+                    int symbole = production->symboles[j];
+                    double somme = 0.0;
+                    if (EST_TERMINAL_IDX(symbole)) {
+                        if (l >= 1) somme = SUFFIXE(table, p, j + 1, l - 1);
+                    } else {
+                        for (int i = 0; i <= l; i++) {
+                            double suite = SUFFIXE(table, p, j + 1, l - i);
+                            if (suite != 0.0) somme += compte_symbole(table, symbole, i) * suite;
+                        }
+                    }
+                    SUFFIXE(table, p, j, l) = somme;
+                }
+            }
+
+            stable = 1;
+            for (int nt = 0; nt < grammaire->nb_non_terminaux; nt++) {
+                double somme = 0.0;
+                int debut = grammaire->premiere_production[nt];
+                for (int p = debut; p < debut + grammaire->nb_productions_nt[nt]; p++) {
+                    somme += grammaire->productions[p].poids * SUFFIXE(table, p, 0, l);
+                }
+                double *case_nt = &table->non_terminaux[(size_t)nt * n1 + l];
+                if (somme != *case_nt) {
+                    *case_nt = somme;
+                    stable = 0;
+                }
+            }
+        }
+        if (!stable) {
+            fprintf(stderr, "Erreur : nombre infini de dérivations de longueur %d (cycle de règles unité ou epsilon).\n", l);
+            comptage_liberer(table);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void comptage_liberer(TableComptage *table) {
+    free(table->non_terminaux);
+    free(table->suffixes);
+    free(table->offset_suffixes);
+    table->non_terminaux = NULL;
+    table->suffixes = NULL;
+    table->offset_suffixes = NULL;
+}
+
+#define SUFFIXE_EXACT(table, p, j, l) \
+    ((table)->suffixes[(table)->offset_suffixes[p] + (size_t)(j) * ((table)->longueur_max + 1) + (l)])
+
+static const GrandEntier UN = {{1}};
+static const GrandEntier ZERO = {{0}};
+
+const GrandEntier *comptage_exact_non_terminal(const TableExacte *table, int non_terminal, int longueur) {
+    if (longueur < 0 || longueur > table->longueur_max) return &ZERO;
+    return &table->non_terminaux[(size_t)non_terminal * (table->longueur_max + 1) + longueur];
+}
+
+// Même récurrence que comptage_construire, en entiers exacts et sans poids.
+// Les comptes trop grands pour GrandEntier sont saturés, pas signalés comme erreur.
+int comptage_exact_construire(TableExacte *table, const GrammaireIndexee *grammaire, int longueur_max) {
+    int n1 = longueur_max + 1;
+    memset(table, 0, sizeof(*table));
+    table->grammaire = grammaire;
+    table->longueur_max = longueur_max;
+
+    table->offset_suffixes = malloc((grammaire->nb_productions + 1) * sizeof(size_t));
+    if (!table->offset_suffixes) return -1;
+    size_t total = 0;
+    for (int p = 0; p < grammaire->nb_productions; p++) {
+        table->offset_suffixes[p] = total;
+        total += (size_t)(grammaire->productions[p].longueur + 1) * n1;
+    }
+    table->offset_suffixes[grammaire->nb_productions] = total;
+    table->suffixes = calloc(total ? total : 1, sizeof(GrandEntier));
+    table->non_terminaux = calloc((size_t)grammaire->nb_non_terminaux * n1, sizeof(GrandEntier));
+    if (!table->suffixes || !table->non_terminaux) {
+        comptage_exact_liberer(table);
+        return -1;
+    }
+
+    for (int p = 0; p < grammaire->nb_productions; p++) {
+        SUFFIXE_EXACT(table, p, grammaire->productions[p].longueur, 0) = UN;
+    }
+
+    for (int l = 0; l <= longueur_max; l++) {
+        int stable = 0;
+        for (int passe = 0; passe <= grammaire->nb_non_terminaux + 1 && !stable; passe++) {
+            for (int p = 0; p < grammaire->nb_productions; p++) {
+                const ProductionIndexee *production = &grammaire->productions[p];
+                for (int j = production->longueur - 1; j >= 0; j--) {
+                    int symbole = production->symboles[j];
+                    GrandEntier somme;
+                    ge_zero(&somme);
+                    if (EST_TERMINAL_IDX(symbole)) {
+                        if (l >= 1) somme = SUFFIXE_EXACT(table, p, j + 1, l - 1);
+                    } else {
+                        for (int i = 0; i <= l; i++) {
+                            const GrandEntier *suite = &SUFFIXE_EXACT(table, p, j + 1, l - i);
+                            if (!ge_est_zero(suite)) {
+                                ge_ajouter_produit(&somme, comptage_exact_non_terminal(table, symbole, i), suite);
+                            }
+                        }
+                    }
+                    SUFFIXE_EXACT(table, p, j, l) = somme;
+                }
+            }
+
+            stable = 1;
+            for (int nt = 0; nt < grammaire->nb_non_terminaux; nt++) {
+                GrandEntier somme;
+                ge_zero(&somme);
+                int debut = grammaire->premiere_production[nt];
+                for (int p = debut; p < debut + grammaire->nb_productions_nt[nt]; p++) {
+                    ge_ajouter(&somme, &somme, &SUFFIXE_EXACT(table, p, 0, l));
+                }
+                GrandEntier *case_nt = &table->non_terminaux[(size_t)nt * n1 + l];
+                if (ge_comparer(&somme, case_nt) != 0) {
+                    *case_nt = somme;
+                    stable = 0;
+                }
+            }
+        }
+        if (!stable) {
+            fprintf(stderr, "Erreur : nombre infini de dérivations de longueur %d (cycle de règles unité ou epsilon).\n", l);
+            comptage_exact_liberer(table);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void comptage_exact_liberer(TableExacte *table) {
+    free(table->non_terminaux);
+    free(table->suffixes);
+    free(table->offset_suffixes);
+    table->non_terminaux = NULL;
+    table->suffixes = NULL;
+    table->offset_suffixes = NULL;
+}
+
+static unsigned long long rotation(unsigned long long x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Initialisation par splitmix64, puis xoshiro256**
+void aleatoire_init(Aleatoire *aleatoire, unsigned long long graine) {
+    for (int i = 0; i < 4; i++) {
+        unsigned long long z = (graine += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        aleatoire->etat[i] = z ^ (z >> 31);
+    }
+}
+
+// Réel uniforme dans [0, 1)
+double aleatoire_reel(Aleatoire *aleatoire) {
+    unsigned long long *s = aleatoire->etat;
+    unsigned long long resultat = rotation(s[1] * 5, 7) * 9;
+    unsigned long long t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotation(s[3], 45);
+    return (resultat >> 11) * 0x1.0p-53;
+}
+
+typedef struct {
+    int symbole;
+    int longueur;
+} ElementPile;
+
+// Tirer un mot de longueur `longueur` avec une probabilité proportionnelle au poids de sa
+// dérivation (uniforme sur les dérivations sans fichier de poids, donc uniforme sur les
+// mots pour une grammaire non ambiguë). `mot` doit pouvoir contenir longueur + 1 octets.
+// Le découpage des longueurs se cherche alternativement par les deux bouts, ce qui
+// borne le coût total à O(n log n) quelle que soit la forme de l'arbre.
+int echantillonner_mot(const TableComptage *table, int longueur, Aleatoire *aleatoire, char *mot) {
+    const GrammaireIndexee *grammaire = table->grammaire;
+    if (comptage_non_terminal(table, grammaire->axiome, longueur) <= 0.0) return -1;
+
+    // Chaque non-terminal dérive au moins un terminal ou une production vide : la pile
+    // ne contient jamais plus de longueur + profondeur d'effacement éléments.
+    size_t capacite = (size_t)(longueur + 1) * 2 + MAX_SYMBOLS;
+    ElementPile *pile = malloc(capacite * sizeof(ElementPile));
+    if (!pile) return -1;
+    size_t hauteur = 0;
+    int ecrits = 0;
+    int longueurs[MAX_SYMBOLS];
+
+    pile[hauteur++] = (ElementPile){grammaire->axiome, longueur};
+    while (hauteur > 0) {
+        ElementPile courant = pile[--hauteur];
+        if (EST_TERMINAL_IDX(courant.symbole)) {
+            mot[ecrits++] = CARACTERE_TERMINAL(courant.symbole);
+            continue;
+        }
+
+        // Choix de la production
+        int debut = grammaire->premiere_production[courant.symbole];
+        int fin = debut + grammaire->nb_productions_nt[courant.symbole];
+        double seuil = aleatoire_reel(aleatoire) * compte_symbole(table, courant.symbole, courant.longueur);
+        int choisie = -1;
+        for (int p = debut; p < fin; p++) {
+            double poids = grammaire->productions[p].poids * SUFFIXE(table, p, 0, courant.longueur);
+            if (poids <= 0.0) continue;
+            choisie = p;
+            if (seuil < poids) break;
+            seuil -= poids;
+        }
+        if (choisie == -1) {
+            free(pile);
+            return -1;
+        }
+
+        // Choix des longueurs de chaque symbole de la production
+        const ProductionIndexee *production = &grammaire->productions[choisie];
+        int reste = courant.longueur;
+        for (int j = 0; j < production->longueur; j++) {
+            int symbole = production->symboles[j];
+            if (EST_TERMINAL_IDX(symbole)) {
+                longueurs[j] = 1;
+                reste -= 1;
+                continue;
+            }
+            seuil = aleatoire_reel(aleatoire) * SUFFIXE(table, choisie, j, reste);
+            int retenue = -1;
+            for (int k = 0; k <= reste; k++) {
+                int i = (k % 2 == 0) ? k / 2 : reste - k / 2;
+                double poids = compte_symbole(table, symbole, i) * SUFFIXE(table, choisie, j + 1, reste - i);
+                if (poids <= 0.0) continue;
+                retenue = i;
+                if (seuil < poids) break;
+                seuil -= poids;
+            }
+            if (retenue == -1) {
+                free(pile);
+                return -1;
+            }
+            longueurs[j] = retenue;
+            reste -= retenue;
+        }
+
+        if (hauteur + production->longueur > capacite) {
+            capacite = (hauteur + production->longueur) * 2;
+            ElementPile *nouvelle = realloc(pile, capacite * sizeof(ElementPile));
+            if (!nouvelle) {
+                free(pile);
+                return -1;
+            }
+            pile = nouvelle;
+        }
+        for (int j = production->longueur - 1; j >= 0; j--) {
+            pile[hauteur++] = (ElementPile){production->symboles[j], longueurs[j]};
+        }
+    }
+
+    free(pile);
+    mot[ecrits] = '\0';
+    return ecrits;
+}
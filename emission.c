@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "libgrammaire.h"
+
+// Reconnaisseurs C spécialisés, voir libgrammaire.h. Le fichier engendré ne dépend que de
+// la bibliothèque standard : les tables de la grammaire y deviennent des switch sur l'état
+// (ou le non-terminal) et le caractère, et les productions du code en ligne droite.
+
+#define EST_TERMINAL(s) ((s) < 0)
+#define CARACTERE(s) ((char)(-1 - (s)))
+
+// Code d'un caractère dans un case : 'a' s'il est lisible, sinon sa valeur
+static void ecrire_caractere(FILE *f, char c) {
+    unsigned char u = (unsigned char)c;
+    if (isalnum(u)) fprintf(f, "'%c'", c);
+    else fprintf(f, "%d", u);
+}
+
+static void ecrire_entete(FILE *f, const char *nom, const char *methode) {
+    fprintf(f, "// Reconnaisseur engendré par grammaire --emit-c (%s).\n", methode);
+    fprintf(f, "// int reconnaitre_%s(const char *mot, size_t longueur) renvoie 1 si le mot est reconnu,\n", nom);
+    fprintf(f, "// 0 sinon, -1 si la mémoire manque ; la fonction est réentrante. Compilé avec\n");
+    fprintf(f, "// -DRECONNAISSEUR_MAIN, le fichier lit les mots sur l'entrée standard, un par ligne (E pour\n");
+    fprintf(f, "// le mot vide), écrit ceux qui sont refusés et sort avec 1 si l'un d'eux l'est.\n\n");
+    fprintf(f, "#if defined(RECONNAISSEUR_MAIN) && !defined(_POSIX_C_SOURCE)\n#define _POSIX_C_SOURCE 200809L\n#endif\n\n");
+    fprintf(f, "#include <stddef.h>\n#include <stdint.h>\n#include <stdlib.h>\n#include <string.h>\n\n");
+}
+
+// Pile de symboles ou d'états : d'abord dans la fonction, puis sur le tas au besoin
+static const char *PILE_C =
+    "typedef struct {\n"
+    "    int *symboles;\n"
+    "    size_t sommet, capacite;\n"
+    "    int locale[64];\n"
+    "} Pile;\n"
+    "\n"
+    "static void pile_init(Pile *pile) {\n"
+    "    pile->symboles = pile->locale;\n"
+    "    pile->sommet = 0;\n"
+    "    pile->capacite = 64;\n"
+    "}\n"
+    "\n"
+    "static int reserver(Pile *pile, size_t n) {\n"
+    "    if (pile->sommet + n <= pile->capacite) return 0;\n"
+    "    size_t capacite = 2 * (pile->sommet + n);\n"
+    "    int *symboles = malloc(capacite * sizeof(int));\n"
+    "    if (!symboles) return -1;\n"
+    "    memcpy(symboles, pile->symboles, pile->sommet * sizeof(int));\n"
+    "    if (pile->symboles != pile->locale) free(pile->symboles);\n"
+    "    pile->symboles = symboles;\n"
+    "    pile->capacite = capacite;\n"
+    "    return 0;\n"
+    "}\n"
+    "\n"
+    "static void pile_liberer(Pile *pile) {\n"
+    "    if (pile->symboles != pile->locale) free(pile->symboles);\n"
+    "}\n\n";
+
+static void ecrire_main(FILE *f, const char *nom) {
+    fprintf(f, "\n#ifdef RECONNAISSEUR_MAIN\n#include <stdio.h>\n\n");
+    fprintf(f, "int main(void) {\n");
+    fprintf(f, "    char *ligne = NULL;\n");
+    fprintf(f, "    size_t taille = 0;\n");
+    fprintf(f, "    ssize_t lus;\n");
+    fprintf(f, "    unsigned long long mots = 0, reconnus = 0;\n");
+    fprintf(f, "    while ((lus = getline(&ligne, &taille, stdin)) != -1) {\n");
+    fprintf(f, "        while (lus > 0 && (ligne[lus - 1] == '\\n' || ligne[lus - 1] == '\\r')) ligne[--lus] = '\\0';\n");
+    fprintf(f, "        int reconnu = reconnaitre_%s(ligne, strcmp(ligne, \"E\") == 0 ? 0 : (size_t)lus);\n", nom);
+    fprintf(f, "        if (reconnu == -1) {\n");
+    fprintf(f, "            perror(\"Erreur d'allocation\");\n");
+    fprintf(f, "            free(ligne);\n");
+    fprintf(f, "            return -1;\n");
+    fprintf(f, "        }\n");
+    fprintf(f, "        mots++;\n");
+    fprintf(f, "        reconnus += reconnu;\n");
+    fprintf(f, "        if (!reconnu) printf(\"%%s\\n\", ligne);\n");
+    fprintf(f, "    }\n");
+    fprintf(f, "    free(ligne);\n");
+    fprintf(f, "    fprintf(stderr, \"%%llu mots, %%llu reconnus\\n\", mots, reconnus);\n");
+    fprintf(f, "    return reconnus < mots;\n");
+    fprintf(f, "}\n#endif\n");
+}
+
+int emettre_automate_c(FILE *f, const char *nom, const Automate *automate) {
+    char methode[64];
+    snprintf(methode, sizeof(methode), "automate minimal de %d état%s", automate->nb_etats, automate->nb_etats > 1 ? "s" : "");
+    ecrire_entete(f, nom, methode);
+    fprintf(f, "static const unsigned char final[%d] = {", automate->nb_etats);
+    for (int q = 0; q < automate->nb_etats; q++) fprintf(f, "%s%d", q ? ", " : "", automate->final[q]);
+    fprintf(f, "};\n\n");
+
+    fprintf(f, "int reconnaitre_%s(const char *mot, size_t longueur) {\n", nom);
+    fprintf(f, "    int etat = 0;\n");
+    fprintf(f, "    for (size_t i = 0; i < longueur; i++) {\n");
+    fprintf(f, "        unsigned char c = (unsigned char)mot[i];\n");
+    fprintf(f, "        switch (etat) {\n");
+    for (int q = 0; q < automate->nb_etats; q++) {
+        fprintf(f, "        case %d:\n", q);
+        fprintf(f, "            switch (c) {\n");
+        for (int k = 0; k < automate->nb_lettres; k++) {
+            int r = automate->transitions[(size_t)q * automate->nb_lettres + k];
+            if (r == -1) continue;
+            fprintf(f, "            case ");
+            ecrire_caractere(f, automate->lettres[k]);
+            fprintf(f, ": etat = %d; break;\n", r);
+        }
+        fprintf(f, "            default: return 0;\n");
+        fprintf(f, "            }\n");
+        fprintf(f, "            break;\n");
+    }
+    fprintf(f, "        }\n");
+    fprintf(f, "    }\n");
+    fprintf(f, "    return final[etat];\n");
+    fprintf(f, "}\n");
+    ecrire_main(f, nom);
+    return ferror(f) ? GRAMMAIRE_ERREUR_FICHIER : GRAMMAIRE_OK;
+}
+
+// Symboles de la production p empilés à l'envers, à partir du symbole premier
+static void empiler_symboles(FILE *f, const int *symboles, int premier, int longueur) {
+    if (premier >= longueur) return;
+    fprintf(f, "                if (reserver(&pile, %d) == -1) goto memoire;\n", longueur - premier);
+    for (int k = longueur - 1; k >= premier; k--) {
+        int s = symboles[k];
+        fprintf(f, "                pile.symboles[pile.sommet++] = %d;\n", EST_TERMINAL(s) ? -1 - (unsigned char)CARACTERE(s) : s);
+    }
+}
+
+int emettre_ll1_c(FILE *f, const char *nom, const TableLL1 *table) {
+    ecrire_entete(f, nom, "analyse LL(1) déroulée");
+    fputs(PILE_C, f);
+    fprintf(f, "// Pile : non-terminal >= 0, ou -1 - c pour le terminal c\n");
+    fprintf(f, "int reconnaitre_%s(const char *mot, size_t longueur) {\n", nom);
+    fprintf(f, "    Pile pile;\n");
+    fprintf(f, "    pile_init(&pile);\n");
+    fprintf(f, "    size_t i = 0;\n");
+    fprintf(f, "    int resultat = 0;\n");
+    fprintf(f, "    pile.symboles[pile.sommet++] = 0;\n");
+    fprintf(f, "    while (pile.sommet > 0) {\n");
+    fprintf(f, "        int s = pile.symboles[--pile.sommet];\n");
+    fprintf(f, "        int c = i < longueur ? (unsigned char)mot[i] : -1;\n");
+    fprintf(f, "        if (s < 0) {\n");
+    fprintf(f, "            if (c != -1 - s) goto fin;\n");
+    fprintf(f, "            i++;\n");
+    fprintf(f, "            continue;\n");
+    fprintf(f, "        }\n");
+    fprintf(f, "        switch (s) {\n");
+    int colonnes = table->nb_colonnes;
+    char texte[MAX_SYMBOLS * MAX_SYMBOLS];
+    for (int a = 0; a < table->nb_non_terminaux; a++) {
+        fprintf(f, "        case %d: // %s\n", a, table->noms[a]);
+        fprintf(f, "            switch (c) {\n");
+        const int *ligne = &table->entrees[(size_t)a * colonnes];
+        for (int col = 0; col < colonnes; col++) {
+            int p = ligne[col], deja = 0;
+            if (p == -1) continue;
+            for (int autre = 0; autre < col && !deja; autre++) deja = ligne[autre] == p;
+            if (deja) continue;
+            // Toutes les prévisions de la production p, qui partagent son code
+            const int *symboles = &table->symboles[table->debut[p]];
+            int longueur = table->longueur[p];
+            int lit_terminal = longueur > 0 && EST_TERMINAL(symboles[0]);
+            fprintf(f, "            ");
+            for (int autre = col; autre < colonnes; autre++) {
+                if (ligne[autre] != p) continue;
+                fprintf(f, "case ");
+                if (autre == colonnes - 1) fprintf(f, "-1");
+                else ecrire_caractere(f, table->colonnes[autre]);
+                fprintf(f, ": ");
+            }
+            production_ll1(table, p, texte, sizeof(texte));
+            fprintf(f, "// %s -> %s\n", table->noms[a], texte);
+            // Un terminal en tête est le caractère de prévision : il est lu sans passer par la pile
+            if (lit_terminal) fprintf(f, "                i++;\n");
+            empiler_symboles(f, symboles, lit_terminal, longueur);
+            fprintf(f, "                continue;\n");
+        }
+        fprintf(f, "            default: goto fin;\n");
+        fprintf(f, "            }\n");
+    }
+    fprintf(f, "        }\n");
+    fprintf(f, "    }\n");
+    fprintf(f, "    resultat = i == longueur;\n");
+    fprintf(f, "fin:\n");
+    fprintf(f, "    pile_liberer(&pile);\n");
+    fprintf(f, "    return resultat;\n");
+    fprintf(f, "memoire:\n");
+    fprintf(f, "    pile_liberer(&pile);\n");
+    fprintf(f, "    return -1;\n");
+    fprintf(f, "}\n");
+    ecrire_main(f, nom);
+    return ferror(f) ? GRAMMAIRE_ERREUR_FICHIER : GRAMMAIRE_OK;
+}
+
+static int action_lalr(const TableLALR *table, int etat, int colonne) {
+    int k = table->base_action[etat] + colonne;
+    return k < table->taille_action && table->controle_action[k] == etat ? table->action[k] : table->defaut[etat];
+}
+
+int emettre_lalr_c(FILE *f, const char *nom, const TableLALR *table) {
+    char methode[64];
+    snprintf(methode, sizeof(methode), "analyse LALR(1) déroulée, %d états", table->nb_etats);
+    ecrire_entete(f, nom, methode);
+    fputs(PILE_C, f);
+    fprintf(f, "// Pile d'états ; ACTION et ALLER sont des switch, une réduction un bloc par production\n");
+    fprintf(f, "int reconnaitre_%s(const char *mot, size_t longueur) {\n", nom);
+    fprintf(f, "    Pile pile;\n");
+    fprintf(f, "    pile_init(&pile);\n");
+    fprintf(f, "    size_t i = 0;\n");
+    fprintf(f, "    int resultat = 0, p = 0, a = 0;\n");
+    fprintf(f, "    pile.symboles[pile.sommet++] = 0;\n");
+    fprintf(f, "    for (;;) {\n");
+    fprintf(f, "        int c = i < longueur ? (unsigned char)mot[i] : -1;\n");
+    fprintf(f, "        switch (pile.symboles[pile.sommet - 1]) {\n");
+    int colonnes = table->nb_colonnes;
+    for (int e = 0; e < table->nb_etats; e++) {
+        fprintf(f, "        case %d:\n", e);
+        fprintf(f, "            switch (c) {\n");
+        for (int col = 0; col < colonnes; col++) {
+            int action = action_lalr(table, e, col), deja = 0;
+            if (action == 0 || (action == table->defaut[e] && action < 0)) continue;
+            for (int autre = 0; autre < col && !deja; autre++) deja = action_lalr(table, e, autre) == action;
+            if (deja) continue;
+            fprintf(f, "            ");
+            for (int autre = col; autre < colonnes; autre++) {
+                if (action_lalr(table, e, autre) != action) continue;
+                fprintf(f, "case ");
+                if (autre == colonnes - 1) fprintf(f, "-1");
+                else ecrire_caractere(f, table->colonnes[autre]);
+                fprintf(f, ": ");
+            }
+            if (action > 0) {
+                fprintf(f, "\n                if (reserver(&pile, 1) == -1) goto memoire;\n");
+                fprintf(f, "                pile.symboles[pile.sommet++] = %d;\n", action - 1);
+                fprintf(f, "                i++;\n");
+                fprintf(f, "                continue;\n");
+            } else {
+                fprintf(f, "p = %d; break;\n", -action - 1);
+            }
+        }
+        if (table->defaut[e] < 0) fprintf(f, "            default: p = %d; break;\n", -table->defaut[e] - 1);
+        else fprintf(f, "            default: goto fin;\n");
+        fprintf(f, "            }\n");
+        fprintf(f, "            break;\n");
+    }
+    fprintf(f, "        }\n");
+
+    char texte[MAX_SYMBOLS * MAX_SYMBOLS];
+    fprintf(f, "        switch (p) {\n");
+    fprintf(f, "        case 0: // Acceptation\n");
+    fprintf(f, "            resultat = i == longueur;\n");
+    fprintf(f, "            goto fin;\n");
+    for (int p = 1; p < table->nb_productions; p++) {
+        production_lalr(table, p, texte, sizeof(texte));
+        fprintf(f, "        case %d: // %s -> %s\n", p, table->noms[table->gauche[p]], texte);
+        if (table->longueur[p] > 0) fprintf(f, "            pile.sommet -= %d;\n", table->longueur[p]);
+        fprintf(f, "            a = %d;\n", table->gauche[p]);
+        fprintf(f, "            break;\n");
+    }
+    fprintf(f, "        }\n");
+
+    // ALLER(état sous les symboles réduits, a)
+    fprintf(f, "        if (reserver(&pile, 1) == -1) goto memoire;\n");
+    fprintf(f, "        switch (a) {\n");
+    for (int a = 0; a < table->nb_non_terminaux; a++) {
+        fprintf(f, "        case %d: // %s\n", a, table->noms[a]);
+        fprintf(f, "            switch (pile.symboles[pile.sommet - 1]) {\n");
+        for (int e = 0; e < table->nb_etats; e++) {
+            int k = table->base_aller[a] + e;
+            if (k >= 0 && k < table->taille_aller && table->controle_aller[k] == a) {
+                fprintf(f, "            case %d: pile.symboles[pile.sommet++] = %d; break;\n", e, table->aller[k]);
+            }
+        }
+        fprintf(f, "            default: goto fin;\n");
+        fprintf(f, "            }\n");
+        fprintf(f, "            break;\n");
+    }
+    fprintf(f, "        }\n");
+    fprintf(f, "    }\n");
+    fprintf(f, "fin:\n");
+    fprintf(f, "    pile_liberer(&pile);\n");
+    fprintf(f, "    return resultat;\n");
+    fprintf(f, "memoire:\n");
+    fprintf(f, "    pile_liberer(&pile);\n");
+    fprintf(f, "    return -1;\n");
+    fprintf(f, "}\n");
+    ecrire_main(f, nom);
+    return ferror(f) ? GRAMMAIRE_ERREUR_FICHIER : GRAMMAIRE_OK;
+}
+
+// Bit du non-terminal a dans un ensemble de mots de 64 bits
+static void ecrire_test(FILE *f, const char *ensemble, int a) {
+    fprintf(f, "(%s[%d] >> %d & 1)", ensemble, a / 64, a % 64);
+}
+
+int emettre_cyk_c(ContexteGrammaire *ctx, FILE *f, const char *nom, const Grammaire *grammaire) {
+    int n = grammaire->rule_count, mots = (n + 63) / 64;
+    if (n == 0) return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Grammaire vide.");
+    // binaires[3 * k] -> binaires[3 * k + 1] binaires[3 * k + 2] ; terminaux[c] : règles c
+    int *binaires = NULL, nb_binaires = 0, vide = 0;
+    unsigned char *terminaux = calloc((size_t)256 * n, 1);
+    for (int i = 0; i < n; i++) nb_binaires += grammaire->rules[i].production_count;
+    binaires = malloc((3 * (size_t)nb_binaires + 1) * sizeof(int));
+    if (!terminaux || !binaires) {
+        free(terminaux);
+        free(binaires);
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    }
+    nb_binaires = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < grammaire->rules[i].production_count; j++) {
+            const char *production = grammaire->rules[i].productions[j];
+            int symboles[3], nb = 0, taille;
+            for (int k = 0; production[k] != '\0' && nb < 3; k += taille) {
+                int s = lire_symbole(grammaire, production + k, &taille);
+                if (s != SYMBOLE_EPSILON) symboles[nb++] = s;
+            }
+            int forme = nb == 0 ? i == 0 : nb == 1 ? EST_TERMINAL(symboles[0])
+                                                  : nb == 2 && symboles[0] >= 0 && symboles[1] >= 0;
+            if (!forme) {
+                free(terminaux);
+                free(binaires);
+                return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "%s -> %s : production hors de la forme de Chomsky.",
+                                                   grammaire->rules[i].non_terminal, production);
+            }
+            if (nb == 0) {
+                vide = 1;
+            } else if (nb == 1) {
+                terminaux[(size_t)(unsigned char)CARACTERE(symboles[0]) * n + i] = 1;
+            } else {
+                binaires[3 * nb_binaires] = i;
+                binaires[3 * nb_binaires + 1] = symboles[0];
+                binaires[3 * nb_binaires + 2] = symboles[1];
+                nb_binaires++;
+            }
+        }
+    }
+
+    char methode[64];
+    snprintf(methode, sizeof(methode), "CYK sur %d non-terminaux", n);
+    ecrire_entete(f, nom, methode);
+    fprintf(f, "enum { MOTS = %d };  // Ensemble de non-terminaux : MOTS mots de 64 bits\n\n", mots);
+    fprintf(f, "// Case du facteur de taille l commençant en i, triangle rangé par taille\n");
+    fprintf(f, "static uint64_t *case_cyk(uint64_t *t, size_t longueur, size_t i, size_t l) {\n");
+    fprintf(f, "    return t + (((l - 1) * longueur - (l - 1) * (l - 2) / 2) + i) * MOTS;\n");
+    fprintf(f, "}\n\n");
+    fprintf(f, "int reconnaitre_%s(const char *mot, size_t longueur) {\n", nom);
+    fprintf(f, "    if (longueur == 0) return %d;\n", vide);
+    fprintf(f, "    uint64_t *t = calloc(longueur * (longueur + 1) / 2 * MOTS, sizeof(uint64_t));\n");
+    fprintf(f, "    if (!t) return -1;\n");
+    fprintf(f, "    for (size_t i = 0; i < longueur; i++) {\n");
+    fprintf(f, "        uint64_t *r = case_cyk(t, longueur, i, 1);\n");
+    fprintf(f, "        switch ((unsigned char)mot[i]) {\n");
+    for (int c = 0; c < 256; c++) {
+        const unsigned char *regles = &terminaux[(size_t)c * n];
+        int utilise = 0;
+        for (int a = 0; a < n && !utilise; a++) utilise = regles[a];
+        if (!utilise) continue;
+        fprintf(f, "        case ");
+        ecrire_caractere(f, (char)c);
+        fprintf(f, ":");
+        for (int w = 0; w < mots; w++) {
+            unsigned long long bits = 0;
+            for (int b = 0; b < 64 && 64 * w + b < n; b++) bits |= (unsigned long long)regles[64 * w + b] << b;
+            if (bits) fprintf(f, " r[%d] = 0x%llxull;", w, bits);
+        }
+        fprintf(f, " break;\n");
+    }
+    fprintf(f, "        default: free(t); return 0;\n");
+    fprintf(f, "        }\n");
+    fprintf(f, "    }\n");
+    fprintf(f, "    for (size_t l = 2; l <= longueur; l++) {\n");
+    fprintf(f, "        for (size_t i = 0; i + l <= longueur; i++) {\n");
+    fprintf(f, "            uint64_t *r = case_cyk(t, longueur, i, l);\n");
+    fprintf(f, "            for (size_t k = 1; k < l; k++) {\n");
+    fprintf(f, "                const uint64_t *g = case_cyk(t, longueur, i, k), *d = case_cyk(t, longueur, i + k, l - k);\n");
+    // Productions A -> BC regroupées par B : un test sur g, puis des mises à jour sans branchement
+    for (int b = 0; b < n; b++) {
+        int premier = 1;
+        for (int k = 0; k < nb_binaires; k++) {
+            if (binaires[3 * k + 1] != b) continue;
+            if (premier) {
+                fprintf(f, "                if ");
+                ecrire_test(f, "g", b);
+                fprintf(f, " {\n");
+                premier = 0;
+            }
+            int a = binaires[3 * k], c = binaires[3 * k + 2];
+            fprintf(f, "                    r[%d] |= (uint64_t)", a / 64);
+            ecrire_test(f, "d", c);
+            fprintf(f, " << %d;  // %s -> %s%s\n", a % 64, grammaire->rules[a].non_terminal, grammaire->rules[b].non_terminal,
+                    grammaire->rules[c].non_terminal);
+        }
+        if (!premier) fprintf(f, "                }\n");
+    }
+    fprintf(f, "            }\n");
+    fprintf(f, "        }\n");
+    fprintf(f, "    }\n");
+    fprintf(f, "    int resultat = (int)(case_cyk(t, longueur, 0, longueur)[0] & 1);\n");
+    fprintf(f, "    free(t);\n");
+    fprintf(f, "    return resultat;\n");
+    fprintf(f, "}\n");
+    ecrire_main(f, nom);
+    free(terminaux);
+    free(binaires);
+    return ferror(f) ? contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur d'écriture du reconnaisseur.")
+                     : GRAMMAIRE_OK;
+}
@@ -0,0 +1,243 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "generate_words.h"
+
+// Équivalence bornée de deux grammaires : mêmes mots de longueur <= longueur_max ?
+//
+// Les grammaires sont d'abord mises sans règle epsilon ni règle unité (le mot vide est
+// traité à part) : une grammaire quelconque, même avec des cycles d'unités ou d'epsilon,
+// a alors un nombre fini de dérivations par longueur. Ensuite, longueur par longueur, un comptage exact des dérivations (celui de rang.c) sert de
+// premier filtre : si une seule des grammaires a des mots de cette longueur, elles
+// diffèrent, et le plus petit mot de l'autre est le témoin. Sinon les deux CurseurLex
+// donnent leurs mots distincts dans l'ordre de strcmp et sont fusionnés : le premier
+// écart est le plus petit mot engendré par une seule des grammaires. Aucun ensemble de
+// mots n'est gardé en mémoire, et la comparaison s'arrête au premier écart : le témoin
+// est donc un plus court mot qui distingue les deux langages.
+
+#define MAX_ANNULABLES 16
+
+typedef struct {
+    GrammaireIndexee *grammaire;
+    int capacite;
+} Construction;
+
+// Ajouter une production à la grammaire en construction, sauf si le même membre gauche
+// l'a déjà (les productions d'un membre gauche sont ajoutées à la suite)
+static int ajouter_production_propre(Construction *c, int gauche, const int *symboles, int longueur) {
+    GrammaireIndexee *g = c->grammaire;
+    for (int p = g->premiere_production[gauche]; p < g->nb_productions; p++) {
+        if (g->productions[p].longueur == longueur &&
+            memcmp(g->productions[p].symboles, symboles, longueur * sizeof(int)) == 0) {
+            return 0;
+        }
+    }
+    if (g->nb_productions == c->capacite) {
+        int capacite = c->capacite ? c->capacite * 2 : 64;
+        ProductionIndexee *tab = realloc(g->productions, capacite * sizeof(ProductionIndexee));
+        if (!tab) {
+            perror("Erreur d'allocation");
+            return -1;
+        }
+        g->productions = tab;
+        c->capacite = capacite;
+    }
+    ProductionIndexee *production = &g->productions[g->nb_productions++];
+    production->gauche = gauche;
+    production->longueur = longueur;
+    memcpy(production->symboles, symboles, longueur * sizeof(int));
+    production->poids = 1.0;
+    production->texte[0] = '\0';
+    return 0;
+}
+
+static int est_unite(const ProductionIndexee *production) {
+    return production->longueur == 1 && !EST_TERMINAL_IDX(production->symboles[0]);
+}
+
+// Ajouter à `gauche` les variantes non vides de la production où une partie des
+// non-terminaux annulables sont effacés ; les unités gauche -> gauche sont inutiles
+static int ajouter_variantes(Construction *c, int gauche, const ProductionIndexee *production, const int *annulable) {
+    int positions[MAX_ANNULABLES], nb_positions = 0;
+    for (int j = 0; j < production->longueur; j++) {
+        int s = production->symboles[j];
+        if (EST_TERMINAL_IDX(s) || !annulable[s]) continue;
+        if (nb_positions == MAX_ANNULABLES) {
+            fprintf(stderr, "Erreur : plus de %d non-terminaux annulables dans une production.\n", MAX_ANNULABLES);
+            return -1;
+        }
+        positions[nb_positions++] = j;
+    }
+    for (unsigned masque = 0; masque < (1u << nb_positions); masque++) {
+        int symboles[MAX_SYMBOLS], longueur = 0, k = 0;
+        for (int j = 0; j < production->longueur; j++) {
+            if (k < nb_positions && positions[k] == j) {
+                if (masque & (1u << k++)) continue;
+            }
+            symboles[longueur++] = production->symboles[j];
+        }
+        if (longueur == 0 || (longueur == 1 && symboles[0] == gauche)) continue;
+        if (ajouter_production_propre(c, gauche, symboles, longueur) == -1) return -1;
+    }
+    return 0;
+}
+
+// Grammaire équivalente sans epsilon ni unité (au mot vide près, donné par *vide)
+static int rendre_propre(const GrammaireIndexee *source, GrammaireIndexee *propre, int *vide) {
+    int n = source->nb_non_terminaux;
+    int annulable[MAX_NT_INDEXES] = {0};
+    for (int change = 1; change; ) {
+        change = 0;
+        for (int p = 0; p < source->nb_productions; p++) {
+            const ProductionIndexee *production = &source->productions[p];
+            if (annulable[production->gauche]) continue;
+            int tous = 1;
+            for (int j = 0; j < production->longueur && tous; j++) {
+                int s = production->symboles[j];
+                tous = !EST_TERMINAL_IDX(s) && annulable[s];
+            }
+            if (tous) annulable[production->gauche] = change = 1;
+        }
+    }
+    *vide = annulable[source->axiome];
+
+    // Étape 1 : sans epsilon, dans une grammaire intermédiaire
+    GrammaireIndexee *sans_vide = malloc(sizeof(GrammaireIndexee));
+    if (!sans_vide) {
+        perror("Erreur d'allocation");
+        return -1;
+    }
+    memset(sans_vide, 0, sizeof(*sans_vide));
+    Construction c = { sans_vide, 0 };
+    for (int a = 0; a < n; a++) {
+        sans_vide->premiere_production[a] = sans_vide->nb_productions;
+        for (int p = source->premiere_production[a]; p < source->premiere_production[a] + source->nb_productions_nt[a]; p++) {
+            if (ajouter_variantes(&c, a, &source->productions[p], annulable) == -1) {
+                free(sans_vide->productions);
+                free(sans_vide);
+                return -1;
+            }
+        }
+        sans_vide->nb_productions_nt[a] = sans_vide->nb_productions - sans_vide->premiere_production[a];
+    }
+
+    // Étape 2 : fermeture des unités, puis pour chaque A les productions non unités des B atteints
+    unsigned char (*atteint)[MAX_NT_INDEXES] = calloc(MAX_NT_INDEXES, sizeof(*atteint));
+    int statut = atteint ? 0 : -1;
+    if (statut == -1) perror("Erreur d'allocation");
+    for (int a = 0; a < n && statut == 0; a++) {
+        int pile[MAX_NT_INDEXES], hauteur = 0;
+        atteint[a][a] = 1;
+        pile[hauteur++] = a;
+        while (hauteur > 0) {
+            int b = pile[--hauteur];
+            for (int p = sans_vide->premiere_production[b]; p < sans_vide->premiere_production[b] + sans_vide->nb_productions_nt[b]; p++) {
+                const ProductionIndexee *production = &sans_vide->productions[p];
+                if (!est_unite(production) || atteint[a][production->symboles[0]]) continue;
+                atteint[a][production->symboles[0]] = 1;
+                pile[hauteur++] = production->symboles[0];
+            }
+        }
+    }
+
+    memset(propre, 0, sizeof(*propre));
+    propre->nb_non_terminaux = n;
+    propre->axiome = source->axiome;
+    memcpy(propre->noms, source->noms, sizeof(propre->noms));
+    Construction d = { propre, 0 };
+    for (int a = 0; a < n && statut == 0; a++) {
+        propre->premiere_production[a] = propre->nb_productions;
+        for (int b = 0; b < n && statut == 0; b++) {
+            if (!atteint[a][b]) continue;
+            for (int p = sans_vide->premiere_production[b]; p < sans_vide->premiere_production[b] + sans_vide->nb_productions_nt[b]; p++) {
+                const ProductionIndexee *production = &sans_vide->productions[p];
+                if (est_unite(production)) continue;
+                if (ajouter_production_propre(&d, a, production->symboles, production->longueur) == -1) {
+                    statut = -1;
+                    break;
+                }
+            }
+        }
+        propre->nb_productions_nt[a] = propre->nb_productions - propre->premiere_production[a];
+    }
+    if (statut == -1) {
+        free(propre->productions);
+        propre->productions = NULL;
+    }
+    free(atteint);
+    free(sans_vide->productions);
+    free(sans_vide);
+    return statut;
+}
+
+// Comparer les mots d'une longueur. Renvoie 0 si les ensembles sont égaux, 1 s'ils
+// diffèrent (résultat rempli), -1 en cas d'erreur.
+static int comparer_longueur(CurseurLex *a, CurseurLex *b, int longueur, ComparaisonLangages *resultat) {
+    GrandEntier zero;
+    ge_zero(&zero);
+    int suivant_a = ge_est_zero(curseur_lex_total(a, longueur)) ? 0 : curseur_lex_positionner(a, longueur, &zero);
+    int suivant_b = ge_est_zero(curseur_lex_total(b, longueur)) ? 0 : curseur_lex_positionner(b, longueur, &zero);
+
+    while (suivant_a == 1 && suivant_b == 1) {
+        int ordre = strcmp(curseur_lex_mot(a), curseur_lex_mot(b));
+        if (ordre != 0) {
+            suivant_b = ordre < 0 ? 0 : suivant_b;
+            suivant_a = ordre > 0 ? 0 : suivant_a;
+            break;
+        }
+        suivant_a = curseur_lex_suivant(a);
+        suivant_b = curseur_lex_suivant(b);
+    }
+    if (suivant_a == -1 || suivant_b == -1) return -1;
+    if (suivant_a == suivant_b) return 0;
+
+    resultat->differentes = 1;
+    resultat->longueur = longueur;
+    resultat->dans_premiere = suivant_a == 1;
+    snprintf(resultat->temoin, sizeof(resultat->temoin), "%s", curseur_lex_mot(suivant_a == 1 ? a : b));
+    return 1;
+}
+
+// Comparer les langages de deux grammaires jusqu'à longueur_max. Renvoie 0 (resultat
+// indique si un témoin a été trouvé) ou -1 en cas d'erreur.
+int comparer_langages(const Grammaire *premiere, const Grammaire *seconde, int longueur_max, ComparaisonLangages *resultat) {
+    memset(resultat, 0, sizeof(*resultat));
+    if (longueur_max < 0 || longueur_max >= MAX_WORD_LEN) {
+        fprintf(stderr, "Erreur : longueur invalide : %d\n", longueur_max);
+        return -1;
+    }
+
+    GrammaireIndexee indexee, propres[2];
+    CurseurLex *curseurs[2] = { NULL, NULL };
+    const Grammaire *grammaires[2] = { premiere, seconde };
+    int propres_pretes = 0, vide[2] = { 0, 0 }, statut = 0;
+    for (int i = 0; i < 2 && statut == 0; i++) {
+        if (indexer_grammaire(grammaires[i], &indexee) == -1) {
+            statut = -1;
+            break;
+        }
+        statut = rendre_propre(&indexee, &propres[i], &vide[i]);
+        liberer_grammaire_indexee(&indexee);
+        if (statut == -1) break;
+        propres_pretes++;
+        curseurs[i] = curseur_lex_creer(&propres[i], longueur_max);
+        if (!curseurs[i]) statut = -1;
+    }
+
+    // Le mot vide, que les grammaires propres n'engendrent plus
+    if (statut == 0 && vide[0] != vide[1]) {
+        resultat->differentes = 1;
+        resultat->dans_premiere = vide[0];
+    }
+    for (int longueur = 1; statut == 0 && !resultat->differentes && longueur <= longueur_max; longueur++) {
+        int compare = comparer_longueur(curseurs[0], curseurs[1], longueur, resultat);
+        if (compare == -1) statut = -1;
+        if (compare != 0) break;
+    }
+    if (statut == -1) fprintf(stderr, "Erreur : la comparaison des langages a échoué.\n");
+
+    for (int i = 0; i < 2; i++) curseur_lex_liberer(curseurs[i]);
+    for (int i = 0; i < propres_pretes; i++) liberer_grammaire_indexee(&propres[i]);
+    return statut;
+}
@@ -0,0 +1,61 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "frontcoded.h"
+
+// Décodeur des fichiers produits par generate_words --format=frontcoded.
+// Usage : fccat [--compte] fichier.fc [premier [nombre]]
+int main(int argc, char *argv[]) {
+    int compte_seulement = 0;
+    int arg = 1;
+
+    if (arg < argc && strcmp(argv[arg], "--compte") == 0) {
+        compte_seulement = 1;
+        arg++;
+    }
+    if (arg >= argc) {
+        fprintf(stderr, "Usage : %s [--compte] fichier.fc [premier [nombre]]\n", argv[0]);
+        return 1;
+    }
+
+    LecteurFC lecteur;
+    if (fc_ouvrir_lecture(&lecteur, argv[arg]) == -1) {
+        return 1;
+    }
+
+    if (compte_seulement) {
+        printf("%llu\n", (unsigned long long)lecteur.nombre_mots);
+        fc_fermer_lecture(&lecteur);
+        return 0;
+    }
+
+    uint64_t premier = arg + 1 < argc ? strtoull(argv[arg + 1], NULL, 10) : 0;
+    uint64_t nombre = arg + 2 < argc ? strtoull(argv[arg + 2], NULL, 10) : UINT64_MAX;
+
+    if (fc_positionner(&lecteur, premier) == -1) {
+        fprintf(stderr, "Erreur : fichier corrompu.\n");
+        fc_fermer_lecture(&lecteur);
+        return 1;
+    }
+
+    // Grand tampon de sortie : le décodage ne doit pas être limité par stdio
+    static char tampon_sortie[1 << 20];
+    setvbuf(stdout, tampon_sortie, _IOFBF, sizeof(tampon_sortie));
+
+    const char *mot;
+    size_t longueur;
+    int statut = 0;
+    while (nombre > 0 && (statut = fc_mot_suivant(&lecteur, &mot, &longueur)) == 1) {
+        fwrite(mot, 1, longueur, stdout);
+        putchar('\n');
+        nombre--;
+    }
+
+    fc_fermer_lecture(&lecteur);
+    if (nombre > 0 && statut == -1) {
+        fprintf(stderr, "Erreur : fichier corrompu.\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "generate_words.h"
+
+// Langages finis. Si le graphe des dépendances entre non-terminaux utiles (productifs et
+// accessibles depuis l'axiome, par les productions dont tous les symboles sont productifs)
+// est sans cycle, chaque non-terminal engendre un ensemble fini de mots, chacun par un
+// nombre fini de dérivations. Ces ensembles sont calculés une seule fois, des feuilles vers
+// l'axiome (ordre suffixe du parcours en profondeur) : celui d'une production est le produit
+// des ensembles de ses symboles, celui d'un non-terminal l'union de ses productions, les
+// nombres de dérivations d'un même mot s'ajoutant. Aucune borne de longueur ni de profondeur
+// n'intervient ; seule la taille totale est bornée par LANGAGE_FINI_MAX_MOTS.
+// Le mot vide est "" dans les ensembles : l'ordre court-lexicographique le place en tête.
+
+#define NON_VISITE 0
+#define EN_COURS 1
+#define VISITE 2
+
+typedef struct {
+    const char *mot;
+    size_t indice;
+} MotIndice;
+
+static int comparer_mots_indices(const void *a, const void *b) {
+    const MotIndice *x = a, *y = b;
+    int c = comparer_mots_shortlex(x->mot, y->mot);
+    if (c != 0) return c;
+    return x->indice < y->indice ? -1 : x->indice > y->indice;
+}
+
+static int production_productive(const ProductionIndexee *production, const unsigned char *productif) {
+    for (int j = 0; j < production->longueur; j++) {
+        int symbole = production->symboles[j];
+        if (!EST_TERMINAL_IDX(symbole) && !productif[symbole]) return 0;
+    }
+    return 1;
+}
+
+// Parcours en profondeur depuis nt ; ordre reçoit les non-terminaux en ordre suffixe.
+// Renvoie 1 si un cycle est trouvé.
+static int chercher_cycle(const GrammaireIndexee *grammaire, const unsigned char *productif, unsigned char *couleur,
+                          int nt, int *ordre, int *nb_ordre) {
+    couleur[nt] = EN_COURS;
+    int fin = grammaire->premiere_production[nt] + grammaire->nb_productions_nt[nt];
+    for (int p = grammaire->premiere_production[nt]; p < fin; p++) {
+        const ProductionIndexee *production = &grammaire->productions[p];
+        if (!production_productive(production, productif)) continue;
+        for (int j = 0; j < production->longueur; j++) {
+            int symbole = production->symboles[j];
+            if (EST_TERMINAL_IDX(symbole) || couleur[symbole] == VISITE) continue;
+            if (couleur[symbole] == EN_COURS) return 1;
+            if (chercher_cycle(grammaire, productif, couleur, symbole, ordre, nb_ordre)) return 1;
+        }
+    }
+    couleur[nt] = VISITE;
+    ordre[(*nb_ordre)++] = nt;
+    return 0;
+}
+
+// Ajouter à la liste brute les mots de la production (produit des ensembles de ses symboles).
+// Renvoie 0, 1 si les bornes sont dépassées, -1 en cas d'erreur.
+static int developper_production(LangageFini *langage, const ProductionIndexee *production, ListeMots *mots,
+                                 GrandEntier **derivations, size_t *capacite) {
+    int longueur = production->longueur;
+    const MotsFinis *ensembles[MAX_SYMBOLS];
+    size_t choix[MAX_SYMBOLS];
+    for (int j = 0; j < longueur; j++) {
+        int symbole = production->symboles[j];
+        ensembles[j] = EST_TERMINAL_IDX(symbole) ? NULL : &langage->non_terminaux[symbole];
+        if (ensembles[j] && ensembles[j]->mots.nombre == 0) return 0;
+        choix[j] = 0;
+    }
+
+    char mot[MAX_WORD_LEN];
+    for (;;) {
+        // Mot et nombre de dérivations de la combinaison en cours
+        size_t taille = 0;
+        GrandEntier nombre;
+        ge_depuis_u64(&nombre, 1);
+        for (int j = 0; j < longueur; j++) {
+            const char *morceau;
+            char lettre[2];
+            if (ensembles[j]) {
+                morceau = ensembles[j]->mots.tries[choix[j]];
+                ge_multiplier(&nombre, &nombre, &ensembles[j]->derivations[choix[j]]);
+            } else {
+                lettre[0] = CARACTERE_TERMINAL(production->symboles[j]);
+                lettre[1] = '\0';
+                morceau = lettre;
+            }
+            size_t l = strlen(morceau);
+            if (taille + l >= MAX_WORD_LEN) return 1;
+            memcpy(mot + taille, morceau, l);
+            taille += l;
+        }
+        if (langage->nb_mots >= LANGAGE_FINI_MAX_MOTS) return 1;
+        if (mots->nombre == *capacite) {
+            size_t nouvelle = *capacite ? *capacite * 2 : 64;
+            GrandEntier *tab = realloc(*derivations, nouvelle * sizeof(GrandEntier));
+            if (!tab) return -1;
+            *derivations = tab;
+            *capacite = nouvelle;
+        }
+        (*derivations)[mots->nombre] = nombre;
+        if (liste_mots_ajouter(mots, mot, taille) == -1) return -1;
+        langage->nb_mots++;
+
+        // Combinaison suivante, le dernier symbole variant le plus vite
+        int j = longueur - 1;
+        while (j >= 0 && (!ensembles[j] || ++choix[j] == ensembles[j]->mots.nombre)) {
+            if (ensembles[j]) choix[j] = 0;
+            j--;
+        }
+        if (j < 0) return 0;
+    }
+}
+
+// Ensemble du non-terminal nt : union triée, sans doublon, des mots de ses productions
+static int construire_non_terminal(LangageFini *langage, const GrammaireIndexee *grammaire,
+                                   const unsigned char *productif, int nt) {
+    ListeMots bruts;
+    liste_mots_init(&bruts);
+    GrandEntier *derivations = NULL;
+    size_t capacite = 0;
+    int statut = 0;
+    int fin = grammaire->premiere_production[nt] + grammaire->nb_productions_nt[nt];
+    for (int p = grammaire->premiere_production[nt]; p < fin && statut == 0; p++) {
+        if (!production_productive(&grammaire->productions[p], productif)) continue;
+        statut = developper_production(langage, &grammaire->productions[p], &bruts, &derivations, &capacite);
+    }
+
+    MotsFinis *ensemble = &langage->non_terminaux[nt];
+    MotIndice *ordre = statut == 0 ? malloc((bruts.nombre ? bruts.nombre : 1) * sizeof(MotIndice)) : NULL;
+    if (statut == 0 && !ordre) statut = -1;
+    if (statut == 0) {
+        for (size_t i = 0; i < bruts.nombre; i++) {
+            ordre[i].mot = bruts.donnees + bruts.debuts[i];
+            ordre[i].indice = i;
+        }
+        qsort(ordre, bruts.nombre, sizeof(MotIndice), comparer_mots_indices);
+        ensemble->derivations = malloc((bruts.nombre ? bruts.nombre : 1) * sizeof(GrandEntier));
+        if (!ensemble->derivations) statut = -1;
+        for (size_t i = 0; i < bruts.nombre && statut == 0; i++) {
+            const GrandEntier *nombre = &derivations[ordre[i].indice];
+            size_t dernier = ensemble->mots.nombre;
+            if (i > 0 && strcmp(ordre[i].mot, ordre[i - 1].mot) == 0) {
+                ge_ajouter(&ensemble->derivations[dernier - 1], &ensemble->derivations[dernier - 1], nombre);
+                continue;
+            }
+            ensemble->derivations[dernier] = *nombre;
+            if (liste_mots_ajouter(&ensemble->mots, ordre[i].mot, strlen(ordre[i].mot)) == -1) statut = -1;
+        }
+        // Les mots sont déjà dans l'ordre : tries suit l'ordre d'insertion
+        if (statut == 0 && liste_mots_trier(&ensemble->mots) == -1) statut = -1;
+    }
+    free(ordre);
+    free(derivations);
+    liste_mots_liberer(&bruts);
+    return statut;
+}
+
+// Construire les ensembles de mots de tous les non-terminaux utiles.
+// Renvoie 1 si le langage est fini et tient dans les bornes, 0 sinon, -1 en cas d'erreur.
+int langage_fini_construire(LangageFini *langage, const GrammaireIndexee *grammaire) {
+    memset(langage, 0, sizeof(*langage));
+    int n = grammaire->nb_non_terminaux;
+    unsigned char *productif = calloc(n ? n : 1, 1), *couleur = calloc(n ? n : 1, 1);
+    int *ordre = malloc((n ? n : 1) * sizeof(int));
+    langage->non_terminaux = calloc(n ? n : 1, sizeof(MotsFinis));
+    if (!productif || !couleur || !ordre || !langage->non_terminaux) {
+        free(productif);
+        free(couleur);
+        free(ordre);
+        langage_fini_liberer(langage);
+        perror("Erreur d'allocation");
+        return -1;
+    }
+    langage->nb_non_terminaux = n;
+    for (int nt = 0; nt < n; nt++) liste_mots_init(&langage->non_terminaux[nt].mots);
+
+    int change = 1;
+    while (change) {
+        change = 0;
+        for (int p = 0; p < grammaire->nb_productions; p++) {
+            const ProductionIndexee *production = &grammaire->productions[p];
+            if (!productif[production->gauche] && production_productive(production, productif)) {
+                productif[production->gauche] = 1;
+                change = 1;
+            }
+        }
+    }
+
+    int nb_ordre = 0, statut = 1;
+    if (productif[grammaire->axiome]) {
+        statut = !chercher_cycle(grammaire, productif, couleur, grammaire->axiome, ordre, &nb_ordre);
+    }
+    for (int i = 0; i < nb_ordre && statut == 1; i++) {
+        int resultat = construire_non_terminal(langage, grammaire, productif, ordre[i]);
+        if (resultat != 0) statut = resultat == 1 ? 0 : -1;
+    }
+    free(productif);
+    free(couleur);
+    free(ordre);
+    if (statut == -1) perror("Erreur d'allocation");
+    if (statut != 1) {
+        langage_fini_liberer(langage);
+        return statut;
+    }
+    langage->langage = &langage->non_terminaux[grammaire->axiome];
+    return 1;
+}
+
+// Indice du mot dans langage->langage (recherche dichotomique), -1 s'il n'y est pas
+long langage_fini_chercher(const LangageFini *langage, const char *mot) {
+    size_t debut = 0, fin = langage->langage->mots.nombre;
+    while (debut < fin) {
+        size_t milieu = debut + (fin - debut) / 2;
+        int c = comparer_mots_shortlex(langage->langage->mots.tries[milieu], mot);
+        if (c == 0) return (long)milieu;
+        if (c < 0) debut = milieu + 1;
+        else fin = milieu;
+    }
+    return -1;
+}
+
+void langage_fini_liberer(LangageFini *langage) {
+    for (int nt = 0; langage->non_terminaux && nt < langage->nb_non_terminaux; nt++) {
+        liste_mots_liberer(&langage->non_terminaux[nt].mots);
+        free(langage->non_terminaux[nt].derivations);
+    }
+    free(langage->non_terminaux);
+    memset(langage, 0, sizeof(*langage));
+}
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "frontcoded.h"
+
+#define FC_TAILLE_PIED (3 * 8 + 4)
+
+// Écrire un entier en varint (7 bits par octet, bit de poids fort = suite)
+static int ecrire_varint(EcrivainFC *fc, uint64_t valeur) {
+    unsigned char tampon[10];
+    int n = 0;
+    do {
+        unsigned char octet = valeur & 0x7F;
+        valeur >>= 7;
+        if (valeur) octet |= 0x80;
+        tampon[n++] = octet;
+    } while (valeur);
+    if (fwrite(tampon, 1, n, fc->fichier) != (size_t)n) return -1;
+    fc->position += n;
+    return 0;
+}
+
+static int ecrire_u64(FILE *fichier, uint64_t valeur) {
+    unsigned char tampon[8];
+    for (int i = 0; i < 8; i++) tampon[i] = (valeur >> (8 * i)) & 0xFF;
+    return fwrite(tampon, 1, 8, fichier) == 8 ? 0 : -1;
+}
+
+static uint64_t lire_u64(const unsigned char *p) {
+    uint64_t valeur = 0;
+    for (int i = 7; i >= 0; i--) valeur = (valeur << 8) | p[i];
+    return valeur;
+}
+
+// Lire un varint ; retourne -1 si le corps est tronqué
+static int lire_varint(const unsigned char *donnees, size_t fin, size_t *position, uint64_t *valeur) {
+    uint64_t resultat = 0;
+    int decalage = 0;
+    while (*position < fin && decalage < 64) {
+        unsigned char octet = donnees[(*position)++];
+        resultat |= (uint64_t)(octet & 0x7F) << decalage;
+        if (!(octet & 0x80)) {
+            *valeur = resultat;
+            return 0;
+        }
+        decalage += 7;
+    }
+    return -1;
+}
+
+int fc_ouvrir_ecriture(EcrivainFC *fc, FILE *fichier, uint32_t intervalle) {
+    memset(fc, 0, sizeof(*fc));
+    fc->fichier = fichier;
+    fc->intervalle = intervalle > 0 ? intervalle : FC_INTERVALLE_DEFAUT;
+
+    unsigned char entete[8];
+    memcpy(entete, FC_MAGIQUE, 4);
+    for (int i = 0; i < 4; i++) entete[4 + i] = (fc->intervalle >> (8 * i)) & 0xFF;
+    if (fwrite(entete, 1, sizeof(entete), fichier) != sizeof(entete)) return -1;
+    fc->position = sizeof(entete);
+    return 0;
+}
+
+// Ajouter un mot ; les mots doivent arriver dans l'ordre de sortie final
+int fc_ecrire_mot(EcrivainFC *fc, const char *mot, size_t longueur) {
+    size_t prefixe = 0;
+
+    if (fc->nombre_mots % fc->intervalle == 0) {
+        // Point de redémarrage : mot écrit en entier
+        if (fc->nb_redemarrages == fc->cap_redemarrages) {
+            size_t cap = fc->cap_redemarrages ? fc->cap_redemarrages * 2 : 64;
+            uint64_t *tab = realloc(fc->redemarrages, cap * sizeof(uint64_t));
+            if (!tab) return -1;
+            fc->redemarrages = tab;
+            fc->cap_redemarrages = cap;
+        }
+        fc->redemarrages[fc->nb_redemarrages++] = fc->position;
+    } else {
+        while (prefixe < longueur && prefixe < fc->len_precedent && mot[prefixe] == fc->precedent[prefixe]) {
+            prefixe++;
+        }
+    }
+
+    if (ecrire_varint(fc, prefixe) == -1 || ecrire_varint(fc, longueur - prefixe) == -1) return -1;
+    if (fwrite(mot + prefixe, 1, longueur - prefixe, fc->fichier) != longueur - prefixe) return -1;
+    fc->position += longueur - prefixe;
+
+    if (longueur > fc->cap_precedent) {
+        char *tampon = realloc(fc->precedent, longueur);
+        if (!tampon) return -1;
+        fc->precedent = tampon;
+        fc->cap_precedent = longueur;
+    }
+    memcpy(fc->precedent + prefixe, mot + prefixe, longueur - prefixe);
+    fc->len_precedent = longueur;
+    fc->nombre_mots++;
+    return 0;
+}
+
+// Écrire le pied (table des redémarrages) et libérer l'écrivain ; ne ferme pas le FILE
+int fc_fermer_ecriture(EcrivainFC *fc) {
+    int statut = 0;
+    uint64_t offset_table = fc->position;
+
+    for (size_t i = 0; i < fc->nb_redemarrages && statut == 0; i++) {
+        statut = ecrire_u64(fc->fichier, fc->redemarrages[i]);
+    }
+    if (statut == 0) statut = ecrire_u64(fc->fichier, fc->nombre_mots);
+    if (statut == 0) statut = ecrire_u64(fc->fichier, fc->nb_redemarrages);
+    if (statut == 0) statut = ecrire_u64(fc->fichier, offset_table);
+    if (statut == 0 && fwrite(FC_MAGIQUE, 1, 4, fc->fichier) != 4) statut = -1;
+
+    free(fc->redemarrages);
+    free(fc->precedent);
+    fc->redemarrages = NULL;
+    fc->precedent = NULL;
+    return statut;
+}
+
+int fc_ouvrir_lecture(LecteurFC *fc, const char *chemin) {
+    memset(fc, 0, sizeof(*fc));
+
+    int fd = open(chemin, O_RDONLY);
+    if (fd == -1) {
+        perror("Erreur lors de l'ouverture du fichier");
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1 || (size_t)st.st_size < 8 + FC_TAILLE_PIED) {
+        fprintf(stderr, "Erreur : %s n'est pas un fichier front-coded valide.\n", chemin);
+        close(fd);
+        return -1;
+    }
+    fc->taille = st.st_size;
+    fc->donnees = mmap(NULL, fc->taille, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (fc->donnees == MAP_FAILED) {
+        perror("Erreur lors de la projection du fichier");
+        fc->donnees = NULL;
+        return -1;
+    }
+    madvise(fc->donnees, fc->taille, MADV_SEQUENTIAL);
+
+    const unsigned char *pied = fc->donnees + fc->taille - FC_TAILLE_PIED;
+    if (memcmp(fc->donnees, FC_MAGIQUE, 4) != 0 || memcmp(pied + 24, FC_MAGIQUE, 4) != 0) {
+        fprintf(stderr, "Erreur : %s n'est pas un fichier front-coded valide.\n", chemin);
+        fc_fermer_lecture(fc);
+        return -1;
+    }
+    fc->intervalle = fc->donnees[4] | fc->donnees[5] << 8 | fc->donnees[6] << 16 | (uint32_t)fc->donnees[7] << 24;
+    fc->nombre_mots = lire_u64(pied);
+    fc->nb_redemarrages = lire_u64(pied + 8);
+    fc->offset_table = lire_u64(pied + 16);
+    // La table doit occuper exactement l'espace entre le corps et le pied, avec un point
+    // de redémarrage par bloc entamé ; calculs faits sans multiplication pour éviter tout débordement
+    uint64_t fin_table = fc->taille - FC_TAILLE_PIED;
+    if (fc->intervalle == 0 || fc->offset_table < 8 || fc->offset_table > fin_table ||
+        (fin_table - fc->offset_table) % 8 != 0 ||
+        fc->nb_redemarrages != (fin_table - fc->offset_table) / 8 ||
+        fc->nb_redemarrages != fc->nombre_mots / fc->intervalle + (fc->nombre_mots % fc->intervalle != 0)) {
+        fprintf(stderr, "Erreur : pied de fichier corrompu dans %s.\n", chemin);
+        fc_fermer_lecture(fc);
+        return -1;
+    }
+    fc->position = 8;
+    return 0;
+}
+
+// Se placer juste avant le mot numéro `index` (0 = premier mot)
+int fc_positionner(LecteurFC *fc, uint64_t index) {
+    if (index >= fc->nombre_mots) {
+        fc->index = fc->nombre_mots;
+        fc->position = fc->offset_table;
+        return 0;
+    }
+
+    uint64_t bloc = index / fc->intervalle;
+    uint64_t redemarrage = lire_u64(fc->donnees + fc->offset_table + bloc * 8);
+    if (redemarrage < 8 || redemarrage >= fc->offset_table) return -1;
+    fc->position = redemarrage;
+    fc->index = bloc * fc->intervalle;
+    fc->len_mot = 0;
+
+    // Décoder les mots du bloc jusqu'à celui demandé
+    const char *mot;
+    size_t longueur;
+    while (fc->index < index) {
+        if (fc_mot_suivant(fc, &mot, &longueur) != 1) return -1;
+    }
+    return 0;
+}
+
+// Décoder le mot suivant : 1 si un mot est disponible, 0 à la fin, -1 si le fichier est corrompu.
+// Le pointeur retourné reste valide jusqu'au prochain appel.
+int fc_mot_suivant(LecteurFC *fc, const char **mot, size_t *longueur) {
+    if (fc->index >= fc->nombre_mots) return 0;
+
+    uint64_t prefixe, suffixe;
+    if (lire_varint(fc->donnees, fc->offset_table, &fc->position, &prefixe) == -1 ||
+        lire_varint(fc->donnees, fc->offset_table, &fc->position, &suffixe) == -1 ||
+        prefixe > fc->len_mot || suffixe > fc->offset_table - fc->position) {
+        return -1;
+    }
+
+    size_t total = prefixe + suffixe;
+    if (total > fc->cap_mot) {
+        size_t cap = fc->cap_mot ? fc->cap_mot : 64;
+        while (cap < total) cap *= 2;
+        char *tampon = realloc(fc->mot, cap);
+        if (!tampon) return -1;
+        fc->mot = tampon;
+        fc->cap_mot = cap;
+    }
+    memcpy(fc->mot + prefixe, fc->donnees + fc->position, suffixe);
+    fc->position += suffixe;
+    fc->len_mot = total;
+    fc->index++;
+
+    *mot = fc->mot;
+    *longueur = total;
+    return 1;
+}
+
+void fc_fermer_lecture(LecteurFC *fc) {
+    if (fc->donnees) munmap(fc->donnees, fc->taille);
+    free(fc->mot);
+    memset(fc, 0, sizeof(*fc));
+}
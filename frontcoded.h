@@ -0,0 +1,54 @@
+#ifndef FRONTCODED_H
+#define FRONTCODED_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Format "front-coded" pour les listes de mots triées :
+//  - en-tête : "MFC1" puis l'intervalle de redémarrage (u32, petit-boutiste)
+//  - corps : pour chaque mot, varint(longueur du préfixe commun avec le mot
+//    précédent), varint(longueur du suffixe), puis les octets du suffixe.
+//    Tous les `intervalle` mots, le préfixe est forcé à 0 (point de redémarrage).
+//  - pied : table des offsets des points de redémarrage (u64), nombre de mots (u64),
+//    nombre de points (u64), offset de la table (u64), puis "MFC1".
+#define FC_MAGIQUE "MFC1"
+#define FC_INTERVALLE_DEFAUT 16
+
+typedef struct {
+    FILE *fichier;
+    uint32_t intervalle;      // Nombre de mots par bloc
+    uint64_t nombre_mots;     // Mots écrits jusqu'ici
+    uint64_t position;        // Octets écrits depuis le début du fichier
+    uint64_t *redemarrages;   // Offsets des points de redémarrage
+    size_t nb_redemarrages;
+    size_t cap_redemarrages;
+    char *precedent;          // Dernier mot écrit (pour le préfixe commun)
+    size_t len_precedent;
+    size_t cap_precedent;
+} EcrivainFC;
+
+typedef struct {
+    unsigned char *donnees;   // Fichier projeté en mémoire
+    size_t taille;
+    uint32_t intervalle;
+    uint64_t nombre_mots;
+    uint64_t nb_redemarrages;
+    uint64_t offset_table;    // Début de la table des redémarrages (= fin du corps)
+    uint64_t index;           // Index du prochain mot à décoder
+    size_t position;          // Position courante dans le corps
+    char *mot;                // Mot courant reconstruit
+    size_t len_mot;
+    size_t cap_mot;
+} LecteurFC;
+
+int fc_ouvrir_ecriture(EcrivainFC *fc, FILE *fichier, uint32_t intervalle);
+int fc_ecrire_mot(EcrivainFC *fc, const char *mot, size_t longueur);
+int fc_fermer_ecriture(EcrivainFC *fc);
+
+int fc_ouvrir_lecture(LecteurFC *fc, const char *chemin);
+int fc_positionner(LecteurFC *fc, uint64_t index);
+int fc_mot_suivant(LecteurFC *fc, const char **mot, size_t *longueur);
+void fc_fermer_lecture(LecteurFC *fc);
+
+#endif
@@ -2,77 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
+#include <unistd.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/resource.h>
 
-#define MAX_RULES 100
-#define MAX_SYMBOLS 100
-#define MAX_WORD_LEN 256
-
-typedef struct {
-    char non_terminal[MAX_SYMBOLS];
-    char productions[MAX_RULES][MAX_SYMBOLS];
-    int production_count;
-} Rule;
-
-typedef struct {
-    Rule rules[MAX_RULES];
-    int rule_count;
-    char axiome[MAX_SYMBOLS];
-} Grammaire;
-
-// Nettoyer les espaces dans une chaîne
-void nettoyer_chaine(char *str) {
-    char *write_ptr = str;
-    for (char *read_ptr = str; *read_ptr != '\0'; read_ptr++) {
-        if (!isspace((unsigned char)*read_ptr)) {
-            *write_ptr++ = *read_ptr;
-        }
-    }
-    *write_ptr = '\0';
-}
-
-// Charger une grammaire depuis un fichier
-int lire_grammaire(Grammaire *grammaire, const char *filename) {
-    grammaire->rule_count = 0;
-
-    FILE *file = fopen(filename, "r");
-    if (file == NULL) {
-        perror("Erreur lors de l'ouverture du fichier");
-        return -1;
-    }
-
-    char line[256];
-    while (fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\n")] = '\0'; // Supprime le saut de ligne
-        nettoyer_chaine(line);           // Nettoyer les espaces inutiles
-
-        if (strlen(line) == 0) {
-            continue;
-        }
-
-        Rule rule;
-        rule.production_count = 0;
-
-        char *token = strtok(line, ":");
-        if (token == NULL) {
-            fprintf(stderr, "Erreur : Format incorrect : %s\n", line);
-            fclose(file);
-            return -1;
-        }
-        strcpy(rule.non_terminal, token);
-
-        token = strtok(NULL, "|");
-        while (token != NULL) {
-            nettoyer_chaine(token); // Nettoyer chaque production
-            strcpy(rule.productions[rule.production_count++], token);
-            token = strtok(NULL, "|");
-        }
-
-        grammaire->rules[grammaire->rule_count++] = rule;
-    }
-
-    fclose(file);
-    return 0;
-}
+#include "frontcoded.h"
+#include "generate_words.h"
 
 // Décompose un mot en symboles (terminaux et non-terminaux)
 char **decomposer_mot(const char *mot, int *nombre_de_symboles) {
@@ -110,8 +47,12 @@ int trouver_productions(const char *non_terminal, Grammaire *grammaire, char pro
 }
 
 // Génère récursivement tous les mots possibles
-void generer_mots_recursif(const char *forme_courante, int longueur_max, Grammaire *grammaire, int profondeur_max, char mots[MAX_RULES * MAX_SYMBOLS][MAX_WORD_LEN], int *mot_count) {
-    if (profondeur_max < 0) return;
+void generer_mots_recursif(const char *forme_courante, int longueur_max, Grammaire *grammaire, int profondeur_max,
+                           TriExterne *tri, ListeMots *mots) {
+    if (profondeur_max < 0) {
+        COMPTER(tri->compteurs, elaguees_profondeur);
+        return;
+    }
 
     int nombre_de_symboles = 0;
     char **symboles = decomposer_mot(forme_courante, &nombre_de_symboles);
@@ -126,8 +67,11 @@ void generer_mots_recursif(const char *forme_courante, int longueur_max, Grammai
     }
 
     if (est_terminal_total) {
-        if (strlen(forme_courante) <= longueur_max) {
-            strcpy(mots[(*mot_count)++], forme_courante);
+        size_t longueur = strlen(forme_courante);
+        if (longueur > (size_t)longueur_max) {
+            COMPTER(tri->compteurs, elaguees_longueur);
+        } else if (tri_externe_ajouter(tri, mots, forme_courante, longueur) == -1) {
+            fprintf(stderr, "Erreur : mémoire insuffisante pour stocker les mots.\n");
         }
         for (int i = 0; i < nombre_de_symboles; i++) free(symboles[i]);
         free(symboles);
@@ -135,6 +79,7 @@ void generer_mots_recursif(const char *forme_courante, int longueur_max, Grammai
     }
 
     // Développer les règles pour les non-terminaux
+    COMPTER(tri->compteurs, formes);
     for (int i = 0; i < nombre_de_symboles; i++) {
         if (!est_terminal(symboles[i])) {
             char productions[MAX_RULES][MAX_SYMBOLS];
@@ -142,11 +87,16 @@ void generer_mots_recursif(const char *forme_courante, int longueur_max, Grammai
 
             for (int j = 0; j < production_count; j++) {
                 char nouvelle_forme[MAX_WORD_LEN] = "";
+                // Une forme qui dépasse MAX_WORD_LEN ne peut de toute façon pas donner un mot assez court
+                if (strlen(forme_courante) - strlen(symboles[i]) + strlen(productions[j]) >= MAX_WORD_LEN) {
+                    COMPTER(tri->compteurs, elaguees_longueur);
+                    continue;
+                }
                 for (int k = 0; k < i; k++) strcat(nouvelle_forme, symboles[k]);
                 strcat(nouvelle_forme, productions[j]);
                 for (int k = i + 1; k < nombre_de_symboles; k++) strcat(nouvelle_forme, symboles[k]);
 
-                generer_mots_recursif(nouvelle_forme, longueur_max, grammaire, profondeur_max - 1, mots, mot_count);
+                generer_mots_recursif(nouvelle_forme, longueur_max, grammaire, profondeur_max - 1, tri, mots);
             }
             break; // Un seul non-terminal est traité à la fois
         }
@@ -156,83 +106,933 @@ void generer_mots_recursif(const char *forme_courante, int longueur_max, Grammai
     free(symboles);
 }
 
-// Fonction de tri lexicographique
-int comparer_mots(const void *a, const void *b) {
-    const char *mot_a = (const char *)a;
-    const char *mot_b = (const char *)b;
+// Lire les mots d'une grammaire régulière non ambiguë sur son automate minimal
+// (automate.c) : un mot par dérivation, comme generer_mots_recursif.
+static int generer_mots_automate(const Plan *plan, TriExterne *tri, ListeMots *mots) {
+    ParcoursAutomate parcours;
+    if (parcours_automate_ouvrir(&parcours, &plan->automate, plan->longueur_max) == -1) return -1;
+    const char *mot;
+    size_t longueur;
+    int statut = 0;
+    while (statut == 0 && parcours_automate_suivant(&parcours, &mot, &longueur) == 1) {
+        // Le mot vide s'écrit E
+        statut = longueur == 0 ? tri_externe_ajouter(tri, mots, "E", 1) : tri_externe_ajouter(tri, mots, mot, longueur);
+    }
+    parcours_automate_fermer(&parcours);
+    return statut;
+}
 
-    int len_diff = strlen(mot_a) - strlen(mot_b);
-    if (len_diff != 0) return len_diff;
+// Lire les mots d'un langage fini sur ses ensembles de mots, calculés une fois (fini.c) :
+// chaque mot de longueur <= longueur_max est ajouté autant de fois qu'il a de dérivations
+// (sur 64 bits, vérifié par planifier).
+static int generer_mots_fini(const Plan *plan, TriExterne *tri, ListeMots *mots) {
+    const MotsFinis *axiome = plan->langage.langage;
+    int statut = 0;
+    for (size_t i = 0; i < axiome->mots.nombre && statut == 0; i++) {
+        const char *mot = axiome->mots.tries[i];
+        size_t longueur = strlen(mot);
+        if (longueur > (size_t)plan->longueur_max) break;
+        for (uint64_t k = 0; k < axiome->derivations[i].l[0] && statut == 0; k++) {
+            // Le mot vide s'écrit E
+            statut = longueur == 0 ? tri_externe_ajouter(tri, mots, "E", 1) : tri_externe_ajouter(tri, mots, mot, longueur);
+        }
+    }
+    return statut;
+}
 
-    return strcmp(mot_a, mot_b);
+// Écrire les mots par comptage des dérivations : pour chaque longueur, le CurseurLex (rang.c)
+// donne les mots distincts dans l'ordre de strcmp avec leur nombre de dérivations, qui tient
+// sur 64 bits (vérifié par planifier). Les mots sortent dans l'ordre : ni tampon ni tri.
+static int ecrire_mots_longueur(const Plan *plan, SortieMots *sortie, CompteursGeneration *compteurs) {
+    CurseurLex *curseur = curseur_lex_creer(&plan->indexee, plan->longueur_max);
+    if (!curseur) return -1;
+    GrandEntier zero, multiplicite;
+    ge_zero(&zero);
+    int statut = 0;
+    for (int l = 0; l <= plan->longueur_max && statut == 0; l++) {
+        int place = curseur_lex_positionner(curseur, l, &zero);
+        while (place == 1 && statut == 0) {
+            curseur_lex_rangs(curseur, NULL, &multiplicite);
+            // Le mot vide s'écrit E
+            const char *mot = l == 0 ? "E" : curseur_lex_mot(curseur);
+            size_t longueur = l == 0 ? 1 : (size_t)l;
+            struct timespec debut;
+            if (compteurs) clock_gettime(CLOCK_MONOTONIC, &debut);
+            for (uint64_t k = 0; k < multiplicite.l[0] && statut == 0; k++) statut = sortie_ecrire(sortie, mot, longueur);
+            if (compteurs) {
+                compteurs->duree_ecriture += secondes_depuis(&debut);
+                atomic_fetch_add_explicit(&compteurs->derivations, multiplicite.l[0], memory_order_relaxed);
+                compter_ecriture(compteurs, mot, longueur, multiplicite.l[0]);
+            }
+            place = curseur_lex_suivant(curseur);
+        }
+        if (place == -1) statut = -1;
+    }
+    curseur_lex_liberer(curseur);
+    return statut;
 }
-// Générer tous les mots
-// Générer tous les mots
-void generer_mots(Grammaire *grammaire, int longueur_max, const char *nom_fichier_sortie) {
-    char mots[MAX_RULES * MAX_SYMBOLS][MAX_WORD_LEN] = {{0}}; // Initialisation du tableau à zéro
-    int mot_count = 0;
 
-    // Vérifier si l'axiome a epsilon (E) comme production
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        if (strcmp(grammaire->rules[i].non_terminal, grammaire->axiome) == 0) {
-            for (int j = 0; j < grammaire->rules[i].production_count; j++) {
-                if (strcmp(grammaire->rules[i].productions[j], "E") == 0) {
+// Générer tous les mots avec le moteur choisi par planifier (planificateur.c). Au-delà de
+// options->memoire octets de mots, les tampons sont déversés sur disque et fusionnés à
+// l'écriture (tri_externe.c). Avec options->statistiques, l'énumération est instrumentée
+// (statistiques.c).
+int generer_mots(Grammaire *grammaire, int longueur_max, const char *nom_fichier_sortie, const OptionsGeneration *options) {
+    Plan plan;
+    if (planifier(grammaire, longueur_max, options->nb_threads, options->moteur, &plan) == -1) return -1;
+    int parallele = plan.moteur == MOTEUR_DFS && options->nb_threads > 1;
+
+    // Un tampon par thread, plus celui des mots trouvés avant la répartition
+    int nb_tampons = parallele ? options->nb_threads + 1 : 1;
+    ListeMots *tampons = malloc(nb_tampons * sizeof(ListeMots));
+    TriExterne tri;
+    if (!tampons || tri_externe_init(&tri, options->memoire / nb_tampons) == -1) {
+        perror("Erreur d'allocation");
+        free(tampons);
+        plan_liberer(&plan);
+        return -1;
+    }
+    for (int i = 0; i < nb_tampons; i++) liste_mots_init(&tampons[i]);
+
+    CompteursGeneration compteurs;
+    Progression progression;
+    int progression_active = 0;
+    if (options->statistiques) {
+        compteurs_init(&compteurs);
+        compteurs.methode = plan.moteur != MOTEUR_DFS ? nom_moteur(plan.moteur) : parallele ? "parallele" : "recursif";
+        tri.compteurs = &compteurs;
+        progression_active = progression_demarrer(&progression, &compteurs) == 0;
+    }
+
+    SortieMots sortie;
+    int statut = 0;
+    if (plan.moteur == MOTEUR_LONGUEUR) {
+        // Les mots sortent triés : écrits directement
+        statut = sortie_ouvrir(&sortie, nom_fichier_sortie, options->format);
+        if (statut == 0) {
+            if (ecrire_mots_longueur(&plan, &sortie, tri.compteurs) == -1) {
+                fprintf(stderr, "Erreur : le parcours par longueur a échoué.\n");
+                statut = -1;
+            }
+            if (sortie_fermer(&sortie) == -1) statut = -1;
+            if (statut == 0) printf("Mots générés sauvegardés dans %s\n", nom_fichier_sortie);
+        }
+        if (tri.compteurs) compteurs.duree_derivation = secondes_depuis(&compteurs.debut) - compteurs.duree_ecriture;
+    } else {
+        if (plan.moteur == MOTEUR_FINI) {
+            statut = generer_mots_fini(&plan, &tri, &tampons[0]);
+        } else if (plan.moteur == MOTEUR_AUTOMATE) {
+            statut = generer_mots_automate(&plan, &tri, &tampons[0]);
+        } else {
+            // Vérifier si l'axiome (première règle) a epsilon (E) comme production
+            const Rule *axiome = &grammaire->rules[0];
+            for (int j = 0; j < axiome->production_count; j++) {
+                if (strcmp(axiome->productions[j], "E") == 0) {
                     // Ajouter explicitement "E" dans les mots générés
-                    strcpy(mots[mot_count++], "E");
+                    tri_externe_ajouter(&tri, &tampons[0], "E", 1);
                 }
             }
-            break;
+
+            // Générer les autres mots récursivement ; ils sont triés à l'écriture
+            if (parallele) {
+                statut = generer_mots_parallele(grammaire, longueur_max, options->nb_threads, &tri, tampons);
+            } else {
+                generer_mots_recursif(grammaire->rules[0].non_terminal, longueur_max, grammaire, longueur_max * 2, &tri, &tampons[0]);
+            }
+        }
+        if (tri.erreur) statut = -1;
+        if (tri.compteurs) {
+            compteurs.duree_derivation = secondes_depuis(&compteurs.debut);
+            atomic_store(&compteurs.phase, PHASE_FUSION);
         }
-    }
 
-    // Générer les autres mots récursivement
-    generer_mots_recursif(grammaire->axiome, longueur_max, grammaire, longueur_max * 2, mots, &mot_count);
+        // Sauvegarder dans le fichier
+        if (statut == -1) {
+            fprintf(stderr, "Erreur : la génération des mots a échoué.\n");
+        } else if (sortie_ouvrir(&sortie, nom_fichier_sortie, options->format) == -1) {
+            statut = -1;
+        } else {
+            statut = tri_externe_ecrire(&tri, tampons, nb_tampons, &sortie);
+            if (sortie_fermer(&sortie) == -1) statut = -1;
+            else if (statut == -1) fprintf(stderr, "Erreur : la fusion des mots triés a échoué.\n");
+            if (statut == 0) printf("Mots générés sauvegardés dans %s\n", nom_fichier_sortie);
+        }
+        if (tri.compteurs) {
+            // L'écriture a lieu pendant la fusion : elle est retirée de sa durée
+            compteurs.duree_fusion = secondes_depuis(&compteurs.debut) - compteurs.duree_derivation - compteurs.duree_ecriture;
+        }
+    }
+    if (tri.compteurs) {
+        atomic_store(&compteurs.phase, PHASE_TERMINEE);
+        if (progression_active) progression_arreter(&progression);
+        if (statut != -1) {
+            ecrire_statistiques(options->statistiques, &compteurs, longueur_max, options->nb_threads, nom_fichier_sortie);
+        }
+    }
+    for (int i = 0; i < nb_tampons; i++) liste_mots_liberer(&tampons[i]);
+    free(tampons);
+    tri_externe_liberer(&tri);
+    plan_liberer(&plan);
+    return statut;
+}
 
-    // Trier les mots
-    qsort(mots, mot_count, MAX_WORD_LEN, comparer_mots);
+// Ouvrir un fichier de sortie de mots ("-" pour la sortie standard)
+int sortie_ouvrir(SortieMots *sortie, const char *nom_fichier, FormatSortie format) {
+    sortie->format = format;
+    sortie->nom = nom_fichier;
+    sortie->erreur = 0;
+    if (strcmp(nom_fichier, "-") == 0) {
+        sortie->fichier = stdout;
+    } else {
+        sortie->fichier = fopen(nom_fichier, format == FORMAT_FRONTCODED ? "wb" : "w");
+    }
+    if (!sortie->fichier) {
+        perror("Erreur d'ouverture du fichier de sortie");
+        return -1;
+    }
+    if (format == FORMAT_FRONTCODED && fc_ouvrir_ecriture(&sortie->fc, sortie->fichier, FC_INTERVALLE_DEFAUT) == -1) {
+        sortie->erreur = 1;
+    }
+    return 0;
+}
 
-    // Sauvegarder dans le fichier
-    FILE *output = fopen(nom_fichier_sortie, "w");
-    if (!output) {
+// Rouvrir une sortie texte pour la compléter : le fichier est tronqué à la taille
+// enregistrée dans le point de reprise, les mots suivants sont écrits à la suite
+int sortie_reprendre(SortieMots *sortie, const char *nom_fichier, long octets) {
+    sortie->format = FORMAT_TEXTE;
+    sortie->nom = nom_fichier;
+    sortie->erreur = 0;
+    sortie->fichier = fopen(nom_fichier, "r+");
+    if (!sortie->fichier) {
         perror("Erreur d'ouverture du fichier de sortie");
-        return;
+        return -1;
+    }
+    if (fseek(sortie->fichier, 0, SEEK_END) != 0 || ftell(sortie->fichier) < octets) {
+        fprintf(stderr, "Erreur : %s est plus court que son point de reprise.\n", nom_fichier);
+        fclose(sortie->fichier);
+        return -1;
+    }
+    if (ftruncate(fileno(sortie->fichier), octets) == -1 || fseek(sortie->fichier, octets, SEEK_SET) != 0) {
+        perror("Erreur de troncature du fichier de sortie");
+        fclose(sortie->fichier);
+        return -1;
+    }
+    return 0;
+}
+
+int sortie_ecrire(SortieMots *sortie, const char *mot, size_t longueur) {
+    if (sortie->erreur) return -1;
+    if (sortie->format == FORMAT_FRONTCODED) {
+        if (fc_ecrire_mot(&sortie->fc, mot, longueur) == -1) sortie->erreur = 1;
+    } else if (fwrite(mot, 1, longueur, sortie->fichier) != longueur || putc('\n', sortie->fichier) == EOF) {
+        sortie->erreur = 1;
+    }
+    return sortie->erreur ? -1 : 0;
+}
+
+int sortie_fermer(SortieMots *sortie) {
+    if (sortie->format == FORMAT_FRONTCODED && fc_fermer_ecriture(&sortie->fc) == -1) sortie->erreur = 1;
+    if (sortie->fichier == stdout) {
+        if (fflush(stdout) == EOF) sortie->erreur = 1;
+    } else if (fclose(sortie->fichier) == EOF) {
+        sortie->erreur = 1;
+    }
+    if (sortie->erreur) {
+        fprintf(stderr, "Erreur : écriture impossible dans %s\n", sortie->nom);
+        return -1;
+    }
+    return 0;
+}
+
+// Mettre une grammaire lue sous la forme demandée, comme le ferait grammaire ; avec
+// NORMALISATION_AUCUNE, elle est seulement vérifiée non vide.
+int preparer_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire, Normalisation normalisation) {
+    if (grammaire->rule_count == 0) return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Grammaire vide.");
+    if (normalisation == NORMALISATION_AUCUNE) return GRAMMAIRE_OK;
+    int statut = rewriter_grammaire(ctx, grammaire);
+    if (statut != GRAMMAIRE_OK) return statut;
+    return normaliser_grammaire(ctx, grammaire, normalisation == NORMALISATION_GREIBACH ? FORME_GREIBACH : FORME_CHOMSKY,
+                                NULL);
+}
+
+// Charger une grammaire ; l'axiome est le membre gauche de la première règle. Avec
+// options->normaliser, le fichier est une grammaire quelconque, mise sous forme normale en
+// mémoire par libgrammaire et passée telle quelle au générateur, sans fichier intermédiaire
+// (options->ecrire_grammaire l'écrit aussi, comme le ferait grammaire).
+Grammaire *charger_grammaire(const char *fichier_grammaire, const OptionsGeneration *options) {
+    Grammaire *grammaire = malloc(sizeof(Grammaire));
+    if (!grammaire) {
+        perror("Erreur d'allocation");
+        return NULL;
+    }
+    ContexteGrammaire ctx;
+    contexte_grammaire_init(&ctx);
+    int statut = lire_grammaire(&ctx, grammaire, fichier_grammaire);
+    if (statut == GRAMMAIRE_OK) statut = preparer_grammaire(&ctx, grammaire, options->normaliser);
+    if (statut == GRAMMAIRE_OK && options->normaliser != NORMALISATION_AUCUNE && options->ecrire_grammaire) {
+        char base[4096];
+        nom_base_sortie(fichier_grammaire, base, sizeof(base));
+        statut = sauvegarder_grammaire(&ctx, grammaire, base, options->normaliser == NORMALISATION_GREIBACH ? 'g' : 'c');
+    }
+    if (statut != GRAMMAIRE_OK) {
+        fprintf(stderr, "Erreur : %s\n", contexte_grammaire_message(&ctx));
+        fprintf(stderr, "Erreur : Impossible de lire la grammaire %s.\n", fichier_grammaire);
+        free(grammaire);
+        return NULL;
+    }
+    return grammaire;
+}
+
+// Tirer options->nb_echantillons mots de longueur options->longueur_echantillons
+int echantillonner_mots(Grammaire *grammaire, const char *nom_fichier_sortie, const OptionsGeneration *options) {
+    GrammaireIndexee indexee;
+    TableComptage table;
+    int longueur = options->longueur_echantillons;
+
+    if (indexer_grammaire(grammaire, &indexee) == -1) return -1;
+    if (options->fichier_poids && lire_poids(&indexee, options->fichier_poids) == -1) {
+        liberer_grammaire_indexee(&indexee);
+        return -1;
+    }
+    if (comptage_construire(&table, &indexee, longueur) == -1) {
+        liberer_grammaire_indexee(&indexee);
+        return -1;
+    }
+    if (comptage_non_terminal(&table, indexee.axiome, longueur) <= 0.0) {
+        fprintf(stderr, "Erreur : la grammaire n'engendre aucun mot de longueur %d.\n", longueur);
+        comptage_liberer(&table);
+        liberer_grammaire_indexee(&indexee);
+        return -1;
     }
 
-    for (int i = 0; i < mot_count; i++) {
-        fprintf(output, "%s\n", mots[i]);
+    SortieMots sortie;
+    int statut = sortie_ouvrir(&sortie, nom_fichier_sortie, options->format);
+    if (statut == 0) {
+        Aleatoire aleatoire;
+        aleatoire_init(&aleatoire, options->graine);
+        char *mot = malloc(longueur + 2);
+        if (!mot) statut = -1;
+        for (long k = 0; k < options->nb_echantillons && statut == 0; k++) {
+            int ecrits = echantillonner_mot(&table, longueur, &aleatoire, mot);
+            if (ecrits == -1) {
+                statut = -1;
+            } else if (ecrits == 0) {
+                statut = sortie_ecrire(&sortie, "E", 1); // Le mot vide s'écrit E
+            } else {
+                statut = sortie_ecrire(&sortie, mot, ecrits);
+            }
+        }
+        free(mot);
+        if (sortie_fermer(&sortie) == -1) statut = -1;
     }
 
-    fclose(output);
-    printf("Mots générés sauvegardés dans %s\n", nom_fichier_sortie);
+    comptage_liberer(&table);
+    liberer_grammaire_indexee(&indexee);
+    return statut;
+}
+
+// Curseur couvrant au moins la longueur demandée ; la longueur maximale double au besoin
+CurseurLex *curseur_pour_longueur(CurseurLex *curseur, const GrammaireIndexee *indexee, int longueur) {
+    if (curseur && curseur_lex_longueur_max(curseur) >= longueur) return curseur;
+    int longueur_max = curseur ? curseur_lex_longueur_max(curseur) : 16;
+    while (longueur_max < longueur) longueur_max *= 2;
+    if (longueur_max > MAX_WORD_LEN - 1) longueur_max = MAX_WORD_LEN - 1;
+    curseur_lex_liberer(curseur);
+    return curseur_lex_creer(indexee, longueur_max);
 }
+
+// Écrire les mots de rangs [options->rang_depart, + options->nb_rangs) dans l'ordre
+// hiérarchique (longueur puis ordre alphabétique), ou dans l'ordre alphabétique des mots
+// de longueur options->longueur_echantillons si elle est donnée. Seuls les mots précédant
+// la tranche sont comptés, jamais énumérés.
+int derang_mots(Grammaire *grammaire, const char *nom_fichier_sortie, const OptionsGeneration *options) {
+    GrandEntier premier, fin, nombre, base, rang, debut, multiplicite;
+    if (ge_lire(&premier, options->rang_depart) == -1) {
+        fprintf(stderr, "Erreur : rang invalide : %s\n", options->rang_depart);
+        return -1;
+    }
+    ge_depuis_u64(&nombre, (uint64_t)options->nb_rangs);
+    ge_ajouter(&fin, &premier, &nombre);
+
+    if (options->longueur_echantillons >= MAX_WORD_LEN) {
+        fprintf(stderr, "Erreur : longueur invalide : %d\n", options->longueur_echantillons);
+        return -1;
+    }
+
+    GrammaireIndexee indexee;
+    if (indexer_grammaire(grammaire, &indexee) == -1) return -1;
+
+    int par_longueur = options->longueur_echantillons >= 0;
+    int longueur = par_longueur ? options->longueur_echantillons : 0;
+    CurseurLex *curseur = curseur_pour_longueur(NULL, &indexee, longueur);
+    int statut = curseur ? 0 : -1;
+
+    // Trouver la longueur du premier mot et son rang parmi les mots de cette longueur
+    ge_zero(&base);
+    rang = premier;
+    while (statut == 0 && !par_longueur) {
+        const GrandEntier *total = curseur_lex_total(curseur, longueur);
+        if (ge_comparer(&rang, total) < 0) break;
+        ge_soustraire(&rang, &rang, total);
+        ge_ajouter(&base, &base, total);
+        if (++longueur >= MAX_WORD_LEN) {
+            statut = -1;
+        } else if (!(curseur = curseur_pour_longueur(curseur, &indexee, longueur))) {
+            statut = -1;
+        }
+    }
+    if (statut == -1) {
+        fprintf(stderr, "Erreur : la grammaire engendre moins de %s mots de longueur < %d.\n", options->rang_depart, MAX_WORD_LEN);
+        curseur_lex_liberer(curseur);
+        liberer_grammaire_indexee(&indexee);
+        return -1;
+    }
+
+    SortieMots sortie;
+    statut = sortie_ouvrir(&sortie, nom_fichier_sortie, options->format);
+    if (statut == -1) {
+        curseur_lex_liberer(curseur);
+        liberer_grammaire_indexee(&indexee);
+        return -1;
+    }
+
+    int place = curseur_lex_positionner(curseur, longueur, &rang);
+    while (place != -1 && statut == 0) {
+        if (place == 0) {
+            // Plus de mot de cette longueur : passer à la suivante
+            if (par_longueur || longueur + 1 >= MAX_WORD_LEN) break;
+            ge_ajouter(&base, &base, curseur_lex_total(curseur, longueur));
+            longueur++;
+            if (!(curseur = curseur_pour_longueur(curseur, &indexee, longueur))) {
+                place = -1;
+                break;
+            }
+            ge_zero(&rang);
+            place = curseur_lex_positionner(curseur, longueur, &rang);
+            continue;
+        }
+
+        curseur_lex_rangs(curseur, &debut, &multiplicite);
+        ge_ajouter(&debut, &debut, &base);
+        if (ge_comparer(&debut, &fin) >= 0) break;
+        // Grammaire ambiguë : un mot appartient à la tranche qui contient son premier rang
+        if (ge_comparer(&debut, &premier) >= 0) {
+            const char *mot = curseur_lex_mot(curseur);
+            statut = longueur == 0 ? sortie_ecrire(&sortie, "E", 1) : sortie_ecrire(&sortie, mot, longueur);
+        }
+        place = curseur_lex_suivant(curseur);
+    }
+    if (place == -1) {
+        fprintf(stderr, "Erreur : parcours des rangs interrompu.\n");
+        statut = -1;
+    }
+    if (sortie_fermer(&sortie) == -1) statut = -1;
+
+    curseur_lex_liberer(curseur);
+    liberer_grammaire_indexee(&indexee);
+    return statut;
+}
+
+// Afficher le rang de options->mot_rang dans l'ordre hiérarchique et parmi les mots de sa longueur
+int rang_mot(Grammaire *grammaire, const OptionsGeneration *options) {
+    const char *mot = strcmp(options->mot_rang, "E") == 0 ? "" : options->mot_rang;
+    int longueur = (int)strlen(mot);
+    if (longueur >= MAX_WORD_LEN) {
+        fprintf(stderr, "Erreur : mot trop long.\n");
+        return -1;
+    }
+
+    GrammaireIndexee indexee;
+    if (indexer_grammaire(grammaire, &indexee) == -1) return -1;
+
+    GrandEntier rang, multiplicite, global;
+    CurseurLex *curseur = NULL;
+    LangageFini langage;
+    int statut = langage_fini_construire(&langage, &indexee);
+    if (statut == 1) {
+        // Langage fini : recherche dichotomique dans ses mots triés
+        long i = langage_fini_chercher(&langage, mot);
+        statut = i >= 0;
+        if (statut == 1) {
+            const MotsFinis *axiome = langage.langage;
+            ge_zero(&global);
+            ge_zero(&rang);
+            for (long j = 0; j < i; j++) {
+                ge_ajouter(&global, &global, &axiome->derivations[j]);
+                if (strlen(axiome->mots.tries[j]) == (size_t)longueur) ge_ajouter(&rang, &rang, &axiome->derivations[j]);
+            }
+            multiplicite = axiome->derivations[i];
+        }
+        langage_fini_liberer(&langage);
+    } else if (statut == 0) {
+        curseur = curseur_pour_longueur(NULL, &indexee, longueur);
+        if (!curseur) {
+            liberer_grammaire_indexee(&indexee);
+            return -1;
+        }
+        statut = curseur_lex_rang(curseur, mot, &rang, &multiplicite);
+        if (statut == 1) {
+            global = rang;
+            for (int l = 0; l < longueur; l++) ge_ajouter(&global, &global, curseur_lex_total(curseur, l));
+        }
+    }
+    if (statut == 1) {
+        char texte_global[200], texte_rang[200], texte_multiplicite[200];
+        ge_ecrire(&global, texte_global, sizeof(texte_global));
+        ge_ecrire(&rang, texte_rang, sizeof(texte_rang));
+        ge_ecrire(&multiplicite, texte_multiplicite, sizeof(texte_multiplicite));
+        printf("%s\t%s\t%s\n", texte_global, texte_rang, texte_multiplicite);
+        statut = 0;
+    } else if (statut == 0) {
+        fprintf(stderr, "Le mot %s n'est pas engendré par la grammaire.\n", options->mot_rang);
+        statut = 1;
+    }
+
+    curseur_lex_liberer(curseur);
+    liberer_grammaire_indexee(&indexee);
+    return statut;
+}
+
+static volatile sig_atomic_t signal_recu = 0;
+
+static void noter_signal(int numero) {
+    signal_recu = numero;
+}
+
+// Mémoire résidente maximale du processus, en octets
+static size_t memoire_residente(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == -1) return 0;
+    return (size_t)usage.ru_maxrss * 1024;
+}
+
+// Écrire les mots au fur et à mesure qu'un itérateur les produit, sans les stocker.
+// Vers un fichier texte, l'état de l'itérateur est sauvegardé dans un point de reprise
+// (reprise.c) toutes les options->intervalle_reprise secondes, et quand un budget ou un
+// signal (SIGINT, SIGTERM) arrête l'écriture, toujours après un mot complet.
+// Renvoie 0, 1 si l'écriture a été arrêtée avant la fin, -1 en cas d'erreur.
+int ecrire_mots_iterateur(Grammaire *grammaire, int longueur_max, const char *nom_fichier_sortie, const OptionsGeneration *options) {
+    int reprise_possible = options->format == FORMAT_TEXTE && strcmp(nom_fichier_sortie, "-") != 0;
+    if ((options->intervalle_reprise > 0 || options->reprendre) && !reprise_possible) {
+        fprintf(stderr, "Erreur : --checkpoint et --resume demandent une sortie texte dans un fichier.\n");
+        return -1;
+    }
+    int budget = options->max_mots > 0 || options->max_secondes > 0 || options->max_memoire > 0;
+    long intervalle = options->intervalle_reprise;
+    if (intervalle == 0 && options->reprendre) intervalle = REPRISE_INTERVALLE_DEFAUT;
+    int points_reprise = reprise_possible && (intervalle > 0 || budget);
+    char *fichier_reprise = malloc(strlen(nom_fichier_sortie) + sizeof(REPRISE_EXTENSION));
+    if (!fichier_reprise) {
+        perror("Erreur d'allocation");
+        return -1;
+    }
+    sprintf(fichier_reprise, "%s%s", nom_fichier_sortie, REPRISE_EXTENSION);
+
+    IterateurMots *iterateur = iterateur_ouvrir(grammaire, longueur_max, options->ordre);
+    if (!iterateur) {
+        free(fichier_reprise);
+        return -1;
+    }
+
+    SortieMots sortie;
+    unsigned long long mots = 0;
+    int statut;
+    if (options->reprendre) {
+        long octets;
+        statut = reprise_lire(fichier_reprise, grammaire, longueur_max, options->ordre, iterateur, &mots, &octets);
+        if (statut == 0) statut = sortie_reprendre(&sortie, nom_fichier_sortie, octets);
+    } else {
+        statut = sortie_ouvrir(&sortie, nom_fichier_sortie, options->format);
+    }
+    if (statut == -1) {
+        iterateur_fermer(iterateur);
+        free(fichier_reprise);
+        return -1;
+    }
+    if (points_reprise) {
+        signal_recu = 0;
+        signal(SIGINT, noter_signal);
+        signal(SIGTERM, noter_signal);
+    }
+
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    double dernier_point = 0.0;
+    const char *arret = NULL;      // Budget ou signal qui a arrêté l'écriture
+    const char *mot;
+    size_t longueur;
+    int suivant = 0;
+    while (statut == 0) {
+        if (options->max_mots > 0 && mots >= options->max_mots) arret = "--max-words";
+        else if (signal_recu) arret = signal_recu == SIGINT ? "SIGINT" : "SIGTERM";
+        if (arret || (suivant = iterateur_suivant(iterateur, &mot, &longueur)) != 1) break;
+        statut = longueur == 0 ? sortie_ecrire(&sortie, "E", 1) : sortie_ecrire(&sortie, mot, longueur);
+        if (statut != 0 || ++mots % REPRISE_VERIFICATION != 0) continue;
+
+        double ecoule = secondes_depuis(&debut);
+        if (options->max_secondes > 0 && ecoule >= (double)options->max_secondes) {
+            arret = "--max-seconds";
+        } else if (options->max_memoire > 0 && memoire_residente() > options->max_memoire) {
+            arret = "--max-memory";
+        } else if (points_reprise && intervalle > 0 && ecoule - dernier_point >= (double)intervalle) {
+            statut = reprise_ecrire(fichier_reprise, grammaire, longueur_max, options->ordre, iterateur, &sortie, mots);
+            dernier_point = ecoule;
+        }
+        if (arret) break;
+    }
+    if (suivant == -1) statut = -1;
+    if (statut == 0 && arret && points_reprise) {
+        statut = reprise_ecrire(fichier_reprise, grammaire, longueur_max, options->ordre, iterateur, &sortie, mots);
+    }
+    if (sortie_fermer(&sortie) == -1) statut = -1;
+    iterateur_fermer(iterateur);
+    if (points_reprise) {
+        signal(SIGINT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+    }
+
+    if (statut == 0 && arret) {
+        printf("Écriture arrêtée (%s) après %llu mots dans %s%s\n", arret, mots, nom_fichier_sortie,
+               points_reprise ? " ; --resume la poursuit" : "");
+        free(fichier_reprise);
+        return 1;
+    }
+    if (statut == 0) {
+        // Énumération complète : le point de reprise ne sert plus
+        if (points_reprise) remove(fichier_reprise);
+        printf("Mots générés sauvegardés dans %s\n", nom_fichier_sortie);
+    }
+    free(fichier_reprise);
+    return statut;
+}
+
+// Charger une grammaire normalisée et générer ses mots dans un fichier (renvoie le statut
+// de ecrire_mots_iterateur avec --ordre)
+int charger_et_generer(const char *fichier_grammaire, int longueur_max, const char *nom_fichier_sortie, const OptionsGeneration *options) {
+    Grammaire *grammaire = charger_grammaire(fichier_grammaire, options);
+    if (!grammaire) return -1;
+
+    int statut = 0;
+    if (options->expliquer) {
+        Plan plan;
+        statut = planifier(grammaire, longueur_max, options->nb_threads, options->moteur, &plan);
+        if (statut == 0) {
+            expliquer_plan(stdout, &plan);
+            plan_liberer(&plan);
+        }
+    } else if (options->flux) {
+        statut = ecrire_mots_iterateur(grammaire, longueur_max, nom_fichier_sortie, options);
+    } else {
+        statut = generer_mots(grammaire, longueur_max, nom_fichier_sortie, options);
+    }
+    free(grammaire);
+    return statut;
+}
+
+// Comparer la première grammaire à chacune des suivantes jusqu'à la longueur n.
+// Renvoie 0 si toutes sont équivalentes, 1 si l'une diffère, -1 en cas d'erreur.
+int verifier_equivalences(const char **fichiers, int nb_fichiers, const OptionsGeneration *options) {
+    int longueur_max = options->longueur_equivalence;
+    Grammaire *reference = charger_grammaire(fichiers[0], options);
+    if (!reference) return -1;
+    int statut = 0;
+    for (int i = 1; i < nb_fichiers && statut != -1; i++) {
+        Grammaire *grammaire = charger_grammaire(fichiers[i], options);
+        ComparaisonLangages comparaison;
+        if (!grammaire || comparer_langages(reference, grammaire, longueur_max, &comparaison) == -1) {
+            statut = -1;
+        } else if (!comparaison.differentes) {
+            printf("%s : équivalente à %s jusqu'à la longueur %d\n", fichiers[i], fichiers[0], longueur_max);
+        } else {
+            printf("%s : différente de %s : %s (longueur %d) n'est engendré que par %s\n", fichiers[i], fichiers[0],
+                   comparaison.longueur == 0 ? "E" : comparaison.temoin, comparaison.longueur,
+                   comparaison.dans_premiere ? fichiers[0] : fichiers[i]);
+            statut = 1;
+        }
+        free(grammaire);
+    }
+    free(reference);
+    return statut;
+}
+
+// Lire la valeur d'une option, écrite "--nom=valeur" ou "--nom valeur"
+const char *valeur_option(int argc, char *argv[], int *i, const char *nom) {
+    size_t len = strlen(nom);
+    if (strncmp(argv[*i], nom, len) != 0) return NULL;
+    if (argv[*i][len] == '=') return argv[*i] + len + 1;
+    if (argv[*i][len] == '\0' && *i + 1 < argc) return argv[++*i];
+    return NULL;
+}
+
+// Lire un entier décimal positif ; renvoie -1 si la valeur n'en est pas un
+static int lire_nombre(const char *valeur, unsigned long long *nombre) {
+    char *fin;
+    if (*valeur < '0' || *valeur > '9') return -1;
+    *nombre = strtoull(valeur, &fin, 10);
+    return *fin == '\0' ? 0 : -1;
+}
+
+void afficher_usage(const char *programme) {
+    fprintf(stderr, "Usage : %s [--format=texte|frontcoded] [--threads=N | --ordre=hierarchique|derivation] [--memoire=Mo] [--stats[=fichier.json]]\n"
+                    "        [--moteur=auto|dfs|longueur|automate|fini] [--explain] [fichier_grammaire n [fichier_sortie]]\n", programme);
+    fprintf(stderr, "        %s --ordre=... [--checkpoint=S] [--resume] [--max-words=N] [--max-seconds=S] [--max-memory=Mo] fichier_grammaire n [fichier_sortie]\n", programme);
+    fprintf(stderr, "        %s --normaliser=greibach|chomsky [--ecrire-grammaire] [options de génération] fichier.general n [fichier_sortie]\n", programme);
+    fprintf(stderr, "        %s --sample K --length n [--poids fichier] [--graine S] fichier_grammaire [fichier_sortie]\n", programme);
+    fprintf(stderr, "        %s --unrank K [--count M] [--length n] fichier_grammaire [fichier_sortie]\n", programme);
+    fprintf(stderr, "        %s --rank mot fichier_grammaire\n", programme);
+    fprintf(stderr, "        %s --equivalence n grammaire_reference grammaire [grammaire]\n", programme);
+    fprintf(stderr, "        %s --service=socket\n", programme);
+    fprintf(stderr, "        %s --client=socket [--normaliser=greibach|chomsky] normaliser|appartient|compter|enumerer grammaire [mot|n]\n", programme);
+    fprintf(stderr, "Sans argument, génère les mots de longueur <= 4 pour exemple.Transforme.chomsky et .greibach.\n");
+}
+
 // Fonction principale
-int main() {
-    Grammaire grammaire_chomsky;
-    Grammaire grammaire_greibach;
+int main(int argc, char *argv[]) {
+    OptionsGeneration options = { FORMAT_TEXTE, 1, 0, -1, NULL, 0, NULL, 1, NULL, 0, ORDRE_HIERARCHIQUE, -1, TRI_EXTERNE_MEMOIRE_DEFAUT,
+                                  0, 0, 0, 0, 0, NULL, MOTEUR_AUTO, 0, NORMALISATION_AUCUNE, 0, NULL, NULL };
+    const char *positionnels[3];
+    int nb_positionnels = 0;
+    const char *valeur;
+    unsigned long long nombre;
 
-    // Charger la grammaire en forme normale de Chomsky
-    if (lire_grammaire(&grammaire_chomsky, "exemple.Transforme.chomsky") == -1) {
-        fprintf(stderr, "Erreur : Impossible de lire la grammaire en forme normale de Chomsky.\n");
+    options.graine = (unsigned long long)time(NULL) ^ ((unsigned long long)getpid() << 32);
+
+    for (int i = 1; i < argc; i++) {
+        if ((valeur = valeur_option(argc, argv, &i, "--format"))) {
+            if (strcmp(valeur, "texte") == 0) {
+                options.format = FORMAT_TEXTE;
+            } else if (strcmp(valeur, "frontcoded") == 0) {
+                options.format = FORMAT_FRONTCODED;
+            } else {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+        } else if ((valeur = valeur_option(argc, argv, &i, "--threads"))) {
+            // 0 = autant de threads que de cœurs disponibles
+            options.nb_threads = atoi(valeur);
+            if (options.nb_threads == 0) options.nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+            if (options.nb_threads < 1) options.nb_threads = 1;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--ordre"))) {
+            options.flux = 1;
+            if (strcmp(valeur, "hierarchique") == 0) {
+                options.ordre = ORDRE_HIERARCHIQUE;
+            } else if (strcmp(valeur, "derivation") == 0) {
+                options.ordre = ORDRE_DERIVATION;
+            } else {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+        } else if ((valeur = valeur_option(argc, argv, &i, "--memoire"))) {
+            // En mégaoctets ; 0 = sans limite
+            if (lire_nombre(valeur, &nombre) == -1) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.memoire = (size_t)nombre << 20;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--checkpoint"))) {
+            if (lire_nombre(valeur, &nombre) == -1 || nombre == 0) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.intervalle_reprise = (long)nombre;
+        } else if (strcmp(argv[i], "--resume") == 0) {
+            options.reprendre = 1;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--max-words"))) {
+            if (lire_nombre(valeur, &options.max_mots) == -1) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+        } else if ((valeur = valeur_option(argc, argv, &i, "--max-seconds"))) {
+            if (lire_nombre(valeur, &options.max_secondes) == -1) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+        } else if ((valeur = valeur_option(argc, argv, &i, "--max-memory"))) {
+            // En mégaoctets, comme --memoire
+            if (lire_nombre(valeur, &nombre) == -1) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.max_memoire = (size_t)nombre << 20;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--moteur"))) {
+            int moteur = lire_moteur(valeur);
+            if (moteur == -1) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.moteur = (Moteur)moteur;
+        } else if (strcmp(argv[i], "--explain") == 0) {
+            options.expliquer = 1;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--normaliser"))) {
+            if (strcmp(valeur, "greibach") == 0) {
+                options.normaliser = NORMALISATION_GREIBACH;
+            } else if (strcmp(valeur, "chomsky") == 0) {
+                options.normaliser = NORMALISATION_CHOMSKY;
+            } else {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--ecrire-grammaire") == 0) {
+            options.ecrire_grammaire = 1;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--service"))) {
+            options.service = valeur;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--client"))) {
+            options.client = valeur;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            options.statistiques = "-";
+        } else if (strncmp(argv[i], "--stats=", 8) == 0) {
+            options.statistiques = argv[i] + 8;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--sample"))) {
+            if (lire_nombre(valeur, &nombre) == -1 || nombre == 0 || nombre > LONG_MAX) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.nb_echantillons = (long)nombre;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--length"))) {
+            if (lire_nombre(valeur, &nombre) == -1 || nombre >= MAX_WORD_LEN) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.longueur_echantillons = (int)nombre;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--unrank"))) {
+            options.rang_depart = valeur;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--count"))) {
+            if (lire_nombre(valeur, &nombre) == -1 || nombre > LONG_MAX) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.nb_rangs = (long)nombre;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--rank"))) {
+            options.mot_rang = valeur;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--poids"))) {
+            options.fichier_poids = valeur;
+        } else if ((valeur = valeur_option(argc, argv, &i, "--graine"))) {
+            if (lire_nombre(valeur, &options.graine) == -1) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+        } else if ((valeur = valeur_option(argc, argv, &i, "--equivalence"))) {
+            if (lire_nombre(valeur, &nombre) == -1 || nombre >= MAX_WORD_LEN) {
+                afficher_usage(argv[0]);
+                return -1;
+            }
+            options.longueur_equivalence = (int)nombre;
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            afficher_usage(argv[0]);
+            return -1;
+        } else if (nb_positionnels < 3) {
+            positionnels[nb_positionnels++] = argv[i];
+        } else {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    const char *extension = options.format == FORMAT_FRONTCODED ? "fc" : "txt";
+
+    if ((options.intervalle_reprise > 0 || options.reprendre || options.max_mots > 0 || options.max_secondes > 0 ||
+         options.max_memoire > 0) && !options.flux) {
+        fprintf(stderr, "Erreur : --checkpoint, --resume et les budgets --max-* s'appliquent à l'écriture au fil de l'itérateur (--ordre).\n");
+        return -1;
+    }
+    if ((options.moteur != MOTEUR_AUTO || options.expliquer) && options.flux) {
+        fprintf(stderr, "Erreur : --moteur et --explain s'appliquent à la génération triée, sans --ordre.\n");
+        return -1;
+    }
+    if (options.ecrire_grammaire && options.normaliser == NORMALISATION_AUCUNE) {
+        fprintf(stderr, "Erreur : --ecrire-grammaire s'applique avec --normaliser.\n");
+        return -1;
+    }
+    if (options.statistiques && options.flux) {
+        fprintf(stderr, "Erreur : --stats s'applique à la génération triée, sans --ordre.\n");
         return -1;
     }
-    // Définir automatiquement l'axiome comme le premier non-terminal pour Chomsky
-    strcpy(grammaire_chomsky.axiome, grammaire_chomsky.rules[0].non_terminal);
+
+    if (options.service) {
+        if (nb_positionnels > 0) {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+        return servir(options.service);
+    }
+    if (options.client) {
+        if (nb_positionnels < 2) {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+        return interroger_service(options.client, positionnels[0], positionnels[1],
+                                  nb_positionnels == 3 ? positionnels[2] : NULL, options.normaliser);
+    }
+
+    if (options.longueur_equivalence >= 0) {
+        if (nb_positionnels < 2) {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+        return verifier_equivalences(positionnels, nb_positionnels, &options);
+    }
+
+    if (options.rang_depart || options.mot_rang) {
+        int attendus = options.mot_rang ? 1 : 2;
+        if (nb_positionnels < 1 || nb_positionnels > attendus ||
+            (options.rang_depart && options.mot_rang)) {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+        Grammaire *grammaire = charger_grammaire(positionnels[0], &options);
+        if (!grammaire) return -1;
+        int statut = options.mot_rang ? rang_mot(grammaire, &options)
+                                      : derang_mots(grammaire, nb_positionnels == 2 ? positionnels[1] : "-", &options);
+        free(grammaire);
+        return statut;
+    }
+
+    if (options.nb_echantillons > 0) {
+        if (nb_positionnels < 1 || nb_positionnels > 2 || options.longueur_echantillons < 0) {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+        char nom_defaut[32];
+        snprintf(nom_defaut, sizeof(nom_defaut), "mots_echantillon.%s", extension);
+        const char *nom_sortie = nb_positionnels == 2 ? positionnels[1] : nom_defaut;
+        Grammaire *grammaire = charger_grammaire(positionnels[0], &options);
+        if (!grammaire) return -1;
+        int statut = echantillonner_mots(grammaire, nom_sortie, &options);
+        free(grammaire);
+        return statut;
+    }
+
+    if (nb_positionnels >= 2) {
+        int longueur_max = atoi(positionnels[1]);
+        if (longueur_max < 0 || longueur_max >= MAX_WORD_LEN) {
+            fprintf(stderr, "Erreur : longueur invalide : %s\n", positionnels[1]);
+            return -1;
+        }
+        char nom_defaut[32];
+        snprintf(nom_defaut, sizeof(nom_defaut), "mots_generes.%s", extension);
+        const char *nom_sortie = nb_positionnels == 3 ? positionnels[2] : nom_defaut;
+        return charger_et_generer(positionnels[0], longueur_max, nom_sortie, &options);
+    } else if (nb_positionnels == 1) {
+        afficher_usage(argv[0]);
+        return -1;
+    }
+
+    char nom_sortie[32];
 
     // Générer des mots pour la grammaire en forme normale de Chomsky
     printf("\n==== Génération de mots (Chomsky) ====");
-    generer_mots(&grammaire_chomsky, 4, "mots_chomsky_generes.txt");
-
-    // Charger la grammaire en forme normale de Greibach
-    if (lire_grammaire(&grammaire_greibach, "exemple.Transforme.greibach") == -1) {
-        fprintf(stderr, "Erreur : Impossible de lire la grammaire en forme normale de Greibach.\n");
+    snprintf(nom_sortie, sizeof(nom_sortie), "mots_chomsky_generes.%s", extension);
+    if (charger_et_generer("exemple.Transforme.chomsky", 4, nom_sortie, &options) == -1) {
+        fprintf(stderr, "Erreur : Impossible de lire la grammaire en forme normale de Chomsky.\n");
         return -1;
     }
-    // Définir automatiquement l'axiome comme le premier non-terminal pour Greibach
-    strcpy(grammaire_greibach.axiome, grammaire_greibach.rules[0].non_terminal);
 
     // Générer des mots pour la grammaire en forme normale de Greibach
     printf("\n==== Génération de mots (Greibach) ====");
-    generer_mots(&grammaire_greibach,4, "mots_greibach_generes.txt");
+    snprintf(nom_sortie, sizeof(nom_sortie), "mots_greibach_generes.%s", extension);
+    if (charger_et_generer("exemple.Transforme.greibach", 4, nom_sortie, &options) == -1) {
+        fprintf(stderr, "Erreur : Impossible de lire la grammaire en forme normale de Greibach.\n");
+        return -1;
+    }
 
     return 0;
 }
@@ -0,0 +1,372 @@
+#ifndef GENERATE_WORDS_H
+#define GENERATE_WORDS_H
+
+#include <stddef.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "automate.h"
+#include "frontcoded.h"
+#include "grand_entier.h"
+#include "libgrammaire.h"
+
+#define MAX_WORD_LEN 256
+
+// Les grammaires sont celles de la bibliothèque de normalisation (libgrammaire.h) ; comme
+// dans les fichiers, l'axiome est le membre gauche de la première règle.
+
+// Format du fichier de sortie
+typedef enum {
+    FORMAT_TEXTE,      // Un mot par ligne
+    FORMAT_FRONTCODED  // Préfixes partagés, voir frontcoded.h
+} FormatSortie;
+
+// Ordre de parcours d'un IterateurMots (voir iterateur.c)
+typedef enum {
+    ORDRE_HIERARCHIQUE,  // Par longueur puis ordre alphabétique, mots distincts
+    ORDRE_DERIVATION     // Dérivations gauches en profondeur, sans tri
+} OrdreIteration;
+
+typedef struct IterateurMots IterateurMots;
+
+// Moteur d'énumération de generer_mots (voir planificateur.c)
+typedef enum {
+    MOTEUR_AUTO,       // Choisi par le planificateur
+    MOTEUR_DFS,        // Développement récursif des formes (éventuellement parallèle)
+    MOTEUR_LONGUEUR,   // Comptage des dérivations par longueur (CurseurLex)
+    MOTEUR_AUTOMATE,   // Automate minimal d'une grammaire régulière non ambiguë
+    MOTEUR_FINI,       // Mots d'un langage fini, calculés une fois
+    NB_MOTEURS
+} Moteur;
+
+// Grammaire d'entrée : déjà sous forme normale, ou à normaliser au chargement (--normaliser)
+typedef enum {
+    NORMALISATION_AUCUNE,
+    NORMALISATION_GREIBACH,
+    NORMALISATION_CHOMSKY
+} Normalisation;
+
+// Options de generer_mots
+typedef struct {
+    FormatSortie format;
+    int nb_threads;    // 1 = énumération séquentielle
+    long nb_echantillons;          // --sample : nombre de mots tirés au hasard
+    int longueur_echantillons;     // --length (-1 si absent)
+    const char *fichier_poids;     // --poids : poids des productions (tirage biaisé)
+    unsigned long long graine;     // --graine
+    const char *rang_depart;       // --unrank : premier rang de la tranche (décimal)
+    long nb_rangs;                 // --count : taille de la tranche
+    const char *mot_rang;          // --rank : mot dont on veut le rang
+    int flux;                      // --ordre : écrire les mots au fil d'un IterateurMots
+    OrdreIteration ordre;
+    int longueur_equivalence;      // --equivalence : longueur maximale comparée (-1 si absent)
+    size_t memoire;                // --memoire : octets de mots gardés en mémoire par generer_mots
+    long intervalle_reprise;       // --checkpoint : secondes entre deux points de reprise (0 : aucun)
+    int reprendre;                 // --resume : repartir du point de reprise de la sortie
+    unsigned long long max_mots;   // --max-words : mots écrits au plus, reprises comprises (0 : sans limite)
+    unsigned long long max_secondes;  // --max-seconds : durée de l'exécution (0 : sans limite)
+    size_t max_memoire;            // --max-memory : mémoire résidente en octets (0 : sans limite)
+    const char *statistiques;      // --stats : résumé JSON ("-" : sortie d'erreur), NULL sans instrumentation
+    Moteur moteur;                 // --moteur (MOTEUR_AUTO par défaut)
+    int expliquer;                 // --explain : décrire le plan sans générer
+    Normalisation normaliser;      // --normaliser : forme normale calculée en mémoire au chargement
+    int ecrire_grammaire;          // --ecrire-grammaire : écrire aussi x.Transforme.greibach ou .chomsky
+    const char *service;           // --service : socket sur laquelle servir les requêtes
+    const char *client;            // --client : socket du service à interroger
+} OptionsGeneration;
+
+// Liste de mots de taille quelconque : les mots sont concaténés dans une seule zone
+typedef struct {
+    char *donnees;          // Mots terminés par '\0', les uns à la suite des autres
+    size_t taille;
+    size_t capacite;
+    size_t *debuts;         // Offset de chaque mot dans donnees
+    size_t nombre;
+    size_t capacite_debuts;
+    const char **tries;     // Mots dans l'ordre de sortie (rempli par liste_mots_trier)
+} ListeMots;
+
+// Fichier de sortie d'une liste de mots, dans l'un des formats ci-dessus
+typedef struct {
+    FILE *fichier;
+    FormatSortie format;
+    EcrivainFC fc;
+    const char *nom;
+    int erreur;
+} SortieMots;
+
+// Grammaire indexée : symboles numérotés, pour les algorithmes qui travaillent par
+// (non-terminal, longueur). Un symbole >= 0 est un non-terminal, < 0 un terminal.
+#define MAX_NT_INDEXES 256
+#define EST_TERMINAL_IDX(s) ((s) < 0)
+#define TERMINAL_IDX(c) (-1 - (int)(unsigned char)(c))
+#define CARACTERE_TERMINAL(s) ((char)(-1 - (s)))
+
+typedef struct {
+    int gauche;                   // Non-terminal du membre gauche
+    int longueur;                 // Nombre de symboles (0 pour E)
+    int symboles[MAX_SYMBOLS];
+    double poids;                 // 1 par défaut, voir lire_poids
+    char texte[MAX_SYMBOLS];      // Production telle qu'écrite dans le fichier
+} ProductionIndexee;
+
+typedef struct {
+    int nb_non_terminaux;
+    char noms[MAX_NT_INDEXES][MAX_SYMBOLS];
+    int axiome;
+    ProductionIndexee *productions;  // Regroupées par membre gauche, dans l'ordre du fichier
+    int nb_productions;
+    int premiere_production[MAX_NT_INDEXES];
+    int nb_productions_nt[MAX_NT_INDEXES];
+} GrammaireIndexee;
+
+// Comptage des dérivations par (non-terminal, longueur), pondérées par les poids des productions.
+// suffixes[p][j][l] = poids total des façons dont les symboles j.. de la production p
+// dérivent un mot de longueur l.
+typedef struct {
+    const GrammaireIndexee *grammaire;
+    int longueur_max;
+    double *non_terminaux;        // [A * (longueur_max + 1) + l]
+    double *suffixes;
+    size_t *offset_suffixes;      // Début de la production p dans suffixes
+} TableComptage;
+
+// Même comptage en entiers exacts (sans poids) : pour une grammaire non ambiguë,
+// non_terminaux[A][l] est le nombre de mots de longueur l engendrés par A.
+typedef struct {
+    const GrammaireIndexee *grammaire;
+    int longueur_max;
+    GrandEntier *non_terminaux;
+    GrandEntier *suffixes;
+    size_t *offset_suffixes;
+} TableExacte;
+
+// Langage fini (voir fini.c) : mots de chaque non-terminal, distincts et dans l'ordre
+// court-lexicographique, avec leur nombre de dérivations
+#define LANGAGE_FINI_MAX_MOTS (1 << 20)   // Mots produits au plus pendant la construction
+
+typedef struct {
+    ListeMots mots;                // mots.tries : mots triés, "" pour le mot vide
+    GrandEntier *derivations;      // derivations[i] : nombre de dérivations de mots.tries[i]
+} MotsFinis;
+
+typedef struct {
+    int nb_non_terminaux;
+    MotsFinis *non_terminaux;      // Vides pour les non-terminaux inutiles
+    const MotsFinis *langage;      // Mots de l'axiome
+    size_t nb_mots;
+} LangageFini;
+
+// Plan de generer_mots (planificateur.c) : analyse de la grammaire, coût estimé de chaque
+// moteur (< 0 s'il ne s'applique pas, raisons[m] dit alors pourquoi) et moteur retenu.
+// L'automate et le langage fini construits pendant l'analyse servent à l'exécution.
+typedef struct {
+    Moteur moteur;
+    int impose;                    // 1 : moteur imposé par --moteur
+    int longueur_max;
+    int nb_threads;
+    int indexee_valide;
+    GrammaireIndexee indexee;
+    int derivations_completes;     // Dérivations bornées : les moteurs autres que dfs s'appliquent
+    int fini;                      // 1 : langage fini, langage rempli
+    LangageFini langage;
+    int reguliere;                 // 1 : automate rempli
+    Automate automate;
+    int etats;
+    int non_ambigue;               // 1 : autant de mots que de dérivations à chaque longueur <= n
+    int lignes_connues;
+    GrandEntier lignes;            // Lignes de la sortie : dérivations des mots de longueur <= n
+    int distincts_connus;
+    GrandEntier distincts;         // Mots distincts de longueur <= n
+    double couts[NB_MOTEURS];
+    const char *raisons[NB_MOTEURS];
+} Plan;
+
+// Curseur sur les mots d'une longueur donnée, dans l'ordre de strcmp (voir rang.c)
+typedef struct CurseurLex CurseurLex;
+
+// Compteurs de generer_mots (statistiques.c, --stats). Les compteurs atomiques sont mis à
+// jour par tous les threads et lus par le rapport de progression ; les comptes par
+// longueur et les durées de fusion et d'écriture sont tenus par le seul thread qui écrit.
+// Durées : derivation et fusion sont des phases (temps réel, déversements compris), tri
+// la somme des tris de tampons sur tous les threads, ecriture le temps passé dans la
+// sortie pendant la fusion.
+#define PROGRESSION_INTERVALLE 1   // Secondes entre deux lignes de progression
+
+typedef enum {
+    PHASE_DERIVATION,
+    PHASE_FUSION,
+    PHASE_TERMINEE
+} PhaseGeneration;
+
+typedef struct {
+    atomic_ullong formes;              // Formes sententielles développées
+    atomic_ullong elaguees_profondeur; // Branches abandonnées à la profondeur maximale
+    atomic_ullong elaguees_longueur;   // Mots plus longs que longueur_max, formes plus longues que MAX_WORD_LEN
+    atomic_ullong derivations;         // Mots ajoutés aux tampons, un par dérivation
+    atomic_ullong deversements;        // Tampons déversés dans une série temporaire
+    atomic_ullong ecrits;              // Lignes écrites dans la sortie
+    atomic_ullong nanosecondes_tri;
+    atomic_int phase;
+    unsigned long long mots_longueur[MAX_WORD_LEN];       // Lignes écrites par longueur (E : 0)
+    unsigned long long distincts_longueur[MAX_WORD_LEN];  // Mots distincts par longueur
+    double duree_derivation, duree_fusion, duree_ecriture;
+    const char *methode;               // "recursif", "parallele", "longueur", "automate" ou "fini"
+    struct timespec debut;
+} CompteursGeneration;
+
+// Thread qui écrit une ligne de progression sur la sortie d'erreur toutes les
+// PROGRESSION_INTERVALLE secondes
+typedef struct {
+    const CompteursGeneration *compteurs;
+    pthread_t thread;
+    pthread_mutex_t verrou;
+    pthread_cond_t condition;
+    int arreter;
+} Progression;
+
+#define COMPTER(compteurs, champ) \
+    do { \
+        if (compteurs) atomic_fetch_add_explicit(&(compteurs)->champ, 1, memory_order_relaxed); \
+    } while (0)
+
+// Tri externe de generer_mots (tri_externe.c) : les tampons de mots qui dépassent le
+// budget sont triés et déversés dans des fichiers temporaires, fusionnés à la fin. Plusieurs
+// threads peuvent déverser en même temps, chacun son tampon.
+#define TRI_EXTERNE_MEMOIRE_DEFAUT ((size_t)1024 << 20)
+#define TRI_EXTERNE_MAX_SERIES 16  // Séries d'un même niveau regroupées en une seule
+
+typedef struct {
+    size_t budget;                 // Octets par tampon, 0 sans limite
+    FILE **series;
+    int *niveaux;                  // Niveau de chaque série : 0 au déversement, + 1 à chaque regroupement
+    int nb_series;
+    int capacite_series;
+    int erreur;
+    pthread_mutex_t verrou;
+    CompteursGeneration *compteurs;  // NULL sans --stats
+} TriExterne;
+
+// Points de reprise et budgets de l'écriture au fil de l'itérateur (reprise.c). Le point
+// de reprise d'une sortie x est x.reprise.
+#define REPRISE_EXTENSION ".reprise"
+#define REPRISE_INTERVALLE_DEFAUT 60   // Secondes entre deux points de reprise avec --resume seul
+#define REPRISE_VERIFICATION 256       // Mots écrits entre deux mesures de la durée et de la mémoire
+
+// Résultat de comparer_langages (equivalence.c)
+typedef struct {
+    int differentes;               // 1 si un mot de longueur <= longueur_max distingue les grammaires
+    int longueur;                  // Longueur du témoin
+    int dans_premiere;             // 1 : le témoin n'est engendré que par la première grammaire
+    char temoin[MAX_WORD_LEN];     // Plus petit mot (longueur puis strcmp) qui les distingue
+} ComparaisonLangages;
+
+// Générateur pseudo-aléatoire (xoshiro256**)
+typedef struct {
+    unsigned long long etat[4];
+} Aleatoire;
+
+// liste_mots.c
+void liste_mots_init(ListeMots *liste);
+int liste_mots_ajouter(ListeMots *liste, const char *mot, size_t longueur);
+int liste_mots_trier(ListeMots *liste);
+void liste_mots_liberer(ListeMots *liste);
+int comparer_mots_shortlex(const char *mot_a, const char *mot_b);
+
+// tri_externe.c
+int tri_externe_init(TriExterne *tri, size_t budget);
+int tri_externe_ajouter(TriExterne *tri, ListeMots *tampon, const char *mot, size_t longueur);
+int tri_externe_trier(TriExterne *tri, ListeMots *tampon);
+int tri_externe_ecrire(TriExterne *tri, ListeMots *tampons, int nb_tampons, SortieMots *sortie);
+void tri_externe_liberer(TriExterne *tri);
+
+// planificateur.c
+const char *nom_moteur(Moteur moteur);
+int lire_moteur(const char *nom);
+int planifier(const Grammaire *grammaire, int longueur_max, int nb_threads, Moteur force, Plan *plan);
+void expliquer_plan(FILE *flux, const Plan *plan);
+void plan_liberer(Plan *plan);
+
+// statistiques.c
+double secondes_depuis(const struct timespec *debut);
+void compteurs_init(CompteursGeneration *compteurs);
+void compter_ecriture(CompteursGeneration *compteurs, const char *mot, size_t longueur, unsigned long long nombre);
+int progression_demarrer(Progression *progression, const CompteursGeneration *compteurs);
+void progression_arreter(Progression *progression);
+int ecrire_statistiques(const char *chemin, const CompteursGeneration *compteurs, int longueur_max, int nb_threads,
+                        const char *sortie);
+
+// generate_words.c
+int preparer_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire, Normalisation normalisation);
+Grammaire *charger_grammaire(const char *fichier_grammaire, const OptionsGeneration *options);
+CurseurLex *curseur_pour_longueur(CurseurLex *curseur, const GrammaireIndexee *indexee, int longueur);
+int sortie_ouvrir(SortieMots *sortie, const char *nom_fichier, FormatSortie format);
+int sortie_reprendre(SortieMots *sortie, const char *nom_fichier, long octets);
+int sortie_ecrire(SortieMots *sortie, const char *mot, size_t longueur);
+int sortie_fermer(SortieMots *sortie);
+char **decomposer_mot(const char *mot, int *nombre_de_symboles);
+int est_terminal(const char *symbole);
+int trouver_productions(const char *non_terminal, Grammaire *grammaire, char productions[MAX_RULES][MAX_SYMBOLS]);
+void generer_mots_recursif(const char *forme_courante, int longueur_max, Grammaire *grammaire, int profondeur_max,
+                           TriExterne *tri, ListeMots *mots);
+
+// grammaire_indexee.c
+int indexer_grammaire(const Grammaire *grammaire, GrammaireIndexee *indexee);
+int lire_poids(GrammaireIndexee *indexee, const char *fichier);
+void liberer_grammaire_indexee(GrammaireIndexee *indexee);
+int automate_grammaire_indexee(const GrammaireIndexee *indexee, Automate *automate);
+
+// comptage.c
+int comptage_construire(TableComptage *table, const GrammaireIndexee *grammaire, int longueur_max);
+double comptage_non_terminal(const TableComptage *table, int non_terminal, int longueur);
+void comptage_liberer(TableComptage *table);
+int comptage_exact_construire(TableExacte *table, const GrammaireIndexee *grammaire, int longueur_max);
+const GrandEntier *comptage_exact_non_terminal(const TableExacte *table, int non_terminal, int longueur);
+void comptage_exact_liberer(TableExacte *table);
+void aleatoire_init(Aleatoire *aleatoire, unsigned long long graine);
+double aleatoire_reel(Aleatoire *aleatoire);
+int echantillonner_mot(const TableComptage *table, int longueur, Aleatoire *aleatoire, char *mot);
+
+// fini.c
+int langage_fini_construire(LangageFini *langage, const GrammaireIndexee *grammaire);
+long langage_fini_chercher(const LangageFini *langage, const char *mot);
+void langage_fini_liberer(LangageFini *langage);
+
+// rang.c
+CurseurLex *curseur_lex_creer(const GrammaireIndexee *grammaire, int longueur_max);
+void curseur_lex_liberer(CurseurLex *curseur);
+int curseur_lex_longueur_max(const CurseurLex *curseur);
+const GrandEntier *curseur_lex_total(const CurseurLex *curseur, int longueur);
+int curseur_lex_positionner(CurseurLex *curseur, int longueur, const GrandEntier *k);
+int curseur_lex_suivant(CurseurLex *curseur);
+const char *curseur_lex_mot(const CurseurLex *curseur);
+void curseur_lex_rangs(const CurseurLex *curseur, GrandEntier *debut, GrandEntier *multiplicite);
+int curseur_lex_rang(CurseurLex *curseur, const char *mot, GrandEntier *rang, GrandEntier *multiplicite);
+
+// iterateur.c
+IterateurMots *iterateur_ouvrir(const Grammaire *grammaire, int longueur_max, OrdreIteration ordre);
+int iterateur_suivant(IterateurMots *iterateur, const char **mot, size_t *longueur);
+void iterateur_annuler(IterateurMots *iterateur);
+void iterateur_fermer(IterateurMots *iterateur);
+int iterateur_sauvegarder(const IterateurMots *iterateur, FILE *flux);
+int iterateur_restaurer(IterateurMots *iterateur, FILE *flux);
+
+// reprise.c
+int reprise_ecrire(const char *fichier, const Grammaire *grammaire, int longueur_max, OrdreIteration ordre,
+                   const IterateurMots *iterateur, SortieMots *sortie, unsigned long long mots);
+int reprise_lire(const char *fichier, const Grammaire *grammaire, int longueur_max, OrdreIteration ordre,
+                 IterateurMots *iterateur, unsigned long long *mots, long *octets);
+
+// equivalence.c
+int comparer_langages(const Grammaire *premiere, const Grammaire *seconde, int longueur_max, ComparaisonLangages *resultat);
+
+// service.c
+int servir(const char *chemin);
+int interroger_service(const char *chemin, const char *commande, const char *grammaire, const char *argument,
+                       Normalisation forme);
+
+// parallele.c
+int generer_mots_parallele(Grammaire *grammaire, int longueur_max, int nb_threads, TriExterne *tri, ListeMots *tampons);
+
+#endif
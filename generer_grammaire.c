@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "synthese.h"
+
+void afficher_usage(const char *programme) {
+    fprintf(stderr, "Usage : %s [--graine=S] [--regles=N] [--productions=P] [--longueur=L] [--terminaux=T]\n"
+                    "       [--epsilon=D] [--unites=U] [--recursivite=R] [fichier.general]\n", programme);
+    fprintf(stderr, "Écrit une grammaire synthétique (sortie standard par défaut).\n");
+}
+
+// Lire une valeur d'option entière ou réelle ; renvoie -1 si elle n'est pas entièrement un nombre
+static int lire_entier(const char *valeur, int *entier) {
+    char *fin;
+    long nombre = strtol(valeur, &fin, 10);
+    if (fin == valeur || *fin != '\0' || nombre < INT_MIN || nombre > INT_MAX) return -1;
+    *entier = (int)nombre;
+    return 0;
+}
+
+static int lire_reel(const char *valeur, double *reel) {
+    char *fin;
+    *reel = strtod(valeur, &fin);
+    return fin == valeur || *fin != '\0' ? -1 : 0;
+}
+
+int main(int argc, char *argv[]) {
+    ParametresSynthese parametres;
+    parametres_synthese_defaut(&parametres);
+    const char *fichier = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *valeur = strchr(argv[i], '=');
+        if (valeur) valeur++;
+        int statut = 0;
+        if (strncmp(argv[i], "--graine=", 9) == 0) {
+            char *fin;
+            parametres.graine = strtoull(valeur, &fin, 10);
+            if (*valeur < '0' || *valeur > '9' || *fin != '\0') statut = -1;
+        } else if (strncmp(argv[i], "--regles=", 9) == 0) {
+            statut = lire_entier(valeur, &parametres.regles);
+        } else if (strncmp(argv[i], "--productions=", 14) == 0) {
+            statut = lire_entier(valeur, &parametres.productions);
+        } else if (strncmp(argv[i], "--longueur=", 11) == 0) {
+            statut = lire_entier(valeur, &parametres.longueur);
+        } else if (strncmp(argv[i], "--terminaux=", 12) == 0) {
+            statut = lire_entier(valeur, &parametres.terminaux);
+        } else if (strncmp(argv[i], "--epsilon=", 10) == 0) {
+            statut = lire_reel(valeur, &parametres.epsilon);
+        } else if (strncmp(argv[i], "--unites=", 9) == 0) {
+            statut = lire_entier(valeur, &parametres.unites);
+        } else if (strncmp(argv[i], "--recursivite=", 14) == 0) {
+            statut = lire_entier(valeur, &parametres.recursivite);
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            afficher_usage(argv[0]);
+            return -1;
+        } else if (!fichier) {
+            fichier = argv[i];
+        } else {
+            afficher_usage(argv[0]);
+            return -1;
+        }
+        if (statut == -1) {
+            fprintf(stderr, "Erreur : valeur invalide : %s\n", argv[i]);
+            return -1;
+        }
+    }
+    // Vérifier avant d'ouvrir la sortie, pour ne pas écraser le fichier avec une grammaire vide
+    if (verifier_parametres_synthese(&parametres) == -1) return -1;
+
+    FILE *sortie = fichier ? fopen(fichier, "w") : stdout;
+    if (sortie == NULL) {
+        perror("Erreur lors de l'ouverture du fichier");
+        return -1;
+    }
+    int statut = generer_grammaire_synthetique(sortie, &parametres);
+    if (fichier && fclose(sortie) != 0) {
+        perror("Erreur lors de l'écriture du fichier");
+        statut = -1;
+    }
+    return statut == 0 ? 0 : 1;
+}
@@ -1,1275 +1,692 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h> // Pour isupper()
-#include <stdbool.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
-
-#define MAX_RULES 100
-#define MAX_SYMBOLS 100 // Augmentation de MAX_SYMBOLS si nécessaire
-#define MAX_NON_TERMINAUX 250
-
-typedef struct {
-    char non_terminal[MAX_SYMBOLS]; // Stocke une chaîne pour le non-terminal
-    char productions[MAX_RULES][MAX_SYMBOLS]; // Productions associées
-    int production_count; // Nombre de productions
-} Rule;
+#include "libgrammaire.h"
+#include "cache.h"
+#include "rapport.h"
 
 typedef struct {
-    Rule rules[MAX_RULES]; // Ensemble des règles
-    int rule_count; // Nombre de règles
-} Grammaire;
-
-// Fonction pour nettoyer une chaîne de caractères (supprimer les espaces)
-void nettoyer_chaine(char *str) {
-    char *src = str, *dst = str;
-    while (*src) {
-        if (*src != ' ') {
-            *dst++ = *src;
-        }
-        src++;
-    }
-    *dst = '\0';
-}
-// Fonction pour vérifier si un symbole est un non-terminal
-int isNonTerminal(const char *symbol) {
-    // Vérifie que la chaîne est de longueur 2, le premier caractère est une majuscule
-    // et le second est un chiffre.
-    return strlen(symbol) == 2 && isupper(symbol[0]) && isdigit(symbol[1]);
-}
-// Vérifie si un non-terminal existe déjà dans la grammaire
-int non_terminal_exists(const Grammaire *grammaire, const char *non_terminal) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        if (strcmp(grammaire->rules[i].non_terminal, non_terminal) == 0) {
-            return 1; // Le non-terminal existe
-        }
-    }
-    return 0; // Le non-terminal n'existe pas
-}
-
-// Fonction pour générer un nouveau non-terminal unique
-void generate_non_terminal(char *result, const Grammaire *grammaire) {
-    static int letter_index = 25; // Commencer par 'Z'
-    static int number_index = 9;  // Commencer par 9
-    int attempts = 0;
-
-    printf("Début : letter_index=%d, number_index=%d\n", letter_index, number_index);
-
-    do {
-        snprintf(result, MAX_SYMBOLS, "%c%d", 'A' + letter_index, number_index);
-
-        if (--number_index < 0) {
-            number_index = 9;
-            if (--letter_index < 0) {
-                fprintf(stderr, "Erreur : Limite de non-terminaux atteinte (A0 à Z9 épuisés).\n");
-                exit(EXIT_FAILURE);
+    const TraceGrammaire *trace;   // NULL : conversions silencieuses
+    const CacheGrammaires *cache;  // NULL sans cache
+    int modulaire;                 // Normaliser composante par composante (normaliser_modulaire)
+    int threads_composantes;       // Threads de normaliser_modulaire, thread appelant compris
+    int ll1;                       // Analyser la sortie de Greibach (analyser_ll1)
+    int lalr;                      // Analyser la grammaire d'entrée (analyser_lalr)
+    int emettre_c;                 // Écrire un reconnaisseur C (analyser_emission)
+} OptionsNormalisation;
+
+// Lire un fichier, le mettre sous une forme normale et sauvegarder le résultat à côté.
+// Chaque appel a son propre contexte : les deux formes d'un même fichier sont indépendantes.
+// Avec un cache, une grammaire déjà normalisée n'est pas recalculée (*depuis_cache vaut alors 1) ;
+// en mode modulaire, les composantes déjà vues ne le sont pas non plus (bilan, facultatif).
+// Avec mesures, la lecture (étape 0) et chaque étape y sont mesurées.
+// Une grammaire régulière est normalisée depuis son automate minimal (normaliser_reguliere) :
+// *etats_automate (facultatif) reçoit alors son nombre d'états, sinon 0.
+int normaliser_fichier(const char *fichier, FormeNormale forme, const OptionsNormalisation *options,
+                       int *depuis_cache, BilanModulaire *bilan, int *etats_automate, MesuresConversion *mesures,
+                       char *message, size_t taille_message) {
+    const CacheGrammaires *cache = options->cache;
+    ContexteGrammaire ctx;
+    contexte_grammaire_init(&ctx);
+    ctx.trace = options->trace;
+    if (mesures) {
+        ctx.mesure = enregistrer_mesure;
+        ctx.donnees_mesure = mesures;
+    }
+    double depart = horloge_grammaire();
+
+    Grammaire *grammaire = malloc(sizeof(Grammaire));
+    if (!grammaire) {
+        snprintf(message, taille_message, "Mémoire insuffisante.");
+        return GRAMMAIRE_ERREUR_MEMOIRE;
+    }
+
+    char base[4096];
+    nom_base_sortie(fichier, base, sizeof(base));
+    int statut = lire_grammaire(&ctx, grammaire, fichier);
+    if (statut == GRAMMAIRE_OK && grammaire->rule_count == 0) {
+        snprintf(message, taille_message, "Grammaire vide : %s", fichier);
+        free(grammaire);
+        return GRAMMAIRE_ERREUR_FORMAT;
+    }
+    if (statut == GRAMMAIRE_OK) statut = rewriter_grammaire(&ctx, grammaire);
+    if (statut == GRAMMAIRE_OK) contexte_grammaire_mesurer(&ctx, "Lecture", 0, depart, 0, grammaire);
+
+    const char *extension = forme == FORME_GREIBACH ? "greibach" : "chomsky";
+    char sortie[4200];
+    snprintf(sortie, sizeof(sortie), "%s.%s", base, extension);
+    *depuis_cache = 0;
+    int etats = 0;
+    if (etats_automate) *etats_automate = 0;
+    CleCache cle = { "", NULL, 0 };
+    if (statut == GRAMMAIRE_OK && cache && cache_calculer_cle(grammaire, options->modulaire ? "modulaire" : NULL, &cle) == 0 &&
+        cache_chercher(cache, &cle, extension, sortie) == 1) {
+        *depuis_cache = 1;
+        cache_liberer_cle(&cle);
+        free(grammaire);
+        return GRAMMAIRE_OK;
+    }
+
+    if (statut == GRAMMAIRE_OK) {
+        if (options->modulaire) {
+            // L'axiome est copié : les étapes déplacent les règles
+            char axiome[MAX_SYMBOLS];
+            strcpy(axiome, grammaire->rules[0].non_terminal);
+            // Une grammaire régulière sort directement de son automate minimal
+            statut = normaliser_reguliere(&ctx, grammaire, axiome, forme, &etats);
+            if (statut == GRAMMAIRE_OK && etats == 0) {
+                MemoComposantes memo;
+                if (cache) memo = cache_memo_composantes(cache);
+                statut = normaliser_modulaire(&ctx, grammaire, axiome, forme, cache ? &memo : NULL,
+                                              options->threads_composantes, bilan);
             }
-        }
-
-        attempts++;
-        if (attempts > MAX_NON_TERMINAUX) {
-            fprintf(stderr, "Erreur : Trop de tentatives pour générer un nouveau non-terminal.\n");
-            exit(EXIT_FAILURE);
-        }
-
-        printf("Généré : %s\n", result); // Affiche le non-terminal généré
-    } while (non_terminal_exists(grammaire, result));
-
-    printf("Fin : letter_index=%d, number_index=%d\n", letter_index, number_index);
-}
-// Fonction pour lire une grammaire depuis un fichier
-int lire_grammaire(Grammaire *grammaire, const char *filename) {
-    grammaire->rule_count = 0;
-
-    FILE *file = fopen(filename, "r");
-    if (file == NULL) {
-        perror("Erreur lors de l'ouverture du fichier");
-        return -1;
-    }
-
-    char line[256];
-    while (fgets(line, sizeof(line), file)) {
-        line[strcspn(line, "\n")] = '\0'; // Supprime le saut de ligne
-        nettoyer_chaine(line);           // Nettoyer les espaces inutiles
-
-        if (strlen(line) == 0) {
-            continue;
-        }
-
-        Rule rule;
-        rule.production_count = 0;
-
-        char *token = strtok(line, ":");
-        if (token == NULL) {
-            fprintf(stderr, "Erreur : Format incorrect : %s\n", line);
-            fclose(file);
-            return -1;
-        }
-        strcpy(rule.non_terminal, token);
-
-        token = strtok(NULL, "|");
-        while (token != NULL) {
-            nettoyer_chaine(token); // Nettoyer chaque production
-            strcpy(rule.productions[rule.production_count++], token);
-            token = strtok(NULL, "|");
-        }
-
-        grammaire->rules[grammaire->rule_count++] = rule;
-    }
-
-    fclose(file);
-    return 0;
-}
-
-
-int prefix_common_length(const char *str1, const char *str2) {
-    int len = 0;
-    while (str1[len] != '\0' && str2[len] != '\0' && str1[len] == str2[len]) {
-        len++;
-    }
-    return len;
-}
-
-// Factoriser deux productions ayant un préfixe commun
-int factoriser_productions(char *prod1, char *prod2, Grammaire *grammaire) {
-    int prefix_len = prefix_common_length(prod1, prod2);
-
-    if (prefix_len > 0) {
-        char new_non_terminal[MAX_SYMBOLS];
-        generate_non_terminal(new_non_terminal, grammaire); // Appel mis à jour
-
-        Rule new_rule;
-        strcpy(new_rule.non_terminal, new_non_terminal);
-        new_rule.production_count = 0;
-
-        // Ajouter les suffixes après le préfixe à la nouvelle règle
-        if (strlen(prod1) > prefix_len) {
-            strcpy(new_rule.productions[new_rule.production_count++], prod1 + prefix_len);
         } else {
-            strcpy(new_rule.productions[new_rule.production_count++], "E");
-        }
-
-        if (strlen(prod2) > prefix_len) {
-            strcpy(new_rule.productions[new_rule.production_count++], prod2 + prefix_len);
-        } else {
-            strcpy(new_rule.productions[new_rule.production_count++], "E");
-        }
-
-        // Ajouter la nouvelle règle dans la grammaire
-        grammaire->rules[grammaire->rule_count++] = new_rule;
-
-        // Mettre à jour prod1 pour inclure uniquement le préfixe + nouveau non-terminal
-        snprintf(prod1, MAX_SYMBOLS, "%.*s%s", prefix_len, prod1, new_non_terminal);
-
-        // Effacer prod2 car elle a été intégrée dans la nouvelle règle
-        strcpy(prod2, prod1);
-
-        return 1;
-    }
-
-    return 0;
-}
-
-// Appliquer la factorisation sur une règle
-void factoriser_rule(Rule *rule, Grammaire *grammaire) {
-    for (int i = 0; i < rule->production_count; i++) {
-        for (int j = i + 1; j < rule->production_count; j++) {
-            // Tenter de factoriser les deux productions
-            if (factoriser_productions(rule->productions[i], rule->productions[j], grammaire)) {
-                // Supprimer la production à l'indice `j` car elle a été absorbée
-                for (int k = j; k < rule->production_count - 1; k++) {
-                    strcpy(rule->productions[k], rule->productions[k + 1]);
-                }
-                rule->production_count--;
-                j--; // Réexaminer la position actuelle
-            }
+            statut = normaliser_grammaire(&ctx, grammaire, forme, &etats);
         }
+        if (statut == GRAMMAIRE_OK) statut = sauvegarder_grammaire(&ctx, grammaire, base, forme == FORME_GREIBACH ? 'g' : 'c');
+        if (statut == GRAMMAIRE_OK && etats_automate) *etats_automate = etats;
     }
+    // Un échec du cache n'empêche pas la sortie d'être correcte : il est seulement signalé
+    if (statut == GRAMMAIRE_OK && cle.canonique) cache_ranger(cache, &cle, extension, sortie);
+    if (statut != GRAMMAIRE_OK) snprintf(message, taille_message, "%s", contexte_grammaire_message(&ctx));
+    cache_liberer_cle(&cle);
+    free(grammaire);
+    return statut;
 }
 
-
-
-// Appliquer la factorisation à toute la grammaire
-void factoriser(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        factoriser_rule(rule, grammaire);
-    }
-}
-
-
-
-
-
-// Supprimer epsilon
- void supprimer_epsilon(Grammaire *grammaire, const char *axiome) {
-    int epsilon_non_terminals[MAX_RULES] = {0};
-    int changes;
-
-    // Étape 1 : Identifier les non-terminaux produisant epsilon directement ou indirectement
-    do {
-        changes = 0;
-        for (int i = 0; i < grammaire->rule_count; i++) {
-            if (epsilon_non_terminals[i]) continue; // Déjà marqué comme epsilon
-            Rule *rule = &grammaire->rules[i];
-            for (int j = 0; j < rule->production_count; j++) {
-                if (strcmp(rule->productions[j], "E") == 0) {
-                    epsilon_non_terminals[i] = 1;
-                    changes = 1;
-                    break;
-                }
-                // Vérifier si toutes les parties de la production peuvent produire epsilon
-                int all_epsilon = 1;
-                for (int k = 0; k < strlen(rule->productions[j]); k += 2) {
-                    char non_terminal[3] = {rule->productions[j][k], rule->productions[j][k + 1], '\0'};
-                    int found = 0;
-                    for (int l = 0; l < grammaire->rule_count; l++) {
-                        if (strcmp(grammaire->rules[l].non_terminal, non_terminal) == 0) {
-                            if (epsilon_non_terminals[l]) {
-                                found = 1;
-                                break;
-                            }
-                        }
-                    }
-                    if (!found) {
-                        all_epsilon = 0;
-                        break;
-                    }
-                }
-                if (all_epsilon) {
-                    epsilon_non_terminals[i] = 1;
-                    changes = 1;
-                    break;
-                }
-            }
-        }
-    } while (changes);
-
-    // Étape 2 : Ajouter des variantes en remplaçant les epsilon-productions
-    do {
-        changes = 0; // Réinitialiser l'indicateur de modifications
-        for (int i = 0; i < grammaire->rule_count; i++) {
-            Rule *rule = &grammaire->rules[i];
-            int original_count = rule->production_count;
-
-            for (int j = 0; j < original_count; j++) {
-                char *prod = rule->productions[j];
-
-                // Générer toutes les combinaisons en remplaçant les non-terminaux epsilon
-                for (int k = 0; k < grammaire->rule_count; k++) {
-                    if (epsilon_non_terminals[k]) {
-                        char *non_terminal = grammaire->rules[k].non_terminal;
-                        char *found = strstr(prod, non_terminal);
-                        while (found) {
-                            char new_production[MAX_SYMBOLS] = "";
-
-                            // Partie avant le non-terminal
-                            strncpy(new_production, prod, found - prod);
-                            new_production[found - prod] = '\0';
-
-                            // Partie après le non-terminal
-                            strcat(new_production, found + strlen(non_terminal));
-
-                            // Ajouter la nouvelle production si elle n'existe pas déjà
-                            int exists = 0;
-                            for (int l = 0; l < rule->production_count; l++) {
-                                if (strcmp(rule->productions[l], new_production) == 0) {
-                                    exists = 1;
-                                    break;
-                                }
-                            }
-                            if (!exists && strlen(new_production) > 0) {
-                                strcpy(rule->productions[rule->production_count++], new_production);
-                                changes = 1; // Une modification a été effectuée
-                            }
-
-                            // Chercher la prochaine occurrence
-                            found = strstr(found + 1, non_terminal);
-                        }
-                    }
-                }
-            }
-        }
-    } while (changes);
-
-    // Étape 3 : Supprimer explicitement les productions contenant uniquement epsilon
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        if (strcmp(rule->non_terminal, axiome) != 0) {
-            for (int j = 0; j < rule->production_count;) {
-                if (strcmp(rule->productions[j], "E") == 0) {
-                    for (int k = j; k < rule->production_count - 1; k++) {
-                        strcpy(rule->productions[k], rule->productions[k + 1]);
-                    }
-                    rule->production_count--;
-                } else {
-                    j++;
-                }
-            }
-        }
-    }
-
-    // Étape 4 : Supprimer les règles inutiles
-    for (int i = 0; i < grammaire->rule_count;) {
-        Rule *rule = &grammaire->rules[i];
-        if (rule->production_count == 0 && strcmp(rule->non_terminal, axiome) != 0) {
-            char non_terminal_to_remove[MAX_SYMBOLS];
-            strcpy(non_terminal_to_remove, rule->non_terminal);
-
-            // Supprimer cette règle
-            for (int j = i; j < grammaire->rule_count - 1; j++) {
-                grammaire->rules[j] = grammaire->rules[j + 1];
-            }
-            grammaire->rule_count--;
-
-            // Supprimer les références dans les autres règles
-            for (int j = 0; j < grammaire->rule_count; j++) {
-                Rule *other_rule = &grammaire->rules[j];
-                for (int k = 0; k < other_rule->production_count;) {
-                    if (strstr(other_rule->productions[k], non_terminal_to_remove)) {
-                        for (int l = k; l < other_rule->production_count - 1; l++) {
-                            strcpy(other_rule->productions[l], other_rule->productions[l + 1]);
-                        }
-                        other_rule->production_count--;
-                    } else {
-                        k++;
-                    }
-                }
-            }
+typedef struct {
+    int faite;
+    int conflits;
+    char detail[256];              // Table écrite, ou premier conflit
+} ResultatAnalyse;
+
+// Ouvrir le fichier d'une table ; comme pour sauvegarder_grammaire, un lien existant
+// n'est pas suivi
+FILE *ouvrir_table(const char *chemin, char *message, size_t taille_message) {
+    unlink(chemin);
+    FILE *fichier = fopen(chemin, "w");
+    if (!fichier) snprintf(message, taille_message, "Erreur lors de l'ouverture du fichier %s", chemin);
+    return fichier;
+}
+
+int fermer_table(FILE *fichier, int statut, const char *chemin, char *message, size_t taille_message) {
+    if (fclose(fichier) != 0) statut = GRAMMAIRE_ERREUR_FICHIER;
+    if (statut != GRAMMAIRE_OK) snprintf(message, taille_message, "Erreur d'écriture dans %s.", chemin);
+    return statut;
+}
+
+// Lire une grammaire pour l'analyser
+int lire_pour_analyse(const char *chemin, int regrouper, Grammaire **grammaire, ContexteGrammaire *ctx,
+                      char *message, size_t taille_message) {
+    contexte_grammaire_init(ctx);
+    *grammaire = malloc(sizeof(Grammaire));
+    if (!*grammaire) {
+        snprintf(message, taille_message, "Mémoire insuffisante.");
+        return GRAMMAIRE_ERREUR_MEMOIRE;
+    }
+    int statut = lire_grammaire(ctx, *grammaire, chemin);
+    if (statut == GRAMMAIRE_OK && regrouper) statut = rewriter_grammaire(ctx, *grammaire);
+    if (statut != GRAMMAIRE_OK) {
+        snprintf(message, taille_message, "%s", contexte_grammaire_message(ctx));
+        free(*grammaire);
+    }
+    return statut;
+}
+
+// Analyse LL(1) de la sortie de Greibach <base>.greibach : sans conflit, la table est
+// écrite dans <base>.ll1, sinon le premier conflit est décrit
+int analyser_ll1(const char *base, ResultatAnalyse *resultat, char *message, size_t taille_message) {
+    ContexteGrammaire ctx;
+    Grammaire *grammaire;
+    char chemin[4200];
+    snprintf(chemin, sizeof(chemin), "%s.greibach", base);
+    int statut = lire_pour_analyse(chemin, 0, &grammaire, &ctx, message, taille_message);
+    if (statut != GRAMMAIRE_OK) return statut;
+    TableLL1 table;
+    statut = construire_table_ll1(&ctx, grammaire, &table);
+    free(grammaire);
+    if (statut != GRAMMAIRE_OK) {
+        snprintf(message, taille_message, "%s", contexte_grammaire_message(&ctx));
+        return statut;
+    }
+
+    resultat->faite = 1;
+    resultat->conflits = table.nb_conflits;
+    if (table.nb_conflits > 0) {
+        decrire_conflit_ll1(&table, &table.conflits[0], resultat->detail, sizeof(resultat->detail));
+    } else {
+        snprintf(chemin, sizeof(chemin), "%s.ll1", base);
+        snprintf(resultat->detail, sizeof(resultat->detail), "table %s", chemin);
+        FILE *fichier = ouvrir_table(chemin, message, taille_message);
+        statut = fichier ? fermer_table(fichier, ecrire_table_ll1(fichier, &table), chemin, message, taille_message)
+                         : GRAMMAIRE_ERREUR_FICHIER;
+    }
+    liberer_table_ll1(&table);
+    return statut;
+}
+
+// Analyse LALR(1) de la grammaire d'entrée : sans conflit, les tables compressées sont
+// écrites dans <base>.lalr
+int analyser_lalr(const char *fichier_grammaire, const char *base, ResultatAnalyse *resultat, char *message,
+                  size_t taille_message) {
+    ContexteGrammaire ctx;
+    Grammaire *grammaire;
+    int statut = lire_pour_analyse(fichier_grammaire, 1, &grammaire, &ctx, message, taille_message);
+    if (statut != GRAMMAIRE_OK) return statut;
+    TableLALR table;
+    statut = construire_table_lalr(&ctx, grammaire, &table);
+    free(grammaire);
+    if (statut != GRAMMAIRE_OK) {
+        snprintf(message, taille_message, "%s", contexte_grammaire_message(&ctx));
+        return statut;
+    }
+
+    resultat->faite = 1;
+    resultat->conflits = table.nb_conflits;
+    if (table.nb_conflits > 0) {
+        decrire_conflit_lalr(&table, &table.conflits[0], resultat->detail, sizeof(resultat->detail));
+    } else {
+        char chemin[4200];
+        snprintf(chemin, sizeof(chemin), "%s.lalr", base);
+        snprintf(resultat->detail, sizeof(resultat->detail), "%d états, table %s", table.nb_etats, chemin);
+        FILE *fichier = ouvrir_table(chemin, message, taille_message);
+        statut = fichier ? fermer_table(fichier, ecrire_table_lalr(fichier, &table), chemin, message, taille_message)
+                         : GRAMMAIRE_ERREUR_FICHIER;
+    }
+    liberer_table_lalr(&table);
+    return statut;
+}
+
+// Nom de la fonction d'un reconnaisseur : le nom de fichier de la base, sans répertoire ni
+// ".Transforme", réduit aux caractères d'un identificateur C
+void nom_reconnaisseur(const char *base, char *nom, size_t taille) {
+    const char *debut = strrchr(base, '/');
+    debut = debut ? debut + 1 : base;
+    size_t longueur = strlen(debut), suffixe = strlen(".Transforme"), n = 0;
+    if (longueur > suffixe && strcmp(debut + longueur - suffixe, ".Transforme") == 0) longueur -= suffixe;
+    if (longueur == 0 || isdigit((unsigned char)debut[0])) nom[n++] = '_';
+    for (size_t i = 0; i < longueur && n + 1 < taille; i++) {
+        unsigned char c = (unsigned char)debut[i];
+        nom[n++] = isalnum(c) && c < 128 ? (char)c : '_';
+    }
+    nom[n] = '\0';
+}
+
+// Reconnaisseur C autonome de la grammaire, écrit dans <base>.c, par la première méthode
+// qui convient : automate minimal de la grammaire d'entrée si elle est régulière, analyse
+// LL(1) de <base>.greibach ou LALR(1) de la grammaire d'entrée sans conflit, et sinon CYK
+// sur <base>.chomsky
+int analyser_emission(const char *fichier_grammaire, const char *base, ResultatAnalyse *resultat, char *message,
+                      size_t taille_message) {
+    ContexteGrammaire ctx;
+    Grammaire *grammaire;
+    char chemin[4200], nom[128];
+    nom_reconnaisseur(base, nom, sizeof(nom));
+    snprintf(chemin, sizeof(chemin), "%s.c", base);
+    int statut = lire_pour_analyse(fichier_grammaire, 1, &grammaire, &ctx, message, taille_message);
+    if (statut != GRAMMAIRE_OK) return statut;
+
+    Automate automate;
+    int reguliere = 0, ecrite = 0;
+    FILE *fichier = NULL;
+    statut = compiler_grammaire_reguliere(&ctx, grammaire, EMISSION_MAX_ETATS, &automate, &reguliere);
+    if (statut == GRAMMAIRE_OK && reguliere) {
+        fichier = ouvrir_table(chemin, message, taille_message);
+        statut = fichier ? fermer_table(fichier, emettre_automate_c(fichier, nom, &automate), chemin, message, taille_message)
+                         : GRAMMAIRE_ERREUR_FICHIER;
+        snprintf(resultat->detail, sizeof(resultat->detail), "automate minimal de %d état%s, %s", automate.nb_etats,
+                 automate.nb_etats > 1 ? "s" : "", chemin);
+        liberer_automate(&automate);
+        ecrite = 1;
+    }
+
+    if (statut == GRAMMAIRE_OK && !ecrite) {
+        TableLALR lalr;
+        statut = construire_table_lalr(&ctx, grammaire, &lalr);
+        if (statut == GRAMMAIRE_OK) {
+            // La table LL(1) de la sortie de Greibach, plus simple, passe avant
+            char greibach[4200];
+            Grammaire *sortie;
+            ContexteGrammaire ctx_sortie;
+            TableLL1 ll1;
+            int construite = 0;
+            snprintf(greibach, sizeof(greibach), "%s.greibach", base);
+            statut = lire_pour_analyse(greibach, 0, &sortie, &ctx_sortie, message, taille_message);
+            if (statut == GRAMMAIRE_OK) {
+                statut = construire_table_ll1(&ctx_sortie, sortie, &ll1);
+                if (statut != GRAMMAIRE_OK) snprintf(message, taille_message, "%s", contexte_grammaire_message(&ctx_sortie));
+                construite = statut == GRAMMAIRE_OK;
+                free(sortie);
+            }
+            if (construite && (ll1.nb_conflits == 0 || lalr.nb_conflits == 0)) {
+                fichier = ouvrir_table(chemin, message, taille_message);
+                if (!fichier) statut = GRAMMAIRE_ERREUR_FICHIER;
+                else if (ll1.nb_conflits == 0) statut = fermer_table(fichier, emettre_ll1_c(fichier, nom, &ll1), chemin, message, taille_message);
+                else statut = fermer_table(fichier, emettre_lalr_c(fichier, nom, &lalr), chemin, message, taille_message);
+                if (ll1.nb_conflits == 0) snprintf(resultat->detail, sizeof(resultat->detail), "analyse LL(1), %s", chemin);
+                else snprintf(resultat->detail, sizeof(resultat->detail), "analyse LALR(1) de %d états, %s", lalr.nb_etats, chemin);
+                ecrite = 1;
+            }
+            if (construite) liberer_table_ll1(&ll1);
+            liberer_table_lalr(&lalr);
         } else {
-            i++;
-        }
-    }
-
-    // Étape supplémentaire : Ajouter E à l'axiome s'il peut produire epsilon
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        if (strcmp(rule->non_terminal, axiome) == 0) {
-            if (epsilon_non_terminals[i]) {
-                int already_has_epsilon = 0;
-                for (int j = 0; j < rule->production_count; j++) {
-                    if (strcmp(rule->productions[j], "E") == 0) {
-                        already_has_epsilon = 1;
-                        break;
-                    }
-                }
-                if (!already_has_epsilon) {
-                    strcpy(rule->productions[rule->production_count++], "E");
-                }
-            }
-        }
-    }
-}
-void nettoyer_grammaire(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        int is_used = 0;
-        for (int j = 0; j < grammaire->rule_count; j++) {
-            if (i != j) {
-                for (int k = 0; k < grammaire->rules[j].production_count; k++) {
-                    if (strstr(grammaire->rules[j].productions[k], rule->non_terminal)) {
-                        is_used = 1;
-                        break;
-                    }
-                }
-            }
-            if (is_used) break;
-        }
-        if (!is_used && rule->production_count == 0) {
-            for (int j = i; j < grammaire->rule_count - 1; j++) {
-                grammaire->rules[j] = grammaire->rules[j + 1];
-            }
-            grammaire->rule_count--;
-            i--;
+            snprintf(message, taille_message, "%s", contexte_grammaire_message(&ctx));
         }
+    } else if (statut != GRAMMAIRE_OK) {
+        snprintf(message, taille_message, "%s", contexte_grammaire_message(&ctx));
     }
-}
-void supprimer_unite(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        int index = 0;
-
-        // Parcourir les productions
-        while (index < rule->production_count) {
-            char *prod = rule->productions[index];
-
-            // Vérifier si c'est une règle unité (une lettre majuscule suivie d'un chiffre)
-            if (strlen(prod) > 1 && isupper(prod[0]) && isdigit(prod[1])) {
-                char target_non_terminal[MAX_SYMBOLS];
-                strcpy(target_non_terminal, prod);
-
-                // Trouver la règle associée
-                int found = 0;
-                for (int j = 0; j < grammaire->rule_count; j++) {
-                    if (strcmp(grammaire->rules[j].non_terminal, target_non_terminal) == 0) {
-                        Rule *target_rule = &grammaire->rules[j];
-                        found = 1;
-
-                        // Ajouter les productions de la règle cible à la règle courante
-                        for (int k = 0; k < target_rule->production_count; k++) {
-                            char *new_prod = target_rule->productions[k];
-
-                            // Vérifier si la production existe déjà
-                            int exists = 0;
-                            for (int l = 0; l < rule->production_count; l++) {
-                                if (strcmp(rule->productions[l], new_prod) == 0) {
-                                    exists = 1;
-                                    break;
-                                }
-                            }
-
-                            // Ajouter la production si elle n'existe pas encore
-                            if (!exists && rule->production_count < MAX_RULES) {
-                                strcpy(rule->productions[rule->production_count++], new_prod);
-                            }
-                        }
-                        break;
-                    }
-                }
-
-                // Si la règle associée est trouvée, supprimer la règle unité
-                if (found) {
-                    for (int k = index; k < rule->production_count - 1; k++) {
-                        strcpy(rule->productions[k], rule->productions[k + 1]);
-                    }
-                    rule->production_count--;
-                } else {
-                    index++; // Passer à la production suivante si aucune règle associée
-                }
-            } else {
-                index++; // Passer à la production suivante si ce n'est pas une règle unité
-            }
-        }
-    }
-}
-void supprimer_non_terminaux_en_tete(Grammaire *grammaire) {
-    int changes;
-
-    do {
-        changes = 0; // Indicateur de modifications
-
-        for (int i = 0; i < grammaire->rule_count; i++) {
-            Rule *rule = &grammaire->rules[i];
-
-            for (int j = 0; j < rule->production_count; j++) {
-                char *prod = rule->productions[j];
-
-                // Identifier si le premier symbole est un non-terminal valide (Majuscule + Chiffre uniquement)
-                if (strlen(prod) > 1 && isupper(prod[0]) && isdigit(prod[1])) {
-                    char non_terminal_tete[MAX_SYMBOLS] = {0};
-
-                    // Extraire le non-terminal (ex: "A0")
-                    snprintf(non_terminal_tete, 3, "%c%c", prod[0], prod[1]);
+    free(grammaire);
 
-                    // Vérifier si ce non-terminal existe dans les règles
-                    int found = 0;
-                    for (int l = 0; l < grammaire->rule_count; l++) {
-                        if (strcmp(grammaire->rules[l].non_terminal, non_terminal_tete) == 0) {
-                            found = 1;
-                            Rule *target_rule = &grammaire->rules[l];
-
-                            // Remplacer le non-terminal en tête par ses productions
-                            for (int m = 0; m < target_rule->production_count; m++) {
-                                char nouvelle_production[MAX_SYMBOLS];
-
-                                // Construire la nouvelle production
-                                snprintf(nouvelle_production, sizeof(nouvelle_production), "%s%s",
-                                         target_rule->productions[m], prod + 2);
-
-                                // Vérifier si cette nouvelle production existe déjà
-                                int existe = 0;
-                                for (int n = 0; n < rule->production_count; n++) {
-                                    if (strcmp(rule->productions[n], nouvelle_production) == 0) {
-                                        existe = 1;
-                                        break;
-                                    }
-                                }
-
-                                // Ajouter la nouvelle production si elle n'existe pas
-                                if (!existe && rule->production_count < MAX_RULES) {
-                                    strcpy(rule->productions[rule->production_count++], nouvelle_production);
-                                }
-                            }
-
-                            // Supprimer l'ancienne production
-                            for (int m = j; m < rule->production_count - 1; m++) {
-                                strcpy(rule->productions[m], rule->productions[m + 1]);
-                            }
-                            rule->production_count--;
-                            j--; // Réexaminer la position actuelle après suppression
-
-                            changes = 1; // Indiquer qu'une modification a été effectuée
-                            break;
-                        }
-                    }
-
-                    // Si le non-terminal n'existe pas dans les règles, ce n'est pas une erreur ici
-                    if (!found) {
-                        continue;
-                    }
-                }
-            }
-        }
-    } while (changes); // Répéter jusqu'à ce qu'il n'y ait plus de modifications
-}
-void supprimer_terminaux_non_en_tete(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-
-        for (int j = 0; j < rule->production_count; j++) {
-            char *prod = rule->productions[j];
-            char new_production[MAX_SYMBOLS] = "";
-            int changed = 0;
-
-            // Vérifier chaque caractère dans la production
-            for (int k = 0; prod[k] != '\0'; k++) {
-                if (islower(prod[k]) && k != 0) { // Si un terminal n'est pas en tête
-                    // Créer un nouveau non-terminal pour ce terminal
-                    char new_non_terminal[MAX_SYMBOLS];
-                    generate_non_terminal(new_non_terminal, grammaire);
-
-                    // Ajouter une nouvelle règle pour ce terminal
-                    Rule new_rule;
-                    strcpy(new_rule.non_terminal, new_non_terminal);
-                    new_rule.production_count = 1;
-                    snprintf(new_rule.productions[0], MAX_SYMBOLS, "%c", prod[k]);
-                    grammaire->rules[grammaire->rule_count++] = new_rule;
-
-                    // Remplacer le terminal par le nouveau non-terminal
-                    snprintf(new_production + strlen(new_production), MAX_SYMBOLS - strlen(new_production), "%s", new_non_terminal);
-                    changed = 1;
-                } else {
-                    // Ajouter le caractère original s'il n'est pas modifié
-                    snprintf(new_production + strlen(new_production), MAX_SYMBOLS - strlen(new_production), "%c", prod[k]);
-                }
-            }
-
-            // Mettre à jour la production si des changements ont été effectués
-            if (changed) {
-                strcpy(rule->productions[j], new_production);
-            }
+    if (statut == GRAMMAIRE_OK && !ecrite) {
+        char chomsky[4200];
+        snprintf(chomsky, sizeof(chomsky), "%s.chomsky", base);
+        statut = lire_pour_analyse(chomsky, 0, &grammaire, &ctx, message, taille_message);
+        if (statut != GRAMMAIRE_OK) return statut;
+        fichier = ouvrir_table(chemin, message, taille_message);
+        if (!fichier) {
+            statut = GRAMMAIRE_ERREUR_FICHIER;
+        } else {
+            int emission = emettre_cyk_c(&ctx, fichier, nom, grammaire);
+            statut = fermer_table(fichier, emission, chemin, message, taille_message);
+            if (emission != GRAMMAIRE_OK) snprintf(message, taille_message, "%s", contexte_grammaire_message(&ctx));
         }
+        snprintf(resultat->detail, sizeof(resultat->detail), "CYK sur %d non-terminaux, %s", grammaire->rule_count, chemin);
+        free(grammaire);
     }
+    resultat->faite = statut == GRAMMAIRE_OK;
+    resultat->conflits = 0;
+    return statut;
 }
 
-int non_terminal_in_rule(const Grammaire *grammaire, const char *non_terminal, const char *rule_production) {
-    int len = strlen(rule_production);
-
-    for (int i = 0; i < len; i += 2) {
-        if (isupper(rule_production[i]) && isdigit(rule_production[i + 1])) {
-            char current_non_terminal[MAX_SYMBOLS];
-            snprintf(current_non_terminal, 3, "%c%c", rule_production[i], rule_production[i + 1]);
-            if (strcmp(current_non_terminal, non_terminal) == 0) {
-                return 1; // Le non-terminal est trouvé dans la production
-            }
-        }
+// Compte rendu d'une analyse ("LL(1)" ou "LALR(1)")
+void afficher_analyse(const char *classe, const ResultatAnalyse *resultat) {
+    if (resultat->conflits == 0) {
+        printf("%s : %s", classe, resultat->detail);
+    } else {
+        printf("non %s : %d conflit%s, dont %s", classe, resultat->conflits, resultat->conflits > 1 ? "s" : "", resultat->detail);
     }
-    return 0; // Non-terminal absent de la production
 }
-void supprimer_regles_avec_plus_de_deux_non_terminaux(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-
-        for (int j = 0; j < rule->production_count; j++) {
-            char *prod = rule->productions[j];
-            int len = strlen(prod);
-
-            // Compter les non-terminaux dans la production
-            int non_terminal_count = 0;
-            for (int k = 0; k < len; k += 2) {
-                if (isupper(prod[k]) && isdigit(prod[k + 1])) {
-                    non_terminal_count++;
-                }
-            }
-
-            // Si plus de deux non-terminaux, procéder à la décomposition
-            if (non_terminal_count > 2) {
-                char current_prod[MAX_SYMBOLS];
-                strcpy(current_prod, prod); // Copie la production actuelle
-
-                char new_non_terminal[MAX_SYMBOLS];
-                char remaining_prod[MAX_SYMBOLS];
-
-                // Initialisation : traiter le premier non-terminal
-                strncpy(remaining_prod, current_prod + 2, MAX_SYMBOLS - 2);
-                remaining_prod[MAX_SYMBOLS - 2] = '\0';
-
-                do {
-                    generate_non_terminal(new_non_terminal, grammaire);
-                } while (non_terminal_exists(grammaire, new_non_terminal) ||
-                         non_terminal_in_rule(grammaire, new_non_terminal, prod));
-
-                snprintf(rule->productions[j], MAX_SYMBOLS, "%.*s%s", 2, current_prod, new_non_terminal);
-
-                // Créer de nouvelles règles pour gérer le reste
-                while (strlen(remaining_prod) > 2) {
-                    char first_non_terminal[MAX_SYMBOLS];
-                    strncpy(first_non_terminal, remaining_prod, 2);
-                    first_non_terminal[2] = '\0';
 
-                    // Générer un nouveau non-terminal
-                    char temp_non_terminal[MAX_SYMBOLS];
-                    do {
-                        generate_non_terminal(temp_non_terminal, grammaire);
-                    } while (non_terminal_exists(grammaire, temp_non_terminal) ||
-                             non_terminal_in_rule(grammaire, temp_non_terminal, prod));
-
-                    Rule new_rule;
-                    strcpy(new_rule.non_terminal, new_non_terminal);
-                    snprintf(new_rule.productions[0], MAX_SYMBOLS, "%s%s", first_non_terminal, temp_non_terminal);
-                    new_rule.production_count = 1;
-                    grammaire->rules[grammaire->rule_count++] = new_rule;
-
-                    strcpy(new_non_terminal, temp_non_terminal);
-                    memmove(remaining_prod, remaining_prod + 2, strlen(remaining_prod) - 1);
-                }
-
-                // Cas où il reste exactement deux non-terminaux
-                if (strlen(remaining_prod) == 2) {
-                    Rule final_rule;
-                    strcpy(final_rule.non_terminal, new_non_terminal);
-                    snprintf(final_rule.productions[0], MAX_SYMBOLS, "%s", remaining_prod);
-                    final_rule.production_count = 1;
-                    grammaire->rules[grammaire->rule_count++] = final_rule;
-                }
-            }
-        }
+// Traitement par lots : une tâche par (fichier, forme normale), prises dans l'ordre par
+// un groupe de threads. Les résultats sont rangés par tâche pour un compte rendu dans l'ordre.
+typedef struct {
+    const char **fichiers;
+    int nb_fichiers;
+    const OptionsNormalisation *options;
+    atomic_int prochaine;
+    int *statuts;
+    int *depuis_cache;
+    BilanModulaire *bilans;
+    int *etats_automate;           // Par tâche, 0 si la grammaire n'est pas passée par son automate
+    MesuresConversion *mesures;    // NULL sans rapport
+    ResultatAnalyse *ll1;          // Un par fichier, avec la tâche Greibach
+    ResultatAnalyse *lalr;         // Un par fichier, avec la tâche Chomsky
+    ResultatAnalyse *c;            // Un par fichier, après les deux tâches
+    char (*messages)[256];
+} Lot;
+
+void *travailleur_lot(void *argument) {
+    Lot *lot = argument;
+    for (;;) {
+        int tache = atomic_fetch_add(&lot->prochaine, 1);
+        if (tache >= 2 * lot->nb_fichiers) break;
+        FormeNormale forme = tache % 2 == 0 ? FORME_GREIBACH : FORME_CHOMSKY;
+        lot->statuts[tache] = normaliser_fichier(lot->fichiers[tache / 2], forme, lot->options, &lot->depuis_cache[tache], &lot->bilans[tache],
+                                                 &lot->etats_automate[tache], lot->mesures ? &lot->mesures[tache] : NULL,
+                                                 lot->messages[tache], sizeof(lot->messages[tache]));
+        if (lot->statuts[tache] == GRAMMAIRE_OK && forme == FORME_GREIBACH && lot->options->ll1) {
+            char base[4096];
+            nom_base_sortie(lot->fichiers[tache / 2], base, sizeof(base));
+            lot->statuts[tache] = analyser_ll1(base, &lot->ll1[tache / 2], lot->messages[tache], sizeof(lot->messages[tache]));
+        }
+        if (lot->statuts[tache] == GRAMMAIRE_OK && forme == FORME_CHOMSKY && lot->options->lalr) {
+            char base[4096];
+            nom_base_sortie(lot->fichiers[tache / 2], base, sizeof(base));
+            lot->statuts[tache] = analyser_lalr(lot->fichiers[tache / 2], base, &lot->lalr[tache / 2], lot->messages[tache],
+                                                sizeof(lot->messages[tache]));
+        }
+    }
+    return NULL;
+}
+
+// Écrire le rapport des tâches du lot, dans l'ordre des fichiers
+int ecrire_rapport_lot(const char *rapport, const Lot *lot) {
+    ConversionRapport *conversions = calloc(2 * (size_t)lot->nb_fichiers + 1, sizeof(ConversionRapport));
+    if (!conversions) {
+        perror("Erreur d'allocation");
+        return -1;
     }
-}
-void supprimer_recursivite_gauche(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule_i = &grammaire->rules[i];
-
-        // Identifier les productions récursives et non récursives
-        char recursive_productions[MAX_RULES][MAX_SYMBOLS] = {0};
-        char non_recursive_productions[MAX_RULES][MAX_SYMBOLS] = {0};
-        int recursive_count = 0, non_recursive_count = 0;
-
-        for (int j = 0; j < rule_i->production_count; j++) {
-            if (strncmp(rule_i->productions[j], rule_i->non_terminal, strlen(rule_i->non_terminal)) == 0) {
-                // Production récursive
-                strcpy(recursive_productions[recursive_count++], rule_i->productions[j] + strlen(rule_i->non_terminal));
-            } else {
-                // Production non récursive
-                strcpy(non_recursive_productions[non_recursive_count++], rule_i->productions[j]);
-            }
-        }
-
-        // Si aucune récursivité gauche, passer à la règle suivante
-        if (recursive_count == 0) {
+    int statut = 0;
+    for (int tache = 0; tache < 2 * lot->nb_fichiers; tache++) {
+        if (lot->mesures[tache].echec_allocation) statut = -1;
+        conversions[tache].fichier = lot->fichiers[tache / 2];
+        conversions[tache].forme = tache % 2 == 0 ? FORME_GREIBACH : FORME_CHOMSKY;
+        conversions[tache].statut = lot->statuts[tache];
+        conversions[tache].depuis_cache = lot->depuis_cache[tache];
+        conversions[tache].mesures = &lot->mesures[tache];
+    }
+    if (statut == -1) fprintf(stderr, "Erreur : mémoire insuffisante, rapport incomplet.\n");
+    if (ecrire_rapport(rapport, conversions, 2 * lot->nb_fichiers) == -1) statut = -1;
+    free(conversions);
+    return statut;
+}
+
+// Normaliser tous les fichiers avec nb_threads threads ; renvoie le nombre de fichiers en échec.
+// Avec un rapport, les mesures de chaque conversion y sont écrites à la fin.
+int normaliser_lot(const char **fichiers, int nb_fichiers, int nb_threads, const OptionsNormalisation *options,
+                   const char *rapport) {
+    Lot lot;
+    lot.fichiers = fichiers;
+    lot.nb_fichiers = nb_fichiers;
+    lot.options = options;
+    atomic_init(&lot.prochaine, 0);
+    lot.statuts = calloc(2 * (size_t)nb_fichiers + 1, sizeof(int));
+    lot.depuis_cache = calloc(2 * (size_t)nb_fichiers + 1, sizeof(int));
+    lot.bilans = calloc(2 * (size_t)nb_fichiers + 1, sizeof(BilanModulaire));
+    lot.etats_automate = calloc(2 * (size_t)nb_fichiers + 1, sizeof(int));
+    lot.messages = calloc(2 * (size_t)nb_fichiers + 1, sizeof(*lot.messages));
+    lot.ll1 = calloc((size_t)nb_fichiers + 1, sizeof(ResultatAnalyse));
+    lot.lalr = calloc((size_t)nb_fichiers + 1, sizeof(ResultatAnalyse));
+    lot.c = calloc((size_t)nb_fichiers + 1, sizeof(ResultatAnalyse));
+    lot.mesures = rapport ? calloc(2 * (size_t)nb_fichiers + 1, sizeof(MesuresConversion)) : NULL;
+    if (!lot.statuts || !lot.depuis_cache || !lot.bilans || !lot.etats_automate || !lot.messages || !lot.ll1 || !lot.lalr || !lot.c || (rapport && !lot.mesures)) {
+        perror("Erreur d'allocation");
+        free(lot.ll1);
+        free(lot.lalr);
+        free(lot.c);
+        free(lot.statuts);
+        free(lot.depuis_cache);
+        free(lot.bilans);
+        free(lot.etats_automate);
+        free(lot.messages);
+        free(lot.mesures);
+        return nb_fichiers;
+    }
+
+    if (nb_threads > 2 * nb_fichiers) nb_threads = 2 * nb_fichiers;
+    pthread_t *threads = malloc((nb_threads > 0 ? nb_threads : 1) * sizeof(pthread_t));
+    int lances = 0;
+    if (threads) {
+        for (; lances < nb_threads; lances++) {
+            if (pthread_create(&threads[lances], NULL, travailleur_lot, &lot) != 0) break;
+        }
+    }
+    // Le thread principal travaille aussi, ce qui suffit si aucun thread n'a pu être créé
+    travailleur_lot(&lot);
+    for (int i = 0; i < lances; i++) pthread_join(threads[i], NULL);
+    free(threads);
+
+    // Le reconnaisseur C lit les deux sorties d'un fichier : il vient une fois les tâches finies
+    for (int i = 0; i < nb_fichiers && options->emettre_c; i++) {
+        if (lot.statuts[2 * i] != GRAMMAIRE_OK || lot.statuts[2 * i + 1] != GRAMMAIRE_OK) continue;
+        char base[4096];
+        nom_base_sortie(fichiers[i], base, sizeof(base));
+        lot.statuts[2 * i + 1] = analyser_emission(fichiers[i], base, &lot.c[i], lot.messages[2 * i + 1],
+                                                   sizeof(lot.messages[2 * i + 1]));
+    }
+
+    int echecs = 0;
+    for (int i = 0; i < nb_fichiers; i++) {
+        int g = lot.statuts[2 * i], c = lot.statuts[2 * i + 1];
+        if (g == GRAMMAIRE_OK && c == GRAMMAIRE_OK) {
+            int caches = lot.depuis_cache[2 * i] + lot.depuis_cache[2 * i + 1];
+            printf("%s : greibach et chomsky sauvegardées%s", fichiers[i],
+                   caches == 2 ? " (cache)" : caches == 1 ? " (une depuis le cache)" : "");
+            const BilanModulaire *bg = &lot.bilans[2 * i], *bc = &lot.bilans[2 * i + 1];
+            if (bg->composantes || bc->composantes) {
+                printf(" (composantes recalculées : greibach %d/%d, chomsky %d/%d)",
+                       bg->recalculees, bg->composantes, bc->recalculees, bc->composantes);
+            }
+            int etats = lot.etats_automate[2 * i] ? lot.etats_automate[2 * i] : lot.etats_automate[2 * i + 1];
+            if (etats) printf(" (régulière : automate minimal de %d état%s)", etats, etats > 1 ? "s" : "");
+            if (lot.ll1[i].faite) {
+                printf(" ; ");
+                afficher_analyse("LL(1)", &lot.ll1[i]);
+            }
+            if (lot.lalr[i].faite) {
+                printf(" ; ");
+                afficher_analyse("LALR(1)", &lot.lalr[i]);
+            }
+            if (lot.c[i].faite) {
+                printf(" ; ");
+                afficher_analyse("C", &lot.c[i]);
+            }
+            printf("\n");
             continue;
         }
-
-        // Générer un nouveau non-terminal pour gérer la récursivité
-        char new_non_terminal[MAX_SYMBOLS];
-        generate_non_terminal(new_non_terminal, grammaire);
-
-        // Remplacer les règles de rule_i avec les productions non récursives suivies du nouveau non-terminal
-        rule_i->production_count = 0;
-        for (int j = 0; j < non_recursive_count; j++) {
-            snprintf(rule_i->productions[rule_i->production_count++], MAX_SYMBOLS, "%s%s",
-                     non_recursive_productions[j], new_non_terminal);
-        }
-
-        // Ajouter les règles pour le nouveau non-terminal
-        Rule new_rule;
-        strcpy(new_rule.non_terminal, new_non_terminal);
-        new_rule.production_count = 0;
-        for (int j = 0; j < recursive_count; j++) {
-            snprintf(new_rule.productions[new_rule.production_count++], MAX_SYMBOLS, "%s%s",
-                     recursive_productions[j], new_non_terminal);
-        }
-        strcpy(new_rule.productions[new_rule.production_count++], "E"); // Ajout de epsilon
-
-        // Ajouter le nouveau non-terminal à la grammaire
-        grammaire->rules[grammaire->rule_count++] = new_rule;
-        
-    }
-    
-}
-
-
-//remplacer axiome du membre droit par un non terminal
-
-void ajouter_regle_pour_axe(const char *axiome, Grammaire *grammaire) {
-    // Vérifier si l'axiome est présent dans les membres droits
-    int axiome_present = 0;
-
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        for (int j = 0; j < rule->production_count; j++) {
-            if (strstr(rule->productions[j], axiome)) {
-                axiome_present = 1;
-                break;
-            }
-        }
-        if (axiome_present) break; // Sortir dès que l'axiome est trouvé
-    }
-
-    // Si l'axiome n'est pas présent dans les membres droits, ne rien modifier
-    if (!axiome_present) {
-        printf("Aucune règle ne contient l'axiome '%s' dans ses membres droits. Pas de modification nécessaire.\n", axiome);
-        return;
-    }
-
-    // Générer un nouveau non-terminal
-    char nouveau_non_terminal[MAX_SYMBOLS];
-    generate_non_terminal(nouveau_non_terminal, grammaire);
-
-    // Ajouter une règle qui lie l'axiome au nouveau non-terminal
-    Rule nouvelle_regle;
-    strcpy(nouvelle_regle.non_terminal, axiome);
-    strcpy(nouvelle_regle.productions[0], nouveau_non_terminal);
-    nouvelle_regle.production_count = 1;
-
-    if (grammaire->rule_count < MAX_RULES) {
-        // Déplacer toutes les règles existantes vers la droite pour insérer la nouvelle règle en première position
-        for (int i = grammaire->rule_count; i > 0; i--) {
-            grammaire->rules[i] = grammaire->rules[i - 1];
-        }
-        // Ajouter la nouvelle règle en première position
-        grammaire->rules[0] = nouvelle_regle;
-        grammaire->rule_count++;
-    } else {
-        fprintf(stderr, "Erreur : Limite de règles atteinte, impossible d'ajouter la nouvelle règle.\n");
-        return;
-    }
-
-    // Parcourir toutes les règles pour remplacer les occurrences de l'axiome par le nouveau non-terminal
-    for (int i = 1; i < grammaire->rule_count; i++) { // Commence à 1 pour ignorer la règle ajoutée
-        Rule *rule = &grammaire->rules[i];
-
-        // Si le non-terminal de la règle est l'axiome, le remplacer par le nouveau non-terminal
-        if (strcmp(rule->non_terminal, axiome) == 0) {
-            strcpy(rule->non_terminal, nouveau_non_terminal);
-        }
-
-        // Parcourir les productions et remplacer chaque occurrence de l'axiome
-        for (int j = 0; j < rule->production_count; j++) {
-            char *production = rule->productions[j];
-            char temp[MAX_SYMBOLS] = "";
-            char *pos = production;
-
-            // Remplacer toutes les occurrences de l'axiome par le nouveau non-terminal
-            while ((pos = strstr(pos, axiome)) != NULL) {
-                // Copier la partie avant l'axiome
-                strncat(temp, production, pos - production);
-                strcat(temp, nouveau_non_terminal);
-                production = pos + strlen(axiome);
-                pos = production;
-            }
-
-            // Ajouter la partie restante
-            strcat(temp, production);
-            strcpy(rule->productions[j], temp);
-        }
+        echecs++;
+        if (g != GRAMMAIRE_OK) fprintf(stderr, "%s : greibach : %s\n", fichiers[i], lot.messages[2 * i]);
+        if (c != GRAMMAIRE_OK) fprintf(stderr, "%s : chomsky : %s\n", fichiers[i], lot.messages[2 * i + 1]);
+    }
+    if (rapport) {
+        if (ecrire_rapport_lot(rapport, &lot) == -1) echecs++;
+        for (int tache = 0; tache < 2 * nb_fichiers; tache++) liberer_mesures(&lot.mesures[tache]);
+        free(lot.mesures);
+    }
+    free(lot.statuts);
+    free(lot.depuis_cache);
+    free(lot.bilans);
+    free(lot.etats_automate);
+    free(lot.messages);
+    free(lot.ll1);
+    free(lot.lalr);
+    free(lot.c);
+    return echecs;
+}
+
+// Ajouter à la liste les fichiers d'un manifeste (un chemin par ligne, # pour un commentaire)
+int lire_manifeste(const char *manifeste, char ***fichiers, int *nb_fichiers, int *capacite) {
+    FILE *file = fopen(manifeste, "r");
+    if (file == NULL) {
+        perror("Erreur lors de l'ouverture du manifeste");
+        return -1;
     }
-}
-int isTerminal(char c) {
-    return islower(c);
-}
-// retirer les terminaux dans le membre droit si la taille du membre droit>=2
-// ( donc terminaux non isoles)
-void transformRule(Rule *rule, Grammaire *grammaire) {
-    for (int i = 0; i < rule->production_count; i++) {
-        char *production = rule->productions[i];
-        char nouvelle_production[MAX_SYMBOLS] = "";
-        int len = strlen(production);
-
-        for (int j = 0; j < len; j++) {
-            if (isTerminal(production[j]) && len > 1) {
-                // Remplacer tous les terminaux dans une production de taille > 1
-                char nouveau_non_terminal[MAX_SYMBOLS];
-                generate_non_terminal(nouveau_non_terminal, grammaire);
-
-                // Créer une nouvelle règle associant le terminal au non-terminal
-                Rule nouvelle_regle;
-                strcpy(nouvelle_regle.non_terminal, nouveau_non_terminal);
-                nouvelle_regle.production_count = 1;
-                snprintf(nouvelle_regle.productions[0], MAX_SYMBOLS, "%c", production[j]);
-
-                // Ajouter la règle à la grammaire
-                if (grammaire->rule_count < MAX_RULES) {
-                    grammaire->rules[grammaire->rule_count++] = nouvelle_regle;
-                } else {
-                    fprintf(stderr, "Erreur : Limite de règles atteinte, impossible d'ajouter une nouvelle règle.\n");
-                    return;
-                }
-
-                // Remplacer le terminal par le nouveau non-terminal dans la production
-                strcat(nouvelle_production, nouveau_non_terminal);
-            } else {
-                // Garder les non-terminaux ou les terminaux isolés
-                char temp[2] = {production[j], '\0'};
-                strcat(nouvelle_production, temp);
-            }
+    char line[4096];
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char *debut = line;
+        while (*debut == ' ' || *debut == '\t') debut++;
+        if (*debut == '\0' || *debut == '#') continue;
+        if (*nb_fichiers == *capacite) {
+            int nouvelle = *capacite ? *capacite * 2 : 64;
+            char **tab = realloc(*fichiers, nouvelle * sizeof(char *));
+            if (!tab) {
+                fclose(file);
+                return -1;
+            }
+            *fichiers = tab;
+            *capacite = nouvelle;
+        }
+        if (!((*fichiers)[(*nb_fichiers)++] = strdup(debut))) {
+            fclose(file);
+            return -1;
         }
-
-        // Remplacer l'ancienne production par la nouvelle
-        strcpy(rule->productions[i], nouvelle_production);
     }
+    fclose(file);
+    return 0;
 }
 
-void transform(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        transformRule(&grammaire->rules[i], grammaire);
-    }
-}
-// Afficher la grammaire
-void afficher_grammaire(Grammaire *grammaire) {
-    printf("Grammaire:\n");
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        printf("%s -> ", rule->non_terminal);
-        for (int j = 0; j < rule->production_count; j++) {
-            printf("%s", rule->productions[j]);
-            if (j < rule->production_count - 1) printf(" | ");
-        }
-        printf("\n");
+void afficher_usage(const char *programme) {
+    fprintf(stderr, "Usage : %s [--threads=N] [--cache=répertoire [--cache-liens]] [--modulaire] [--rapport=fichier.json|.csv] [--ll1] [--lalr] [--emit-c]\n"
+                    "       [--trace=niveau[:etapes,allocation,validation]] [--trace-fichier=fichier] [--manifest fichier] [fichier.general ...]\n", programme);
+    fprintf(stderr, "Sans fichier, normalise exemple.general.txt en affichant chaque étape (--trace=2:etapes par défaut).\n");
+}
+
+// Lire "niveau[:catégorie,...]" ; sans catégorie, toutes sont tracées
+int lire_trace(const char *texte, TraceGrammaire *trace) {
+    char *fin;
+    long niveau = strtol(texte, &fin, 10);
+    if (fin == texte || niveau < TRACE_SILENCE || niveau > TRACE_DETAIL) return -1;
+    trace->niveau = (int)niveau;
+    trace->categories = TRACE_TOUT;
+    if (*fin == '\0') return 0;
+    if (*fin != ':') return -1;
+    trace->categories = 0;
+    const char *noms[] = {"etapes", "allocation", "validation"};
+    const unsigned categories[] = {TRACE_ETAPES, TRACE_ALLOCATION, TRACE_VALIDATION};
+    for (const char *nom = fin + 1; *nom; ) {
+        size_t longueur = strcspn(nom, ",");
+        int trouve = 0;
+        for (int i = 0; i < 3; i++) {
+            if (strlen(noms[i]) == longueur && strncmp(nom, noms[i], longueur) == 0) {
+                trace->categories |= categories[i];
+                trouve = 1;
+            }
+        }
+        if (!trouve) return -1;
+        nom += longueur;
+        if (*nom == ',') nom++;
     }
+    return 0;
 }
-void regrouper_terminaux(Grammaire *grammaire) {
-    char terminal_to_non_terminal[128][MAX_SYMBOLS] = {{0}}; // Associer chaque terminal à un unique non-terminal
-    char non_terminals_to_replace[MAX_RULES][MAX_SYMBOLS];   // Liste des anciens non-terminaux à remplacer
-    char terminal_for_non_terminal[MAX_RULES][2] = {{0}};    // Terminal associé à chaque ancien non-terminal
-    int replace_count = 0;                                  // Compteur des non-terminaux à remplacer
-    Grammaire updated_grammaire = *grammaire;               // Copie pour modification
-
-    // Étape 1 : Identifier les terminaux similaires et créer un unique non-terminal pour chaque terminal
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        if (rule->production_count == 1 && strlen(rule->productions[0]) == 1 && islower(rule->productions[0][0])) {
-            char terminal = rule->productions[0][0];
-
-            // Vérifier si un non-terminal existe déjà pour ce terminal
-            if (strlen(terminal_to_non_terminal[(int)terminal]) == 0) {
-                // Générer un nouveau non-terminal
-                char new_non_terminal[MAX_SYMBOLS];
-                generate_non_terminal(new_non_terminal, &updated_grammaire);
-
-                // Associer ce non-terminal au terminal
-                strcpy(terminal_to_non_terminal[(int)terminal], new_non_terminal);
 
-                // Ajouter une règle pour ce terminal
-                Rule new_rule;
-                strcpy(new_rule.non_terminal, new_non_terminal);
-                snprintf(new_rule.productions[0], MAX_SYMBOLS, "%c", terminal);
-                new_rule.production_count = 1;
-                updated_grammaire.rules[updated_grammaire.rule_count++] = new_rule;
+// Normaliser exemple.general.txt en affichant chaque étape
+int normaliser_exemple(const OptionsNormalisation *options, const char *rapport) {
+    const char *fichier = "exemple.general.txt";
+    char message[256];
+    MesuresConversion mesures[2];
+    memset(mesures, 0, sizeof(mesures));
+    ConversionRapport conversions[2] = {
+        { fichier, FORME_GREIBACH, GRAMMAIRE_OK, 0, &mesures[0] },
+        { fichier, FORME_CHOMSKY, GRAMMAIRE_OK, 0, &mesures[1] },
+    };
+
+    int statut = 0, faites = 0;
+    for (int i = 0; i < 2 && statut == 0; i++, faites++) {
+        const char *nom = i == 0 ? "Greibach" : "Chomsky";
+        printf("\n==== Transformation en forme normale de %s ====\n", nom);
+        conversions[i].statut = normaliser_fichier(fichier, conversions[i].forme, options, &conversions[i].depuis_cache,
+                                                   NULL, NULL, rapport ? &mesures[i] : NULL, message, sizeof(message));
+        if (conversions[i].statut != GRAMMAIRE_OK) {
+            fprintf(stderr, "Erreur : %s\n", message);
+            statut = -1;
+        } else {
+            printf("Grammaire sauvegardée dans le fichier 'exemple.Transforme.%s'.\n", i == 0 ? "greibach" : "chomsky");
+        }
+        ResultatAnalyse analyse = { 0, 0, "" };
+        int demandee = i == 0 ? options->ll1 : options->lalr;
+        if (statut == 0 && demandee) {
+            int code = i == 0 ? analyser_ll1("exemple.Transforme", &analyse, message, sizeof(message))
+                              : analyser_lalr(fichier, "exemple.Transforme", &analyse, message, sizeof(message));
+            if (code != GRAMMAIRE_OK) {
+                fprintf(stderr, "Erreur : %s\n", message);
+                statut = -1;
+            } else {
+                afficher_analyse(i == 0 ? "LL(1)" : "LALR(1)", &analyse);
+                printf("\n");
             }
-
-            // Enregistrer l'ancien non-terminal à remplacer
-            strcpy(non_terminals_to_replace[replace_count], rule->non_terminal);
-            terminal_for_non_terminal[replace_count][0] = terminal;
-            replace_count++;
         }
     }
-
-    // Étape 2 : Supprimer les anciennes règles redondantes
-    Grammaire temp_grammaire = {0};
-    for (int i = 0; i < updated_grammaire.rule_count; i++) {
-        Rule *rule = &updated_grammaire.rules[i];
-
-        // Vérifier si c'est une règle redondante à supprimer
-        int skip = 0;
-        for (int j = 0; j < replace_count; j++) {
-            if (strcmp(rule->non_terminal, non_terminals_to_replace[j]) == 0) {
-                skip = 1;
-                break;
+    if (statut == 0 && options->emettre_c) {
+        ResultatAnalyse analyse = { 0, 0, "" };
+        if (analyser_emission(fichier, "exemple.Transforme", &analyse, message, sizeof(message)) != GRAMMAIRE_OK) {
+            fprintf(stderr, "Erreur : %s\n", message);
+            statut = -1;
+        } else {
+            afficher_analyse("C", &analyse);
+            printf("\n");
+        }
+    }
+    if (rapport && ecrire_rapport(rapport, conversions, faites) == -1) {
+        statut = -1;
+    }
+    liberer_mesures(&mesures[0]);
+    liberer_mesures(&mesures[1]);
+    return statut;
+}
+
+int main(int argc, char *argv[]) {
+    char **fichiers = NULL;
+    int nb_fichiers = 0, capacite = 0;
+    int nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    CacheGrammaires cache = { NULL, 0 };
+    OptionsNormalisation options = { NULL, NULL, 0, 1, 0, 0, 0 };
+    const char *rapport = NULL;
+    const char *trace_fichier = NULL;
+    TraceGrammaire trace = { NULL, TRACE_SILENCE, 0 };
+    int trace_donnee = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--cache=", 8) == 0) {
+            cache.repertoire = argv[i] + 8;
+        } else if (strcmp(argv[i], "--cache-liens") == 0) {
+            cache.liens = 1;
+        } else if (strcmp(argv[i], "--modulaire") == 0) {
+            options.modulaire = 1;
+        } else if (strcmp(argv[i], "--ll1") == 0) {
+            options.ll1 = 1;
+        } else if (strcmp(argv[i], "--lalr") == 0) {
+            options.lalr = 1;
+        } else if (strcmp(argv[i], "--emit-c") == 0) {
+            options.emettre_c = 1;
+        } else if (strncmp(argv[i], "--rapport=", 10) == 0) {
+            rapport = argv[i] + 10;
+        } else if (strncmp(argv[i], "--trace=", 8) == 0) {
+            if (lire_trace(argv[i] + 8, &trace) == -1) {
+                fprintf(stderr, "Erreur : trace invalide : %s\n", argv[i] + 8);
+                return -1;
+            }
+            trace_donnee = 1;
+        } else if (strncmp(argv[i], "--trace-fichier=", 16) == 0) {
+            trace_fichier = argv[i] + 16;
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            nb_threads = atoi(argv[i] + 10);
+            if (nb_threads == 0) nb_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        } else if (strcmp(argv[i], "--manifest") == 0 && i + 1 < argc) {
+            if (lire_manifeste(argv[++i], &fichiers, &nb_fichiers, &capacite) == -1) return -1;
+        } else if (argv[i][0] == '-' && argv[i][1] == '-') {
+            afficher_usage(argv[0]);
+            return -1;
+        } else {
+            if (nb_fichiers == capacite) {
+                capacite = capacite ? capacite * 2 : 64;
+                char **tab = realloc(fichiers, capacite * sizeof(char *));
+                if (!tab) return -1;
+                fichiers = tab;
             }
-        }
-
-        if (!skip) {
-            temp_grammaire.rules[temp_grammaire.rule_count++] = *rule;
+            fichiers[nb_fichiers++] = strdup(argv[i]);
         }
     }
+    if (nb_threads < 1) nb_threads = 1;
+    options.cache = cache.repertoire ? &cache : NULL;
 
-    updated_grammaire = temp_grammaire;
-
-    // Étape 3 : Mettre à jour toutes les règles avec les nouveaux non-terminaux
-    for (int i = 0; i < updated_grammaire.rule_count; i++) {
-        Rule *rule = &updated_grammaire.rules[i];
-        for (int j = 0; j < rule->production_count; j++) {
-            char *prod = rule->productions[j];
-            for (int k = 0; k < replace_count; k++) {
-                if (strcmp(prod, non_terminals_to_replace[k]) == 0) {
-                    strcpy(prod, terminal_to_non_terminal[(int)terminal_for_non_terminal[k][0]]);
-                }
-            }
-        }
+    // L'exemple affiche chaque étape sur la sortie standard ; les lots sont silencieux,
+    // leur trace va par défaut sur la sortie d'erreur
+    if (nb_fichiers == 0 && !trace_donnee) {
+        trace.niveau = TRACE_DETAIL;
+        trace.categories = TRACE_ETAPES;
     }
-
-    // Étape 4 : Remplacer les anciens non-terminaux dans toutes les productions où ils apparaissent
-    for (int i = 0; i < updated_grammaire.rule_count; i++) {
-        Rule *rule = &updated_grammaire.rules[i];
-        for (int j = 0; j < rule->production_count; j++) {
-            char *prod = rule->productions[j];
-            for (int k = 0; k < replace_count; k++) {
-                // Si le non-terminal à remplacer est dans une production
-                char *found = strstr(prod, non_terminals_to_replace[k]);
-                if (found) {
-                    // Remplacer par le nouveau non-terminal
-                    strncpy(found, terminal_to_non_terminal[(int)terminal_for_non_terminal[k][0]], strlen(non_terminals_to_replace[k]));
-                }
-            }
+    trace.fichier = nb_fichiers == 0 ? stdout : stderr;
+    if (trace.niveau > TRACE_SILENCE && trace_fichier) {
+        trace.fichier = fopen(trace_fichier, "w");
+        if (trace.fichier == NULL) {
+            perror("Erreur lors de l'ouverture de la trace");
+            return -1;
         }
     }
+    options.trace = trace.niveau > TRACE_SILENCE ? &trace : NULL;
 
-    // Mise à jour finale de la grammaire
-    *grammaire = updated_grammaire;
-}
-void sauvegarder_grammaire(const Grammaire *grammaire, const char *nom_base, char c) {
-    // Construire le nom du fichier en fonction du caractère c
-    char nom_fichier[MAX_SYMBOLS];
-    if (c == 'c') {
-        snprintf(nom_fichier, sizeof(nom_fichier), "%s.chomsky", nom_base);
-    } else if (c == 'g') {
-        snprintf(nom_fichier, sizeof(nom_fichier), "%s.greibach", nom_base);
+    int statut;
+    if (nb_fichiers == 0) {
+        options.threads_composantes = nb_threads;
+        statut = normaliser_exemple(&options, rapport);
     } else {
-        printf("Erreur : caractère non valide. Utilisez 'c' ou 'g'.\n");
-        return;
-    }
-
-    // Ouvrir le fichier en mode écriture
-    FILE *fichier = fopen(nom_fichier, "w");
-    if (!fichier) {
-        perror("Erreur lors de l'ouverture du fichier");
-        return;
-    }
-
-    // Parcourir les règles de la grammaire
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        const Rule *rule = &grammaire->rules[i];
-
-        // Écrire le non-terminal
-        fprintf(fichier, "%s : ", rule->non_terminal);
-
-        // Écrire les productions séparées par " | "
-        for (int j = 0; j < rule->production_count; j++) {
-            fprintf(fichier, "%s", rule->productions[j]);
-            if (j < rule->production_count - 1) {
-                fprintf(fichier, " | ");
-            }
-        }
-
-        // Fin de ligne pour la règle
-        fprintf(fichier, "\n");
+        // Le thread principal prend aussi des tâches ; les threads en trop vont aux composantes
+        options.threads_composantes = nb_threads / (2 * nb_fichiers);
+        if (options.threads_composantes < 1) options.threads_composantes = 1;
+        statut = normaliser_lot((const char **)fichiers, nb_fichiers, nb_threads - 1, &options, rapport) == 0 ? 0 : 1;
     }
-
-    // Fermer le fichier
-    fclose(fichier);
-    printf("Grammaire sauvegardée dans le fichier '%s'.\n", nom_fichier);
-}
-bool est_majuscule_ou_minuscule(char c) {
-    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
-}
-
-void supprimer_E_non_isole(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-        
-        // Parcours de toutes les productions de chaque règle
-        for (int j = 0; j < rule->production_count; j++) {
-            char *production = rule->productions[j];
-            int len = strlen(production);
-            
-            for (int i = 0; i < len; i++) {
-                // On cherche les 'E' dans la production
-                if (production[i] == 'E') {
-                    // Vérifier si E est précédé ou suivi d'une majuscule ou minuscule
-                    if ((i > 0 && est_majuscule_ou_minuscule(production[i - 1])) || 
-                        (i < len - 1 && est_majuscule_ou_minuscule(production[i + 1]))) {
-                        
-                        // Supprimer le 'E' de la production
-                        printf("Avant suppression de E : %s\n", production);
-                        // Décaler le reste de la chaîne après le 'E'
-                        memmove(production + i, production + i + 1, len - i);
-                        printf("Après suppression de E : %s\n", production);
-                        break; // Passer à la production suivante après modification
-                    }
-                }
-            }
-        }
-    }
-}
-void transformer_en_chomsky(Grammaire *grammaire, const char *axiome) {
-    printf("Début de la transformation en forme normale de Chomsky\n");
-
-    printf("\nÉtape 1 : Supprimer la récursivité gauche\n");
-    supprimer_recursivite_gauche(grammaire);
-    afficher_grammaire(grammaire);
-    printf("\n==== Suppression de E-non-isolé si il existe\n");
-    supprimer_E_non_isole(grammaire);
-    afficher_grammaire(grammaire);
-    
-    printf("\nÉtape 2 : factoriser\n");
-    factoriser(grammaire);
-    afficher_grammaire(grammaire);
-    printf("Étape 3 : Retirer l'axiome des membres droits\n");
-    ajouter_regle_pour_axe(axiome, grammaire);
-    afficher_grammaire(grammaire); 
-
-    printf("\nÉtape 4 : Supprimer les terminaux dans le membre droit des règles de longueur au moins deux\n");
-    transform(grammaire);
-    afficher_grammaire(grammaire);
-
-   
-
-    printf("\nÉtape 5 : Supprimer les règles avec plus de deux non-terminaux\n");
-    supprimer_regles_avec_plus_de_deux_non_terminaux(grammaire);
-    afficher_grammaire(grammaire);
-
-    printf("\nÉtape 6 : Supprimer les règles X → ε sauf si X est l'axiome\n");
-    supprimer_epsilon(grammaire, axiome);
-    afficher_grammaire(grammaire);
-
-    printf("\nÉtape 7 : Supprimer les règles unité X → Y\n");
-    supprimer_unite(grammaire);
-    afficher_grammaire(grammaire);
-
-    printf("\nÉtape 8 : nettoyer la grammaire\n");
-     regrouper_terminaux(grammaire);
-    afficher_grammaire(grammaire);
-
-    printf("Fin de la transformation en forme normale de Chomsky\n");
-    afficher_grammaire(grammaire);
-}
-
-void greibach(Grammaire *grammaire, const char *axiome) {
-    // Étape 0 : Factoriser les règles (simplification préalable)
-    printf("==== Application de la factorisation ====\n");
-    factoriser(grammaire);
-    afficher_grammaire(grammaire);
-
-    // Étape 2 : Supprimer la récursivité gauche
-    printf("\n==== Suppression de la récursivité gauche ====\n");
-    supprimer_recursivite_gauche(grammaire);
-    afficher_grammaire(grammaire);
-    printf("\n==== Suppression de E-non-isolé si il existe\n");
-    supprimer_E_non_isole(grammaire);
-    afficher_grammaire(grammaire);
-    // Étape 3 : Ajouter une règle pour l’axiome
-    printf("\n==== Ajout de la règle pour l'axiome ====\n");
-    ajouter_regle_pour_axe((char *)axiome, grammaire);
-    afficher_grammaire(grammaire);
-
-    // Étape 4 : Supprimer les règles epsilon
-    printf("\n==== Suppression des règles epsilon ====\n");
-    supprimer_epsilon(grammaire, axiome);
-    afficher_grammaire(grammaire);
-
-    // Étape 5 : Supprimer les règles unité
-    printf("\n==== Suppression des règles unité ====\n");
-    supprimer_unite(grammaire);
-    afficher_grammaire(grammaire);
-
-
-    // Étape 6 : Supprimer les non-terminaux en tête
-    printf("\n==== Suppression des non-terminaux en tête des règles ====\n");
-    supprimer_non_terminaux_en_tete(grammaire);
-    afficher_grammaire(grammaire);
-
-    // Étape 7 : Supprimer les terminaux qui ne sont pas en tête
-    printf("\n==== Suppression des terminaux non en tête ====\n");
-    supprimer_terminaux_non_en_tete(grammaire);
-    afficher_grammaire(grammaire);
-
-    // Étape 8 : nettoyer la grammaire 
-    printf("\n==== nettoyer la grammaire ====\n");
-    regrouper_terminaux(grammaire);
-    printf("\nTransformation en forme normale de Greibach terminée.\n");
-    afficher_grammaire(grammaire);
-}
-
-// Fonction pour vérifier si la grammaire est sous la forme normale de Chomsky
-int isChomsky(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-
-        for (int j = 0; j < rule->production_count; j++) {
-            const char *production = rule->productions[j];
-            printf("Vérification de la production : %s\n", production);
-
-            // Cas 1 : Un seul terminal
-            if (strlen(production) == 1 && isTerminal(production[0])) {
-                printf("Valide : terminal isolé\n");
-                continue;
-            }
-
-            // Cas 2 : Deux non-terminaux
-            if (strlen(production) == 4) { // Longueur 4, ex : "Y8Z0"
-                char left[3] = {production[0], production[1], '\0'}; // Premier non-terminal : Y8
-                char right[3] = {production[2], production[3], '\0'}; // Second non-terminal : Z0
-
-                if (isNonTerminal(left) && isNonTerminal(right)) {
-                    printf("Valide : deux non-terminaux (%s et %s)\n", left, right);
-                    continue;
-                } else {
-                    if (!isNonTerminal(left)) {
-                        printf("Non valide : %s n'est pas un non-terminal valide.\n", left);
-                    }
-                    if (!isNonTerminal(right)) {
-                        printf("Non valide : %s n'est pas un non-terminal valide.\n", right);
-                    }
-                }
-            }
-
-            // Cas 3 : Axiome produisant epsilon
-            if (strcmp(production, "E") == 0 &&
-                strcmp(rule->non_terminal, grammaire->rules[0].non_terminal) == 0) {
-                printf("Valide : epsilon pour l'axiome\n");
-                continue;
-            }
-
-            printf("Non valide : La production %s ne respecte pas CNF.\n", production);
-            return 0;
-        }
+    for (int i = 0; i < nb_fichiers; i++) free(fichiers[i]);
+    free(fichiers);
+    if (trace_fichier && options.trace && fclose(trace.fichier) != 0) {
+        perror("Erreur lors de l'écriture de la trace");
+        statut = -1;
     }
-    return 1; // Toutes les règles sont valides
+    return statut;
 }
-int isGreibach(Grammaire *grammaire) {
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-
-        for (int j = 0; j < rule->production_count; j++) {
-            const char *production = rule->productions[j];
-            printf("Vérification de la production : %s\n", production);
-
-            // Cas 1 : Axiome produisant epsilon
-            if (strcmp(production, "E") == 0 &&
-                strcmp(rule->non_terminal, grammaire->rules[0].non_terminal) == 0) {
-                printf("Valide : epsilon pour l'axiome\n");
-                continue;
-            }
-
-            // Cas 2 : La production commence par un terminal
-            if (isTerminal(production[0])) {
-                int valide = 1;
 
-                // Vérifier que les symboles suivants sont des non-terminaux
-                for (int k = 1; k < strlen(production); k += 2) {
-                    char symbol[3] = {production[k], production[k + 1], '\0'};
-                    if (!isNonTerminal(symbol)) {
-                        valide = 0;
-                        break;
-                    }
-                }
-
-                if (valide) {
-                    printf("Valide : commence par un terminal suivi de non-terminaux\n");
-                    continue;
-                }
-            }
-
-            // Si aucune condition n'est remplie, la production n'est pas valide
-            printf("Non valide : La production %s ne respecte pas GNF.\n", production);
-            return 0;
-        }
-    }
-    return 1; // Toutes les productions respectent GNF
-}
-
-// Fonction pour ajouter une production à une règle, en évitant les doublons
-void ajouter_production(Rule *rule, const char *production) {
-    for (int i = 0; i < rule->production_count; i++) {
-        if (strcmp(rule->productions[i], production) == 0) {
-            return; // Production déjà présente, on ne l'ajoute pas
-        }
-    }
-    strcpy(rule->productions[rule->production_count++], production);
-}
-
-// Fonction pour réécrire la grammaire sous la forme avec "|" entre les productions pour chaque non-terminal
-void rewriter_grammaire(Grammaire *grammaire) {
-    // Création d'un tableau pour stocker les nouvelles règles
-    Grammaire nouvelle_grammaire;
-    nouvelle_grammaire.rule_count = 0;
-
-    // Parcours de chaque règle
-    for (int i = 0; i < grammaire->rule_count; i++) {
-        Rule *rule = &grammaire->rules[i];
-
-        // Chercher si une règle avec le même non-terminal existe déjà dans la nouvelle grammaire
-        int found = 0;
-        for (int j = 0; j < nouvelle_grammaire.rule_count; j++) {
-            if (strcmp(nouvelle_grammaire.rules[j].non_terminal, rule->non_terminal) == 0) {
-                // Ajouter toutes les productions de cette règle à la règle correspondante
-                for (int k = 0; k < rule->production_count; k++) {
-                    ajouter_production(&nouvelle_grammaire.rules[j], rule->productions[k]);
-                }
-                found = 1;
-                break;
-            }
-        }
-
-        // Si la règle n'a pas encore été ajoutée, on l'ajoute à la nouvelle grammaire
-        if (!found) {
-            strcpy(nouvelle_grammaire.rules[nouvelle_grammaire.rule_count].non_terminal, rule->non_terminal);
-            nouvelle_grammaire.rules[nouvelle_grammaire.rule_count].production_count = 0;
-
-            for (int k = 0; k < rule->production_count; k++) {
-                ajouter_production(&nouvelle_grammaire.rules[nouvelle_grammaire.rule_count], rule->productions[k]);
-            }
-
-            nouvelle_grammaire.rule_count++;
-        }
-    }
-
-    // Copier la nouvelle grammaire dans la grammaire d'origine
-    *grammaire = nouvelle_grammaire;
-}
-
-int main() {
-    Grammaire grammaire_originale;
-
-    // Lire la grammaire depuis un fichier
-    if (lire_grammaire(&grammaire_originale, "exemple.general.txt") == -1) {
-        fprintf(stderr, "Erreur : Impossible de lire la grammaire.\n");
-        return -1;
-    }
-
-    const char *axiome = grammaire_originale.rules[0].non_terminal;
-
-    // Affichage initial de la grammaire
-    printf("Grammaire originale :\n");
-    afficher_grammaire(&grammaire_originale);
-
-    // Affichage avant réécriture
-    printf("Avant réécriture:\n");
-    afficher_grammaire(&grammaire_originale);
-
-    // Réécrire la grammaire
-    rewriter_grammaire(&grammaire_originale);
-
-    // Affichage après réécriture
-    printf("\nAprès réécriture:\n");
-    afficher_grammaire(&grammaire_originale); 
-
-    // Créer une copie de la grammaire originale pour chaque transformation
-    Grammaire grammaire_greibach = grammaire_originale;
-    Grammaire grammaire_chomsky = grammaire_originale;
-
-    // Transformation en forme normale de Greibach
-    printf("\n==== Transformation en forme normale de Greibach ====\n");
-    greibach(&grammaire_greibach, axiome);
-    sauvegarder_grammaire(&grammaire_greibach, "exemple.Transforme", 'g');
-    if (isGreibach(&grammaire_greibach)) {
-        printf("La grammaire est sous forme normale de Greibach.\n");
-    } else {
-        printf("La grammaire n'est PAS sous forme normale de Greibach.\n");
-    }
-
-    // Transformation en forme normale de Chomsky
-    printf("\n==== Transformation en forme normale de Chomsky ====\n");
-    transformer_en_chomsky(&grammaire_chomsky, axiome);
-    sauvegarder_grammaire(&grammaire_chomsky, "exemple.Transforme", 'c');
-    if (isChomsky(&grammaire_chomsky)) {
-        printf("La grammaire est en forme de Chomsky.\n");
-    } else {
-        printf("La grammaire n'est PAS en forme de Chomsky.\n");
-    }
-    
-
-    return 0;
-    
-}
\ No newline at end of file
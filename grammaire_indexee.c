@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "generate_words.h"
+
+// Retrouver (ou créer) le numéro d'un non-terminal
+static int index_non_terminal(GrammaireIndexee *indexee, const char *nom) {
+    for (int i = 0; i < indexee->nb_non_terminaux; i++) {
+        if (strcmp(indexee->noms[i], nom) == 0) return i;
+    }
+    if (indexee->nb_non_terminaux >= MAX_NT_INDEXES) {
+        fprintf(stderr, "Erreur : trop de non-terminaux (%d au plus).\n", MAX_NT_INDEXES);
+        return -1;
+    }
+    snprintf(indexee->noms[indexee->nb_non_terminaux], MAX_SYMBOLS, "%s", nom);
+    return indexee->nb_non_terminaux++;
+}
+
+// Découper une production en symboles indexés. "E" seul est le mot vide ;
+// un E au milieu d'une production est ignoré (il ne dérive que epsilon).
+static int indexer_production(GrammaireIndexee *indexee, const char *texte, ProductionIndexee *production) {
+    production->longueur = 0;
+    if (strcmp(texte, "E") == 0) return 0;
+
+    for (int i = 0; texte[i] != '\0'; ) {
+        char nom[3] = {texte[i], '\0', '\0'};
+        if (isupper((unsigned char)texte[i])) {
+            if (isdigit((unsigned char)texte[i + 1])) {
+                nom[1] = texte[i + 1];
+                i += 2;
+            } else {
+                i++;
+                if (nom[0] == 'E') continue;
+            }
+            int nt = index_non_terminal(indexee, nom);
+            if (nt == -1) return -1;
+            production->symboles[production->longueur++] = nt;
+        } else {
+            production->symboles[production->longueur++] = TERMINAL_IDX(texte[i]);
+            i++;
+        }
+    }
+    return 0;
+}
+
+// Construire la grammaire indexée. Les règles qui partagent un membre gauche
+// (plusieurs lignes "S : ...") sont regroupées.
+int indexer_grammaire(const Grammaire *grammaire, GrammaireIndexee *indexee) {
+    memset(indexee, 0, sizeof(*indexee));
+
+    int total = 0;
+    for (int i = 0; i < grammaire->rule_count; i++) total += grammaire->rules[i].production_count;
+    indexee->productions = malloc((total ? total : 1) * sizeof(ProductionIndexee));
+    if (!indexee->productions) return -1;
+
+    // L'axiome reçoit le numéro 0, puis les membres gauches dans l'ordre du fichier
+    if (index_non_terminal(indexee, grammaire->rules[0].non_terminal) == -1) return -1;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        if (index_non_terminal(indexee, grammaire->rules[i].non_terminal) == -1) return -1;
+    }
+    indexee->axiome = 0;
+    int nb_gauches = indexee->nb_non_terminaux;
+
+    for (int nt = 0; nt < nb_gauches; nt++) {
+        indexee->premiere_production[nt] = indexee->nb_productions;
+        for (int i = 0; i < grammaire->rule_count; i++) {
+            const Rule *rule = &grammaire->rules[i];
+            if (strcmp(rule->non_terminal, indexee->noms[nt]) != 0) continue;
+            for (int j = 0; j < rule->production_count; j++) {
+                ProductionIndexee *production = &indexee->productions[indexee->nb_productions];
+                production->gauche = nt;
+                production->poids = 1.0;
+                snprintf(production->texte, MAX_SYMBOLS, "%s", rule->productions[j]);
+                if (indexer_production(indexee, rule->productions[j], production) == -1) {
+                    liberer_grammaire_indexee(indexee);
+                    return -1;
+                }
+                indexee->nb_productions++;
+            }
+        }
+        indexee->nb_productions_nt[nt] = indexee->nb_productions - indexee->premiere_production[nt];
+    }
+    // Les non-terminaux sans règle (apparus seulement en membre droit) n'ont aucune production
+    for (int nt = nb_gauches; nt < indexee->nb_non_terminaux; nt++) {
+        indexee->premiere_production[nt] = indexee->nb_productions;
+        indexee->nb_productions_nt[nt] = 0;
+    }
+    return 0;
+}
+
+// Lire un fichier de poids : une ligne "X : production = poids" par production pondérée.
+// Les productions absentes du fichier gardent le poids 1.
+int lire_poids(GrammaireIndexee *indexee, const char *fichier) {
+    FILE *file = fopen(fichier, "r");
+    if (file == NULL) {
+        perror("Erreur lors de l'ouverture du fichier de poids");
+        return -1;
+    }
+
+    char line[256];
+    int numero = 0;
+    while (fgets(line, sizeof(line), file)) {
+        numero++;
+        line[strcspn(line, "\n")] = '\0';
+        nettoyer_chaine(line);
+        if (strlen(line) == 0) continue;
+
+        char *deux_points = strchr(line, ':');
+        char *egal = strrchr(line, '=');
+        if (!deux_points || !egal || egal < deux_points) {
+            fprintf(stderr, "Erreur : %s:%d : format attendu \"X : production = poids\".\n", fichier, numero);
+            fclose(file);
+            return -1;
+        }
+        *deux_points = '\0';
+        *egal = '\0';
+        char *fin;
+        double poids = strtod(egal + 1, &fin);
+        if (*fin != '\0' || poids < 0) {
+            fprintf(stderr, "Erreur : %s:%d : poids invalide.\n", fichier, numero);
+            fclose(file);
+            return -1;
+        }
+
+        int trouve = 0;
+        for (int p = 0; p < indexee->nb_productions; p++) {
+            ProductionIndexee *production = &indexee->productions[p];
+            if (strcmp(indexee->noms[production->gauche], line) == 0 &&
+                strcmp(production->texte, deux_points + 1) == 0) {
+                production->poids = poids;
+                trouve = 1;
+            }
+        }
+        if (!trouve) {
+            fprintf(stderr, "Erreur : %s:%d : production %s : %s inconnue.\n", fichier, numero, line, deux_points + 1);
+            fclose(file);
+            return -1;
+        }
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// Automate minimal de la grammaire si elle est régulière (voir automate.h) : 1 si l'automate
+// est rempli, 0 sinon, -1 si la mémoire manque
+int automate_grammaire_indexee(const GrammaireIndexee *indexee, Automate *automate) {
+    int nb = indexee->nb_productions;
+    int *gauche = malloc((nb + 1) * sizeof(int)), *debut = malloc((nb + 1) * sizeof(int));
+    int *longueur = malloc((nb + 1) * sizeof(int)), *symboles = malloc(((size_t)nb * MAX_SYMBOLS + 1) * sizeof(int));
+    int statut = -1;
+    if (gauche && debut && longueur && symboles) {
+        int position = 0;
+        for (int p = 0; p < nb; p++) {
+            const ProductionIndexee *production = &indexee->productions[p];
+            gauche[p] = production->gauche;
+            debut[p] = position;
+            longueur[p] = production->longueur;
+            memcpy(symboles + position, production->symboles, production->longueur * sizeof(int));
+            position += production->longueur;
+        }
+        GrammaireSymboles description = { indexee->nb_non_terminaux, indexee->axiome, nb, gauche, debut, longueur, symboles };
+        statut = compiler_automate(&description, AUTOMATE_MAX_SOUS_ENSEMBLES, automate);
+    }
+    free(gauche);
+    free(debut);
+    free(longueur);
+    free(symboles);
+    return statut;
+}
+
+void liberer_grammaire_indexee(GrammaireIndexee *indexee) {
+    free(indexee->productions);
+    indexee->productions = NULL;
+    indexee->nb_productions = 0;
+}
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "grand_entier.h"
+
+void ge_zero(GrandEntier *r) {
+    memset(r, 0, sizeof(*r));
+}
+
+void ge_depuis_u64(GrandEntier *r, uint64_t valeur) {
+    ge_zero(r);
+    r->l[0] = valeur;
+}
+
+static void ge_saturer(GrandEntier *r) {
+    memset(r, 0xFF, sizeof(*r));
+}
+
+int ge_est_zero(const GrandEntier *a) {
+    for (int i = 0; i < GE_LIMBES; i++) {
+        if (a->l[i]) return 0;
+    }
+    return 1;
+}
+
+int ge_est_sature(const GrandEntier *a) {
+    for (int i = 0; i < GE_LIMBES; i++) {
+        if (a->l[i] != UINT64_MAX) return 0;
+    }
+    return 1;
+}
+
+int ge_comparer(const GrandEntier *a, const GrandEntier *b) {
+    for (int i = GE_LIMBES - 1; i >= 0; i--) {
+        if (a->l[i] != b->l[i]) return a->l[i] < b->l[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+void ge_ajouter(GrandEntier *r, const GrandEntier *a, const GrandEntier *b) {
+    if (ge_est_sature(a) || ge_est_sature(b)) {
+        ge_saturer(r);
+        return;
+    }
+    unsigned __int128 retenue = 0;
+    for (int i = 0; i < GE_LIMBES; i++) {
+        retenue += (unsigned __int128)a->l[i] + b->l[i];
+        r->l[i] = (uint64_t)retenue;
+        retenue >>= 64;
+    }
+    if (retenue || ge_est_sature(r)) ge_saturer(r);
+}
+
+// r = a - b, avec a >= b
+void ge_soustraire(GrandEntier *r, const GrandEntier *a, const GrandEntier *b) {
+    if (ge_est_sature(a)) {
+        ge_saturer(r);
+        return;
+    }
+    uint64_t emprunt = 0;
+    for (int i = 0; i < GE_LIMBES; i++) {
+        uint64_t x = a->l[i], y = b->l[i];
+        uint64_t d = x - y - emprunt;
+        emprunt = (x < y || (x == y && emprunt)) ? 1 : 0;
+        r->l[i] = d;
+    }
+}
+
+void ge_multiplier(GrandEntier *r, const GrandEntier *a, const GrandEntier *b) {
+    if (ge_est_zero(a) || ge_est_zero(b)) {
+        ge_zero(r);
+        return;
+    }
+    if (ge_est_sature(a) || ge_est_sature(b)) {
+        ge_saturer(r);
+        return;
+    }
+    int na = GE_LIMBES, nb = GE_LIMBES;
+    while (na > 0 && a->l[na - 1] == 0) na--;
+    while (nb > 0 && b->l[nb - 1] == 0) nb--;
+    if (na + nb > GE_LIMBES + 1) {
+        ge_saturer(r);
+        return;
+    }
+
+    uint64_t resultat[2 * GE_LIMBES] = {0};
+    for (int i = 0; i < na; i++) {
+        unsigned __int128 retenue = 0;
+        for (int j = 0; j < nb; j++) {
+            retenue += (unsigned __int128)a->l[i] * b->l[j] + resultat[i + j];
+            resultat[i + j] = (uint64_t)retenue;
+            retenue >>= 64;
+        }
+        resultat[i + nb] = (uint64_t)retenue;
+    }
+    for (int i = GE_LIMBES; i < 2 * GE_LIMBES; i++) {
+        if (resultat[i]) {
+            ge_saturer(r);
+            return;
+        }
+    }
+    memcpy(r->l, resultat, sizeof(r->l));
+    if (ge_est_sature(r)) ge_saturer(r);
+}
+
+// r += a * b
+void ge_ajouter_produit(GrandEntier *r, const GrandEntier *a, const GrandEntier *b) {
+    GrandEntier produit;
+    ge_multiplier(&produit, a, b);
+    ge_ajouter(r, r, &produit);
+}
+
+// Lire un entier décimal ; -1 si le texte n'est pas un entier ou s'il est trop grand
+int ge_lire(GrandEntier *r, const char *texte) {
+    GrandEntier dix, chiffre;
+    ge_zero(r);
+    ge_depuis_u64(&dix, 10);
+    if (*texte == '\0') return -1;
+    for (; *texte; texte++) {
+        if (*texte < '0' || *texte > '9') return -1;
+        ge_depuis_u64(&chiffre, *texte - '0');
+        ge_multiplier(r, r, &dix);
+        ge_ajouter(r, r, &chiffre);
+        if (ge_est_sature(r)) return -1;
+    }
+    return 0;
+}
+
+// Écrire en décimal (au plus 155 chiffres pour 512 bits)
+void ge_ecrire(const GrandEntier *a, char *tampon, size_t taille) {
+    if (ge_est_sature(a)) {
+        snprintf(tampon, taille, "inf");
+        return;
+    }
+    GrandEntier q = *a;
+    char chiffres[GE_LIMBES * 20 + 1];
+    int n = 0;
+    do {
+        // Division par 10^19 limbe par limbe
+        const uint64_t base = 10000000000000000000ULL;
+        unsigned __int128 reste = 0;
+        for (int i = GE_LIMBES - 1; i >= 0; i--) {
+            unsigned __int128 courant = (reste << 64) | q.l[i];
+            q.l[i] = (uint64_t)(courant / base);
+            reste = courant % base;
+        }
+        uint64_t bloc = (uint64_t)reste;
+        int zero = ge_est_zero(&q);
+        for (int k = 0; k < 19 && (bloc || !zero); k++) {
+            chiffres[n++] = '0' + bloc % 10;
+            bloc /= 10;
+        }
+        if (zero && n == 0) chiffres[n++] = '0';
+    } while (!ge_est_zero(&q));
+
+    size_t i = 0;
+    for (; i + 1 < taille && n > 0; i++) tampon[i] = chiffres[--n];
+    if (taille > 0) tampon[i] = '\0';
+}
@@ -0,0 +1,28 @@
+#ifndef GRAND_ENTIER_H
+#define GRAND_ENTIER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Entiers naturels de taille fixe (512 bits) pour les comptages exacts.
+// Les opérations saturent : un résultat trop grand devient GE_SATURE, valeur qui
+// reste plus grande que tout entier représentable et que ge_est_sature détecte.
+#define GE_LIMBES 8
+
+typedef struct {
+    uint64_t l[GE_LIMBES];   // Poids faible en premier
+} GrandEntier;
+
+void ge_zero(GrandEntier *r);
+void ge_depuis_u64(GrandEntier *r, uint64_t valeur);
+int ge_est_zero(const GrandEntier *a);
+int ge_est_sature(const GrandEntier *a);
+int ge_comparer(const GrandEntier *a, const GrandEntier *b);
+void ge_ajouter(GrandEntier *r, const GrandEntier *a, const GrandEntier *b);
+void ge_soustraire(GrandEntier *r, const GrandEntier *a, const GrandEntier *b);
+void ge_multiplier(GrandEntier *r, const GrandEntier *a, const GrandEntier *b);
+void ge_ajouter_produit(GrandEntier *r, const GrandEntier *a, const GrandEntier *b);
+int ge_lire(GrandEntier *r, const char *texte);
+void ge_ecrire(const GrandEntier *a, char *tampon, size_t taille);
+
+#endif
@@ -0,0 +1,409 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "generate_words.h"
+
+// Itérateur de mots : l'appelant tire les mots un par un, sans fichier intermédiaire.
+//
+// ORDRE_HIERARCHIQUE parcourt chaque longueur avec un CurseurLex (rang.c) : mots distincts,
+// par longueur croissante puis dans l'ordre de strcmp, comme le fichier de generer_mots.
+// Un langage fini est lu sur ses ensembles de mots (fini.c) et une grammaire régulière
+// parcourue sur son automate minimal (automate.c), dans le même ordre, sans table de comptage.
+// ORDRE_DERIVATION suit les dérivations gauches en profondeur, productions dans l'ordre du
+// fichier : les mots sortent dès qu'ils sont trouvés, une fois par dérivation.
+// Dans les deux cas la mémoire dépend de la grammaire et de longueur_max, pas du nombre
+// de mots déjà produits.
+
+// Un choix de production en attente : la pile sous le non-terminal développé
+// (sommet en dernier) est copiée dans piles_cadres à partir de debut_pile
+typedef struct {
+    size_t debut_pile;
+    int hauteur;
+    int prefixe;          // Nombre de lettres déjà lues quand le non-terminal a été développé
+    int production;       // Prochaine production à essayer
+    int fin_production;
+} Cadre;
+
+struct IterateurMots {
+    GrammaireIndexee grammaire;
+    OrdreIteration ordre;
+    int longueur_max;
+    atomic_int annule;
+    char *mot;
+
+    // ORDRE_HIERARCHIQUE
+    CurseurLex *curseur;
+    int fini;                // 1 : mots lus dans le langage fini à la place du curseur
+    LangageFini langage;
+    size_t position;
+    int reguliere;           // 1 : parcours de l'automate à la place du curseur
+    Automate automate;
+    ParcoursAutomate parcours;
+    const char *courant;     // Dernier mot du langage fini ou de l'automate
+    int longueur;            // Longueur en cours, -1 avant le premier mot
+
+    // ORDRE_DERIVATION
+    int demarre;
+    int profondeur_max;
+    int *longueur_min;       // Longueur minimale des mots dérivés de chaque non-terminal
+    Cadre *cadres;
+    int nb_cadres;
+    int *piles_cadres;
+    size_t taille_piles, capacite_piles;
+    int *courante;           // Pile de la dérivation en cours, sommet en dernier
+    int hauteur_courante, capacite_courante;
+};
+
+#define LONGUEUR_INFINIE (MAX_WORD_LEN + 1)
+
+// Longueur minimale de chaque non-terminal (point fixe, LONGUEUR_INFINIE si improductif)
+static void calculer_longueurs_min(const GrammaireIndexee *grammaire, int *longueur_min) {
+    for (int nt = 0; nt < grammaire->nb_non_terminaux; nt++) longueur_min[nt] = LONGUEUR_INFINIE;
+    int change = 1;
+    while (change) {
+        change = 0;
+        for (int p = 0; p < grammaire->nb_productions; p++) {
+            const ProductionIndexee *production = &grammaire->productions[p];
+            int total = 0;
+            for (int j = 0; j < production->longueur && total < LONGUEUR_INFINIE; j++) {
+                int symbole = production->symboles[j];
+                total += EST_TERMINAL_IDX(symbole) ? 1 : longueur_min[symbole];
+            }
+            if (total > LONGUEUR_INFINIE) total = LONGUEUR_INFINIE;
+            if (total < longueur_min[production->gauche]) {
+                longueur_min[production->gauche] = total;
+                change = 1;
+            }
+        }
+    }
+}
+
+static int reserver_courante(IterateurMots *it, int hauteur) {
+    if (hauteur <= it->capacite_courante) return 0;
+    int capacite = it->capacite_courante * 2;
+    if (capacite < hauteur) capacite = hauteur;
+    int *tab = realloc(it->courante, capacite * sizeof(int));
+    if (!tab) return -1;
+    it->courante = tab;
+    it->capacite_courante = capacite;
+    return 0;
+}
+
+// Sauvegarder la pile courante (sans son sommet) dans un nouveau cadre
+static int empiler_cadre(IterateurMots *it, int non_terminal, int prefixe) {
+    int hauteur = it->hauteur_courante - 1;
+    if (it->taille_piles + hauteur > it->capacite_piles) {
+        size_t capacite = it->capacite_piles * 2;
+        if (capacite < it->taille_piles + hauteur) capacite = it->taille_piles + hauteur;
+        int *tab = realloc(it->piles_cadres, capacite * sizeof(int));
+        if (!tab) return -1;
+        it->piles_cadres = tab;
+        it->capacite_piles = capacite;
+    }
+    Cadre *cadre = &it->cadres[it->nb_cadres++];
+    cadre->debut_pile = it->taille_piles;
+    cadre->hauteur = hauteur;
+    cadre->prefixe = prefixe;
+    cadre->production = it->grammaire.premiere_production[non_terminal];
+    cadre->fin_production = cadre->production + it->grammaire.nb_productions_nt[non_terminal];
+    memcpy(it->piles_cadres + it->taille_piles, it->courante, hauteur * sizeof(int));
+    it->taille_piles += hauteur;
+    return 0;
+}
+
+static void depiler_cadre(IterateurMots *it) {
+    it->nb_cadres--;
+    it->taille_piles = it->cadres[it->nb_cadres].debut_pile;
+}
+
+// Lire les terminaux au sommet de la pile courante puis, si elle n'est pas vide,
+// mettre le non-terminal du sommet en attente de développement.
+// Renvoie 1 si un mot est complet, 0 si la branche continue ou est abandonnée, -1 en cas d'erreur.
+static int descendre(IterateurMots *it, int prefixe) {
+    while (it->hauteur_courante > 0 && EST_TERMINAL_IDX(it->courante[it->hauteur_courante - 1])) {
+        if (prefixe >= it->longueur_max) return 0;
+        it->mot[prefixe++] = CARACTERE_TERMINAL(it->courante[--it->hauteur_courante]);
+    }
+    if (it->hauteur_courante == 0) {
+        it->mot[prefixe] = '\0';
+        it->longueur = prefixe;
+        return 1;
+    }
+
+    int minimum = prefixe;
+    for (int i = 0; i < it->hauteur_courante && minimum <= it->longueur_max; i++) {
+        int symbole = it->courante[i];
+        minimum += EST_TERMINAL_IDX(symbole) ? 1 : it->longueur_min[symbole];
+    }
+    if (minimum > it->longueur_max || it->nb_cadres >= it->profondeur_max) return 0;
+    return empiler_cadre(it, it->courante[it->hauteur_courante - 1], prefixe);
+}
+
+static int suivant_derivation(IterateurMots *it) {
+    if (!it->demarre) {
+        it->demarre = 1;
+        it->courante[0] = it->grammaire.axiome;
+        it->hauteur_courante = 1;
+        int statut = descendre(it, 0);
+        if (statut != 0) return statut;
+    }
+
+    while (it->nb_cadres > 0) {
+        if (atomic_load(&it->annule)) return 0;
+        Cadre *cadre = &it->cadres[it->nb_cadres - 1];
+        if (cadre->production == cadre->fin_production) {
+            depiler_cadre(it);
+            continue;
+        }
+        const ProductionIndexee *production = &it->grammaire.productions[cadre->production++];
+        if (reserver_courante(it, cadre->hauteur + production->longueur) == -1) return -1;
+        memcpy(it->courante, it->piles_cadres + cadre->debut_pile, cadre->hauteur * sizeof(int));
+        it->hauteur_courante = cadre->hauteur;
+        for (int j = production->longueur - 1; j >= 0; j--) {
+            it->courante[it->hauteur_courante++] = production->symboles[j];
+        }
+        int statut = descendre(it, cadre->prefixe);
+        if (statut != 0) return statut;
+    }
+    return 0;
+}
+
+static int suivant_hierarchique(IterateurMots *it) {
+    if (it->fini) {
+        const MotsFinis *axiome = it->langage.langage;
+        if (it->position == axiome->mots.nombre) return 0;
+        it->courant = axiome->mots.tries[it->position++];
+        it->longueur = (int)strlen(it->courant);
+        return it->longueur <= it->longueur_max;
+    }
+    if (it->reguliere) {
+        size_t longueur;
+        int statut = parcours_automate_suivant(&it->parcours, &it->courant, &longueur);
+        if (statut == 1) it->longueur = (int)longueur;
+        return statut;
+    }
+    if (it->longueur >= 0) {
+        int statut = curseur_lex_suivant(it->curseur);
+        if (statut != 0) return statut;
+    }
+    GrandEntier zero;
+    ge_zero(&zero);
+    while (++it->longueur <= it->longueur_max) {
+        if (atomic_load(&it->annule)) return 0;
+        int statut = curseur_lex_positionner(it->curseur, it->longueur, &zero);
+        if (statut != 0) return statut;
+    }
+    return 0;
+}
+
+// Ouvrir un itérateur sur les mots de longueur <= longueur_max. La grammaire est copiée
+// sous forme indexée : elle peut être libérée dès le retour.
+IterateurMots *iterateur_ouvrir(const Grammaire *grammaire, int longueur_max, OrdreIteration ordre) {
+    if (longueur_max < 0 || longueur_max >= MAX_WORD_LEN) {
+        fprintf(stderr, "Erreur : longueur invalide : %d\n", longueur_max);
+        return NULL;
+    }
+    IterateurMots *it = calloc(1, sizeof(IterateurMots));
+    if (!it) {
+        perror("Erreur d'allocation");
+        return NULL;
+    }
+    if (indexer_grammaire(grammaire, &it->grammaire) == -1) {
+        free(it);
+        return NULL;
+    }
+    it->ordre = ordre;
+    it->longueur_max = longueur_max;
+    it->longueur = -1;
+    atomic_init(&it->annule, 0);
+    it->mot = malloc(longueur_max + 1);
+    if (!it->mot) goto erreur;
+
+    if (ordre == ORDRE_HIERARCHIQUE) {
+        it->fini = langage_fini_construire(&it->langage, &it->grammaire);
+        if (it->fini == -1) {
+            it->fini = 0;
+            iterateur_fermer(it);
+            return NULL;
+        }
+        if (it->fini) return it;
+        it->reguliere = automate_grammaire_indexee(&it->grammaire, &it->automate);
+        if (it->reguliere == -1) {
+            it->reguliere = 0;
+            goto erreur;
+        }
+        if (it->reguliere) {
+            if (parcours_automate_ouvrir(&it->parcours, &it->automate, longueur_max) == -1) goto erreur;
+            return it;
+        }
+        it->curseur = curseur_lex_creer(&it->grammaire, longueur_max);
+        if (!it->curseur) {
+            iterateur_fermer(it);
+            return NULL;
+        }
+    } else {
+        // Même borne que generer_mots_recursif, plus le développement de l'axiome
+        it->profondeur_max = 2 * longueur_max + 1;
+        it->longueur_min = malloc(it->grammaire.nb_non_terminaux * sizeof(int));
+        it->cadres = malloc(it->profondeur_max * sizeof(Cadre));
+        if (!it->longueur_min || !it->cadres || reserver_courante(it, MAX_SYMBOLS) == -1) goto erreur;
+        calculer_longueurs_min(&it->grammaire, it->longueur_min);
+    }
+    return it;
+
+erreur:
+    perror("Erreur d'allocation");
+    iterateur_fermer(it);
+    return NULL;
+}
+
+// Mot suivant : *mot reste valide jusqu'au prochain appel. Le mot vide est "" (longueur 0).
+// Renvoie 1 si un mot est produit, 0 à la fin ou après iterateur_annuler, -1 en cas d'erreur.
+int iterateur_suivant(IterateurMots *it, const char **mot, size_t *longueur) {
+    if (atomic_load(&it->annule)) return 0;
+    int statut;
+    if (it->ordre == ORDRE_HIERARCHIQUE) {
+        statut = suivant_hierarchique(it);
+        if (statut == 1) {
+            *mot = it->fini || it->reguliere ? it->courant : curseur_lex_mot(it->curseur);
+            *longueur = (size_t)it->longueur;
+        }
+    } else {
+        statut = suivant_derivation(it);
+        if (statut == 1) {
+            *mot = it->mot;
+            *longueur = (size_t)it->longueur;
+        }
+    }
+    if (statut == -1) fprintf(stderr, "Erreur : l'itération des mots a échoué.\n");
+    if (statut != 1) atomic_store(&it->annule, 1);
+    return statut;
+}
+
+// Arrêter l'itération : les appels suivants à iterateur_suivant renvoient 0.
+// Peut être appelée depuis un autre thread que celui qui consomme les mots.
+void iterateur_annuler(IterateurMots *it) {
+    atomic_store(&it->annule, 1);
+}
+
+// Sauvegarder l'état de l'itérateur (point de reprise, voir reprise.c). Ordre
+// hiérarchique : longueur et dernier mot produit, les mots étant distincts. Ordre des
+// dérivations : pile des cadres et lettres déjà lues par le cadre du sommet.
+int iterateur_sauvegarder(const IterateurMots *it, FILE *flux) {
+    if (it->ordre == ORDRE_HIERARCHIQUE) {
+        const char *mot = it->fini || it->reguliere ? it->courant : curseur_lex_mot(it->curseur);
+        int longueur = mot ? it->longueur : -1;
+        if (fprintf(flux, "hierarchique %d ", longueur) < 0) return -1;
+        if (longueur > 0 && fwrite(mot, 1, longueur, flux) != (size_t)longueur) return -1;
+        return putc('\n', flux) == EOF ? -1 : 0;
+    }
+    int prefixe = it->nb_cadres > 0 ? it->cadres[it->nb_cadres - 1].prefixe : 0;
+    if (fprintf(flux, "derivation %d %d %zu %d ", it->demarre, it->nb_cadres, it->taille_piles, prefixe) < 0 ||
+        fwrite(it->mot, 1, prefixe, flux) != (size_t)prefixe || putc('\n', flux) == EOF) {
+        return -1;
+    }
+    for (int c = 0; c < it->nb_cadres; c++) {
+        const Cadre *cadre = &it->cadres[c];
+        if (fprintf(flux, "%zu %d %d %d %d\n", cadre->debut_pile, cadre->hauteur, cadre->prefixe, cadre->production,
+                    cadre->fin_production) < 0) {
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < it->taille_piles; i++) {
+        if (fprintf(flux, i + 1 < it->taille_piles ? "%d " : "%d", it->piles_cadres[i]) < 0) return -1;
+    }
+    return putc('\n', flux) == EOF ? -1 : 0;
+}
+
+// Lire n octets suivis d'une fin de ligne
+static int lire_octets(FILE *flux, char *tampon, int n) {
+    if (n > 0 && fread(tampon, 1, n, flux) != (size_t)n) return -1;
+    tampon[n] = '\0';
+    return getc(flux) == '\n' ? 0 : -1;
+}
+
+// Remettre un itérateur tout juste ouvert dans l'état sauvegardé par iterateur_sauvegarder,
+// pour la même grammaire, la même longueur et le même ordre.
+// Renvoie 0, -1 si l'état est illisible ou ne correspond pas à l'itérateur.
+int iterateur_restaurer(IterateurMots *it, FILE *flux) {
+    int longueur;
+    if (it->ordre == ORDRE_HIERARCHIQUE) {
+        if (fscanf(flux, "hierarchique %d", &longueur) != 1 || getc(flux) != ' ') return -1;
+        if (longueur < -1 || longueur > it->longueur_max) return -1;
+        if (longueur == -1) return getc(flux) == '\n' ? 0 : -1;
+        if (lire_octets(flux, it->mot, longueur) == -1) return -1;
+        if (it->fini) {
+            long i = langage_fini_chercher(&it->langage, it->mot);
+            if (i < 0) return -1;
+            it->position = (size_t)i + 1;
+            it->courant = it->langage.langage->mots.tries[i];
+        } else if (it->reguliere) {
+            if (parcours_automate_placer(&it->parcours, it->mot, (size_t)longueur) != 1) return -1;
+            it->courant = it->parcours.mot;
+        } else {
+            GrandEntier rang, multiplicite;
+            if (curseur_lex_rang(it->curseur, it->mot, &rang, &multiplicite) != 1) return -1;
+        }
+        it->longueur = longueur;
+        return 0;
+    }
+
+    int demarre, nb_cadres;
+    size_t taille_piles;
+    if (fscanf(flux, "derivation %d %d %zu %d", &demarre, &nb_cadres, &taille_piles, &longueur) != 4 ||
+        getc(flux) != ' ') {
+        return -1;
+    }
+    if (nb_cadres < 0 || nb_cadres > it->profondeur_max || longueur < 0 || longueur > it->longueur_max ||
+        taille_piles > (size_t)nb_cadres * MAX_SYMBOLS * (it->longueur_max + 1) || lire_octets(flux, it->mot, longueur) == -1) {
+        return -1;
+    }
+    if (taille_piles > it->capacite_piles) {
+        int *tab = realloc(it->piles_cadres, taille_piles * sizeof(int));
+        if (!tab) return -1;
+        it->piles_cadres = tab;
+        it->capacite_piles = taille_piles;
+    }
+    const GrammaireIndexee *grammaire = &it->grammaire;
+    for (int c = 0; c < nb_cadres; c++) {
+        Cadre *cadre = &it->cadres[c];
+        if (fscanf(flux, "%zu %d %d %d %d", &cadre->debut_pile, &cadre->hauteur, &cadre->prefixe, &cadre->production,
+                   &cadre->fin_production) != 5) {
+            return -1;
+        }
+        if (cadre->hauteur < 0 || cadre->debut_pile + cadre->hauteur > taille_piles || cadre->prefixe < 0 ||
+            cadre->prefixe > longueur || cadre->production < 0 || cadre->production > cadre->fin_production ||
+            cadre->fin_production > grammaire->nb_productions) {
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < taille_piles; i++) {
+        int symbole;
+        if (fscanf(flux, "%d", &symbole) != 1 || symbole >= grammaire->nb_non_terminaux || symbole < -256) return -1;
+        it->piles_cadres[i] = symbole;
+    }
+    if (getc(flux) != '\n') return -1;
+    it->demarre = demarre != 0;
+    it->nb_cadres = nb_cadres;
+    it->taille_piles = taille_piles;
+    return 0;
+}
+
+void iterateur_fermer(IterateurMots *it) {
+    if (!it) return;
+    curseur_lex_liberer(it->curseur);
+    if (it->fini) langage_fini_liberer(&it->langage);
+    if (it->reguliere) {
+        parcours_automate_fermer(&it->parcours);
+        liberer_automate(&it->automate);
+    }
+    free(it->longueur_min);
+    free(it->cadres);
+    free(it->piles_cadres);
+    free(it->courante);
+    free(it->mot);
+    liberer_grammaire_indexee(&it->grammaire);
+    free(it);
+}
@@ -0,0 +1,804 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "libgrammaire.h"
+
+// Analyse LALR(1), voir libgrammaire.h.
+//
+// Un item (production p, point d) est numéroté premier_item[p] + d. Un état est l'ensemble
+// de ses items noyau, triés ; sa fermeture ajoute les productions des non-terminaux placés
+// après un point. Les prévisions ne sont gardées que pour les items noyau : celles de la
+// fermeture se recalculent (PREMIER de la suite, et prévision de l'item si la suite
+// s'efface), puis passent aux items noyau des états successeurs, jusqu'au point fixe.
+// C'est la fusion des états LR(1) de même noyau, c'est-à-dire LALR(1).
+
+#define EST_TERMINAL(s) ((s) < 0)
+#define CARACTERE(s) ((char)(-1 - (s)))
+
+typedef struct {
+    TableLALR *table;
+    int nb_symboles_nt;            // Non-terminaux, S' compris
+    int *premiere_production;      // Par non-terminal (productions consécutives)
+    int *nb_productions_nt;
+    int *premier_item;             // Par production
+    int *production_de_item;       // Par item
+    int nb_items;
+    unsigned char *annulable;
+    unsigned char *premier;        // nb_symboles_nt × nb_colonnes
+
+    // États : noyau[debut_noyau[e] .. debut_noyau[e + 1] - 1]
+    int nb_etats, capacite_etats;
+    int *debut_noyau;
+    unsigned *hachage;
+    int *seau, nb_seaux;           // Premier état de chaque seau de hachage, -1 si vide
+    int *etat_suivant;             // État suivant dans le même seau
+    int *noyau;
+    int taille_noyau, capacite_noyau;
+    unsigned char *prevision;      // Une ligne par item noyau (indice dans noyau)
+
+    // Transitions de chaque état, par symbole
+    int *debut_transitions;
+    int *symbole_transition, *cible_transition;
+    int nb_transitions, capacite_transitions;
+
+    // Tampons de fermeture
+    int *fermeture;
+    unsigned char *ajoute;         // Par non-terminal
+    unsigned char *prevision_nt;   // nb_symboles_nt × nb_colonnes
+} Construction;
+
+static int signaler_memoire(ContexteGrammaire *ctx) {
+    return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+}
+
+void liberer_table_lalr(TableLALR *table) {
+    free(table->noms);
+    free(table->gauche);
+    free(table->debut);
+    free(table->longueur);
+    free(table->symboles);
+    free(table->defaut);
+    free(table->base_action);
+    free(table->action);
+    free(table->controle_action);
+    free(table->base_aller);
+    free(table->aller);
+    free(table->controle_aller);
+    memset(table, 0, sizeof(*table));
+}
+
+static void liberer_construction(Construction *c) {
+    free(c->premiere_production);
+    free(c->nb_productions_nt);
+    free(c->premier_item);
+    free(c->production_de_item);
+    free(c->annulable);
+    free(c->premier);
+    free(c->debut_noyau);
+    free(c->hachage);
+    free(c->seau);
+    free(c->etat_suivant);
+    free(c->noyau);
+    free(c->prevision);
+    free(c->debut_transitions);
+    free(c->symbole_transition);
+    free(c->cible_transition);
+    free(c->fermeture);
+    free(c->ajoute);
+    free(c->prevision_nt);
+}
+
+// Découper les productions, la production 0 étant S' -> axiome
+static int decouper(ContexteGrammaire *ctx, const Grammaire *grammaire, TableLALR *t) {
+    memset(t, 0, sizeof(*t));
+    int n = grammaire->rule_count;
+    size_t total = 1;
+    t->nb_productions = 1;
+    for (int i = 0; i < n; i++) {
+        t->nb_productions += grammaire->rules[i].production_count;
+        for (int j = 0; j < grammaire->rules[i].production_count; j++) total += strlen(grammaire->rules[i].productions[j]);
+    }
+    t->nb_non_terminaux = n;
+    t->noms = malloc((n + 1) * sizeof(*t->noms));
+    t->gauche = malloc(t->nb_productions * sizeof(int));
+    t->debut = malloc(t->nb_productions * sizeof(int));
+    t->longueur = malloc(t->nb_productions * sizeof(int));
+    t->symboles = malloc(total * sizeof(int));
+    if (!t->noms || !t->gauche || !t->debut || !t->longueur || !t->symboles) {
+        liberer_table_lalr(t);
+        return signaler_memoire(ctx);
+    }
+
+    for (int c = 0; c < 256; c++) t->colonne[c] = -1;
+    snprintf(t->noms[n], MAX_SYMBOLS, "%.*s'", MAX_SYMBOLS - 2, n > 0 ? grammaire->rules[0].non_terminal : "S");
+    t->gauche[0] = n;
+    t->debut[0] = 0;
+    t->longueur[0] = 1;
+    t->symboles[0] = 0;
+    int position = 1, p = 1;
+    for (int i = 0; i < n; i++) {
+        strcpy(t->noms[i], grammaire->rules[i].non_terminal);
+        for (int j = 0; j < grammaire->rules[i].production_count; j++, p++) {
+            const char *production = grammaire->rules[i].productions[j];
+            t->gauche[p] = i;
+            t->debut[p] = position;
+            for (int k = 0, taille; production[k] != '\0'; k += taille) {
+                int symbole = lire_symbole(grammaire, production + k, &taille);
+                if (symbole == SYMBOLE_INCONNU) {
+                    int code = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Non-terminal sans règle dans %s : %s",
+                                                           grammaire->rules[i].non_terminal, production);
+                    liberer_table_lalr(t);
+                    return code;
+                }
+                if (symbole == SYMBOLE_EPSILON) continue;
+                if (EST_TERMINAL(symbole) && t->colonne[(unsigned char)CARACTERE(symbole)] == -1) {
+                    t->colonne[(unsigned char)CARACTERE(symbole)] = t->nb_colonnes;
+                    t->colonnes[t->nb_colonnes++] = CARACTERE(symbole);
+                }
+                t->symboles[position++] = symbole;
+            }
+            t->longueur[p] = position - t->debut[p];
+        }
+    }
+    t->colonnes[t->nb_colonnes++] = LL1_FIN;
+    t->colonnes[t->nb_colonnes] = '\0';
+    return GRAMMAIRE_OK;
+}
+
+static int reunir(unsigned char *destination, const unsigned char *source, int nb_colonnes) {
+    int change = 0;
+    for (int k = 0; k < nb_colonnes; k++) {
+        if (source[k] && !destination[k]) destination[k] = change = 1;
+    }
+    return change;
+}
+
+static int preparer(ContexteGrammaire *ctx, Construction *c) {
+    TableLALR *t = c->table;
+    int nt = t->nb_non_terminaux + 1, colonnes = t->nb_colonnes;
+    c->nb_symboles_nt = nt;
+    c->premiere_production = calloc(nt, sizeof(int));
+    c->nb_productions_nt = calloc(nt, sizeof(int));
+    c->premier_item = malloc(t->nb_productions * sizeof(int));
+    c->annulable = calloc(nt, 1);
+    c->premier = calloc((size_t)nt * colonnes, 1);
+    c->ajoute = calloc(nt, 1);
+    c->prevision_nt = calloc((size_t)nt * colonnes, 1);
+    if (!c->premiere_production || !c->nb_productions_nt || !c->premier_item || !c->annulable || !c->premier ||
+        !c->ajoute || !c->prevision_nt) {
+        return signaler_memoire(ctx);
+    }
+    for (int p = t->nb_productions - 1; p >= 0; p--) {
+        c->premiere_production[t->gauche[p]] = p;
+        c->nb_productions_nt[t->gauche[p]]++;
+    }
+    for (int p = 0; p < t->nb_productions; p++) {
+        c->premier_item[p] = c->nb_items;
+        c->nb_items += t->longueur[p] + 1;
+    }
+    c->fermeture = malloc((c->nb_items + 1) * sizeof(int));
+    c->production_de_item = malloc((c->nb_items + 1) * sizeof(int));
+    if (!c->fermeture || !c->production_de_item) return signaler_memoire(ctx);
+    for (int p = 0; p < t->nb_productions; p++) {
+        for (int d = 0; d <= t->longueur[p]; d++) c->production_de_item[c->premier_item[p] + d] = p;
+    }
+
+    // Annulables et PREMIER
+    for (int change = 1; change; ) {
+        change = 0;
+        for (int p = 0; p < t->nb_productions; p++) {
+            int a = t->gauche[p], k = 0;
+            for (; k < t->longueur[p]; k++) {
+                int s = t->symboles[t->debut[p] + k];
+                if (EST_TERMINAL(s)) {
+                    unsigned char *case_premier = &c->premier[a * colonnes + t->colonne[(unsigned char)CARACTERE(s)]];
+                    if (!*case_premier) *case_premier = change = 1;
+                    break;
+                }
+                change |= reunir(&c->premier[a * colonnes], &c->premier[s * colonnes], colonnes);
+                if (!c->annulable[s]) break;
+            }
+            if (k == t->longueur[p] && !c->annulable[a]) c->annulable[a] = change = 1;
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+
+static int production_item(const Construction *c, int item) {
+    return c->production_de_item[item];
+}
+
+// Fermeture d'un état : ses items noyau, puis les items (B -> ·γ) ; renvoie leur nombre
+static int fermer(Construction *c, const int *noyau, int taille) {
+    const TableLALR *t = c->table;
+    memset(c->ajoute, 0, c->nb_symboles_nt);
+    int nb = 0;
+    for (int i = 0; i < taille; i++) c->fermeture[nb++] = noyau[i];
+    for (int i = 0; i < nb; i++) {
+        int p = production_item(c, c->fermeture[i]), point = c->fermeture[i] - c->premier_item[p];
+        if (point == t->longueur[p]) continue;
+        int s = t->symboles[t->debut[p] + point];
+        if (EST_TERMINAL(s) || c->ajoute[s]) continue;
+        c->ajoute[s] = 1;
+        for (int q = c->premiere_production[s]; q < c->premiere_production[s] + c->nb_productions_nt[s]; q++) {
+            c->fermeture[nb++] = c->premier_item[q];
+        }
+    }
+    return nb;
+}
+
+static unsigned hacher_noyau(const int *noyau, int taille) {
+    unsigned h = 2166136261u;
+    for (int i = 0; i < taille; i++) h = (h ^ (unsigned)noyau[i]) * 16777619u;
+    return h;
+}
+
+static int comparer_entiers(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// État de ce noyau (trié), créé s'il n'existe pas encore ; -1 si la mémoire manque
+static int etat_du_noyau(Construction *c, const int *noyau, int taille) {
+    unsigned h = hacher_noyau(noyau, taille);
+    for (int e = c->nb_seaux ? c->seau[h & (c->nb_seaux - 1)] : -1; e != -1; e = c->etat_suivant[e]) {
+        int debut = c->debut_noyau[e];
+        if (c->hachage[e] == h && c->debut_noyau[e + 1] - debut == taille &&
+            memcmp(&c->noyau[debut], noyau, taille * sizeof(int)) == 0) {
+            return e;
+        }
+    }
+    if (c->nb_etats + 1 >= c->capacite_etats) {
+        int capacite = c->capacite_etats ? 2 * c->capacite_etats : 64;
+        int *debut = realloc(c->debut_noyau, (capacite + 1) * sizeof(int));
+        if (!debut) return -1;
+        c->debut_noyau = debut;
+        unsigned *hachage = realloc(c->hachage, capacite * sizeof(unsigned));
+        if (!hachage) return -1;
+        c->hachage = hachage;
+        int *transitions = realloc(c->debut_transitions, (capacite + 1) * sizeof(int));
+        if (!transitions) return -1;
+        c->debut_transitions = transitions;
+        int *etat_suivant = realloc(c->etat_suivant, capacite * sizeof(int));
+        if (!etat_suivant) return -1;
+        c->etat_suivant = etat_suivant;
+        // Deux seaux par état possible : on répartit à nouveau les états existants
+        int *seau = malloc(2 * capacite * sizeof(int));
+        if (!seau) return -1;
+        free(c->seau);
+        c->seau = seau;
+        c->nb_seaux = 2 * capacite;
+        for (int k = 0; k < c->nb_seaux; k++) c->seau[k] = -1;
+        for (int e = 0; e < c->nb_etats; e++) {
+            c->etat_suivant[e] = c->seau[c->hachage[e] & (c->nb_seaux - 1)];
+            c->seau[c->hachage[e] & (c->nb_seaux - 1)] = e;
+        }
+        c->capacite_etats = capacite;
+    }
+    if (c->taille_noyau + taille > c->capacite_noyau) {
+        int capacite = 2 * (c->taille_noyau + taille) + 64;
+        int *tab = realloc(c->noyau, capacite * sizeof(int));
+        if (!tab) return -1;
+        c->noyau = tab;
+        c->capacite_noyau = capacite;
+    }
+    if (c->nb_etats == 0) c->debut_noyau[0] = 0;
+    memcpy(&c->noyau[c->taille_noyau], noyau, taille * sizeof(int));
+    c->taille_noyau += taille;
+    c->hachage[c->nb_etats] = h;
+    c->etat_suivant[c->nb_etats] = c->seau[h & (c->nb_seaux - 1)];
+    c->seau[h & (c->nb_seaux - 1)] = c->nb_etats;
+    c->debut_noyau[++c->nb_etats] = c->taille_noyau;
+    return c->nb_etats - 1;
+}
+
+static int ajouter_transition(Construction *c, int symbole, int cible) {
+    if (c->nb_transitions == c->capacite_transitions) {
+        int capacite = c->capacite_transitions ? 2 * c->capacite_transitions : 256;
+        int *symboles = realloc(c->symbole_transition, capacite * sizeof(int));
+        if (!symboles) return -1;
+        c->symbole_transition = symboles;
+        int *cibles = realloc(c->cible_transition, capacite * sizeof(int));
+        if (!cibles) return -1;
+        c->cible_transition = cibles;
+        c->capacite_transitions = capacite;
+    }
+    c->symbole_transition[c->nb_transitions] = symbole;
+    c->cible_transition[c->nb_transitions++] = cible;
+    return 0;
+}
+
+// Automate LR(0) : les états sont traités dans l'ordre de création, leurs transitions
+// rangées à la suite
+static int construire_automate(ContexteGrammaire *ctx, Construction *c) {
+    const TableLALR *t = c->table;
+    int *suivant = malloc((c->nb_items + 1) * sizeof(int));
+    int depart = 0;
+    if (!suivant || etat_du_noyau(c, &depart, 1) == -1) {
+        free(suivant);
+        return signaler_memoire(ctx);
+    }
+
+    for (int e = 0; e < c->nb_etats; e++) {
+        c->debut_transitions[e] = c->nb_transitions;
+        int debut = c->debut_noyau[e];
+        int nb = fermer(c, &c->noyau[debut], c->debut_noyau[e + 1] - debut);
+        for (int i = 0; i < nb; i++) {
+            int p = production_item(c, c->fermeture[i]), point = c->fermeture[i] - c->premier_item[p];
+            if (point == t->longueur[p]) continue;
+            int x = t->symboles[t->debut[p] + point], deja = 0;
+            for (int j = 0; j < i && !deja; j++) {
+                int q = production_item(c, c->fermeture[j]), point_q = c->fermeture[j] - c->premier_item[q];
+                deja = point_q < t->longueur[q] && t->symboles[t->debut[q] + point_q] == x;
+            }
+            if (deja) continue;
+            // Noyau du successeur par x : les items de la fermeture qui avancent sur x
+            int taille = 0;
+            for (int j = i; j < nb; j++) {
+                int q = production_item(c, c->fermeture[j]), point_q = c->fermeture[j] - c->premier_item[q];
+                if (point_q < t->longueur[q] && t->symboles[t->debut[q] + point_q] == x) suivant[taille++] = c->fermeture[j] + 1;
+            }
+            qsort(suivant, taille, sizeof(int), comparer_entiers);
+            int cible = etat_du_noyau(c, suivant, taille);
+            if (cible == -1 || ajouter_transition(c, x, cible) == -1) {
+                free(suivant);
+                return signaler_memoire(ctx);
+            }
+        }
+    }
+    c->debut_transitions[c->nb_etats] = c->nb_transitions;
+    free(suivant);
+    return GRAMMAIRE_OK;
+}
+
+static int transition(const Construction *c, int etat, int symbole) {
+    for (int k = c->debut_transitions[etat]; k < c->debut_transitions[etat + 1]; k++) {
+        if (c->symbole_transition[k] == symbole) return c->cible_transition[k];
+    }
+    return -1;
+}
+
+// Position d'un item dans le noyau d'un état
+static int rang_noyau(const Construction *c, int etat, int item) {
+    int debut = c->debut_noyau[etat];
+    const int *trouve = bsearch(&item, &c->noyau[debut], c->debut_noyau[etat + 1] - debut, sizeof(int), comparer_entiers);
+    return trouve ? (int)(trouve - c->noyau) : -1;
+}
+
+// Prévision du i-ième item (de production p) de la fermeture de l'état
+static const unsigned char *prevision_item(const Construction *c, int etat, int i, int p) {
+    int colonnes = c->table->nb_colonnes;
+    int taille_noyau = c->debut_noyau[etat + 1] - c->debut_noyau[etat];
+    return i < taille_noyau ? &c->prevision[(size_t)(c->debut_noyau[etat] + i) * colonnes]
+                            : &c->prevision_nt[c->table->gauche[p] * colonnes];
+}
+
+// Prévisions des items de la fermeture d'un état : celles des items noyau sont dans
+// c->prevision, celles des items (B -> ·γ) dans la ligne B de c->prevision_nt
+static void prevoir_fermeture(Construction *c, int etat, int nb) {
+    const TableLALR *t = c->table;
+    int colonnes = t->nb_colonnes;
+    memset(c->prevision_nt, 0, (size_t)c->nb_symboles_nt * colonnes);
+    for (int change = 1; change; ) {
+        change = 0;
+        for (int i = 0; i < nb; i++) {
+            int p = production_item(c, c->fermeture[i]), point = c->fermeture[i] - c->premier_item[p];
+            if (point == t->longueur[p]) continue;
+            int b = t->symboles[t->debut[p] + point];
+            if (EST_TERMINAL(b)) continue;
+            unsigned char *ligne = &c->prevision_nt[b * colonnes];
+            int k = point + 1;
+            for (; k < t->longueur[p]; k++) {
+                int s = t->symboles[t->debut[p] + k];
+                if (EST_TERMINAL(s)) {
+                    int col = t->colonne[(unsigned char)CARACTERE(s)];
+                    if (!ligne[col]) ligne[col] = change = 1;
+                    break;
+                }
+                change |= reunir(ligne, &c->premier[s * colonnes], colonnes);
+                if (!c->annulable[s]) break;
+            }
+            if (k == t->longueur[p]) {
+                change |= reunir(ligne, prevision_item(c, etat, i, p), colonnes);
+            }
+        }
+    }
+}
+
+// Point fixe des prévisions des items noyau ; l'item S' -> ·axiome prévoit la fin du mot
+static int propager_previsions(ContexteGrammaire *ctx, Construction *c) {
+    const TableLALR *t = c->table;
+    int colonnes = t->nb_colonnes;
+    c->prevision = calloc((size_t)c->taille_noyau * colonnes + 1, 1);
+    if (!c->prevision) return signaler_memoire(ctx);
+    c->prevision[colonnes - 1] = 1;
+    for (int change = 1; change; ) {
+        change = 0;
+        for (int e = 0; e < c->nb_etats; e++) {
+            int nb = fermer(c, &c->noyau[c->debut_noyau[e]], c->debut_noyau[e + 1] - c->debut_noyau[e]);
+            prevoir_fermeture(c, e, nb);
+            for (int i = 0; i < nb; i++) {
+                int p = production_item(c, c->fermeture[i]), point = c->fermeture[i] - c->premier_item[p];
+                if (point == t->longueur[p]) continue;
+                int cible = transition(c, e, t->symboles[t->debut[p] + point]);
+                int rang = rang_noyau(c, cible, c->fermeture[i] + 1);
+                change |= reunir(&c->prevision[(size_t)rang * colonnes], prevision_item(c, e, i, p), colonnes);
+            }
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+
+static void relever_conflit(TableLALR *t, int etat, int colonne, int decalage, int premiere, int seconde) {
+    if (t->nb_conflits < LALR_MAX_CONFLITS) {
+        ConflitLALR *conflit = &t->conflits[t->nb_conflits];
+        conflit->etat = etat;
+        conflit->terminal = t->colonnes[colonne];
+        conflit->decalage = decalage;
+        conflit->premiere = premiere;
+        conflit->seconde = seconde;
+    }
+    t->nb_conflits++;
+}
+
+// Ranger des lignes creuses en peigne : la ligne r occupe les cases base[r] + colonne
+// (libres jusque-là) d'un vecteur commun, marquées r dans controle. Les lignes sont
+// données par (ligne, colonne, valeur), triées par ligne.
+static int ranger_peigne(int nb_lignes, const int *lignes, const int *colonnes, const int *valeurs, int nb,
+                         int **base, int **vecteur, int **controle, int *taille) {
+    int capacite = nb + 64;
+    *base = calloc(nb_lignes + 1, sizeof(int));
+    *vecteur = malloc(capacite * sizeof(int));
+    *controle = malloc(capacite * sizeof(int));
+    if (!*base || !*vecteur || !*controle) return -1;
+    for (int k = 0; k < capacite; k++) {
+        (*vecteur)[k] = 0;
+        (*controle)[k] = -1;
+    }
+    *taille = 0;
+    for (int debut = 0, fin; debut < nb; debut = fin) {
+        int r = lignes[debut];
+        for (fin = debut; fin < nb && lignes[fin] == r; fin++) {}
+        int b = 0;
+        for (;; b++) {
+            int libre = 1;
+            for (int k = debut; k < fin && libre; k++) {
+                int position = b + colonnes[k];
+                libre = position >= capacite || (*controle)[position] == -1;
+            }
+            if (libre) break;
+        }
+        for (int k = debut; k < fin; k++) {
+            int position = b + colonnes[k];
+            if (position >= capacite) {
+                int nouvelle = 2 * position + 64;
+                int *v = realloc(*vecteur, nouvelle * sizeof(int));
+                if (!v) return -1;
+                *vecteur = v;
+                int *ctl = realloc(*controle, nouvelle * sizeof(int));
+                if (!ctl) return -1;
+                *controle = ctl;
+                for (int q = capacite; q < nouvelle; q++) {
+                    (*vecteur)[q] = 0;
+                    (*controle)[q] = -1;
+                }
+                capacite = nouvelle;
+            }
+            (*vecteur)[position] = valeurs[k];
+            (*controle)[position] = r;
+            if (position + 1 > *taille) *taille = position + 1;
+        }
+        (*base)[r] = b;
+    }
+    return 0;
+}
+
+// Tables ACTION et ALLER : une ligne pleine par état, puis compression
+static int remplir_tables(ContexteGrammaire *ctx, Construction *c) {
+    TableLALR *t = c->table;
+    int colonnes = t->nb_colonnes;
+    t->nb_etats = c->nb_etats;
+    int *ligne = malloc(colonnes * sizeof(int));
+    int *comptes = calloc(t->nb_productions, sizeof(int));
+    // Cases non vides : au plus une par (état, colonne) pour ACTION, par (état, non-terminal) pour ALLER
+    size_t capacite = (size_t)c->nb_etats * (colonnes > t->nb_non_terminaux ? colonnes : t->nb_non_terminaux) + 1;
+    int *lignes = malloc(capacite * sizeof(int)), *cols = malloc(capacite * sizeof(int)), *valeurs = malloc(capacite * sizeof(int));
+    t->defaut = calloc(c->nb_etats + 1, sizeof(int));
+    int statut = ligne && comptes && lignes && cols && valeurs && t->defaut ? GRAMMAIRE_OK : signaler_memoire(ctx);
+    int nb = 0;
+
+    for (int e = 0; statut == GRAMMAIRE_OK && e < c->nb_etats; e++) {
+        for (int k = 0; k < colonnes; k++) ligne[k] = 0;
+        for (int k = c->debut_transitions[e]; k < c->debut_transitions[e + 1]; k++) {
+            int x = c->symbole_transition[k];
+            if (EST_TERMINAL(x)) ligne[t->colonne[(unsigned char)CARACTERE(x)]] = c->cible_transition[k] + 1;
+        }
+        int nb_fermeture = fermer(c, &c->noyau[c->debut_noyau[e]], c->debut_noyau[e + 1] - c->debut_noyau[e]);
+        prevoir_fermeture(c, e, nb_fermeture);
+        for (int i = 0; i < nb_fermeture; i++) {
+            int p = production_item(c, c->fermeture[i]);
+            if (c->fermeture[i] - c->premier_item[p] != t->longueur[p]) continue;
+            const unsigned char *prevision = prevision_item(c, e, i, p);
+            for (int k = 0; k < colonnes; k++) {
+                if (!prevision[k]) continue;
+                if (ligne[k] == 0) {
+                    ligne[k] = -p - 1;
+                } else if (ligne[k] > 0) {
+                    relever_conflit(t, e, k, 1, p, -1);
+                } else if (ligne[k] != -p - 1) {
+                    // Comme yacc : la production écrite la première l'emporte
+                    int autre = -ligne[k] - 1;
+                    relever_conflit(t, e, k, 0, autre < p ? autre : p, autre < p ? p : autre);
+                    if (p < autre) ligne[k] = -p - 1;
+                }
+            }
+        }
+        // Réduction par défaut : la plus fréquente de la ligne
+        int defaut = 0, meilleur = 0;
+        for (int k = 0; k < colonnes; k++) {
+            if (ligne[k] < 0 && ++comptes[-ligne[k] - 1] > meilleur) {
+                meilleur = comptes[-ligne[k] - 1];
+                defaut = ligne[k];
+            }
+        }
+        for (int k = 0; k < colonnes; k++) {
+            if (ligne[k] < 0) comptes[-ligne[k] - 1] = 0;
+        }
+        t->defaut[e] = defaut;
+        for (int k = 0; k < colonnes; k++) {
+            if (ligne[k] == 0 || ligne[k] == defaut) continue;
+            lignes[nb] = e;
+            cols[nb] = k;
+            valeurs[nb++] = ligne[k];
+        }
+    }
+    if (statut == GRAMMAIRE_OK &&
+        ranger_peigne(c->nb_etats, lignes, cols, valeurs, nb, &t->base_action, &t->action, &t->controle_action, &t->taille_action) == -1) {
+        statut = signaler_memoire(ctx);
+    }
+
+    // ALLER, une ligne par non-terminal (S' n'en a pas)
+    nb = 0;
+    for (int a = 0; statut == GRAMMAIRE_OK && a < t->nb_non_terminaux; a++) {
+        for (int e = 0; e < c->nb_etats; e++) {
+            int cible = transition(c, e, a);
+            if (cible == -1) continue;
+            lignes[nb] = a;
+            cols[nb] = e;
+            valeurs[nb++] = cible;
+        }
+    }
+    if (statut == GRAMMAIRE_OK &&
+        ranger_peigne(t->nb_non_terminaux, lignes, cols, valeurs, nb, &t->base_aller, &t->aller, &t->controle_aller, &t->taille_aller) == -1) {
+        statut = signaler_memoire(ctx);
+    }
+    free(ligne);
+    free(comptes);
+    free(lignes);
+    free(cols);
+    free(valeurs);
+    return statut;
+}
+
+int construire_table_lalr(ContexteGrammaire *ctx, const Grammaire *grammaire, TableLALR *table) {
+    int statut = decouper(ctx, grammaire, table);
+    if (statut != GRAMMAIRE_OK) return statut;
+    Construction c;
+    memset(&c, 0, sizeof(c));
+    c.table = table;
+    statut = preparer(ctx, &c);
+    if (statut == GRAMMAIRE_OK) statut = construire_automate(ctx, &c);
+    if (statut == GRAMMAIRE_OK) statut = propager_previsions(ctx, &c);
+    if (statut == GRAMMAIRE_OK) statut = remplir_tables(ctx, &c);
+    liberer_construction(&c);
+    if (statut != GRAMMAIRE_OK) liberer_table_lalr(table);
+    return statut;
+}
+
+void production_lalr(const TableLALR *table, int p, char *texte, size_t taille) {
+    size_t position = 0;
+    texte[0] = '\0';
+    if (table->longueur[p] == 0) {
+        snprintf(texte, taille, "E");
+        return;
+    }
+    for (int k = 0; k < table->longueur[p] && position < taille; k++) {
+        int s = table->symboles[table->debut[p] + k];
+        position += EST_TERMINAL(s) ? snprintf(texte + position, taille - position, "%c", CARACTERE(s))
+                                    : snprintf(texte + position, taille - position, "%s", table->noms[s]);
+    }
+}
+
+void decrire_conflit_lalr(const TableLALR *table, const ConflitLALR *conflit, char *texte, size_t taille) {
+    char premiere[MAX_SYMBOLS * MAX_SYMBOLS], seconde[MAX_SYMBOLS * MAX_SYMBOLS];
+    production_lalr(table, conflit->premiere, premiere, sizeof(premiere));
+    if (conflit->decalage) {
+        snprintf(texte, taille, "état %d sur %c : décalage / réduction %s -> %s", conflit->etat, conflit->terminal,
+                 table->noms[table->gauche[conflit->premiere]], premiere);
+    } else {
+        production_lalr(table, conflit->seconde, seconde, sizeof(seconde));
+        snprintf(texte, taille, "état %d sur %c : réduction %s -> %s / réduction %s -> %s", conflit->etat, conflit->terminal,
+                 table->noms[table->gauche[conflit->premiere]], premiere, table->noms[table->gauche[conflit->seconde]], seconde);
+    }
+}
+
+static void ecrire_vecteur(FILE *fichier, const char *nom, const int *vecteur, int taille) {
+    fprintf(fichier, "%s %d", nom, taille);
+    for (int k = 0; k < taille; k++) fprintf(fichier, " %d", vecteur[k]);
+    fprintf(fichier, "\n");
+}
+
+int ecrire_table_lalr(FILE *fichier, const TableLALR *table) {
+    fprintf(fichier, "# Table LALR(1) : %d états, %d productions, terminaux %.*s\n", table->nb_etats,
+            table->nb_productions, table->nb_colonnes - 1, table->colonnes);
+    fprintf(fichier, "# ACTION : %d cases sur %d, ALLER : %d sur %d\n", table->taille_action, table->nb_etats * table->nb_colonnes,
+            table->taille_aller, table->nb_etats * table->nb_non_terminaux);
+    char texte[MAX_SYMBOLS * MAX_SYMBOLS];
+    // La production 0 (S' -> axiome) est implicite ; les autres redonnent la grammaire à la relecture
+    fprintf(fichier, "# 0 %s -> %s\n", table->noms[table->nb_non_terminaux], table->noms[0]);
+    for (int p = 1; p < table->nb_productions; p++) {
+        production_lalr(table, p, texte, sizeof(texte));
+        fprintf(fichier, "production %d %s -> %s\n", p, table->noms[table->gauche[p]], texte);
+    }
+    fprintf(fichier, "colonnes %s\n", table->colonnes);
+    ecrire_vecteur(fichier, "defaut", table->defaut, table->nb_etats);
+    ecrire_vecteur(fichier, "base_action", table->base_action, table->nb_etats);
+    ecrire_vecteur(fichier, "action", table->action, table->taille_action);
+    ecrire_vecteur(fichier, "controle_action", table->controle_action, table->taille_action);
+    ecrire_vecteur(fichier, "base_aller", table->base_aller, table->nb_non_terminaux);
+    ecrire_vecteur(fichier, "aller", table->aller, table->taille_aller);
+    ecrire_vecteur(fichier, "controle_aller", table->controle_aller, table->taille_aller);
+    return ferror(fichier) ? GRAMMAIRE_ERREUR_FICHIER : GRAMMAIRE_OK;
+}
+
+// 1 si la ligne "nom taille v1 v2 ..." (sans le nom) redonne exactement le vecteur
+static int vecteur_conforme(const char *ligne, const int *vecteur, int taille) {
+    char *fin;
+    if (strtol(ligne, &fin, 10) != taille) return 0;
+    for (int k = 0; k < taille; k++) {
+        ligne = fin;
+        if (*ligne != ' ' || strtol(ligne, &fin, 10) != vecteur[k] || fin == ligne) return 0;
+    }
+    return *fin == '\0';
+}
+
+// Relire une table écrite par ecrire_table_lalr : les lignes "production" redonnent la
+// grammaire, dont la table est reconstruite puis comparée aux vecteurs lus
+int lire_table_lalr(ContexteGrammaire *ctx, TableLALR *table, const char *fichier) {
+    static const char *const noms_vecteurs[] = { "colonnes", "defaut", "base_action", "action", "controle_action",
+                                                 "base_aller", "aller", "controle_aller" };
+    enum { NB_VECTEURS = sizeof(noms_vecteurs) / sizeof(noms_vecteurs[0]) };
+    memset(table, 0, sizeof(*table));
+    FILE *file = fopen(fichier, "r");
+    if (file == NULL) {
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur lors de l'ouverture du fichier %s : %s",
+                                           fichier, strerror(errno));
+    }
+    Grammaire *grammaire = malloc(sizeof(Grammaire));
+    char *vecteurs[NB_VECTEURS] = { NULL };
+    char *ligne = NULL;
+    size_t taille_ligne = 0;
+    int nb_productions = 1;
+    int statut = grammaire ? GRAMMAIRE_OK : signaler_memoire(ctx);
+    if (grammaire) grammaire->rule_count = 0;
+
+    while (statut == GRAMMAIRE_OK && getline(&ligne, &taille_ligne, file) != -1) {
+        ligne[strcspn(ligne, "\r\n")] = '\0';
+        if (ligne[0] == '\0' || ligne[0] == '#') continue;
+        char *suite;
+        char *mot = strtok_r(ligne, " ", &suite);
+        if (!mot) continue;
+        if (strcmp(mot, "production") == 0) {
+            // production <numéro> <non-terminal> -> <production>
+            char *numero = strtok_r(NULL, " ", &suite);
+            char *gauche = strtok_r(NULL, " ", &suite);
+            char *fleche = strtok_r(NULL, " ", &suite);
+            char *droite = strtok_r(NULL, " ", &suite);
+            if (!droite || strtok_r(NULL, " ", &suite) || strcmp(fleche, "->") != 0 || atoi(numero) != nb_productions ||
+                strlen(gauche) >= MAX_SYMBOLS || strlen(droite) >= MAX_SYMBOLS) {
+                statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Production mal formée dans %s : %s",
+                                                     fichier, numero ? numero : "");
+                break;
+            }
+            int i = 0;
+            while (i < grammaire->rule_count && strcmp(grammaire->rules[i].non_terminal, gauche) != 0) i++;
+            if (i == grammaire->rule_count) {
+                if (i >= MAX_RULES) {
+                    statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Table trop grande : %s", fichier);
+                    break;
+                }
+                strcpy(grammaire->rules[i].non_terminal, gauche);
+                grammaire->rules[i].production_count = 0;
+                grammaire->rule_count++;
+            }
+            Rule *rule = &grammaire->rules[i];
+            if (rule->production_count >= MAX_RULES) {
+                statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de productions atteinte (%d) pour %s.",
+                                                     MAX_RULES, rule->non_terminal);
+                break;
+            }
+            strcpy(rule->productions[rule->production_count++], droite);
+            nb_productions++;
+            continue;
+        }
+        int v = 0;
+        while (v < NB_VECTEURS && strcmp(mot, noms_vecteurs[v]) != 0) v++;
+        if (v == NB_VECTEURS || vecteurs[v]) {
+            statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Ligne inattendue dans %s : %s", fichier, mot);
+            break;
+        }
+        if ((vecteurs[v] = strdup(suite)) == NULL) statut = signaler_memoire(ctx);
+    }
+    if (statut == GRAMMAIRE_OK && ferror(file)) {
+        statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur de lecture de %s.", fichier);
+    }
+    free(ligne);
+    fclose(file);
+    if (statut == GRAMMAIRE_OK) {
+        int complete = grammaire->rule_count > 0;
+        for (int v = 0; v < NB_VECTEURS; v++) complete = complete && vecteurs[v];
+        if (!complete) {
+            statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "%s n'est pas une table LALR(1) complète.", fichier);
+        }
+    }
+
+    if (statut == GRAMMAIRE_OK) statut = construire_table_lalr(ctx, grammaire, table);
+    // La table reconstruite doit redonner chaque vecteur du fichier
+    if (statut == GRAMMAIRE_OK) {
+        int conforme = table->nb_conflits == 0 && strcmp(vecteurs[0], table->colonnes) == 0 &&
+                       vecteur_conforme(vecteurs[1], table->defaut, table->nb_etats) &&
+                       vecteur_conforme(vecteurs[2], table->base_action, table->nb_etats) &&
+                       vecteur_conforme(vecteurs[3], table->action, table->taille_action) &&
+                       vecteur_conforme(vecteurs[4], table->controle_action, table->taille_action) &&
+                       vecteur_conforme(vecteurs[5], table->base_aller, table->nb_non_terminaux) &&
+                       vecteur_conforme(vecteurs[6], table->aller, table->taille_aller) &&
+                       vecteur_conforme(vecteurs[7], table->controle_aller, table->taille_aller);
+        if (!conforme) {
+            liberer_table_lalr(table);
+            statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "%s n'est pas une table LALR(1) cohérente.", fichier);
+        }
+    }
+    for (int v = 0; v < NB_VECTEURS; v++) free(vecteurs[v]);
+    free(grammaire);
+    return statut;
+}
+
+static int empiler(PileAnalyse *pile, size_t *sommet, int etat) {
+    if (*sommet == pile->capacite) {
+        size_t capacite = pile->capacite ? 2 * pile->capacite : 64;
+        int *symboles = realloc(pile->symboles, capacite * sizeof(int));
+        if (!symboles) return -1;
+        pile->symboles = symboles;
+        pile->capacite = capacite;
+    }
+    pile->symboles[(*sommet)++] = etat;
+    return 0;
+}
+
+// Analyse par décalage-réduction : ACTION sur l'état au sommet et le prochain caractère
+int reconnaitre_lalr(const TableLALR *table, const char *mot, size_t longueur, PileAnalyse *pile) {
+    size_t sommet = 0, position = 0;
+    if (empiler(pile, &sommet, 0) == -1) return -1;
+    for (;;) {
+        int etat = pile->symboles[sommet - 1];
+        int colonne = position < longueur ? table->colonne[(unsigned char)mot[position]] : table->nb_colonnes - 1;
+        if (colonne == -1) return 0;
+        int k = table->base_action[etat] + colonne;
+        int action = k < table->taille_action && table->controle_action[k] == etat ? table->action[k] : table->defaut[etat];
+        if (action == 0) return 0;
+        if (action > 0) {
+            if (empiler(pile, &sommet, action - 1) == -1) return -1;
+            position++;
+            continue;
+        }
+        int p = -action - 1;
+        if (p == 0) return position == longueur;
+        sommet -= table->longueur[p];
+        int a = table->gauche[p];
+        k = table->base_aller[a] + pile->symboles[sommet - 1];
+        if (k >= table->taille_aller || table->controle_aller[k] != a) return 0;
+        if (empiler(pile, &sommet, table->aller[k]) == -1) return -1;
+    }
+}
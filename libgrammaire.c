@@ -0,0 +1,1513 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <ctype.h> // Pour isupper()
+#include <stdbool.h>
+#include <time.h>
+
+#include "libgrammaire.h"
+
+void contexte_grammaire_init(ContexteGrammaire *ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->letter_index = 25; // Commencer par 'Z'
+    ctx->number_index = 9;  // Commencer par 9
+    ctx->erreur = GRAMMAIRE_OK;
+}
+
+const char *contexte_grammaire_message(const ContexteGrammaire *ctx) {
+    return ctx->erreur == GRAMMAIRE_OK ? "" : ctx->message;
+}
+
+// Enregistrer une erreur dans le contexte (seule la première est gardée) et renvoyer son code
+static int vsignaler(ContexteGrammaire *ctx, CodeGrammaire code, const char *format, va_list args) {
+    if (ctx->erreur == GRAMMAIRE_OK) {
+        vsnprintf(ctx->message, sizeof(ctx->message), format, args);
+        ctx->erreur = code;
+    }
+    return code;
+}
+
+static int signaler(ContexteGrammaire *ctx, CodeGrammaire code, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsignaler(ctx, code, format, args);
+    va_end(args);
+    return code;
+}
+
+// Même chose pour les modules qui étendent la bibliothèque
+int contexte_grammaire_signaler(ContexteGrammaire *ctx, CodeGrammaire code, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    vsignaler(ctx, code, format, args);
+    va_end(args);
+    return code;
+}
+
+// Ajouter une règle à la fin de la grammaire
+static int ajouter_regle(ContexteGrammaire *ctx, Grammaire *grammaire, const Rule *rule) {
+    if (grammaire->rule_count >= MAX_RULES) {
+        return signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de règles atteinte (%d), impossible d'ajouter %s.",
+                        MAX_RULES, rule->non_terminal);
+    }
+    grammaire->rules[grammaire->rule_count++] = *rule;
+    return GRAMMAIRE_OK;
+}
+
+// Vérifier qu'une règle peut encore recevoir une production
+static int place_production(ContexteGrammaire *ctx, const Rule *rule) {
+    if (rule->production_count >= MAX_RULES) {
+        return signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de productions atteinte (%d) pour %s.",
+                        MAX_RULES, rule->non_terminal);
+    }
+    return GRAMMAIRE_OK;
+}
+
+// Ensemble des productions d'une règle, tenu à jour pendant une passe qui y ajoute ou en
+// retire des productions : ni le test de doublon ni le retrait ne parcourent la règle.
+// Table à adressage ouvert d'indices dans rule->productions, jamais remplie à plus de
+// moitié (chaque indice y occupe au plus une alvéole). Une production retirée laisse une
+// marque dans la table et reste en place dans la règle jusqu'à compacter_productions, qui
+// la supprime en gardant l'ordre des autres : la règle obtenue est la même qu'en décalant
+// les productions à chaque retrait.
+#define ALVEOLES_PRODUCTIONS (2 * MAX_RULES + 1)
+#define ALVEOLE_VIDE -1
+#define ALVEOLE_RETIREE -2
+
+typedef struct {
+    const Rule *rule;
+    short indices[ALVEOLES_PRODUCTIONS];
+    unsigned char retiree[MAX_RULES];    // Productions retirées, encore dans la règle
+    int retirees;
+    int doublons;                        // La règle avait des productions répétées
+} EnsembleProductions;
+
+static unsigned alveole_production(const char *production) {
+    unsigned h = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *)production; *c; c++) h = (h ^ *c) * 16777619u;
+    return h % ALVEOLES_PRODUCTIONS;
+}
+
+// Indice de la production dans la règle, -1 si elle n'y est pas (ou plus)
+static int chercher_production(const EnsembleProductions *ensemble, const char *production) {
+    for (unsigned a = alveole_production(production); ensemble->indices[a] != ALVEOLE_VIDE;
+         a = (a + 1) % ALVEOLES_PRODUCTIONS) {
+        int indice = ensemble->indices[a];
+        if (indice >= 0 && strcmp(ensemble->rule->productions[indice], production) == 0) return indice;
+    }
+    return -1;
+}
+
+// Enregistrer rule->productions[indice] (absente de l'ensemble)
+static void enregistrer_production(EnsembleProductions *ensemble, int indice) {
+    unsigned a = alveole_production(ensemble->rule->productions[indice]);
+    while (ensemble->indices[a] >= 0) a = (a + 1) % ALVEOLES_PRODUCTIONS;
+    ensemble->indices[a] = (short)indice;
+}
+
+// (Re)construire l'ensemble d'une règle sans production retirée
+static void indexer_productions(EnsembleProductions *ensemble, const Rule *rule) {
+    ensemble->rule = rule;
+    memset(ensemble->indices, 0xff, sizeof(ensemble->indices)); // ALVEOLE_VIDE partout
+    memset(ensemble->retiree, 0, sizeof(ensemble->retiree));
+    ensemble->retirees = 0;
+    ensemble->doublons = 0;
+    for (int i = 0; i < rule->production_count; i++) {
+        if (chercher_production(ensemble, rule->productions[i]) < 0) {
+            enregistrer_production(ensemble, i);
+        } else {
+            ensemble->doublons = 1;
+        }
+    }
+}
+
+// Ajouter une production absente en fin de règle ; renvoie 1 si elle a été ajoutée
+static int ajouter_production_unique(EnsembleProductions *ensemble, Rule *rule, const char *production) {
+    if (chercher_production(ensemble, production) >= 0) return 0;
+    strcpy(rule->productions[rule->production_count], production);
+    enregistrer_production(ensemble, rule->production_count++);
+    return 1;
+}
+
+// Retirer rule->productions[indice] : elle n'est plus trouvée (sauf s'il en reste un
+// exemplaire, cas d'une règle lue avec des productions répétées), et une production égale
+// ajoutée ensuite le sera de nouveau
+static void retirer_production(EnsembleProductions *ensemble, int indice) {
+    const Rule *rule = ensemble->rule;
+    ensemble->retiree[indice] = 1;
+    ensemble->retirees++;
+    unsigned a = alveole_production(rule->productions[indice]);
+    while (ensemble->indices[a] != indice) {
+        if (ensemble->indices[a] == ALVEOLE_VIDE) return; // Exemplaire répété, jamais enregistré
+        a = (a + 1) % ALVEOLES_PRODUCTIONS;
+    }
+    ensemble->indices[a] = ALVEOLE_RETIREE;
+    for (int i = 0; ensemble->doublons && i < rule->production_count; i++) {
+        if (!ensemble->retiree[i] && strcmp(rule->productions[i], rule->productions[indice]) == 0) {
+            ensemble->indices[a] = (short)i;
+            return;
+        }
+    }
+}
+
+// Supprimer de la règle les productions retirées, dans l'ordre, et reconstruire l'ensemble.
+// `position` et `autre` (facultatifs), indices de productions gardées, suivent leur production.
+static void compacter_productions(EnsembleProductions *ensemble, Rule *rule, int *position, int *autre) {
+    int gardees = 0, nouvelle_position = -1, nouvel_autre = -1;
+    for (int i = 0; i < rule->production_count; i++) {
+        if (ensemble->retiree[i]) continue;
+        if (position && *position == i) nouvelle_position = gardees;
+        if (autre && *autre == i) nouvel_autre = gardees;
+        if (gardees != i) strcpy(rule->productions[gardees], rule->productions[i]);
+        gardees++;
+    }
+    rule->production_count = gardees;
+    if (position) *position = nouvelle_position;
+    if (autre) *autre = nouvel_autre;
+    indexer_productions(ensemble, rule);
+}
+
+double horloge_grammaire(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+void mesurer_grammaire(const Grammaire *grammaire, int *regles, int *productions, long *symboles) {
+    *regles = grammaire->rule_count;
+    *productions = 0;
+    *symboles = 0;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        const Rule *rule = &grammaire->rules[i];
+        *productions += rule->production_count;
+        for (int j = 0; j < rule->production_count; j++) {
+            const char *p = rule->productions[j];
+            if (strcmp(p, "E") == 0) continue;
+            for (int k = 0; p[k] != '\0'; k++) {
+                if (isupper(p[k]) && isdigit(p[k + 1])) k++;
+                (*symboles)++;
+            }
+        }
+    }
+}
+
+// Passer au contexte les mesures d'une étape commencée à `debut`
+void contexte_grammaire_mesurer(ContexteGrammaire *ctx, const char *etape, int numero, double debut,
+                                int generes_avant, const Grammaire *grammaire) {
+    if (!ctx->mesure) return;
+    MesureEtape mesure;
+    mesure.etape = etape;
+    mesure.numero = numero;
+    mesure.secondes = horloge_grammaire() - debut;
+    mesurer_grammaire(grammaire, &mesure.regles, &mesure.productions, &mesure.symboles);
+    mesure.nouveaux_non_terminaux = ctx->non_terminaux_generes - generes_avant;
+    ctx->mesure(ctx->donnees_mesure, &mesure);
+}
+
+void contexte_grammaire_tracer(const ContexteGrammaire *ctx, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    flockfile(ctx->trace->fichier);
+    fputs("# ", ctx->trace->fichier);
+    vfprintf(ctx->trace->fichier, format, args);
+    fputc('\n', ctx->trace->fichier);
+    funlockfile(ctx->trace->fichier);
+    va_end(args);
+}
+
+// Tracer la fin d'une étape : une ligne, et la grammaire obtenue au niveau détaillé
+void contexte_grammaire_tracer_etape(const ContexteGrammaire *ctx, int numero, const char *etape,
+                                     const Grammaire *grammaire) {
+    if (!TRACE_ACTIVE(ctx, TRACE_RESUME, TRACE_ETAPES)) return;
+    int regles, productions;
+    long symboles;
+    mesurer_grammaire(grammaire, &regles, &productions, &symboles);
+    flockfile(ctx->trace->fichier);
+    fprintf(ctx->trace->fichier, "# etapes %d %s : %d règles, %d productions, %ld symboles\n",
+            numero, etape, regles, productions, symboles);
+    if (TRACE_ACTIVE(ctx, TRACE_DETAIL, TRACE_ETAPES)) ecrire_grammaire(ctx->trace->fichier, grammaire);
+    funlockfile(ctx->trace->fichier);
+}
+
+// Notifier le journal du contexte de la fin d'une étape
+static void journaliser(ContexteGrammaire *ctx, const char *etape, const Grammaire *grammaire) {
+    if (ctx->journal) ctx->journal(ctx->donnees_journal, etape, grammaire);
+}
+
+// Fonction pour nettoyer une chaîne de caractères (supprimer les espaces)
+void nettoyer_chaine(char *str) {
+    char *src = str, *dst = str;
+    while (*src) {
+        if (!isspace((unsigned char)*src)) {
+            *dst++ = *src;
+        }
+        src++;
+    }
+    *dst = '\0';
+}
+// Fonction pour vérifier si un symbole est un non-terminal
+int isNonTerminal(const char *symbol) {
+    // Vérifie que la chaîne est de longueur 2, le premier caractère est une majuscule
+    // et le second est un chiffre.
+    return strlen(symbol) == 2 && isupper(symbol[0]) && isdigit(symbol[1]);
+}
+int lire_symbole(const Grammaire *grammaire, const char *texte, int *taille) {
+    int meilleur = -1, longueur_meilleur = 0;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        int l = strlen(grammaire->rules[i].non_terminal);
+        if (l > longueur_meilleur && strncmp(texte, grammaire->rules[i].non_terminal, l) == 0) {
+            meilleur = i;
+            longueur_meilleur = l;
+        }
+    }
+    if (longueur_meilleur < 2 && isupper(texte[0]) && isdigit(texte[1])) {
+        *taille = 2;
+        return SYMBOLE_INCONNU;
+    }
+    if (meilleur >= 0) {
+        *taille = longueur_meilleur;
+        return meilleur;
+    }
+    *taille = 1;
+    return texte[0] == 'E' ? SYMBOLE_EPSILON : -1 - (unsigned char)texte[0];
+}
+// Vérifie si un non-terminal existe déjà dans la grammaire
+int non_terminal_exists(const Grammaire *grammaire, const char *non_terminal) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        if (strcmp(grammaire->rules[i].non_terminal, non_terminal) == 0) {
+            return 1; // Le non-terminal existe
+        }
+    }
+    return 0; // Le non-terminal n'existe pas
+}
+
+// Fonction pour générer un nouveau non-terminal unique ; les compteurs sont ceux du contexte
+int generate_non_terminal(ContexteGrammaire *ctx, char *result, const Grammaire *grammaire) {
+    int attempts = 0;
+
+    do {
+        if (ctx->letter_index < 0) {
+            return signaler(ctx, GRAMMAIRE_ERREUR_NON_TERMINAUX, "Limite de non-terminaux atteinte (A0 à Z9 épuisés).");
+        }
+        snprintf(result, MAX_SYMBOLS, "%c%d", 'A' + ctx->letter_index, ctx->number_index);
+
+        if (--ctx->number_index < 0) {
+            ctx->number_index = 9;
+            --ctx->letter_index;
+        }
+
+        attempts++;
+        if (attempts > MAX_NON_TERMINAUX) {
+            return signaler(ctx, GRAMMAIRE_ERREUR_NON_TERMINAUX, "Trop de tentatives pour générer un nouveau non-terminal.");
+        }
+    } while (non_terminal_exists(grammaire, result));
+
+    ctx->non_terminaux_generes++;
+    TRACER(ctx, TRACE_DETAIL, TRACE_ALLOCATION, "allocation %s", result);
+    return GRAMMAIRE_OK;
+}
+// Fonction pour lire une grammaire depuis un fichier
+int lire_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire, const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        grammaire->rule_count = 0;
+        return signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur lors de l'ouverture du fichier %s : %s",
+                        filename, strerror(errno));
+    }
+    int statut = lire_grammaire_flux(ctx, grammaire, file);
+    fclose(file);
+    return statut;
+}
+
+// Même lecture depuis un flux ouvert (laissé ouvert)
+int lire_grammaire_flux(ContexteGrammaire *ctx, Grammaire *grammaire, FILE *file) {
+    grammaire->rule_count = 0;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\n")] = '\0'; // Supprime le saut de ligne
+        nettoyer_chaine(line);           // Nettoyer les espaces inutiles
+
+        if (strlen(line) == 0) {
+            continue;
+        }
+
+        Rule rule;
+        rule.production_count = 0;
+
+        char *suite;
+        char *token = strtok_r(line, ":", &suite);
+        if (token == NULL) {
+            return signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Format incorrect : %s", line);
+        }
+        strcpy(rule.non_terminal, token);
+
+        token = strtok_r(NULL, "|", &suite);
+        while (token != NULL) {
+            nettoyer_chaine(token); // Nettoyer chaque production
+            if (place_production(ctx, &rule) != GRAMMAIRE_OK) {
+                return ctx->erreur;
+            }
+            strcpy(rule.productions[rule.production_count++], token);
+            token = strtok_r(NULL, "|", &suite);
+        }
+
+        if (ajouter_regle(ctx, grammaire, &rule) != GRAMMAIRE_OK) {
+            return ctx->erreur;
+        }
+    }
+
+    return ferror(file) ? signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur de lecture de la grammaire.") : 0;
+}
+
+
+int prefix_common_length(const char *str1, const char *str2) {
+    int len = 0;
+    while (str1[len] != '\0' && str2[len] != '\0' && str1[len] == str2[len]) {
+        len++;
+    }
+    return len;
+}
+
+// Factoriser deux productions ayant un préfixe commun
+// Renvoie 1 si les productions ont été factorisées, 0 sinon, un code d'erreur en cas d'échec
+int factoriser_productions(ContexteGrammaire *ctx, char *prod1, char *prod2, Grammaire *grammaire) {
+    int prefix_len = prefix_common_length(prod1, prod2);
+
+    if (prefix_len > 0) {
+        char new_non_terminal[MAX_SYMBOLS];
+        if (generate_non_terminal(ctx, new_non_terminal, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+
+        Rule new_rule;
+        strcpy(new_rule.non_terminal, new_non_terminal);
+        new_rule.production_count = 0;
+
+        // Ajouter les suffixes après le préfixe à la nouvelle règle
+        if (strlen(prod1) > prefix_len) {
+            strcpy(new_rule.productions[new_rule.production_count++], prod1 + prefix_len);
+        } else {
+            strcpy(new_rule.productions[new_rule.production_count++], "E");
+        }
+
+        if (strlen(prod2) > prefix_len) {
+            strcpy(new_rule.productions[new_rule.production_count++], prod2 + prefix_len);
+        } else {
+            strcpy(new_rule.productions[new_rule.production_count++], "E");
+        }
+
+        // Ajouter la nouvelle règle dans la grammaire
+        if (ajouter_regle(ctx, grammaire, &new_rule) != GRAMMAIRE_OK) return ctx->erreur;
+
+        // Mettre à jour prod1 pour inclure uniquement le préfixe + nouveau non-terminal
+        // (en place : snprintf ne peut pas lire et écrire la même chaîne)
+        prod1[prefix_len] = '\0';
+        strncat(prod1, new_non_terminal, MAX_SYMBOLS - prefix_len - 1);
+
+        // Effacer prod2 car elle a été intégrée dans la nouvelle règle
+        strcpy(prod2, prod1);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+// Appliquer la factorisation sur une règle
+int factoriser_rule(ContexteGrammaire *ctx, Rule *rule, Grammaire *grammaire) {
+    for (int i = 0; i < rule->production_count; i++) {
+        for (int j = i + 1; j < rule->production_count; j++) {
+            // Tenter de factoriser les deux productions
+            int factorise = factoriser_productions(ctx, rule->productions[i], rule->productions[j], grammaire);
+            if (factorise < 0) return factorise;
+            if (factorise) {
+                // Supprimer la production à l'indice `j` car elle a été absorbée
+                for (int k = j; k < rule->production_count - 1; k++) {
+                    strcpy(rule->productions[k], rule->productions[k + 1]);
+                }
+                rule->production_count--;
+                j--; // Réexaminer la position actuelle
+            }
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+
+
+
+// Appliquer la factorisation à toute la grammaire
+int factoriser(ContexteGrammaire *ctx, Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        if (factoriser_rule(ctx, rule, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+    }
+    return GRAMMAIRE_OK;
+}
+
+
+
+
+
+// Supprimer epsilon
+int supprimer_epsilon(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    int epsilon_non_terminals[MAX_RULES] = {0};
+    int changes;
+
+    // Étape 1 : Identifier les non-terminaux produisant epsilon directement ou indirectement
+    do {
+        changes = 0;
+        for (int i = 0; i < grammaire->rule_count; i++) {
+            if (epsilon_non_terminals[i]) continue; // Déjà marqué comme epsilon
+            Rule *rule = &grammaire->rules[i];
+            for (int j = 0; j < rule->production_count; j++) {
+                if (strcmp(rule->productions[j], "E") == 0) {
+                    epsilon_non_terminals[i] = 1;
+                    changes = 1;
+                    break;
+                }
+                // Vérifier si toutes les parties de la production peuvent produire epsilon
+                int all_epsilon = 1;
+                for (int k = 0; k < strlen(rule->productions[j]); k += 2) {
+                    char non_terminal[3] = {rule->productions[j][k], rule->productions[j][k + 1], '\0'};
+                    int found = 0;
+                    for (int l = 0; l < grammaire->rule_count; l++) {
+                        if (strcmp(grammaire->rules[l].non_terminal, non_terminal) == 0) {
+                            if (epsilon_non_terminals[l]) {
+                                found = 1;
+                                break;
+                            }
+                        }
+                    }
+                    if (!found) {
+                        all_epsilon = 0;
+                        break;
+                    }
+                }
+                if (all_epsilon) {
+                    epsilon_non_terminals[i] = 1;
+                    changes = 1;
+                    break;
+                }
+            }
+        }
+    } while (changes);
+
+    // Étape 2 : Ajouter des variantes en remplaçant les epsilon-productions
+    EnsembleProductions ensemble;
+    do {
+        changes = 0; // Réinitialiser l'indicateur de modifications
+        for (int i = 0; i < grammaire->rule_count; i++) {
+            Rule *rule = &grammaire->rules[i];
+            int original_count = rule->production_count;
+            indexer_productions(&ensemble, rule);
+
+            for (int j = 0; j < original_count; j++) {
+                char *prod = rule->productions[j];
+
+                // Générer toutes les combinaisons en remplaçant les non-terminaux epsilon
+                for (int k = 0; k < grammaire->rule_count; k++) {
+                    if (epsilon_non_terminals[k]) {
+                        char *non_terminal = grammaire->rules[k].non_terminal;
+                        char *found = strstr(prod, non_terminal);
+                        while (found) {
+                            char new_production[MAX_SYMBOLS] = "";
+
+                            // Partie avant le non-terminal
+                            strncpy(new_production, prod, found - prod);
+                            new_production[found - prod] = '\0';
+
+                            // Partie après le non-terminal
+                            strcat(new_production, found + strlen(non_terminal));
+
+                            // Ajouter la nouvelle production si elle n'existe pas déjà
+                            if (new_production[0] != '\0' && chercher_production(&ensemble, new_production) < 0) {
+                                if (place_production(ctx, rule) != GRAMMAIRE_OK) return ctx->erreur;
+                                ajouter_production_unique(&ensemble, rule, new_production);
+                                changes = 1; // Une modification a été effectuée
+                            }
+
+                            // Chercher la prochaine occurrence
+                            found = strstr(found + 1, non_terminal);
+                        }
+                    }
+                }
+            }
+        }
+    } while (changes);
+
+    // Étape 3 : Supprimer explicitement les productions contenant uniquement epsilon
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        if (strcmp(rule->non_terminal, axiome) != 0) {
+            for (int j = 0; j < rule->production_count;) {
+                if (strcmp(rule->productions[j], "E") == 0) {
+                    for (int k = j; k < rule->production_count - 1; k++) {
+                        strcpy(rule->productions[k], rule->productions[k + 1]);
+                    }
+                    rule->production_count--;
+                } else {
+                    j++;
+                }
+            }
+        }
+    }
+
+    // Étape 4 : Supprimer les règles inutiles
+    for (int i = 0; i < grammaire->rule_count;) {
+        Rule *rule = &grammaire->rules[i];
+        if (rule->production_count == 0 && strcmp(rule->non_terminal, axiome) != 0) {
+            char non_terminal_to_remove[MAX_SYMBOLS];
+            strcpy(non_terminal_to_remove, rule->non_terminal);
+
+            // Supprimer cette règle
+            for (int j = i; j < grammaire->rule_count - 1; j++) {
+                grammaire->rules[j] = grammaire->rules[j + 1];
+            }
+            grammaire->rule_count--;
+
+            // Supprimer les références dans les autres règles
+            for (int j = 0; j < grammaire->rule_count; j++) {
+                Rule *other_rule = &grammaire->rules[j];
+                for (int k = 0; k < other_rule->production_count;) {
+                    if (strstr(other_rule->productions[k], non_terminal_to_remove)) {
+                        for (int l = k; l < other_rule->production_count - 1; l++) {
+                            strcpy(other_rule->productions[l], other_rule->productions[l + 1]);
+                        }
+                        other_rule->production_count--;
+                    } else {
+                        k++;
+                    }
+                }
+            }
+        } else {
+            i++;
+        }
+    }
+
+    // Étape supplémentaire : Ajouter E à l'axiome s'il peut produire epsilon
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        if (strcmp(rule->non_terminal, axiome) == 0) {
+            if (epsilon_non_terminals[i]) {
+                int already_has_epsilon = 0;
+                for (int j = 0; j < rule->production_count; j++) {
+                    if (strcmp(rule->productions[j], "E") == 0) {
+                        already_has_epsilon = 1;
+                        break;
+                    }
+                }
+                if (!already_has_epsilon) {
+                    if (place_production(ctx, rule) != GRAMMAIRE_OK) return ctx->erreur;
+                    strcpy(rule->productions[rule->production_count++], "E");
+                }
+            }
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+void nettoyer_grammaire(Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        int is_used = 0;
+        for (int j = 0; j < grammaire->rule_count; j++) {
+            if (i != j) {
+                for (int k = 0; k < grammaire->rules[j].production_count; k++) {
+                    if (strstr(grammaire->rules[j].productions[k], rule->non_terminal)) {
+                        is_used = 1;
+                        break;
+                    }
+                }
+            }
+            if (is_used) break;
+        }
+        if (!is_used && rule->production_count == 0) {
+            for (int j = i; j < grammaire->rule_count - 1; j++) {
+                grammaire->rules[j] = grammaire->rules[j + 1];
+            }
+            grammaire->rule_count--;
+            i--;
+        }
+    }
+}
+void supprimer_unite(Grammaire *grammaire) {
+    EnsembleProductions ensemble;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        indexer_productions(&ensemble, rule);
+
+        // Parcourir les productions (une règle unité remplacée est retirée, la règle compactée
+        // à la fin)
+        for (int index = 0; index < rule->production_count; index++) {
+            char *prod = rule->productions[index];
+
+            // Vérifier si c'est une règle unité (une lettre majuscule suivie d'un chiffre)
+            if (strlen(prod) > 1 && isupper(prod[0]) && isdigit(prod[1])) {
+                char target_non_terminal[MAX_SYMBOLS];
+                strcpy(target_non_terminal, prod);
+
+                // Trouver la règle associée
+                int found = 0;
+                for (int j = 0; j < grammaire->rule_count; j++) {
+                    if (strcmp(grammaire->rules[j].non_terminal, target_non_terminal) == 0) {
+                        Rule *target_rule = &grammaire->rules[j];
+                        found = 1;
+
+                        // Ajouter les productions de la règle cible à la règle courante
+                        // (sauf celles qu'elle a déjà : toutes si la cible est la règle même)
+                        for (int k = 0; target_rule != rule && k < target_rule->production_count; k++) {
+                            if (rule->production_count == MAX_RULES && ensemble.retirees > 0) {
+                                compacter_productions(&ensemble, rule, &index, NULL);
+                            }
+                            if (rule->production_count == MAX_RULES) break;
+                            ajouter_production_unique(&ensemble, rule, target_rule->productions[k]);
+                        }
+                        break;
+                    }
+                }
+
+                // Si la règle associée est trouvée, supprimer la règle unité
+                if (found) retirer_production(&ensemble, index);
+            }
+        }
+        if (ensemble.retirees > 0) compacter_productions(&ensemble, rule, NULL, NULL);
+    }
+}
+void supprimer_non_terminaux_en_tete(Grammaire *grammaire) {
+    int changes;
+    EnsembleProductions ensemble;
+
+    do {
+        changes = 0; // Indicateur de modifications
+
+        for (int i = 0; i < grammaire->rule_count; i++) {
+            Rule *rule = &grammaire->rules[i];
+            indexer_productions(&ensemble, rule);
+
+            for (int j = 0; j < rule->production_count; j++) {
+                char *prod = rule->productions[j];
+
+                // Identifier si le premier symbole est un non-terminal valide (Majuscule + Chiffre uniquement)
+                if (strlen(prod) > 1 && isupper(prod[0]) && isdigit(prod[1])) {
+                    char non_terminal_tete[MAX_SYMBOLS] = {0};
+
+                    // Extraire le non-terminal (ex: "A0")
+                    snprintf(non_terminal_tete, 3, "%c%c", prod[0], prod[1]);
+
+                    // Vérifier si ce non-terminal existe dans les règles
+                    int found = 0;
+                    for (int l = 0; l < grammaire->rule_count; l++) {
+                        if (strcmp(grammaire->rules[l].non_terminal, non_terminal_tete) == 0) {
+                            found = 1;
+                            Rule *target_rule = &grammaire->rules[l];
+
+                            // Remplacer le non-terminal en tête par ses productions (celles
+                            // déjà retirées ne comptent plus quand la cible est la règle même)
+                            for (int m = 0; m < target_rule->production_count; m++) {
+                                if (target_rule == rule && ensemble.retiree[m]) continue;
+                                if (rule->production_count == MAX_RULES && ensemble.retirees > 0) {
+                                    compacter_productions(&ensemble, rule, &j, target_rule == rule ? &m : NULL);
+                                    prod = rule->productions[j];
+                                }
+                                char nouvelle_production[MAX_SYMBOLS];
+
+                                // Construire la nouvelle production
+                                snprintf(nouvelle_production, sizeof(nouvelle_production), "%s%s",
+                                         target_rule->productions[m], prod + 2);
+
+                                // Ajouter la nouvelle production si elle n'existe pas
+                                if (rule->production_count < MAX_RULES) {
+                                    ajouter_production_unique(&ensemble, rule, nouvelle_production);
+                                }
+                            }
+
+                            // Retirer l'ancienne production
+                            retirer_production(&ensemble, j);
+
+                            changes = 1; // Indiquer qu'une modification a été effectuée
+                            break;
+                        }
+                    }
+
+                    // Si le non-terminal n'existe pas dans les règles, ce n'est pas une erreur ici
+                    if (!found) {
+                        continue;
+                    }
+                }
+            }
+            if (ensemble.retirees > 0) compacter_productions(&ensemble, rule, NULL, NULL);
+        }
+    } while (changes); // Répéter jusqu'à ce qu'il n'y ait plus de modifications
+}
+int supprimer_terminaux_non_en_tete(ContexteGrammaire *ctx, Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+
+        for (int j = 0; j < rule->production_count; j++) {
+            char *prod = rule->productions[j];
+            char new_production[MAX_SYMBOLS] = "";
+            int changed = 0;
+
+            // Vérifier chaque caractère dans la production
+            for (int k = 0; prod[k] != '\0'; k++) {
+                if (islower(prod[k]) && k != 0) { // Si un terminal n'est pas en tête
+                    // Créer un nouveau non-terminal pour ce terminal
+                    char new_non_terminal[MAX_SYMBOLS];
+                    if (generate_non_terminal(ctx, new_non_terminal, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+
+                    // Ajouter une nouvelle règle pour ce terminal
+                    Rule new_rule;
+                    strcpy(new_rule.non_terminal, new_non_terminal);
+                    new_rule.production_count = 1;
+                    snprintf(new_rule.productions[0], MAX_SYMBOLS, "%c", prod[k]);
+                    if (ajouter_regle(ctx, grammaire, &new_rule) != GRAMMAIRE_OK) return ctx->erreur;
+
+                    // Remplacer le terminal par le nouveau non-terminal
+                    snprintf(new_production + strlen(new_production), MAX_SYMBOLS - strlen(new_production), "%s", new_non_terminal);
+                    changed = 1;
+                } else {
+                    // Ajouter le caractère original s'il n'est pas modifié
+                    snprintf(new_production + strlen(new_production), MAX_SYMBOLS - strlen(new_production), "%c", prod[k]);
+                }
+            }
+
+            // Mettre à jour la production si des changements ont été effectués
+            if (changed) {
+                strcpy(rule->productions[j], new_production);
+            }
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+
+int non_terminal_in_rule(const Grammaire *grammaire, const char *non_terminal, const char *rule_production) {
+    int len = strlen(rule_production);
+
+    for (int i = 0; i < len; i += 2) {
+        if (isupper(rule_production[i]) && isdigit(rule_production[i + 1])) {
+            char current_non_terminal[MAX_SYMBOLS];
+            snprintf(current_non_terminal, 3, "%c%c", rule_production[i], rule_production[i + 1]);
+            if (strcmp(current_non_terminal, non_terminal) == 0) {
+                return 1; // Le non-terminal est trouvé dans la production
+            }
+        }
+    }
+    return 0; // Non-terminal absent de la production
+}
+int supprimer_regles_avec_plus_de_deux_non_terminaux(ContexteGrammaire *ctx, Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+
+        for (int j = 0; j < rule->production_count; j++) {
+            char *prod = rule->productions[j];
+            int len = strlen(prod);
+
+            // Compter les non-terminaux dans la production
+            int non_terminal_count = 0;
+            for (int k = 0; k < len; k += 2) {
+                if (isupper(prod[k]) && isdigit(prod[k + 1])) {
+                    non_terminal_count++;
+                }
+            }
+
+            // Si plus de deux non-terminaux, procéder à la décomposition
+            if (non_terminal_count > 2) {
+                char current_prod[MAX_SYMBOLS];
+                strcpy(current_prod, prod); // Copie la production actuelle
+
+                char new_non_terminal[MAX_SYMBOLS];
+                char remaining_prod[MAX_SYMBOLS];
+
+                // Initialisation : traiter le premier non-terminal
+                strncpy(remaining_prod, current_prod + 2, MAX_SYMBOLS - 2);
+                remaining_prod[MAX_SYMBOLS - 2] = '\0';
+
+                do {
+                    if (generate_non_terminal(ctx, new_non_terminal, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+                } while (non_terminal_exists(grammaire, new_non_terminal) ||
+                         non_terminal_in_rule(grammaire, new_non_terminal, prod));
+
+                snprintf(rule->productions[j], MAX_SYMBOLS, "%.*s%s", 2, current_prod, new_non_terminal);
+
+                // Créer de nouvelles règles pour gérer le reste
+                while (strlen(remaining_prod) > 2) {
+                    char first_non_terminal[MAX_SYMBOLS];
+                    strncpy(first_non_terminal, remaining_prod, 2);
+                    first_non_terminal[2] = '\0';
+
+                    // Générer un nouveau non-terminal
+                    char temp_non_terminal[MAX_SYMBOLS];
+                    do {
+                        if (generate_non_terminal(ctx, temp_non_terminal, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+                    } while (non_terminal_exists(grammaire, temp_non_terminal) ||
+                             non_terminal_in_rule(grammaire, temp_non_terminal, prod));
+
+                    Rule new_rule;
+                    strcpy(new_rule.non_terminal, new_non_terminal);
+                    snprintf(new_rule.productions[0], MAX_SYMBOLS, "%s%s", first_non_terminal, temp_non_terminal);
+                    new_rule.production_count = 1;
+                    if (ajouter_regle(ctx, grammaire, &new_rule) != GRAMMAIRE_OK) return ctx->erreur;
+
+                    strcpy(new_non_terminal, temp_non_terminal);
+                    memmove(remaining_prod, remaining_prod + 2, strlen(remaining_prod) - 1);
+                }
+
+                // Cas où il reste exactement deux non-terminaux
+                if (strlen(remaining_prod) == 2) {
+                    Rule final_rule;
+                    strcpy(final_rule.non_terminal, new_non_terminal);
+                    snprintf(final_rule.productions[0], MAX_SYMBOLS, "%s", remaining_prod);
+                    final_rule.production_count = 1;
+                    if (ajouter_regle(ctx, grammaire, &final_rule) != GRAMMAIRE_OK) return ctx->erreur;
+                }
+            }
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+int supprimer_recursivite_gauche(ContexteGrammaire *ctx, Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule_i = &grammaire->rules[i];
+
+        // Identifier les productions récursives et non récursives
+        char recursive_productions[MAX_RULES][MAX_SYMBOLS] = {0};
+        char non_recursive_productions[MAX_RULES][MAX_SYMBOLS] = {0};
+        int recursive_count = 0, non_recursive_count = 0;
+
+        for (int j = 0; j < rule_i->production_count; j++) {
+            if (strncmp(rule_i->productions[j], rule_i->non_terminal, strlen(rule_i->non_terminal)) == 0) {
+                // Production récursive
+                strcpy(recursive_productions[recursive_count++], rule_i->productions[j] + strlen(rule_i->non_terminal));
+            } else {
+                // Production non récursive
+                strcpy(non_recursive_productions[non_recursive_count++], rule_i->productions[j]);
+            }
+        }
+
+        // Si aucune récursivité gauche, passer à la règle suivante
+        if (recursive_count == 0) {
+            continue;
+        }
+
+        // Générer un nouveau non-terminal pour gérer la récursivité
+        char new_non_terminal[MAX_SYMBOLS];
+        if (generate_non_terminal(ctx, new_non_terminal, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+
+        // Remplacer les règles de rule_i avec les productions non récursives suivies du nouveau non-terminal
+        rule_i->production_count = 0;
+        for (int j = 0; j < non_recursive_count; j++) {
+            snprintf(rule_i->productions[rule_i->production_count++], MAX_SYMBOLS, "%s%s",
+                     non_recursive_productions[j], new_non_terminal);
+        }
+
+        // Ajouter les règles pour le nouveau non-terminal
+        Rule new_rule;
+        strcpy(new_rule.non_terminal, new_non_terminal);
+        new_rule.production_count = 0;
+        for (int j = 0; j < recursive_count; j++) {
+            snprintf(new_rule.productions[new_rule.production_count++], MAX_SYMBOLS, "%s%s",
+                     recursive_productions[j], new_non_terminal);
+        }
+        if (place_production(ctx, &new_rule) != GRAMMAIRE_OK) return ctx->erreur;
+        strcpy(new_rule.productions[new_rule.production_count++], "E"); // Ajout de epsilon
+
+        // Ajouter le nouveau non-terminal à la grammaire
+        if (ajouter_regle(ctx, grammaire, &new_rule) != GRAMMAIRE_OK) return ctx->erreur;
+    }
+    return GRAMMAIRE_OK;
+}
+
+
+//remplacer axiome du membre droit par un non terminal
+
+int ajouter_regle_pour_axe(ContexteGrammaire *ctx, const char *axiome, Grammaire *grammaire) {
+    // Vérifier si l'axiome est présent dans les membres droits
+    int axiome_present = 0;
+
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        for (int j = 0; j < rule->production_count; j++) {
+            if (strstr(rule->productions[j], axiome)) {
+                axiome_present = 1;
+                break;
+            }
+        }
+        if (axiome_present) break; // Sortir dès que l'axiome est trouvé
+    }
+
+    // Si l'axiome n'est pas présent dans les membres droits, ne rien modifier
+    if (!axiome_present) {
+        return GRAMMAIRE_OK;
+    }
+
+    // Générer un nouveau non-terminal
+    char nouveau_non_terminal[MAX_SYMBOLS];
+    if (generate_non_terminal(ctx, nouveau_non_terminal, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+
+    // Ajouter une règle qui lie l'axiome au nouveau non-terminal
+    Rule nouvelle_regle;
+    strcpy(nouvelle_regle.non_terminal, axiome);
+    strcpy(nouvelle_regle.productions[0], nouveau_non_terminal);
+    nouvelle_regle.production_count = 1;
+
+    if (grammaire->rule_count < MAX_RULES) {
+        // Déplacer toutes les règles existantes vers la droite pour insérer la nouvelle règle en première position
+        for (int i = grammaire->rule_count; i > 0; i--) {
+            grammaire->rules[i] = grammaire->rules[i - 1];
+        }
+        // Ajouter la nouvelle règle en première position
+        grammaire->rules[0] = nouvelle_regle;
+        grammaire->rule_count++;
+    } else {
+        return signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de règles atteinte, impossible d'ajouter la nouvelle règle.");
+    }
+
+    // Parcourir toutes les règles pour remplacer les occurrences de l'axiome par le nouveau non-terminal
+    for (int i = 1; i < grammaire->rule_count; i++) { // Commence à 1 pour ignorer la règle ajoutée
+        Rule *rule = &grammaire->rules[i];
+
+        // Si le non-terminal de la règle est l'axiome, le remplacer par le nouveau non-terminal
+        if (strcmp(rule->non_terminal, axiome) == 0) {
+            strcpy(rule->non_terminal, nouveau_non_terminal);
+        }
+
+        // Parcourir les productions et remplacer chaque occurrence de l'axiome
+        for (int j = 0; j < rule->production_count; j++) {
+            char *production = rule->productions[j];
+            char temp[MAX_SYMBOLS] = "";
+            char *pos = production;
+
+            // Remplacer toutes les occurrences de l'axiome par le nouveau non-terminal
+            while ((pos = strstr(pos, axiome)) != NULL) {
+                // Copier la partie avant l'axiome
+                strncat(temp, production, pos - production);
+                strcat(temp, nouveau_non_terminal);
+                production = pos + strlen(axiome);
+                pos = production;
+            }
+
+            // Ajouter la partie restante
+            strcat(temp, production);
+            strcpy(rule->productions[j], temp);
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+int isTerminal(char c) {
+    return islower(c);
+}
+// retirer les terminaux dans le membre droit si la taille du membre droit>=2
+// ( donc terminaux non isoles)
+int transformRule(ContexteGrammaire *ctx, Rule *rule, Grammaire *grammaire) {
+    for (int i = 0; i < rule->production_count; i++) {
+        char *production = rule->productions[i];
+        char nouvelle_production[MAX_SYMBOLS] = "";
+        int len = strlen(production);
+
+        for (int j = 0; j < len; j++) {
+            if (isTerminal(production[j]) && len > 1) {
+                // Remplacer tous les terminaux dans une production de taille > 1
+                char nouveau_non_terminal[MAX_SYMBOLS];
+                if (generate_non_terminal(ctx, nouveau_non_terminal, grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+
+                // Créer une nouvelle règle associant le terminal au non-terminal
+                Rule nouvelle_regle;
+                strcpy(nouvelle_regle.non_terminal, nouveau_non_terminal);
+                nouvelle_regle.production_count = 1;
+                snprintf(nouvelle_regle.productions[0], MAX_SYMBOLS, "%c", production[j]);
+
+                // Ajouter la règle à la grammaire
+                if (ajouter_regle(ctx, grammaire, &nouvelle_regle) != GRAMMAIRE_OK) return ctx->erreur;
+
+                // Remplacer le terminal par le nouveau non-terminal dans la production
+                strcat(nouvelle_production, nouveau_non_terminal);
+            } else {
+                // Garder les non-terminaux ou les terminaux isolés
+                char temp[2] = {production[j], '\0'};
+                strcat(nouvelle_production, temp);
+            }
+        }
+
+        // Remplacer l'ancienne production par la nouvelle
+        strcpy(rule->productions[i], nouvelle_production);
+    }
+    return GRAMMAIRE_OK;
+}
+
+int transform(ContexteGrammaire *ctx, Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        if (transformRule(ctx, &grammaire->rules[i], grammaire) != GRAMMAIRE_OK) return ctx->erreur;
+    }
+    return GRAMMAIRE_OK;
+}
+int regrouper_terminaux(ContexteGrammaire *ctx, Grammaire *grammaire) {
+    char terminal_to_non_terminal[128][MAX_SYMBOLS] = {{0}}; // Associer chaque terminal à un unique non-terminal
+    char non_terminals_to_replace[MAX_RULES][MAX_SYMBOLS];   // Liste des anciens non-terminaux à remplacer
+    char terminal_for_non_terminal[MAX_RULES][2] = {{0}};    // Terminal associé à chaque ancien non-terminal
+    int replace_count = 0;                                  // Compteur des non-terminaux à remplacer
+
+    // Copies de travail sur le tas : une grammaire occupe près d'un Mo, trop pour la pile d'un thread
+    Grammaire *copies = malloc(2 * sizeof(Grammaire));
+    if (!copies) return signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    Grammaire *updated = &copies[0];
+    Grammaire *temp_grammaire = &copies[1];
+    *updated = *grammaire;                                  // Copie pour modification
+
+    // Étape 1 : Identifier les terminaux similaires et créer un unique non-terminal pour chaque terminal
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        if (rule->production_count == 1 && strlen(rule->productions[0]) == 1 && islower(rule->productions[0][0])) {
+            char terminal = rule->productions[0][0];
+
+            // Vérifier si un non-terminal existe déjà pour ce terminal
+            if (strlen(terminal_to_non_terminal[(int)terminal]) == 0) {
+                // Générer un nouveau non-terminal
+                char new_non_terminal[MAX_SYMBOLS];
+                if (generate_non_terminal(ctx, new_non_terminal, updated) != GRAMMAIRE_OK) {
+                    free(copies);
+                    return ctx->erreur;
+                }
+
+                // Associer ce non-terminal au terminal
+                strcpy(terminal_to_non_terminal[(int)terminal], new_non_terminal);
+
+                // Ajouter une règle pour ce terminal
+                Rule new_rule;
+                strcpy(new_rule.non_terminal, new_non_terminal);
+                snprintf(new_rule.productions[0], MAX_SYMBOLS, "%c", terminal);
+                new_rule.production_count = 1;
+                if (ajouter_regle(ctx, updated, &new_rule) != GRAMMAIRE_OK) {
+                    free(copies);
+                    return ctx->erreur;
+                }
+            }
+
+            // Enregistrer l'ancien non-terminal à remplacer
+            strcpy(non_terminals_to_replace[replace_count], rule->non_terminal);
+            terminal_for_non_terminal[replace_count][0] = terminal;
+            replace_count++;
+        }
+    }
+
+    // Étape 2 : Supprimer les anciennes règles redondantes
+    temp_grammaire->rule_count = 0;
+    for (int i = 0; i < updated->rule_count; i++) {
+        Rule *rule = &updated->rules[i];
+
+        // Vérifier si c'est une règle redondante à supprimer
+        int skip = 0;
+        for (int j = 0; j < replace_count; j++) {
+            if (strcmp(rule->non_terminal, non_terminals_to_replace[j]) == 0) {
+                skip = 1;
+                break;
+            }
+        }
+
+        if (!skip) {
+            temp_grammaire->rules[temp_grammaire->rule_count++] = *rule;
+        }
+    }
+
+    updated = temp_grammaire;
+
+    // Étape 3 : Mettre à jour toutes les règles avec les nouveaux non-terminaux
+    for (int i = 0; i < updated->rule_count; i++) {
+        Rule *rule = &updated->rules[i];
+        for (int j = 0; j < rule->production_count; j++) {
+            char *prod = rule->productions[j];
+            for (int k = 0; k < replace_count; k++) {
+                if (strcmp(prod, non_terminals_to_replace[k]) == 0) {
+                    strcpy(prod, terminal_to_non_terminal[(int)terminal_for_non_terminal[k][0]]);
+                }
+            }
+        }
+    }
+
+    // Étape 4 : Remplacer les anciens non-terminaux dans toutes les productions où ils apparaissent
+    for (int i = 0; i < updated->rule_count; i++) {
+        Rule *rule = &updated->rules[i];
+        for (int j = 0; j < rule->production_count; j++) {
+            char *prod = rule->productions[j];
+            for (int k = 0; k < replace_count; k++) {
+                // Si le non-terminal à remplacer est dans une production
+                char *found = strstr(prod, non_terminals_to_replace[k]);
+                if (found) {
+                    // Remplacer par le nouveau non-terminal
+                    strncpy(found, terminal_to_non_terminal[(int)terminal_for_non_terminal[k][0]], strlen(non_terminals_to_replace[k]));
+                }
+            }
+        }
+    }
+
+    // Mise à jour finale de la grammaire
+    *grammaire = *updated;
+    free(copies);
+    return GRAMMAIRE_OK;
+}
+// Écrire une grammaire au format lu par lire_grammaire
+int ecrire_grammaire(FILE *fichier, const Grammaire *grammaire) {
+    // Parcourir les règles de la grammaire
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        const Rule *rule = &grammaire->rules[i];
+
+        // Écrire le non-terminal
+        fprintf(fichier, "%s : ", rule->non_terminal);
+
+        // Écrire les productions séparées par " | "
+        for (int j = 0; j < rule->production_count; j++) {
+            fprintf(fichier, "%s", rule->productions[j]);
+            if (j < rule->production_count - 1) {
+                fprintf(fichier, " | ");
+            }
+        }
+
+        // Fin de ligne pour la règle
+        fprintf(fichier, "\n");
+    }
+    return ferror(fichier) ? GRAMMAIRE_ERREUR_FICHIER : GRAMMAIRE_OK;
+}
+
+int sauvegarder_grammaire(ContexteGrammaire *ctx, const Grammaire *grammaire, const char *nom_base, char c) {
+    // Construire le nom du fichier en fonction du caractère c
+    char nom_fichier[4096];
+    if (c == 'c') {
+        snprintf(nom_fichier, sizeof(nom_fichier), "%s.chomsky", nom_base);
+    } else if (c == 'g') {
+        snprintf(nom_fichier, sizeof(nom_fichier), "%s.greibach", nom_base);
+    } else {
+        return signaler(ctx, GRAMMAIRE_ERREUR_ARGUMENT, "Caractère non valide. Utilisez 'c' ou 'g'.");
+    }
+
+    // Ouvrir le fichier en mode écriture, après l'avoir détaché : il peut être un lien
+    // physique vers une entrée du cache, qui ne doit pas changer
+    unlink(nom_fichier);
+    FILE *fichier = fopen(nom_fichier, "w");
+    if (!fichier) {
+        return signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur lors de l'ouverture du fichier %s : %s",
+                        nom_fichier, strerror(errno));
+    }
+
+    int statut = ecrire_grammaire(fichier, grammaire);
+
+    // Fermer le fichier
+    if (fclose(fichier) != 0) statut = GRAMMAIRE_ERREUR_FICHIER;
+    if (statut != GRAMMAIRE_OK) {
+        return signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur d'écriture dans %s.", nom_fichier);
+    }
+    return GRAMMAIRE_OK;
+}
+
+// Nom commun des sorties : "dir/x.general.txt" ou "dir/x.general" donne "dir/x.Transforme",
+// à compléter par sauvegarder_grammaire en .greibach ou .chomsky
+void nom_base_sortie(const char *fichier, char *base, size_t taille) {
+    size_t longueur = strlen(fichier);
+    const char *suffixes[] = {".general.txt", ".general"};
+    for (int i = 0; i < 2; i++) {
+        size_t l = strlen(suffixes[i]);
+        if (longueur > l && strcmp(fichier + longueur - l, suffixes[i]) == 0) {
+            longueur -= l;
+            break;
+        }
+    }
+    snprintf(base, taille, "%.*s.Transforme", (int)longueur, fichier);
+}
+
+bool est_majuscule_ou_minuscule(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+void supprimer_E_non_isole(Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+        
+        // Parcours de toutes les productions de chaque règle
+        for (int j = 0; j < rule->production_count; j++) {
+            char *production = rule->productions[j];
+            int len = strlen(production);
+            
+            for (int i = 0; i < len; i++) {
+                // On cherche les 'E' dans la production
+                if (production[i] == 'E') {
+                    // Vérifier si E est précédé ou suivi d'une majuscule ou minuscule
+                    if ((i > 0 && est_majuscule_ou_minuscule(production[i - 1])) || 
+                        (i < len - 1 && est_majuscule_ou_minuscule(production[i + 1]))) {
+                        
+                        // Supprimer le 'E' de la production
+                        // Décaler le reste de la chaîne après le 'E'
+                        memmove(production + i, production + i + 1, len - i);
+                        break; // Passer à la production suivante après modification
+                    }
+                }
+            }
+        }
+    }
+}
+// Adaptateurs : chaque étape d'une conversion a la signature EtapeGrammaire
+static int etape_factoriser(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)axiome;
+    return factoriser(ctx, grammaire);
+}
+static int etape_recursivite_gauche(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)axiome;
+    return supprimer_recursivite_gauche(ctx, grammaire);
+}
+static int etape_E_non_isole(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)ctx;
+    (void)axiome;
+    supprimer_E_non_isole(grammaire);
+    return GRAMMAIRE_OK;
+}
+static int etape_axiome(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    return ajouter_regle_pour_axe(ctx, axiome, grammaire);
+}
+static int etape_epsilon(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    return supprimer_epsilon(ctx, grammaire, axiome);
+}
+static int etape_unite(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)ctx;
+    (void)axiome;
+    supprimer_unite(grammaire);
+    return GRAMMAIRE_OK;
+}
+static int etape_non_terminaux_en_tete(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)ctx;
+    (void)axiome;
+    supprimer_non_terminaux_en_tete(grammaire);
+    return GRAMMAIRE_OK;
+}
+static int etape_terminaux_non_en_tete(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)axiome;
+    return supprimer_terminaux_non_en_tete(ctx, grammaire);
+}
+static int etape_transform(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)axiome;
+    return transform(ctx, grammaire);
+}
+static int etape_plus_de_deux(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)axiome;
+    return supprimer_regles_avec_plus_de_deux_non_terminaux(ctx, grammaire);
+}
+static int etape_regrouper(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    (void)axiome;
+    return regrouper_terminaux(ctx, grammaire);
+}
+
+static const EtapeConversion etapes_chomsky[] = {
+    { "Étape 1 : Supprimer la récursivité gauche", etape_recursivite_gauche },
+    { "Suppression de E-non-isolé si il existe", etape_E_non_isole },
+    { "Étape 2 : factoriser", etape_factoriser },
+    { "Étape 3 : Retirer l'axiome des membres droits", etape_axiome },
+    { "Étape 4 : Supprimer les terminaux dans le membre droit des règles de longueur au moins deux", etape_transform },
+    { "Étape 5 : Supprimer les règles avec plus de deux non-terminaux", etape_plus_de_deux },
+    { "Étape 6 : Supprimer les règles X → ε sauf si X est l'axiome", etape_epsilon },
+    { "Étape 7 : Supprimer les règles unité X → Y", etape_unite },
+    { "Étape 8 : nettoyer la grammaire", etape_regrouper },
+};
+
+static const EtapeConversion etapes_greibach[] = {
+    { "Application de la factorisation", etape_factoriser },
+    { "Suppression de la récursivité gauche", etape_recursivite_gauche },
+    { "Suppression de E-non-isolé si il existe", etape_E_non_isole },
+    { "Ajout de la règle pour l'axiome", etape_axiome },
+    { "Suppression des règles epsilon", etape_epsilon },
+    { "Suppression des règles unité", etape_unite },
+    { "Suppression des non-terminaux en tête des règles", etape_non_terminaux_en_tete },
+    { "Suppression des terminaux non en tête", etape_terminaux_non_en_tete },
+    { "nettoyer la grammaire", etape_regrouper },
+};
+
+// Étapes de la conversion vers une forme normale, dans l'ordre ; la dernière regroupe
+// les règles X → a et peut donc renommer des non-terminaux
+int etapes_conversion(FormeNormale forme, const EtapeConversion **etapes) {
+    if (forme == FORME_GREIBACH) {
+        *etapes = etapes_greibach;
+        return sizeof(etapes_greibach) / sizeof(etapes_greibach[0]);
+    }
+    *etapes = etapes_chomsky;
+    return sizeof(etapes_chomsky) / sizeof(etapes_chomsky[0]);
+}
+
+// Fonction pour vérifier si une production est sous la forme normale de Chomsky
+static int production_chomsky(const Grammaire *grammaire, const Rule *rule, const char *production) {
+    // Cas 1 : Un seul terminal
+    if (strlen(production) == 1 && isTerminal(production[0])) {
+        return 1;
+    }
+
+    // Cas 2 : Deux non-terminaux
+    if (strlen(production) == 4) { // Longueur 4, ex : "Y8Z0"
+        char left[3] = {production[0], production[1], '\0'}; // Premier non-terminal : Y8
+        char right[3] = {production[2], production[3], '\0'}; // Second non-terminal : Z0
+
+        if (isNonTerminal(left) && isNonTerminal(right)) {
+            return 1;
+        }
+    }
+
+    // Cas 3 : Axiome produisant epsilon
+    return strcmp(production, "E") == 0 &&
+           strcmp(rule->non_terminal, grammaire->rules[0].non_terminal) == 0;
+}
+
+// Fonction pour vérifier si une production respecte la forme normale de Greibach
+static int production_greibach(const Grammaire *grammaire, const Rule *rule, const char *production) {
+    // Cas 1 : Axiome produisant epsilon
+    if (strcmp(production, "E") == 0 &&
+        strcmp(rule->non_terminal, grammaire->rules[0].non_terminal) == 0) {
+        return 1;
+    }
+
+    // Cas 2 : La production commence par un terminal
+    if (!isTerminal(production[0])) return 0;
+
+    // Vérifier que les symboles suivants sont des non-terminaux
+    for (size_t k = 1; k < strlen(production); k += 2) {
+        char symbol[3] = {production[k], production[k + 1], '\0'};
+        if (!isNonTerminal(symbol)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int isChomsky(const Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        const Rule *rule = &grammaire->rules[i];
+        for (int j = 0; j < rule->production_count; j++) {
+            if (!production_chomsky(grammaire, rule, rule->productions[j])) return 0;
+        }
+    }
+    return 1; // Toutes les règles sont valides
+}
+
+int isGreibach(const Grammaire *grammaire) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        const Rule *rule = &grammaire->rules[i];
+        for (int j = 0; j < rule->production_count; j++) {
+            if (!production_greibach(grammaire, rule, rule->productions[j])) return 0;
+        }
+    }
+    return 1; // Toutes les productions respectent GNF
+}
+
+// Tracer la vérification de la forme obtenue, avec les productions fautives au niveau détaillé
+static void tracer_validation(const ContexteGrammaire *ctx, const Grammaire *grammaire, FormeNormale forme) {
+    int fautives = 0;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        const Rule *rule = &grammaire->rules[i];
+        for (int j = 0; j < rule->production_count; j++) {
+            const char *production = rule->productions[j];
+            int valide = forme == FORME_GREIBACH ? production_greibach(grammaire, rule, production)
+                                                 : production_chomsky(grammaire, rule, production);
+            if (valide) continue;
+            fautives++;
+            TRACER(ctx, TRACE_DETAIL, TRACE_VALIDATION, "validation %s -> %s non conforme", rule->non_terminal, production);
+        }
+    }
+    TRACER(ctx, TRACE_RESUME, TRACE_VALIDATION, "validation %s : %s (%d productions non conformes)",
+           forme == FORME_GREIBACH ? "greibach" : "chomsky", fautives ? "échec" : "conforme", fautives);
+}
+
+// Exécuter les étapes [debut, fin) d'une conversion, en passant les mesures et le journal
+// du contexte après chacune
+int executer_etapes(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome, FormeNormale forme,
+                    int debut, int fin) {
+    const EtapeConversion *etapes;
+    int nb_etapes = etapes_conversion(forme, &etapes);
+    if (debut < 0 || fin > nb_etapes || debut > fin) {
+        return signaler(ctx, GRAMMAIRE_ERREUR_ARGUMENT, "Étapes %d à %d invalides.", debut, fin);
+    }
+    for (int i = debut; i < fin; i++) {
+        double depart = ctx->mesure ? horloge_grammaire() : 0;
+        int generes = ctx->non_terminaux_generes;
+        if (etapes[i].executer(ctx, grammaire, axiome) != GRAMMAIRE_OK) return ctx->erreur;
+        contexte_grammaire_mesurer(ctx, etapes[i].nom, i + 1, depart, generes, grammaire);
+        TRACER(ctx, TRACE_RESUME, TRACE_ALLOCATION, "allocation étape %d : %d nouveaux non-terminaux",
+               i + 1, ctx->non_terminaux_generes - generes);
+        contexte_grammaire_tracer_etape(ctx, i + 1, etapes[i].nom, grammaire);
+        journaliser(ctx, etapes[i].nom, grammaire);
+    }
+    if (fin == nb_etapes && TRACE_ACTIVE(ctx, TRACE_RESUME, TRACE_VALIDATION)) tracer_validation(ctx, grammaire, forme);
+    return GRAMMAIRE_OK;
+}
+
+int transformer_en_chomsky(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    const EtapeConversion *etapes;
+    return executer_etapes(ctx, grammaire, axiome, FORME_CHOMSKY, 0, etapes_conversion(FORME_CHOMSKY, &etapes));
+}
+
+int greibach(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome) {
+    const EtapeConversion *etapes;
+    return executer_etapes(ctx, grammaire, axiome, FORME_GREIBACH, 0, etapes_conversion(FORME_GREIBACH, &etapes));
+}
+
+int normaliser_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire, FormeNormale forme, int *etats) {
+    if (grammaire->rule_count == 0) return signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Grammaire vide.");
+    // L'axiome est copié : les étapes déplacent les règles
+    char axiome[MAX_SYMBOLS];
+    strcpy(axiome, grammaire->rules[0].non_terminal);
+    int nb_etats = 0;
+    int statut = normaliser_reguliere(ctx, grammaire, axiome, forme, &nb_etats);
+    if (statut == GRAMMAIRE_OK && nb_etats == 0) {
+        statut = forme == FORME_GREIBACH ? greibach(ctx, grammaire, axiome) : transformer_en_chomsky(ctx, grammaire, axiome);
+    }
+    if (etats) *etats = statut == GRAMMAIRE_OK ? nb_etats : 0;
+    return statut;
+}
+
+// Fonction pour ajouter une production à une règle, en évitant les doublons (ajout isolé :
+// les passes qui ajoutent beaucoup de productions tiennent un EnsembleProductions)
+void ajouter_production(Rule *rule, const char *production) {
+    for (int i = 0; i < rule->production_count; i++) {
+        if (strcmp(rule->productions[i], production) == 0) {
+            return; // Production déjà présente, on ne l'ajoute pas
+        }
+    }
+    strcpy(rule->productions[rule->production_count++], production);
+}
+
+// Fonction pour réécrire la grammaire sous la forme avec "|" entre les productions pour chaque non-terminal
+int rewriter_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire) {
+    // Création d'un tableau pour stocker les nouvelles règles (sur le tas, voir regrouper_terminaux)
+    Grammaire *nouvelle_grammaire = malloc(sizeof(Grammaire));
+    if (!nouvelle_grammaire) return signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    nouvelle_grammaire->rule_count = 0;
+
+    // Une règle de la nouvelle grammaire par membre gauche, dans l'ordre de première
+    // apparition ; ses productions sont réunies d'un trait, avec un seul ensemble à la fois
+    EnsembleProductions ensemble;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        Rule *rule = &grammaire->rules[i];
+
+        // Membre gauche déjà regroupé avec une règle précédente
+        int deja_vu = 0;
+        for (int j = 0; j < i && !deja_vu; j++) {
+            deja_vu = strcmp(grammaire->rules[j].non_terminal, rule->non_terminal) == 0;
+        }
+        if (deja_vu) continue;
+
+        Rule *cible = &nouvelle_grammaire->rules[nouvelle_grammaire->rule_count++];
+        strcpy(cible->non_terminal, rule->non_terminal);
+        cible->production_count = 0;
+        indexer_productions(&ensemble, cible);
+
+        // Ajouter les productions de toutes les règles de ce membre gauche
+        for (int j = i; j < grammaire->rule_count; j++) {
+            const Rule *source = &grammaire->rules[j];
+            if (strcmp(source->non_terminal, rule->non_terminal) != 0) continue;
+            for (int k = 0; k < source->production_count; k++) {
+                if (place_production(ctx, cible) != GRAMMAIRE_OK) {
+                    free(nouvelle_grammaire);
+                    return ctx->erreur;
+                }
+                ajouter_production_unique(&ensemble, cible, source->productions[k]);
+            }
+        }
+    }
+
+    // Copier la nouvelle grammaire dans la grammaire d'origine
+    *grammaire = *nouvelle_grammaire;
+    free(nouvelle_grammaire);
+    return GRAMMAIRE_OK;
+}
@@ -0,0 +1,341 @@
+#ifndef LIBGRAMMAIRE_H
+#define LIBGRAMMAIRE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "automate.h"
+
+// Normalisation de grammaires (formes de Greibach et de Chomsky).
+// Tout l'état d'une conversion vit dans un ContexteGrammaire : deux conversions avec des
+// contextes distincts peuvent tourner en même temps dans des threads différents.
+// Les fonctions n'écrivent rien sur la sortie standard et ne terminent jamais le
+// processus : elles renvoient GRAMMAIRE_OK ou un code d'erreur négatif, et le contexte
+// garde le message de la première erreur.
+
+// Version des conversions : à changer dès qu'une étape peut produire une sortie différente
+// (elle fait partie de la clé du cache de grammaire, voir cache.h)
+#define LIBGRAMMAIRE_VERSION "1.4"
+
+#define MAX_RULES 100
+#define MAX_SYMBOLS 100 // Augmentation de MAX_SYMBOLS si nécessaire
+#define MAX_NON_TERMINAUX 250
+
+typedef struct {
+    char non_terminal[MAX_SYMBOLS]; // Stocke une chaîne pour le non-terminal
+    char productions[MAX_RULES][MAX_SYMBOLS]; // Productions associées
+    int production_count; // Nombre de productions
+} Rule;
+
+typedef struct {
+    Rule rules[MAX_RULES]; // Ensemble des règles
+    int rule_count; // Nombre de règles
+} Grammaire;
+
+typedef enum {
+    GRAMMAIRE_OK = 0,
+    GRAMMAIRE_ERREUR_FICHIER = -1,         // Ouverture, lecture ou écriture d'un fichier
+    GRAMMAIRE_ERREUR_FORMAT = -2,          // Ligne de grammaire mal formée
+    GRAMMAIRE_ERREUR_LIMITE = -3,          // MAX_RULES règles ou productions dépassé
+    GRAMMAIRE_ERREUR_NON_TERMINAUX = -4,   // Plus de non-terminal A0..Z9 disponible
+    GRAMMAIRE_ERREUR_MEMOIRE = -5,
+    GRAMMAIRE_ERREUR_ARGUMENT = -6
+} CodeGrammaire;
+
+typedef enum {
+    FORME_GREIBACH,
+    FORME_CHOMSKY
+} FormeNormale;
+
+// Appelée après chaque étape d'une conversion, avec la grammaire obtenue
+typedef void (*JournalGrammaire)(void *donnees, const char *etape, const Grammaire *grammaire);
+
+// Mesures d'une étape, prises juste après son exécution (avant le journal)
+typedef struct {
+    const char *etape;
+    int numero;                    // Rang de l'étape dans la conversion, à partir de 1
+    double secondes;               // Durée de l'étape (horloge monotone)
+    int regles;                    // Taille de la grammaire obtenue
+    int productions;
+    long symboles;                 // Un terminal ou un non-terminal compte pour un, ε pour zéro
+    int nouveaux_non_terminaux;    // Alloués par generate_non_terminal pendant l'étape
+} MesureEtape;
+
+typedef void (*MesureGrammaire)(void *donnees, const MesureEtape *mesure);
+
+// Trace : lignes "# <catégorie> ..." écrites dans un fichier, suivies au niveau détaillé de
+// la grammaire obtenue (format d'ecrire_grammaire). Un niveau au-delà de TRACE_NIVEAU_MAX
+// disparaît à la compilation (-DTRACE_NIVEAU_MAX=0 retire toute la trace) ; en deçà,
+// une trace absente ou d'un niveau plus bas ne coûte qu'un test.
+#define TRACE_SILENCE 0
+#define TRACE_RESUME 1                 // Une ligne par étape, allocation ou vérification
+#define TRACE_DETAIL 2                 // Plus la grammaire après chaque étape et les productions fautives
+#ifndef TRACE_NIVEAU_MAX
+#define TRACE_NIVEAU_MAX TRACE_DETAIL
+#endif
+
+#define TRACE_ETAPES 1u
+#define TRACE_ALLOCATION 2u            // Nouveaux non-terminaux
+#define TRACE_VALIDATION 4u            // Vérification de la forme obtenue après la dernière étape
+#define TRACE_TOUT 7u
+
+typedef struct {
+    FILE *fichier;                 // Partageable entre threads : chaque bloc est écrit d'un seul tenant
+    int niveau;
+    unsigned categories;
+} TraceGrammaire;
+
+#define TRACE_ACTIVE(ctx, niveau_trace, categorie) \
+    ((niveau_trace) <= TRACE_NIVEAU_MAX && (ctx)->trace && (niveau_trace) <= (ctx)->trace->niveau && \
+     ((ctx)->trace->categories & (categorie)))
+#define TRACER(ctx, niveau_trace, categorie, ...) \
+    do { \
+        if (TRACE_ACTIVE(ctx, niveau_trace, categorie)) contexte_grammaire_tracer((ctx), __VA_ARGS__); \
+    } while (0)
+
+typedef struct {
+    int letter_index;              // Prochain non-terminal généré : 'A' + letter_index,
+    int number_index;              // suivi du chiffre number_index (de Z9 vers A0)
+    CodeGrammaire erreur;          // Première erreur rencontrée
+    char message[256];
+    JournalGrammaire journal;      // Facultatif
+    void *donnees_journal;
+    MesureGrammaire mesure;        // Facultatif : les étapes ne sont chronométrées que s'il est donné
+    void *donnees_mesure;
+    int non_terminaux_generes;     // Compteur de generate_non_terminal
+    const TraceGrammaire *trace;   // Facultatif
+} ContexteGrammaire;
+
+void contexte_grammaire_init(ContexteGrammaire *ctx);
+const char *contexte_grammaire_message(const ContexteGrammaire *ctx);
+int contexte_grammaire_signaler(ContexteGrammaire *ctx, CodeGrammaire code, const char *format, ...);
+
+// Écrire une ligne de trace (sans test de niveau : passer par TRACER)
+void contexte_grammaire_tracer(const ContexteGrammaire *ctx, const char *format, ...);
+void contexte_grammaire_tracer_etape(const ContexteGrammaire *ctx, int numero, const char *etape,
+                                     const Grammaire *grammaire);
+
+// Taille d'une grammaire, comptée comme dans MesureEtape
+void mesurer_grammaire(const Grammaire *grammaire, int *regles, int *productions, long *symboles);
+// Secondes de l'horloge monotone, et envoi d'une mesure commencée à `debut` au contexte
+double horloge_grammaire(void);
+void contexte_grammaire_mesurer(ContexteGrammaire *ctx, const char *etape, int numero, double debut,
+                                int generes_avant, const Grammaire *grammaire);
+
+// Lecture, écriture
+void nettoyer_chaine(char *str);
+int lire_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire, const char *filename);
+int lire_grammaire_flux(ContexteGrammaire *ctx, Grammaire *grammaire, FILE *flux);
+int ecrire_grammaire(FILE *fichier, const Grammaire *grammaire);
+int sauvegarder_grammaire(ContexteGrammaire *ctx, const Grammaire *grammaire, const char *nom_base, char c);
+// Nom commun des sorties d'une grammaire : "x.general.txt" ou "x.general" donne "x.Transforme"
+void nom_base_sortie(const char *fichier, char *base, size_t taille);
+
+// Symboles
+int isNonTerminal(const char *symbol);
+int isTerminal(char c);
+bool est_majuscule_ou_minuscule(char c);
+int non_terminal_exists(const Grammaire *grammaire, const char *non_terminal);
+int non_terminal_in_rule(const Grammaire *grammaire, const char *non_terminal, const char *rule_production);
+int generate_non_terminal(ContexteGrammaire *ctx, char *result, const Grammaire *grammaire);
+// Symbole en tête de `texte` dans une production : indice de règle (le nom le plus long),
+// -1 - c pour le terminal c, SYMBOLE_EPSILON, ou SYMBOLE_INCONNU pour un non-terminal sans
+// règle ; *taille reçoit sa longueur
+#define SYMBOLE_EPSILON (-1000)
+#define SYMBOLE_INCONNU (-2000)
+int lire_symbole(const Grammaire *grammaire, const char *texte, int *taille);
+
+// Étapes des conversions
+int prefix_common_length(const char *str1, const char *str2);
+int factoriser_productions(ContexteGrammaire *ctx, char *prod1, char *prod2, Grammaire *grammaire);
+int factoriser_rule(ContexteGrammaire *ctx, Rule *rule, Grammaire *grammaire);
+int factoriser(ContexteGrammaire *ctx, Grammaire *grammaire);
+int supprimer_epsilon(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome);
+void nettoyer_grammaire(Grammaire *grammaire);
+void supprimer_unite(Grammaire *grammaire);
+void supprimer_non_terminaux_en_tete(Grammaire *grammaire);
+int supprimer_terminaux_non_en_tete(ContexteGrammaire *ctx, Grammaire *grammaire);
+int supprimer_regles_avec_plus_de_deux_non_terminaux(ContexteGrammaire *ctx, Grammaire *grammaire);
+int supprimer_recursivite_gauche(ContexteGrammaire *ctx, Grammaire *grammaire);
+int ajouter_regle_pour_axe(ContexteGrammaire *ctx, const char *axiome, Grammaire *grammaire);
+int transformRule(ContexteGrammaire *ctx, Rule *rule, Grammaire *grammaire);
+int transform(ContexteGrammaire *ctx, Grammaire *grammaire);
+int regrouper_terminaux(ContexteGrammaire *ctx, Grammaire *grammaire);
+void supprimer_E_non_isole(Grammaire *grammaire);
+void ajouter_production(Rule *rule, const char *production);
+int rewriter_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire);
+
+// Conversions complètes, comme suites d'étapes
+typedef int (*EtapeGrammaire)(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome);
+typedef struct {
+    const char *nom;               // Nom passé au journal
+    EtapeGrammaire executer;
+} EtapeConversion;
+
+int etapes_conversion(FormeNormale forme, const EtapeConversion **etapes);
+int executer_etapes(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome, FormeNormale forme,
+                    int debut, int fin);
+int transformer_en_chomsky(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome);
+int greibach(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome);
+// Forme normale d'une grammaire regroupée par rewriter_grammaire, l'axiome étant le membre
+// gauche de la première règle : depuis l'automate minimal si elle est régulière
+// (normaliser_reguliere, *etats facultatif reçoit son nombre d'états, sinon 0), par les
+// étapes de la conversion sinon. Le résultat garde l'axiome en première règle.
+int normaliser_grammaire(ContexteGrammaire *ctx, Grammaire *grammaire, FormeNormale forme, int *etats);
+int isChomsky(const Grammaire *grammaire);
+int isGreibach(const Grammaire *grammaire);
+
+// Grammaires régulières (reguliere.c, automate.c). compiler_grammaire_reguliere construit
+// l'automate minimal d'une grammaire regroupée par rewriter_grammaire (*reguliere vaut 1),
+// si elle est sans auto-enchâssement et que l'automate a au plus max_etats états.
+// normaliser_reguliere en tire directement la forme normale, un non-terminal par état qui
+// a des transitions, sans passer par les étapes de la conversion ; *etats reçoit le nombre
+// d'états de l'automate, ou 0 si la grammaire n'est pas régulière, si son langage est vide
+// ou si la forme obtenue dépasse MAX_RULES (la grammaire est alors laissée telle quelle).
+int compiler_grammaire_reguliere(ContexteGrammaire *ctx, const Grammaire *grammaire, int max_etats, Automate *automate,
+                                 int *reguliere);
+int normaliser_reguliere(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome, FormeNormale forme, int *etats);
+
+// Normalisation modulaire (modulaire.c). La grammaire, regroupée par rewriter_grammaire,
+// est découpée en composantes fortement connexes du graphe de dépendance des
+// non-terminaux. Chaque composante est normalisée seule par les étapes de la conversion
+// (sauf le regroupement final), les non-terminaux des composantes inférieures y restant
+// opaques ; les résultats sont ensuite assemblés dans l'ordre des dépendances, puis
+// regroupés. Les composantes sont indépendantes : elles se normalisent en parallèle, et
+// une composante inchangée est reprise du mémo sans être recalculée.
+// Le résultat reconnaît le même langage que greibach ou transformer_en_chomsky, avec
+// d'autres noms de non-terminaux.
+
+// Mémo des composantes. La clé est un texte canonique (la composante avec des noms
+// locaux, la forme et LIBGRAMMAIRE_VERSION) ; le résultat est la composante normalisée,
+// au format d'ecrire_grammaire. Les deux fonctions peuvent être appelées depuis
+// plusieurs threads à la fois.
+typedef struct {
+    char *(*chercher)(void *donnees, const char *cle);   // Résultat alloué par malloc, ou NULL
+    void (*ranger)(void *donnees, const char *cle, const char *resultat);
+    void *donnees;
+} MemoComposantes;
+
+typedef struct {
+    int composantes;
+    int recalculees;               // Composantes absentes du mémo
+} BilanModulaire;
+
+int normaliser_modulaire(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome, FormeNormale forme,
+                         const MemoComposantes *memo, int nb_threads, BilanModulaire *bilan);
+
+// Analyse LL(1) (ll1.c). PREMIER et SUIVANT de chaque non-terminal d'une grammaire (la
+// première règle est l'axiome), conflits, et table d'analyse : pour un non-terminal et un
+// terminal de prévision (ou la fin du mot), la production à appliquer. Sans conflit, la
+// table reconnaît un mot en temps linéaire avec une seule pile. Elle n'est pas modifiée
+// par la reconnaissance : plusieurs threads peuvent s'en servir à la fois.
+#define LL1_FIN '$'                // Prévision « fin du mot »
+#define LL1_MAX_CONFLITS 16        // Conflits gardés dans la table (tous sont comptés)
+
+typedef struct {
+    int non_terminal;
+    char terminal;                 // Terminal de prévision, ou LL1_FIN
+    int premiere, seconde;         // Productions en conflit
+} ConflitLL1;
+
+typedef struct {
+    int nb_non_terminaux;          // Le non-terminal i est la règle i, 0 est l'axiome
+    char (*noms)[MAX_SYMBOLS];
+    int nb_productions;            // Productions de toutes les règles, dans l'ordre
+    int *gauche, *debut, *longueur;
+    int *symboles;                 // Non-terminal, ou -1 - c pour le terminal c ; ε est omis
+    int nb_colonnes;               // Terminaux de la grammaire, puis LL1_FIN
+    char colonnes[257];
+    int colonne[256];              // Colonne d'un caractère, -1 hors de la grammaire
+    unsigned char *annulable;      // nb_non_terminaux
+    unsigned char *premier;        // nb_non_terminaux × nb_colonnes (LL1_FIN jamais)
+    unsigned char *suivant;        // nb_non_terminaux × nb_colonnes
+    int *entrees;                  // nb_non_terminaux × nb_colonnes : production, ou -1
+    int nb_conflits;
+    ConflitLL1 conflits[LL1_MAX_CONFLITS];
+} TableLL1;
+
+// Pile de reconnaissance, réutilisable d'un mot à l'autre ({ NULL, 0 } au départ)
+typedef struct {
+    int *symboles;
+    size_t capacite;
+} PileAnalyse;
+
+int construire_table_ll1(ContexteGrammaire *ctx, const Grammaire *grammaire, TableLL1 *table);
+void liberer_table_ll1(TableLL1 *table);
+// Production p écrite comme dans une grammaire ("E" si elle est vide), et conflit en clair
+void production_ll1(const TableLL1 *table, int p, char *texte, size_t taille);
+void decrire_conflit_ll1(const TableLL1 *table, const ConflitLL1 *conflit, char *texte, size_t taille);
+// Table sans conflit : écriture compacte (une ligne par non-terminal) et relecture
+int ecrire_table_ll1(FILE *fichier, const TableLL1 *table);
+int lire_table_ll1(ContexteGrammaire *ctx, TableLL1 *table, const char *fichier);
+// 1 si le mot (sans "E" pour le mot vide) est reconnu, 0 sinon, -1 si la mémoire manque
+int reconnaitre_ll1(const TableLL1 *table, const char *mot, size_t longueur, PileAnalyse *pile);
+void liberer_pile_analyse(PileAnalyse *pile);
+
+// Analyse LALR(1) (lalr.c). Automate LR(0) de la grammaire augmentée par S' -> axiome,
+// prévisions LALR(1) propagées d'état en état jusqu'au point fixe, conflits, et tables
+// ACTION et ALLER compressées : chaque état garde une réduction par défaut, ses autres
+// actions sont rangées en peigne (les lignes des états, décalées, partagent un même
+// vecteur, et chaque case garde le numéro de sa ligne) ; ALLER de même, une ligne par
+// non-terminal. La reconnaissance se fait en temps linéaire avec une pile d'états.
+#define LALR_MAX_CONFLITS 16
+
+typedef struct {
+    int etat;
+    char terminal;                 // Ou LL1_FIN
+    int decalage;                  // 1 : conflit décalage/réduction (seconde vaut -1)
+    int premiere, seconde;         // Productions réduites
+} ConflitLALR;
+
+typedef struct {
+    int nb_non_terminaux;          // Le non-terminal i est la règle i ; nb_non_terminaux est S'
+    char (*noms)[MAX_SYMBOLS];
+    int nb_productions;            // La production 0 est S' -> axiome, les autres suivent la grammaire
+    int *gauche, *debut, *longueur;
+    int *symboles;                 // Non-terminal, ou -1 - c pour le terminal c
+    int nb_colonnes;               // Terminaux de la grammaire, puis LL1_FIN
+    char colonnes[257];
+    int colonne[256];
+    int nb_etats;
+    // ACTION(e, c) : base_action[e] + c indexe action si controle_action y vaut e, sinon
+    // c'est la réduction par défaut de e (ou une erreur s'il n'en a pas). Une action
+    // a > 0 décale vers l'état a - 1, a < 0 réduit la production -a - 1 ; réduire la
+    // production 0 accepte le mot.
+    int *defaut;                   // Par état : action par défaut, 0 pour aucune
+    int *base_action;
+    int taille_action;
+    int *action, *controle_action;
+    // ALLER(e, A) : aller[base_aller[A] + e] si controle_aller y vaut A
+    int *base_aller;
+    int taille_aller;
+    int *aller, *controle_aller;
+    int nb_conflits;
+    ConflitLALR conflits[LALR_MAX_CONFLITS];
+} TableLALR;
+
+int construire_table_lalr(ContexteGrammaire *ctx, const Grammaire *grammaire, TableLALR *table);
+void liberer_table_lalr(TableLALR *table);
+void production_lalr(const TableLALR *table, int p, char *texte, size_t taille);
+void decrire_conflit_lalr(const TableLALR *table, const ConflitLALR *conflit, char *texte, size_t taille);
+// Tables compressées, au format texte (productions, puis vecteurs en lignes de nombres), et
+// relecture, vérifiée contre la table reconstruite depuis les productions
+int ecrire_table_lalr(FILE *fichier, const TableLALR *table);
+int lire_table_lalr(ContexteGrammaire *ctx, TableLALR *table, const char *fichier);
+// Comme reconnaitre_ll1 ; la pile est une pile d'états
+int reconnaitre_lalr(const TableLALR *table, const char *mot, size_t longueur, PileAnalyse *pile);
+
+// Reconnaisseurs C (emission.c). Chaque fonction écrit un fichier source autonome qui
+// définit int reconnaitre_<nom>(const char *mot, size_t longueur) : l'automate minimal
+// d'une grammaire régulière, l'analyse LL(1) ou LALR(1) d'une table sans conflit, dépliées
+// en switch et en code en ligne droite, ou CYK sur une grammaire de Chomsky, les ensembles
+// de non-terminaux tenant dans un nombre fixe de mots de 64 bits. Le nom doit être un
+// identificateur C. Avec -DRECONNAISSEUR_MAIN, le fichier est aussi un programme qui trie
+// les mots de l'entrée standard comme reconnaitre.
+#define EMISSION_MAX_ETATS 4096        // Au-delà, l'automate régulier n'est pas déplié
+int emettre_automate_c(FILE *fichier, const char *nom, const Automate *automate);
+int emettre_ll1_c(FILE *fichier, const char *nom, const TableLL1 *table);
+int emettre_lalr_c(FILE *fichier, const char *nom, const TableLALR *table);
+int emettre_cyk_c(ContexteGrammaire *ctx, FILE *fichier, const char *nom, const Grammaire *grammaire);
+
+#endif
@@ -0,0 +1,65 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "generate_words.h"
+
+void liste_mots_init(ListeMots *liste) {
+    memset(liste, 0, sizeof(*liste));
+}
+
+// Ajouter un mot (copié) à la fin de la liste
+int liste_mots_ajouter(ListeMots *liste, const char *mot, size_t longueur) {
+    if (liste->taille + longueur + 1 > liste->capacite) {
+        size_t capacite = liste->capacite ? liste->capacite : 4096;
+        while (capacite < liste->taille + longueur + 1) capacite *= 2;
+        char *donnees = realloc(liste->donnees, capacite);
+        if (!donnees) return -1;
+        liste->donnees = donnees;
+        liste->capacite = capacite;
+    }
+    if (liste->nombre == liste->capacite_debuts) {
+        size_t capacite = liste->capacite_debuts ? liste->capacite_debuts * 2 : 256;
+        size_t *debuts = realloc(liste->debuts, capacite * sizeof(size_t));
+        if (!debuts) return -1;
+        liste->debuts = debuts;
+        liste->capacite_debuts = capacite;
+    }
+
+    liste->debuts[liste->nombre++] = liste->taille;
+    memcpy(liste->donnees + liste->taille, mot, longueur);
+    liste->donnees[liste->taille + longueur] = '\0';
+    liste->taille += longueur + 1;
+    return 0;
+}
+
+// Ordre de sortie : d'abord la longueur, puis l'ordre lexicographique
+int comparer_mots_shortlex(const char *mot_a, const char *mot_b) {
+    size_t len_a = strlen(mot_a);
+    size_t len_b = strlen(mot_b);
+    if (len_a != len_b) return len_a < len_b ? -1 : 1;
+    return strcmp(mot_a, mot_b);
+}
+
+static int comparer_pointeurs_mots(const void *a, const void *b) {
+    return comparer_mots_shortlex(*(const char *const *)a, *(const char *const *)b);
+}
+
+// Construire liste->tries et le trier
+int liste_mots_trier(ListeMots *liste) {
+    free(liste->tries);
+    liste->tries = malloc((liste->nombre ? liste->nombre : 1) * sizeof(char *));
+    if (!liste->tries) return -1;
+    for (size_t i = 0; i < liste->nombre; i++) {
+        liste->tries[i] = liste->donnees + liste->debuts[i];
+    }
+    qsort(liste->tries, liste->nombre, sizeof(char *), comparer_pointeurs_mots);
+    return 0;
+}
+
+void liste_mots_liberer(ListeMots *liste) {
+    free(liste->donnees);
+    free(liste->debuts);
+    free(liste->tries);
+    liste_mots_init(liste);
+}
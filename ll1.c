@@ -0,0 +1,403 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+
+#include "libgrammaire.h"
+
+// Analyse LL(1), voir libgrammaire.h.
+//
+// Les ensembles sont des tableaux d'octets indexés par colonne. PREMIER(A) ne contient que
+// des terminaux, l'annulabilité est à part ; SUIVANT(A) peut contenir LL1_FIN. La
+// production A -> α va dans les cases de PREMIER(α), et dans celles de SUIVANT(A) si α
+// est annulable ; une case déjà occupée par une autre production est un conflit.
+
+#define EST_TERMINAL(s) ((s) < 0)
+#define CARACTERE(s) ((char)(-1 - (s)))
+
+void liberer_table_ll1(TableLL1 *table) {
+    free(table->noms);
+    free(table->gauche);
+    free(table->debut);
+    free(table->longueur);
+    free(table->symboles);
+    free(table->annulable);
+    free(table->premier);
+    free(table->suivant);
+    free(table->entrees);
+    memset(table, 0, sizeof(*table));
+}
+
+// Découper les productions de la grammaire et fixer les colonnes
+static int decouper(ContexteGrammaire *ctx, const Grammaire *grammaire, TableLL1 *table) {
+    memset(table, 0, sizeof(*table));
+    int n = grammaire->rule_count;
+    size_t total = 0;
+    for (int i = 0; i < n; i++) {
+        table->nb_productions += grammaire->rules[i].production_count;
+        for (int j = 0; j < grammaire->rules[i].production_count; j++) total += strlen(grammaire->rules[i].productions[j]);
+    }
+    table->nb_non_terminaux = n;
+    table->noms = malloc((n + 1) * sizeof(*table->noms));
+    table->gauche = malloc((table->nb_productions + 1) * sizeof(int));
+    table->debut = malloc((table->nb_productions + 1) * sizeof(int));
+    table->longueur = malloc((table->nb_productions + 1) * sizeof(int));
+    table->symboles = malloc((total + 1) * sizeof(int));
+    if (!table->noms || !table->gauche || !table->debut || !table->longueur || !table->symboles) {
+        liberer_table_ll1(table);
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    }
+
+    for (int c = 0; c < 256; c++) table->colonne[c] = -1;
+    int position = 0, p = 0;
+    for (int i = 0; i < n; i++) {
+        strcpy(table->noms[i], grammaire->rules[i].non_terminal);
+        for (int j = 0; j < grammaire->rules[i].production_count; j++, p++) {
+            const char *production = grammaire->rules[i].productions[j];
+            table->gauche[p] = i;
+            table->debut[p] = position;
+            for (int k = 0, taille; production[k] != '\0'; k += taille) {
+                int symbole = lire_symbole(grammaire, production + k, &taille);
+                if (symbole == SYMBOLE_INCONNU) {
+                    int code = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Non-terminal sans règle dans %s : %s",
+                                                           grammaire->rules[i].non_terminal, production);
+                    liberer_table_ll1(table);
+                    return code;
+                }
+                if (symbole == SYMBOLE_EPSILON) continue;
+                if (EST_TERMINAL(symbole) && table->colonne[(unsigned char)CARACTERE(symbole)] == -1) {
+                    table->colonne[(unsigned char)CARACTERE(symbole)] = table->nb_colonnes;
+                    table->colonnes[table->nb_colonnes++] = CARACTERE(symbole);
+                }
+                table->symboles[position++] = symbole;
+            }
+            table->longueur[p] = position - table->debut[p];
+        }
+    }
+    table->colonnes[table->nb_colonnes++] = LL1_FIN;
+    table->colonnes[table->nb_colonnes] = '\0';
+    return GRAMMAIRE_OK;
+}
+
+// Réunir la ligne `source` dans `destination` ; renvoie 1 si elle a changé
+static int reunir(unsigned char *destination, const unsigned char *source, int nb_colonnes) {
+    int change = 0;
+    for (int k = 0; k < nb_colonnes; k++) {
+        if (source[k] && !destination[k]) destination[k] = change = 1;
+    }
+    return change;
+}
+
+// Annulables, PREMIER et SUIVANT par points fixes
+static void calculer_ensembles(TableLL1 *t) {
+    int colonnes = t->nb_colonnes;
+    for (int change = 1; change; ) {
+        change = 0;
+        for (int p = 0; p < t->nb_productions; p++) {
+            int a = t->gauche[p];
+            int k = 0;
+            for (; k < t->longueur[p]; k++) {
+                int s = t->symboles[t->debut[p] + k];
+                if (EST_TERMINAL(s)) {
+                    unsigned char *case_premier = &t->premier[a * colonnes + t->colonne[(unsigned char)CARACTERE(s)]];
+                    if (!*case_premier) *case_premier = change = 1;
+                    break;
+                }
+                change |= reunir(&t->premier[a * colonnes], &t->premier[s * colonnes], colonnes);
+                if (!t->annulable[s]) break;
+            }
+            if (k == t->longueur[p] && !t->annulable[a]) t->annulable[a] = change = 1;
+        }
+    }
+
+    // De droite à gauche, `suite` est PREMIER des symboles qui suivent, et `suite_annulable`
+    // dit s'ils peuvent s'effacer
+    unsigned char suite[257];
+    if (t->nb_non_terminaux > 0) t->suivant[colonnes - 1] = 1;
+    for (int change = 1; change; ) {
+        change = 0;
+        for (int p = 0; p < t->nb_productions; p++) {
+            int a = t->gauche[p], suite_annulable = 1;
+            memset(suite, 0, sizeof(suite));
+            for (int k = t->longueur[p] - 1; k >= 0; k--) {
+                int s = t->symboles[t->debut[p] + k];
+                if (EST_TERMINAL(s)) {
+                    memset(suite, 0, sizeof(suite));
+                    suite[t->colonne[(unsigned char)CARACTERE(s)]] = 1;
+                    suite_annulable = 0;
+                    continue;
+                }
+                change |= reunir(&t->suivant[s * colonnes], suite, colonnes);
+                if (suite_annulable) change |= reunir(&t->suivant[s * colonnes], &t->suivant[a * colonnes], colonnes);
+                if (!t->annulable[s]) {
+                    memset(suite, 0, sizeof(suite));
+                    suite_annulable = 0;
+                }
+                reunir(suite, &t->premier[s * colonnes], colonnes);
+            }
+        }
+    }
+}
+
+// Ranger la production p dans une case, en relevant le conflit si elle est occupée
+static void ranger(TableLL1 *t, int p, int colonne) {
+    int *entree = &t->entrees[t->gauche[p] * t->nb_colonnes + colonne];
+    if (*entree == -1) {
+        *entree = p;
+        return;
+    }
+    if (*entree == p) return;
+    if (t->nb_conflits < LL1_MAX_CONFLITS) {
+        ConflitLL1 *conflit = &t->conflits[t->nb_conflits];
+        conflit->non_terminal = t->gauche[p];
+        conflit->terminal = t->colonnes[colonne];
+        conflit->premiere = *entree;
+        conflit->seconde = p;
+    }
+    t->nb_conflits++;
+}
+
+static void remplir_table(TableLL1 *t) {
+    int colonnes = t->nb_colonnes;
+    unsigned char prevision[257];
+    for (int p = 0; p < t->nb_productions; p++) {
+        // PREMIER(α), puis SUIVANT(A) si α s'efface
+        memset(prevision, 0, colonnes);
+        int k = 0;
+        for (; k < t->longueur[p]; k++) {
+            int s = t->symboles[t->debut[p] + k];
+            if (EST_TERMINAL(s)) {
+                prevision[t->colonne[(unsigned char)CARACTERE(s)]] = 1;
+                break;
+            }
+            reunir(prevision, &t->premier[s * colonnes], colonnes);
+            if (!t->annulable[s]) break;
+        }
+        if (k == t->longueur[p]) reunir(prevision, &t->suivant[t->gauche[p] * colonnes], colonnes);
+        for (int c = 0; c < colonnes; c++) {
+            if (prevision[c]) ranger(t, p, c);
+        }
+    }
+}
+
+// Construire la table d'une grammaire découpée
+static int completer_table(ContexteGrammaire *ctx, TableLL1 *t) {
+    size_t cases = (size_t)t->nb_non_terminaux * t->nb_colonnes;
+    t->annulable = calloc(t->nb_non_terminaux + 1, 1);
+    t->premier = calloc(cases + 1, 1);
+    t->suivant = calloc(cases + 1, 1);
+    t->entrees = malloc((cases + 1) * sizeof(int));
+    if (!t->annulable || !t->premier || !t->suivant || !t->entrees) {
+        liberer_table_ll1(t);
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    }
+    for (size_t i = 0; i < cases; i++) t->entrees[i] = -1;
+    calculer_ensembles(t);
+    return GRAMMAIRE_OK;
+}
+
+int construire_table_ll1(ContexteGrammaire *ctx, const Grammaire *grammaire, TableLL1 *table) {
+    int statut = decouper(ctx, grammaire, table);
+    if (statut == GRAMMAIRE_OK) statut = completer_table(ctx, table);
+    if (statut == GRAMMAIRE_OK) remplir_table(table);
+    return statut;
+}
+
+void production_ll1(const TableLL1 *table, int p, char *texte, size_t taille) {
+    size_t position = 0;
+    texte[0] = '\0';
+    if (table->longueur[p] == 0) {
+        snprintf(texte, taille, "E");
+        return;
+    }
+    for (int k = 0; k < table->longueur[p] && position < taille; k++) {
+        int s = table->symboles[table->debut[p] + k];
+        int ecrits = EST_TERMINAL(s) ? snprintf(texte + position, taille - position, "%c", CARACTERE(s))
+                                     : snprintf(texte + position, taille - position, "%s", table->noms[s]);
+        position += ecrits;
+    }
+}
+
+void decrire_conflit_ll1(const TableLL1 *table, const ConflitLL1 *conflit, char *texte, size_t taille) {
+    char premiere[MAX_SYMBOLS * MAX_SYMBOLS], seconde[MAX_SYMBOLS * MAX_SYMBOLS];
+    production_ll1(table, conflit->premiere, premiere, sizeof(premiere));
+    production_ll1(table, conflit->seconde, seconde, sizeof(seconde));
+    snprintf(texte, taille, "%s sur %c : %s | %s", table->noms[conflit->non_terminal], conflit->terminal, premiere, seconde);
+}
+
+// Ensemble d'une ligne, écrit "{ a b $ }" ; ε est ajouté pour PREMIER d'un annulable
+static void ecrire_ensemble(FILE *fichier, const TableLL1 *table, const unsigned char *ligne, int epsilon) {
+    fprintf(fichier, "{");
+    for (int c = 0; c < table->nb_colonnes; c++) {
+        if (ligne[c]) fprintf(fichier, " %c", table->colonnes[c]);
+    }
+    fprintf(fichier, "%s }", epsilon ? " E" : "");
+}
+
+// Une ligne par non-terminal, l'axiome en premier : "A t=production ...", LL1_FIN pour la
+// fin du mot. PREMIER et SUIVANT sont en commentaire.
+int ecrire_table_ll1(FILE *fichier, const TableLL1 *table) {
+    if (table->nb_conflits > 0) return GRAMMAIRE_ERREUR_ARGUMENT;
+    fprintf(fichier, "# Table LL(1) : %d non-terminaux, %d productions, terminaux %.*s\n",
+            table->nb_non_terminaux, table->nb_productions, table->nb_colonnes - 1, table->colonnes);
+    char texte[MAX_SYMBOLS * MAX_SYMBOLS];
+    for (int a = 0; a < table->nb_non_terminaux; a++) {
+        fprintf(fichier, "# %s : PREMIER ", table->noms[a]);
+        ecrire_ensemble(fichier, table, &table->premier[a * table->nb_colonnes], table->annulable[a]);
+        fprintf(fichier, " SUIVANT ");
+        ecrire_ensemble(fichier, table, &table->suivant[a * table->nb_colonnes], 0);
+        fprintf(fichier, "\n");
+    }
+    for (int a = 0; a < table->nb_non_terminaux; a++) {
+        fprintf(fichier, "%s", table->noms[a]);
+        for (int c = 0; c < table->nb_colonnes; c++) {
+            int p = table->entrees[a * table->nb_colonnes + c];
+            if (p == -1) continue;
+            production_ll1(table, p, texte, sizeof(texte));
+            fprintf(fichier, " %c=%s", table->colonnes[c], texte);
+        }
+        fprintf(fichier, "\n");
+    }
+    return ferror(fichier) ? GRAMMAIRE_ERREUR_FICHIER : GRAMMAIRE_OK;
+}
+
+// Relire une table écrite par ecrire_table_ll1 : les lignes redonnent une grammaire (les
+// productions distinctes de chaque non-terminal), dont la table est reconstruite puis
+// comparée aux cases lues
+int lire_table_ll1(ContexteGrammaire *ctx, TableLL1 *table, const char *fichier) {
+    memset(table, 0, sizeof(*table));
+    FILE *file = fopen(fichier, "r");
+    if (file == NULL) {
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur lors de l'ouverture du fichier %s : %s",
+                                           fichier, strerror(errno));
+    }
+    Grammaire *grammaire = malloc(sizeof(Grammaire));
+    // Cases lues : (règle, caractère, production dans la règle)
+    int (*cases)[3] = NULL;
+    size_t nb_cases = 0, capacite = 0;
+    char *ligne = NULL;
+    size_t taille_ligne = 0;
+    int statut = grammaire ? GRAMMAIRE_OK : contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    if (grammaire) grammaire->rule_count = 0;
+
+    while (statut == GRAMMAIRE_OK && getline(&ligne, &taille_ligne, file) != -1) {
+        ligne[strcspn(ligne, "\r\n")] = '\0';
+        if (ligne[0] == '\0' || ligne[0] == '#') continue;
+        char *suite;
+        char *mot = strtok_r(ligne, " ", &suite);
+        if (!mot) continue;
+        if (grammaire->rule_count >= MAX_RULES || strlen(mot) >= MAX_SYMBOLS) {
+            statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Table trop grande : %s", fichier);
+            break;
+        }
+        Rule *rule = &grammaire->rules[grammaire->rule_count++];
+        strcpy(rule->non_terminal, mot);
+        rule->production_count = 0;
+        while (statut == GRAMMAIRE_OK && (mot = strtok_r(NULL, " ", &suite)) != NULL) {
+            if (strlen(mot) < 3 || mot[1] != '=' || strlen(mot + 2) >= MAX_SYMBOLS) {
+                statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Case de table mal formée dans %s : %s",
+                                                     fichier, mot);
+                break;
+            }
+            int j = 0;
+            while (j < rule->production_count && strcmp(rule->productions[j], mot + 2) != 0) j++;
+            if (j == rule->production_count) {
+                if (j >= MAX_RULES) {
+                    statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de productions atteinte (%d) pour %s.",
+                                                         MAX_RULES, rule->non_terminal);
+                    break;
+                }
+                strcpy(rule->productions[rule->production_count++], mot + 2);
+            }
+            if (nb_cases == capacite) {
+                capacite = capacite ? capacite * 2 : 64;
+                int (*tab)[3] = realloc(cases, capacite * sizeof(*cases));
+                if (!tab) {
+                    statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+                    break;
+                }
+                cases = tab;
+            }
+            cases[nb_cases][0] = grammaire->rule_count - 1;
+            cases[nb_cases][1] = (unsigned char)mot[0];
+            cases[nb_cases][2] = j;
+            nb_cases++;
+        }
+    }
+    if (statut == GRAMMAIRE_OK && ferror(file)) {
+        statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FICHIER, "Erreur de lecture de %s.", fichier);
+    }
+    free(ligne);
+    fclose(file);
+    // Un fichier vide ou réduit à ses commentaires ne donne aucune ligne de table
+    if (statut == GRAMMAIRE_OK && grammaire->rule_count == 0) {
+        statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "%s ne contient aucune ligne de table LL(1).", fichier);
+    }
+
+    if (statut == GRAMMAIRE_OK) statut = construire_table_ll1(ctx, grammaire, table);
+    // Les cases de la grammaire relue doivent être exactement celles du fichier
+    if (statut == GRAMMAIRE_OK) {
+        size_t occupees = 0;
+        for (size_t i = 0; i < (size_t)table->nb_non_terminaux * table->nb_colonnes; i++) occupees += table->entrees[i] != -1;
+        int conforme = table->nb_conflits == 0 && occupees == nb_cases;
+        for (size_t i = 0; i < nb_cases && conforme; i++) {
+            int a = cases[i][0], colonne = cases[i][1] == LL1_FIN ? table->nb_colonnes - 1 : table->colonne[cases[i][1]];
+            int p = 0;
+            while (table->gauche[p] != a) p++;
+            conforme = colonne != -1 && table->entrees[a * table->nb_colonnes + colonne] == p + cases[i][2];
+        }
+        if (!conforme) {
+            liberer_table_ll1(table);
+            statut = contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "%s n'est pas une table LL(1) cohérente.", fichier);
+        }
+    }
+    free(cases);
+    free(grammaire);
+    return statut;
+}
+
+// Analyse prédictive : la pile garde les symboles à reconnaître, le sommet à la fin. Un
+// non-terminal au sommet est remplacé par la production de la case (sommet, prochain
+// caractère) ; un terminal doit être le prochain caractère. Une table sans conflit vient
+// d'une grammaire sans récursivité gauche : l'analyse se termine, en temps linéaire.
+int reconnaitre_ll1(const TableLL1 *table, const char *mot, size_t longueur, PileAnalyse *pile) {
+    if (table->nb_non_terminaux == 0) return 0;
+    size_t sommet = 0, position = 0;
+    if (pile->capacite == 0) {
+        int *symboles = malloc(64 * sizeof(int));
+        if (!symboles) return -1;
+        pile->symboles = symboles;
+        pile->capacite = 64;
+    }
+    pile->symboles[sommet++] = 0;
+
+    while (sommet > 0) {
+        int s = pile->symboles[--sommet];
+        int c = position < longueur ? (unsigned char)mot[position] : LL1_FIN;
+        if (EST_TERMINAL(s)) {
+            if (position == longueur || CARACTERE(s) != mot[position]) return 0;
+            position++;
+            continue;
+        }
+        int colonne = position < longueur ? table->colonne[c] : table->nb_colonnes - 1;
+        if (colonne == -1) return 0;
+        int p = table->entrees[s * table->nb_colonnes + colonne];
+        if (p == -1) return 0;
+        if (sommet + table->longueur[p] > pile->capacite) {
+            size_t capacite = 2 * (sommet + table->longueur[p]);
+            int *symboles = realloc(pile->symboles, capacite * sizeof(int));
+            if (!symboles) return -1;
+            pile->symboles = symboles;
+            pile->capacite = capacite;
+        }
+        for (int k = table->longueur[p] - 1; k >= 0; k--) pile->symboles[sommet++] = table->symboles[table->debut[p] + k];
+    }
+    return position == longueur;
+}
+
+void liberer_pile_analyse(PileAnalyse *pile) {
+    free(pile->symboles);
+    pile->symboles = NULL;
+    pile->capacite = 0;
+}
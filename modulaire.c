@@ -0,0 +1,703 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "libgrammaire.h"
+
+// Normalisation modulaire, voir libgrammaire.h.
+//
+// Dans une composante C, un non-terminal L d'une composante inférieure est remplacé par
+// L' = L privé de ε : ses occurrences deviennent optionnelles si L est annulable, et
+// disparaissent si L n'engendre que ε. Les non-terminaux sont
+// renommés A0, A1... (membres de C, puis non-terminaux inférieurs dans l'ordre de
+// première apparition) : la clé du mémo ne dépend ni des noms ni du reste de la grammaire.
+// À l'assemblage, les noms d'origine sont rétablis, les nouveaux non-terminaux reçoivent
+// des noms libres, et un non-terminal inférieur resté en tête (Greibach) ou seul
+// (Chomsky) est remplacé par ses productions, déjà assemblées.
+
+#define TERMINAL(c) (-1 - (unsigned char)(c))
+
+typedef struct {
+    const Grammaire *grammaire;
+    int nb;                       // Non-terminaux = règles de la grammaire
+    int axiome;
+
+    // Productions découpées en symboles : indice de règle, ou TERMINAL(c) ; ε est omis
+    int nb_productions;
+    int *gauche, *debut, *longueur;
+    int *symboles;
+
+    bool *generatif;              // Engendre au moins un mot
+    bool *annulable;              // Engendre ε
+    bool *non_vide;               // Engendre un mot non vide
+
+    int *composante;
+    int nb_composantes;
+    int *membres;                 // Membres de chaque composante, axiome en tête
+    int *debut_membres;           // nb_composantes + 1 entrées
+} Analyse;
+
+static void liberer_analyse(Analyse *a) {
+    free(a->gauche);
+    free(a->debut);
+    free(a->longueur);
+    free(a->symboles);
+    free(a->generatif);
+    free(a->annulable);
+    free(a->non_vide);
+    free(a->composante);
+    free(a->membres);
+    free(a->debut_membres);
+}
+
+// Découper les productions ; une production qui cite un non-terminal sans règle
+// n'engendre rien et n'est pas gardée
+static int decouper(ContexteGrammaire *ctx, Analyse *a) {
+    const Grammaire *g = a->grammaire;
+    size_t total = 0;
+    int nb_productions = 0;
+    for (int i = 0; i < g->rule_count; i++) {
+        nb_productions += g->rules[i].production_count;
+        for (int j = 0; j < g->rules[i].production_count; j++) total += strlen(g->rules[i].productions[j]);
+    }
+    a->gauche = malloc((nb_productions + 1) * sizeof(int));
+    a->debut = malloc((nb_productions + 1) * sizeof(int));
+    a->longueur = malloc((nb_productions + 1) * sizeof(int));
+    a->symboles = malloc((total + 1) * sizeof(int));
+    if (!a->gauche || !a->debut || !a->longueur || !a->symboles) {
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    }
+
+    int position = 0;
+    a->nb_productions = 0;
+    for (int i = 0; i < g->rule_count; i++) {
+        for (int j = 0; j < g->rules[i].production_count; j++) {
+            const char *p = g->rules[i].productions[j];
+            int debut = position, morte = 0;
+            for (int k = 0, taille; p[k] != '\0'; k += taille) {
+                int symbole = lire_symbole(g, p + k, &taille);
+                if (symbole == SYMBOLE_INCONNU) morte = 1;
+                else if (symbole != SYMBOLE_EPSILON) a->symboles[position++] = symbole;
+            }
+            if (morte) {
+                position = debut;
+                continue;
+            }
+            a->gauche[a->nb_productions] = i;
+            a->debut[a->nb_productions] = debut;
+            a->longueur[a->nb_productions] = position - debut;
+            a->nb_productions++;
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+
+// Points fixes : génératif, annulable, non vide
+static void calculer_proprietes(Analyse *a) {
+    int change = 1;
+    while (change) {
+        change = 0;
+        for (int p = 0; p < a->nb_productions; p++) {
+            int x = a->gauche[p];
+            bool generatif = true, annulable = true, non_vide = false;
+            for (int k = 0; k < a->longueur[p]; k++) {
+                int s = a->symboles[a->debut[p] + k];
+                if (s < 0) {
+                    annulable = false;
+                    non_vide = true;
+                } else {
+                    generatif = generatif && a->generatif[s];
+                    annulable = annulable && a->annulable[s];
+                    non_vide = non_vide || a->non_vide[s];
+                }
+            }
+            if (generatif && !a->generatif[x]) {
+                a->generatif[x] = true;
+                change = 1;
+            }
+            if (annulable && !a->annulable[x]) {
+                a->annulable[x] = true;
+                change = 1;
+            }
+            if (generatif && non_vide && !a->non_vide[x]) {
+                a->non_vide[x] = true;
+                change = 1;
+            }
+        }
+    }
+}
+
+// Composantes fortement connexes (Tarjan) : une composante reçoit son numéro après
+// toutes celles dont elle dépend, ce qui donne directement l'ordre d'assemblage
+typedef struct {
+    Analyse *a;
+    int compteur;
+    int *indice, *bas, *pile;
+    bool *sur_pile;
+    int hauteur;
+} Tarjan;
+
+static void visiter(Tarjan *t, int x) {
+    Analyse *a = t->a;
+    t->indice[x] = t->bas[x] = t->compteur++;
+    t->pile[t->hauteur++] = x;
+    t->sur_pile[x] = true;
+    for (int p = 0; p < a->nb_productions; p++) {
+        if (a->gauche[p] != x) continue;
+        for (int k = 0; k < a->longueur[p]; k++) {
+            int y = a->symboles[a->debut[p] + k];
+            if (y < 0) continue;
+            if (t->indice[y] < 0) {
+                visiter(t, y);
+                if (t->bas[y] < t->bas[x]) t->bas[x] = t->bas[y];
+            } else if (t->sur_pile[y] && t->indice[y] < t->bas[x]) {
+                t->bas[x] = t->indice[y];
+            }
+        }
+    }
+    if (t->bas[x] == t->indice[x]) {
+        int y;
+        do {
+            y = t->pile[--t->hauteur];
+            t->sur_pile[y] = false;
+            a->composante[y] = a->nb_composantes;
+        } while (y != x);
+        a->nb_composantes++;
+    }
+}
+
+static int calculer_composantes(ContexteGrammaire *ctx, Analyse *a) {
+    Tarjan t = { a, 0, malloc(a->nb * sizeof(int)), malloc(a->nb * sizeof(int)), malloc(a->nb * sizeof(int)),
+                 calloc(a->nb, sizeof(bool)), 0 };
+    a->membres = malloc(a->nb * sizeof(int));
+    a->debut_membres = calloc(a->nb + 1, sizeof(int));
+    if (!t.indice || !t.bas || !t.pile || !t.sur_pile || !a->membres || !a->debut_membres) {
+        free(t.indice);
+        free(t.bas);
+        free(t.pile);
+        free(t.sur_pile);
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    }
+    for (int x = 0; x < a->nb; x++) t.indice[x] = -1;
+    a->nb_composantes = 0;
+    for (int x = 0; x < a->nb; x++) {
+        if (t.indice[x] < 0) visiter(&t, x);
+    }
+    free(t.indice);
+    free(t.bas);
+    free(t.pile);
+    free(t.sur_pile);
+
+    // Membres de chaque composante dans l'ordre de la grammaire, l'axiome d'abord
+    for (int x = 0; x < a->nb; x++) a->debut_membres[a->composante[x] + 1]++;
+    for (int c = 0; c < a->nb_composantes; c++) a->debut_membres[c + 1] += a->debut_membres[c];
+    int *place = malloc(a->nb_composantes * sizeof(int));
+    if (!place) return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    memcpy(place, a->debut_membres, a->nb_composantes * sizeof(int));
+    a->membres[place[a->composante[a->axiome]]++] = a->axiome;
+    for (int x = 0; x < a->nb; x++) {
+        if (x != a->axiome) a->membres[place[a->composante[x]]++] = x;
+    }
+    free(place);
+    return GRAMMAIRE_OK;
+}
+
+// Nom local numéro k : A0, B0... Y0, A1, B1... Les étapes comparent les productions
+// caractère par caractère : des noms voisins doivent commencer par des lettres
+// différentes. E (lu comme ε par certaines étapes) et Z (nouveaux non-terminaux des
+// étapes, de Z9 vers A0) ne sont pas utilisées.
+static const char lettres_locales[] = "ABCDFGHIJKLMNOPQRSTUVWXY";
+#define NB_LETTRES_LOCALES ((int)sizeof(lettres_locales) - 1)
+
+static void nom_local(int k, char *nom) {
+    nom[0] = lettres_locales[k % NB_LETTRES_LOCALES];
+    nom[1] = (char)('0' + k / NB_LETTRES_LOCALES);
+    nom[2] = '\0';
+}
+
+static int numero_local(const char *nom) {
+    const char *lettre = strchr(lettres_locales, nom[0]);
+    if (!lettre || nom[0] == '\0') return -1;
+    return (nom[1] - '0') * NB_LETTRES_LOCALES + (int)(lettre - lettres_locales);
+}
+
+// Une composante préparée : la sous-grammaire avec des noms locaux, et l'indice d'origine
+// de chaque non-terminal inférieur cité (noms locaux nb_membres, nb_membres + 1...)
+typedef struct {
+    Grammaire *grammaire;
+    int nb_membres;
+    int *local;                   // Numéro local de chaque non-terminal, -1 s'il n'est pas cité
+    int *inferieurs;
+    int nb_inferieurs;
+} SousGrammaire;
+
+// Ajouter à `rule` toutes les variantes de la production p à partir du symbole k
+static int developper(ContexteGrammaire *ctx, const Analyse *a, SousGrammaire *s, int c, int p, int k,
+                      char *tampon, int taille, Rule *rule) {
+    if (k == a->longueur[p]) {
+        const char *production = taille == 0 ? "E" : tampon;
+        // X → X n'ajoute rien, et la suppression de la récursivité gauche ne s'en sort pas
+        if (strcmp(production, rule->non_terminal) == 0) return GRAMMAIRE_OK;
+        for (int i = 0; i < rule->production_count; i++) {
+            if (strcmp(rule->productions[i], production) == 0) return GRAMMAIRE_OK;
+        }
+        if (rule->production_count >= MAX_RULES) {
+            return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de productions atteinte (%d) pour %s.",
+                                               MAX_RULES, a->grammaire->rules[a->gauche[p]].non_terminal);
+        }
+        strcpy(rule->productions[rule->production_count++], production);
+        return GRAMMAIRE_OK;
+    }
+    if (taille + 2 >= MAX_SYMBOLS) {
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Production trop longue pour %s.",
+                                           a->grammaire->rules[a->gauche[p]].non_terminal);
+    }
+
+    int symbole = a->symboles[a->debut[p] + k];
+    if (symbole < 0) {
+        tampon[taille] = (char)(-1 - symbole);
+        tampon[taille + 1] = '\0';
+        return developper(ctx, a, s, c, p, k + 1, tampon, taille + 1, rule);
+    }
+    // Un non-terminal inférieur qui n'engendre que ε disparaît ; un non-terminal
+    // improductif reste cité, comme dans les conversions complètes
+    if (a->composante[symbole] == c || a->non_vide[symbole] || !a->annulable[symbole]) {
+        if (s->local[symbole] < 0) {
+            s->local[symbole] = s->nb_membres + s->nb_inferieurs;
+            s->inferieurs[s->nb_inferieurs++] = symbole;
+        }
+        nom_local(s->local[symbole], tampon + taille);
+        if (developper(ctx, a, s, c, p, k + 1, tampon, taille + 2, rule) != GRAMMAIRE_OK) return ctx->erreur;
+    }
+    if (a->composante[symbole] != c && a->annulable[symbole]) {
+        tampon[taille] = '\0';
+        if (developper(ctx, a, s, c, p, k + 1, tampon, taille, rule) != GRAMMAIRE_OK) return ctx->erreur;
+    }
+    return GRAMMAIRE_OK;
+}
+
+static int preparer_composante(ContexteGrammaire *ctx, const Analyse *a, int c, SousGrammaire *s) {
+    s->grammaire = malloc(sizeof(Grammaire));
+    s->local = malloc(a->nb * sizeof(int));
+    s->inferieurs = malloc(a->nb * sizeof(int));
+    if (!s->grammaire || !s->local || !s->inferieurs) {
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    }
+    for (int x = 0; x < a->nb; x++) s->local[x] = -1;
+    s->nb_membres = a->debut_membres[c + 1] - a->debut_membres[c];
+    s->nb_inferieurs = 0;
+    for (int m = 0; m < s->nb_membres; m++) s->local[a->membres[a->debut_membres[c] + m]] = m;
+
+    s->grammaire->rule_count = s->nb_membres;
+    for (int m = 0; m < s->nb_membres; m++) {
+        int x = a->membres[a->debut_membres[c] + m];
+        Rule *rule = &s->grammaire->rules[m];
+        nom_local(m, rule->non_terminal);
+        rule->production_count = 0;
+        for (int p = 0; p < a->nb_productions; p++) {
+            if (a->gauche[p] != x) continue;
+            char tampon[MAX_SYMBOLS] = "";
+            if (developper(ctx, a, s, c, p, 0, tampon, 0, rule) != GRAMMAIRE_OK) return ctx->erreur;
+        }
+    }
+    return GRAMMAIRE_OK;
+}
+
+static void liberer_sous_grammaire(SousGrammaire *s) {
+    free(s->grammaire);
+    free(s->local);
+    free(s->inferieurs);
+}
+
+// Texte d'une grammaire au format d'ecrire_grammaire, précédé d'un en-tête
+static char *ecrire_texte(const char *entete, const Grammaire *grammaire) {
+    char *texte = NULL;
+    size_t taille = 0;
+    FILE *flux = open_memstream(&texte, &taille);
+    if (!flux) return NULL;
+    fputs(entete, flux);
+    int statut = ecrire_grammaire(flux, grammaire);
+    if (fclose(flux) != 0 || statut != GRAMMAIRE_OK) {
+        free(texte);
+        return NULL;
+    }
+    return texte;
+}
+
+// Relire un texte écrit par ecrire_grammaire (sans limite de longueur de ligne)
+static int lire_texte(ContexteGrammaire *ctx, const char *texte, Grammaire *grammaire) {
+    grammaire->rule_count = 0;
+    char *copie = strdup(texte);
+    if (!copie) return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+
+    char *suite_ligne;
+    for (char *ligne = strtok_r(copie, "\n", &suite_ligne); ligne; ligne = strtok_r(NULL, "\n", &suite_ligne)) {
+        nettoyer_chaine(ligne);
+        if (ligne[0] == '\0') continue;
+        char *deux_points = strchr(ligne, ':');
+        if (!deux_points || deux_points - ligne >= MAX_SYMBOLS || grammaire->rule_count >= MAX_RULES) {
+            free(copie);
+            return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_FORMAT, "Composante mal formée : %.40s", ligne);
+        }
+        *deux_points = '\0';
+        Rule *rule = &grammaire->rules[grammaire->rule_count++];
+        strcpy(rule->non_terminal, ligne);
+        rule->production_count = 0;
+
+        char *suite;
+        for (char *p = strtok_r(deux_points + 1, "|", &suite); p; p = strtok_r(NULL, "|", &suite)) {
+            if (rule->production_count >= MAX_RULES || strlen(p) >= MAX_SYMBOLS) {
+                free(copie);
+                return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Composante trop grande pour %s.",
+                                                   rule->non_terminal);
+            }
+            strcpy(rule->productions[rule->production_count++], p);
+        }
+    }
+    free(copie);
+    return GRAMMAIRE_OK;
+}
+
+// Normaliser une composante : renvoie son résultat (noms locaux), pris dans le mémo si possible
+static char *normaliser_composante(ContexteGrammaire *ctx, const Analyse *a, int c, FormeNormale forme,
+                                   const MemoComposantes *memo, SousGrammaire *s, int *recalculee) {
+    *recalculee = 0;
+    if (preparer_composante(ctx, a, c, s) != GRAMMAIRE_OK) return NULL;
+
+    char entete[64];
+    snprintf(entete, sizeof(entete), "composante %s %s\n", LIBGRAMMAIRE_VERSION,
+             forme == FORME_GREIBACH ? "greibach" : "chomsky");
+    char *cle = ecrire_texte(entete, s->grammaire);
+    if (!cle) {
+        contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+        return NULL;
+    }
+    char *resultat = memo && memo->chercher ? memo->chercher(memo->donnees, cle) : NULL;
+    if (resultat) {
+        TRACER(ctx, TRACE_RESUME, TRACE_ETAPES, "composante %d : reprise du mémo", c);
+        free(cle);
+        return resultat;
+    }
+
+    // Toutes les étapes sauf le regroupement, qui renommerait des membres cités ailleurs
+    const EtapeConversion *etapes;
+    int nb_etapes = etapes_conversion(forme, &etapes);
+    ContexteGrammaire local;
+    contexte_grammaire_init(&local);
+    if (executer_etapes(&local, s->grammaire, "A0", forme, 0, nb_etapes - 1) != GRAMMAIRE_OK) {
+        contexte_grammaire_signaler(ctx, local.erreur, "%s", local.message);
+        free(cle);
+        return NULL;
+    }
+    resultat = ecrire_texte("", s->grammaire);
+    if (!resultat) {
+        contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    } else {
+        *recalculee = 1;
+        TRACER(ctx, TRACE_RESUME, TRACE_ETAPES, "composante %d : recalculée (%d nouveaux non-terminaux)",
+               c, local.non_terminaux_generes);
+        if (memo && memo->ranger) memo->ranger(memo->donnees, cle, resultat);
+    }
+    free(cle);
+    return resultat;
+}
+
+// Les composantes sont prises dans l'ordre par un groupe de threads, comme les lots de
+// fichiers de grammaire.c ; chaque thread garde la sous-grammaire préparée
+typedef struct {
+    const Analyse *analyse;
+    FormeNormale forme;
+    const MemoComposantes *memo;
+    atomic_int prochaine;
+    atomic_int echec;
+    atomic_int recalculees;
+    char **resultats;
+    SousGrammaire *sous;
+    ContexteGrammaire *ctx;
+    pthread_mutex_t verrou;
+} TravailComposantes;
+
+static void *travailleur_composantes(void *argument) {
+    TravailComposantes *travail = argument;
+    for (;;) {
+        int c = atomic_fetch_add(&travail->prochaine, 1);
+        if (c >= travail->analyse->nb_composantes || atomic_load(&travail->echec)) break;
+        ContexteGrammaire local;
+        contexte_grammaire_init(&local);
+        // Les étapes d'une composante ne sont pas tracées : leurs noms sont locaux
+        local.trace = travail->ctx->trace;
+        int recalculee;
+        SousGrammaire *s = &travail->sous[c];
+        travail->resultats[c] = normaliser_composante(&local, travail->analyse, c, travail->forme, travail->memo,
+                                                      s, &recalculee);
+        // La sous-grammaire n'est plus utile : seuls les numéros locaux servent à l'assemblage
+        free(s->grammaire);
+        s->grammaire = NULL;
+        if (!travail->resultats[c]) {
+            atomic_store(&travail->echec, 1);
+            pthread_mutex_lock(&travail->verrou);
+            contexte_grammaire_signaler(travail->ctx, local.erreur, "%s", local.message);
+            pthread_mutex_unlock(&travail->verrou);
+        }
+        atomic_fetch_add(&travail->recalculees, recalculee);
+    }
+    return NULL;
+}
+
+// Noms des nouveaux non-terminaux de l'assemblage : de Z9 vers A0 comme
+// generate_non_terminal, sans la lettre E et sans les noms de la grammaire d'origine
+typedef struct {
+    bool pris[26 * 10];
+    int suivant;
+} NomsLibres;
+
+static int nom_libre(ContexteGrammaire *ctx, NomsLibres *noms, char *nom) {
+    while (noms->suivant >= 0) {
+        int n = noms->suivant--;
+        if (n / 10 == 'E' - 'A' || noms->pris[n]) continue;
+        noms->pris[n] = true;
+        ctx->non_terminaux_generes++;
+        nom[0] = (char)('A' + n / 10);
+        nom[1] = (char)('0' + n % 10);
+        nom[2] = '\0';
+        TRACER(ctx, TRACE_DETAIL, TRACE_ALLOCATION, "allocation %s", nom);
+        return GRAMMAIRE_OK;
+    }
+    return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_NON_TERMINAUX, "Limite de non-terminaux atteinte (A0 à Z9 épuisés).");
+}
+
+static int regle_par_nom(const Grammaire *grammaire, const char *nom) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        if (strcmp(grammaire->rules[i].non_terminal, nom) == 0) return i;
+    }
+    return -1;
+}
+
+static int ajouter_production_bornee(ContexteGrammaire *ctx, Rule *rule, const char *production) {
+    for (int i = 0; i < rule->production_count; i++) {
+        if (strcmp(rule->productions[i], production) == 0) return GRAMMAIRE_OK;
+    }
+    if (rule->production_count >= MAX_RULES) {
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de productions atteinte (%d) pour %s.",
+                                           MAX_RULES, rule->non_terminal);
+    }
+    strcpy(rule->productions[rule->production_count++], production);
+    return GRAMMAIRE_OK;
+}
+
+// Nom global d'un nom local de la composante c ; un nouveau non-terminal reçoit un nom
+// libre à sa première apparition. Renvoie NULL si les noms sont épuisés.
+static const char *nom_global(ContexteGrammaire *ctx, const Analyse *a, int c, const SousGrammaire *s,
+                              char (*nouveaux)[3], NomsLibres *noms, const char *nom) {
+    int n = numero_local(nom);
+    if (n >= 0 && n < s->nb_membres) return a->grammaire->rules[a->membres[a->debut_membres[c] + n]].non_terminal;
+    if (n >= 0 && n < s->nb_membres + s->nb_inferieurs) {
+        return a->grammaire->rules[s->inferieurs[n - s->nb_membres]].non_terminal;
+    }
+    int i = (nom[0] - 'A') * 10 + (nom[1] - '0');
+    if (nouveaux[i][0] == '\0' && nom_libre(ctx, noms, nouveaux[i]) != GRAMMAIRE_OK) return NULL;
+    return nouveaux[i];
+}
+
+// Assembler le résultat de la composante c dans sortie
+static int assembler_composante(ContexteGrammaire *ctx, const Analyse *a, int c, FormeNormale forme,
+                                const SousGrammaire *s, const Grammaire *locale, NomsLibres *noms,
+                                Grammaire *sortie) {
+    const Grammaire *g = a->grammaire;
+    char nouveaux[26 * 10][3];    // Nom global de chaque nouveau non-terminal local
+    memset(nouveaux, 0, sizeof(nouveaux));
+
+    for (int i = 0; i < locale->rule_count; i++) {
+        const Rule *rule = &locale->rules[i];
+        int n = numero_local(rule->non_terminal);
+        if (!isNonTerminal(rule->non_terminal) ||
+            (n >= s->nb_membres && n < s->nb_membres + s->nb_inferieurs)) {
+            return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_NON_TERMINAUX,
+                                               "Nom de non-terminal en conflit dans une composante : %s", rule->non_terminal);
+        }
+        // Seul l'axiome de la grammaire garde ε : ailleurs, ε est porté par les productions
+        // des composantes supérieures
+        bool garde_epsilon = n == 0 && a->membres[a->debut_membres[c]] == a->axiome;
+
+        Rule assemblee;
+        const char *gauche = nom_global(ctx, a, c, s, nouveaux, noms, rule->non_terminal);
+        if (!gauche) return ctx->erreur;
+        strcpy(assemblee.non_terminal, gauche);
+        assemblee.production_count = 0;
+
+        for (int j = 0; j < rule->production_count; j++) {
+            const char *p = rule->productions[j];
+            if (strcmp(p, "E") == 0) {
+                if (garde_epsilon && ajouter_production_bornee(ctx, &assemblee, "E") != GRAMMAIRE_OK) return ctx->erreur;
+                continue;
+            }
+
+            // Traduire les noms ; repérer un non-terminal inférieur en tête
+            char traduite[MAX_SYMBOLS] = "";
+            int inferieur_en_tete = -1, nb_symboles = 0, debut_suite = 0;
+            for (int k = 0; p[k] != '\0';) {
+                char symbole[MAX_SYMBOLS];
+                if (isupper(p[k]) && isdigit(p[k + 1])) {
+                    char nom[3] = { p[k], p[k + 1], '\0' };
+                    int m = numero_local(nom);
+                    if (nb_symboles == 0 && m >= s->nb_membres && m < s->nb_membres + s->nb_inferieurs) {
+                        inferieur_en_tete = s->inferieurs[m - s->nb_membres];
+                    }
+                    const char *global = nom_global(ctx, a, c, s, nouveaux, noms, nom);
+                    if (!global) return ctx->erreur;
+                    snprintf(symbole, sizeof(symbole), "%s", global);
+                    k += 2;
+                } else {
+                    symbole[0] = p[k];
+                    symbole[1] = '\0';
+                    k++;
+                }
+                if (strlen(traduite) + strlen(symbole) >= MAX_SYMBOLS) {
+                    return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Production trop longue pour %s.", gauche);
+                }
+                strcat(traduite, symbole);
+                if (nb_symboles++ == 0) debut_suite = strlen(traduite);
+            }
+
+            // Greibach : un non-terminal inférieur en tête est remplacé par ses productions ;
+            // Chomsky : seulement s'il est seul (règle unité)
+            bool substituer = inferieur_en_tete >= 0 && (forme == FORME_GREIBACH || nb_symboles == 1);
+            if (!substituer) {
+                if (ajouter_production_bornee(ctx, &assemblee, traduite) != GRAMMAIRE_OK) return ctx->erreur;
+                continue;
+            }
+            int r = regle_par_nom(sortie, g->rules[inferieur_en_tete].non_terminal);
+            if (r < 0) continue;
+            const Rule *inferieure = &sortie->rules[r];
+            for (int m = 0; m < inferieure->production_count; m++) {
+                if (strcmp(inferieure->productions[m], "E") == 0) continue;
+                char production[MAX_SYMBOLS];
+                size_t l = strlen(inferieure->productions[m]);
+                if (l + strlen(traduite + debut_suite) >= MAX_SYMBOLS) {
+                    return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Production trop longue pour %s.", gauche);
+                }
+                memcpy(production, inferieure->productions[m], l);
+                strcpy(production + l, traduite + debut_suite);
+                if (ajouter_production_bornee(ctx, &assemblee, production) != GRAMMAIRE_OK) return ctx->erreur;
+            }
+        }
+
+        if (assemblee.production_count == 0 && !garde_epsilon) continue;
+        if (sortie->rule_count >= MAX_RULES) {
+            return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_LIMITE, "Limite de règles atteinte (%d), impossible d'ajouter %s.",
+                                               MAX_RULES, assemblee.non_terminal);
+        }
+        sortie->rules[sortie->rule_count++] = assemblee;
+    }
+    return GRAMMAIRE_OK;
+}
+
+int normaliser_modulaire(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome, FormeNormale forme,
+                         const MemoComposantes *memo, int nb_threads, BilanModulaire *bilan) {
+    double depart = ctx->mesure ? horloge_grammaire() : 0;
+    int generes = ctx->non_terminaux_generes;
+    Analyse a;
+    memset(&a, 0, sizeof(a));
+    a.grammaire = grammaire;
+    a.nb = grammaire->rule_count;
+    a.axiome = regle_par_nom(grammaire, axiome);
+    if (a.axiome < 0) {
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_ARGUMENT, "Axiome %s sans règle.", axiome);
+    }
+    a.generatif = calloc(a.nb, sizeof(bool));
+    a.annulable = calloc(a.nb, sizeof(bool));
+    a.non_vide = calloc(a.nb, sizeof(bool));
+    a.composante = malloc(a.nb * sizeof(int));
+    if (!a.generatif || !a.annulable || !a.non_vide || !a.composante) {
+        liberer_analyse(&a);
+        return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    }
+    if (decouper(ctx, &a) != GRAMMAIRE_OK || (calculer_proprietes(&a), calculer_composantes(ctx, &a)) != GRAMMAIRE_OK) {
+        liberer_analyse(&a);
+        return ctx->erreur;
+    }
+
+    TravailComposantes travail;
+    travail.analyse = &a;
+    travail.forme = forme;
+    travail.memo = memo;
+    atomic_init(&travail.prochaine, 0);
+    atomic_init(&travail.echec, 0);
+    atomic_init(&travail.recalculees, 0);
+    travail.resultats = calloc(a.nb_composantes, sizeof(char *));
+    travail.sous = calloc(a.nb_composantes, sizeof(SousGrammaire));
+    travail.ctx = ctx;
+    pthread_mutex_init(&travail.verrou, NULL);
+    Grammaire *copies = malloc(2 * sizeof(Grammaire));
+    if (!travail.resultats || !travail.sous || !copies) {
+        contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+        goto fin;
+    }
+
+    if (nb_threads > a.nb_composantes) nb_threads = a.nb_composantes;
+    pthread_t *threads = malloc((nb_threads > 1 ? nb_threads - 1 : 1) * sizeof(pthread_t));
+    int lances = 0;
+    if (threads) {
+        for (; lances < nb_threads - 1; lances++) {
+            if (pthread_create(&threads[lances], NULL, travailleur_composantes, &travail) != 0) break;
+        }
+    }
+    // Le thread appelant travaille aussi
+    travailleur_composantes(&travail);
+    for (int i = 0; i < lances; i++) pthread_join(threads[i], NULL);
+    free(threads);
+    if (atomic_load(&travail.echec)) goto fin;
+
+    // Assemblage dans l'ordre des dépendances
+    Grammaire *sortie = &copies[0], *locale = &copies[1];
+    sortie->rule_count = 0;
+    NomsLibres noms;
+    memset(&noms, 0, sizeof(noms));
+    noms.suivant = 26 * 10 - 1;
+    for (int x = 0; x < a.nb; x++) {
+        const char *nom = grammaire->rules[x].non_terminal;
+        if (isNonTerminal(nom)) noms.pris[(nom[0] - 'A') * 10 + (nom[1] - '0')] = true;
+    }
+    for (int c = 0; c < a.nb_composantes; c++) {
+        if (lire_texte(ctx, travail.resultats[c], locale) != GRAMMAIRE_OK ||
+            assembler_composante(ctx, &a, c, forme, &travail.sous[c], locale, &noms, sortie) != GRAMMAIRE_OK) {
+            goto fin;
+        }
+    }
+    // L'axiome en tête, comme dans les conversions complètes
+    int r = regle_par_nom(sortie, axiome);
+    if (r > 0) {
+        Rule regle_axiome = sortie->rules[r];
+        memmove(&sortie->rules[1], &sortie->rules[0], r * sizeof(Rule));
+        sortie->rules[0] = regle_axiome;
+    }
+    *grammaire = *sortie;
+    // Les nouveaux non-terminaux comptés sont ceux de la grammaire assemblée
+    const EtapeConversion *etapes;
+    int nb_etapes = etapes_conversion(forme, &etapes);
+    contexte_grammaire_mesurer(ctx, "Assemblage des composantes", nb_etapes - 1, depart, generes, grammaire);
+    TRACER(ctx, TRACE_RESUME, TRACE_ALLOCATION, "allocation étape %d : %d nouveaux non-terminaux",
+           nb_etapes - 1, ctx->non_terminaux_generes - generes);
+    contexte_grammaire_tracer_etape(ctx, nb_etapes - 1, "Assemblage des composantes", grammaire);
+    if (ctx->journal) ctx->journal(ctx->donnees_journal, "Assemblage des composantes", grammaire);
+
+    executer_etapes(ctx, grammaire, axiome, forme, nb_etapes - 1, nb_etapes);
+    if (bilan) {
+        bilan->composantes = a.nb_composantes;
+        bilan->recalculees = atomic_load(&travail.recalculees);
+    }
+
+fin:
+    for (int c = 0; travail.resultats && c < a.nb_composantes; c++) free(travail.resultats[c]);
+    for (int c = 0; travail.sous && c < a.nb_composantes; c++) liberer_sous_grammaire(&travail.sous[c]);
+    free(travail.resultats);
+    free(travail.sous);
+    free(copies);
+    pthread_mutex_destroy(&travail.verrou);
+    liberer_analyse(&a);
+    return ctx->erreur;
+}
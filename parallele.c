@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "generate_words.h"
+
+// Énumération parallèle : l'arbre de dérivation est découpé en tâches (une forme
+// sententielle et la profondeur restante), réparties sur des files à vol de travail.
+// Chaque thread accumule ses mots dans son propre tampon (déversé sur disque au-delà du
+// budget, voir tri_externe.c), trié en fin de parcours ; tri_externe_ecrire fusionne ensuite
+// les tampons : la sortie est identique à celle du parcours séquentiel.
+
+#define TACHES_PAR_THREAD 8        // Taille visée de la frontière initiale, par thread
+#define PROFONDEUR_DECOUPE_MIN 4   // Une tâche moins profonde n'est plus découpée
+
+typedef struct {
+    char forme[MAX_WORD_LEN];
+    int profondeur;
+} TacheDFS;
+
+typedef struct {
+    TacheDFS *taches;
+    size_t debut;   // Côté vol (tâches les plus anciennes, donc les plus grosses)
+    size_t fin;     // Côté propriétaire
+    size_t capacite;
+    pthread_mutex_t verrou;
+} DequeTaches;
+
+typedef struct Pool Pool;
+
+typedef struct {
+    Pool *pool;
+    int id;
+    unsigned graine;
+    DequeTaches deque;
+    ListeMots *mots;
+    int erreur;
+} Travailleur;
+
+struct Pool {
+    Grammaire *grammaire;
+    TriExterne *tri;
+    int longueur_max;
+    int nb_threads;
+    Travailleur *travailleurs;
+    atomic_long taches_restantes;  // Tâches poussées et pas encore terminées
+    atomic_int inactifs;           // Threads à la recherche de travail
+    pthread_mutex_t verrou_attente;
+    pthread_cond_t cond_attente;
+};
+
+static int deque_pousser(DequeTaches *deque, const TacheDFS *tache) {
+    pthread_mutex_lock(&deque->verrou);
+    if (deque->debut == deque->fin) {
+        deque->debut = deque->fin = 0;
+    }
+    if (deque->fin == deque->capacite) {
+        size_t capacite = deque->capacite ? deque->capacite * 2 : 64;
+        TacheDFS *taches = realloc(deque->taches, capacite * sizeof(TacheDFS));
+        if (!taches) {
+            pthread_mutex_unlock(&deque->verrou);
+            return -1;
+        }
+        deque->taches = taches;
+        deque->capacite = capacite;
+    }
+    deque->taches[deque->fin++] = *tache;
+    pthread_mutex_unlock(&deque->verrou);
+    return 0;
+}
+
+// Le propriétaire dépile par la fin (parcours en profondeur, bonne localité)
+static int deque_prendre(DequeTaches *deque, TacheDFS *tache) {
+    int trouve = 0;
+    pthread_mutex_lock(&deque->verrou);
+    if (deque->fin > deque->debut) {
+        *tache = deque->taches[--deque->fin];
+        trouve = 1;
+    }
+    pthread_mutex_unlock(&deque->verrou);
+    return trouve;
+}
+
+// Les voleurs prennent par le début (les sous-arbres les plus gros)
+static int deque_voler(DequeTaches *deque, TacheDFS *tache) {
+    int trouve = 0;
+    if (pthread_mutex_trylock(&deque->verrou) != 0) return 0;
+    if (deque->fin > deque->debut) {
+        *tache = deque->taches[deque->debut++];
+        trouve = 1;
+    }
+    pthread_mutex_unlock(&deque->verrou);
+    return trouve;
+}
+
+// Développer une forme d'un niveau, avec la même sémantique que generer_mots_recursif :
+// ajoute le mot si la forme est terminale, sinon remplit enfants (au plus MAX_RULES).
+static int developper_forme(const TacheDFS *tache, Grammaire *grammaire, int longueur_max, TriExterne *tri,
+                            ListeMots *mots, TacheDFS *enfants, int *nb_enfants) {
+    *nb_enfants = 0;
+    if (tache->profondeur < 0) {
+        COMPTER(tri->compteurs, elaguees_profondeur);
+        return 0;
+    }
+
+    int nombre_de_symboles = 0;
+    char **symboles = decomposer_mot(tache->forme, &nombre_de_symboles);
+    int statut = 0;
+
+    int premier_non_terminal = -1;
+    for (int i = 0; i < nombre_de_symboles; i++) {
+        if (!est_terminal(symboles[i])) {
+            premier_non_terminal = i;
+            break;
+        }
+    }
+
+    if (premier_non_terminal == -1) {
+        size_t longueur = strlen(tache->forme);
+        if (longueur <= (size_t)longueur_max) {
+            statut = tri_externe_ajouter(tri, mots, tache->forme, longueur);
+        } else {
+            COMPTER(tri->compteurs, elaguees_longueur);
+        }
+    } else if (tache->profondeur > 0) {
+        COMPTER(tri->compteurs, formes);
+        char productions[MAX_RULES][MAX_SYMBOLS];
+        int production_count = trouver_productions(symboles[premier_non_terminal], grammaire, productions);
+        size_t len_prefixe = 0;
+        for (int k = 0; k < premier_non_terminal; k++) len_prefixe += strlen(symboles[k]);
+        const char *suite = tache->forme + len_prefixe + strlen(symboles[premier_non_terminal]);
+
+        for (int j = 0; j < production_count; j++) {
+            if (len_prefixe + strlen(productions[j]) + strlen(suite) >= MAX_WORD_LEN) {
+                COMPTER(tri->compteurs, elaguees_longueur);
+                continue;
+            }
+            TacheDFS *enfant = &enfants[(*nb_enfants)++];
+            memcpy(enfant->forme, tache->forme, len_prefixe);
+            enfant->forme[len_prefixe] = '\0';
+            strcat(enfant->forme, productions[j]);
+            strcat(enfant->forme, suite);
+            enfant->profondeur = tache->profondeur - 1;
+        }
+    }
+
+    for (int i = 0; i < nombre_de_symboles; i++) free(symboles[i]);
+    free(symboles);
+    return statut;
+}
+
+static void signaler_travail(Pool *pool) {
+    pthread_mutex_lock(&pool->verrou_attente);
+    pthread_cond_broadcast(&pool->cond_attente);
+    pthread_mutex_unlock(&pool->verrou_attente);
+}
+
+// Parcours en profondeur d'une tâche ; tant qu'un thread est inactif, les sous-arbres
+// assez profonds sont publiés dans la file locale au lieu d'être parcourus ici.
+static void explorer(Travailleur *w, const TacheDFS *tache) {
+    Pool *pool = w->pool;
+
+    if (tache->profondeur < PROFONDEUR_DECOUPE_MIN || atomic_load(&pool->inactifs) == 0) {
+        generer_mots_recursif(tache->forme, pool->longueur_max, pool->grammaire, tache->profondeur, pool->tri, w->mots);
+        return;
+    }
+
+    TacheDFS *enfants = malloc(MAX_RULES * sizeof(TacheDFS));
+    int nb_enfants = 0;
+    if (!enfants || developper_forme(tache, pool->grammaire, pool->longueur_max, pool->tri, w->mots, enfants, &nb_enfants) == -1) {
+        w->erreur = 1;
+        free(enfants);
+        return;
+    }
+
+    // Publier tous les enfants sauf le premier, parcouru directement
+    int publies = 0;
+    for (int j = 1; j < nb_enfants; j++) {
+        atomic_fetch_add(&pool->taches_restantes, 1);
+        if (deque_pousser(&w->deque, &enfants[j]) == -1) {
+            atomic_fetch_sub(&pool->taches_restantes, 1);
+            explorer(w, &enfants[j]);
+        } else {
+            publies++;
+        }
+    }
+    if (publies > 0) signaler_travail(pool);
+    if (nb_enfants > 0) explorer(w, &enfants[0]);
+    free(enfants);
+}
+
+static void *boucle_travailleur(void *argument) {
+    Travailleur *w = argument;
+    Pool *pool = w->pool;
+    TacheDFS tache;
+
+    for (;;) {
+        int trouve = deque_prendre(&w->deque, &tache);
+        for (int essai = 0; !trouve && essai < pool->nb_threads - 1; essai++) {
+            int victime = rand_r(&w->graine) % pool->nb_threads;
+            if (victime != w->id) trouve = deque_voler(&pool->travailleurs[victime].deque, &tache);
+        }
+
+        if (trouve) {
+            explorer(w, &tache);
+            if (atomic_fetch_sub(&pool->taches_restantes, 1) == 1) signaler_travail(pool);
+            continue;
+        }
+        if (atomic_load(&pool->taches_restantes) == 0) break;
+
+        // Rien à voler pour l'instant : attendre qu'un autre thread publie du travail
+        atomic_fetch_add(&pool->inactifs, 1);
+        struct timespec echeance;
+        clock_gettime(CLOCK_REALTIME, &echeance);
+        echeance.tv_nsec += 200000;
+        if (echeance.tv_nsec >= 1000000000L) {
+            echeance.tv_sec++;
+            echeance.tv_nsec -= 1000000000L;
+        }
+        pthread_mutex_lock(&pool->verrou_attente);
+        if (atomic_load(&pool->taches_restantes) > 0) {
+            pthread_cond_timedwait(&pool->cond_attente, &pool->verrou_attente, &echeance);
+        }
+        pthread_mutex_unlock(&pool->verrou_attente);
+        atomic_fetch_sub(&pool->inactifs, 1);
+    }
+
+    // Chaque thread trie son propre tampon avant la fusion
+    if (tri_externe_trier(pool->tri, w->mots) == -1) w->erreur = 1;
+    return NULL;
+}
+
+// Générer les mots avec nb_threads threads dans nb_threads + 1 tampons : tampons[0], qui
+// peut déjà contenir des mots (par exemple "E"), reçoit ceux du découpage initial, et
+// tampons[i + 1] ceux du thread i, trié. Les mots restent à fusionner (tri_externe_ecrire).
+int generer_mots_parallele(Grammaire *grammaire, int longueur_max, int nb_threads, TriExterne *tri, ListeMots *tampons) {
+    int statut = 0;
+
+    // Frontière initiale : développement en largeur depuis l'axiome
+    size_t cible = (size_t)nb_threads * TACHES_PAR_THREAD;
+    size_t nb_frontiere = 1;
+    TacheDFS *frontiere = malloc(sizeof(TacheDFS));
+    TacheDFS *enfants = malloc(MAX_RULES * sizeof(TacheDFS));
+    if (!frontiere || !enfants) {
+        free(frontiere);
+        free(enfants);
+        return -1;
+    }
+    snprintf(frontiere[0].forme, MAX_WORD_LEN, "%s", grammaire->rules[0].non_terminal);
+    frontiere[0].profondeur = longueur_max * 2;
+
+    while (nb_frontiere > 0 && nb_frontiere < cible && statut == 0) {
+        TacheDFS *suivante = NULL;
+        size_t nb_suivante = 0, cap_suivante = 0;
+        for (size_t t = 0; t < nb_frontiere && statut == 0; t++) {
+            int nb_enfants;
+            statut = developper_forme(&frontiere[t], grammaire, longueur_max, tri, &tampons[0], enfants, &nb_enfants);
+            if (nb_suivante + nb_enfants > cap_suivante) {
+                cap_suivante = (nb_suivante + nb_enfants) * 2;
+                TacheDFS *tab = realloc(suivante, cap_suivante * sizeof(TacheDFS));
+                if (!tab) {
+                    statut = -1;
+                    break;
+                }
+                suivante = tab;
+            }
+            memcpy(suivante + nb_suivante, enfants, nb_enfants * sizeof(TacheDFS));
+            nb_suivante += nb_enfants;
+        }
+        free(frontiere);
+        frontiere = suivante;
+        nb_frontiere = nb_suivante;
+    }
+    free(enfants);
+
+    Pool pool;
+    pool.grammaire = grammaire;
+    pool.tri = tri;
+    pool.longueur_max = longueur_max;
+    pool.nb_threads = nb_threads;
+    atomic_init(&pool.taches_restantes, (long)nb_frontiere);
+    atomic_init(&pool.inactifs, 0);
+    pthread_mutex_init(&pool.verrou_attente, NULL);
+    pthread_cond_init(&pool.cond_attente, NULL);
+    pool.travailleurs = calloc(nb_threads, sizeof(Travailleur));
+    if (!pool.travailleurs) statut = -1;
+
+    pthread_t *threads = malloc(nb_threads * sizeof(pthread_t));
+    if (!threads) statut = -1;
+
+    if (statut == 0) {
+        for (int i = 0; i < nb_threads; i++) {
+            Travailleur *w = &pool.travailleurs[i];
+            w->pool = &pool;
+            w->id = i;
+            w->graine = 0x9E3779B9u * (i + 1);
+            pthread_mutex_init(&w->deque.verrou, NULL);
+            w->mots = &tampons[i + 1];
+        }
+        // Répartition circulaire de la frontière
+        for (size_t t = 0; t < nb_frontiere && statut == 0; t++) {
+            statut = deque_pousser(&pool.travailleurs[t % nb_threads].deque, &frontiere[t]);
+        }
+    }
+
+    int lances = 0;
+    if (statut == 0) {
+        // Pile plus grande que par défaut : generer_mots_recursif alloue ~10 Ko par niveau
+        pthread_attr_t attributs;
+        pthread_attr_init(&attributs);
+        pthread_attr_setstacksize(&attributs, 64 * 1024 * 1024);
+        for (; lances < nb_threads; lances++) {
+            int erreur = pthread_create(&threads[lances], &attributs, boucle_travailleur, &pool.travailleurs[lances]);
+            if (erreur != 0) {
+                fprintf(stderr, "Erreur : création de thread impossible : %s\n", strerror(erreur));
+                statut = -1;
+                break;
+            }
+        }
+        pthread_attr_destroy(&attributs);
+        // Si un thread n'a pas pu être lancé, ceux qui tournent terminent quand même tout le travail
+        if (lances == 0) statut = -1;
+    }
+    for (int i = 0; i < lances; i++) {
+        pthread_join(threads[i], NULL);
+        if (pool.travailleurs[i].erreur) statut = -1;
+    }
+    if (lances > 0 && lances < nb_threads) statut = -1;
+
+    if (pool.travailleurs) {
+        for (int i = 0; i < nb_threads; i++) {
+            if (pool.travailleurs[i].pool) {
+                free(pool.travailleurs[i].deque.taches);
+                pthread_mutex_destroy(&pool.travailleurs[i].deque.verrou);
+            }
+        }
+    }
+    free(pool.travailleurs);
+    free(threads);
+    free(frontiere);
+    pthread_mutex_destroy(&pool.verrou_attente);
+    pthread_cond_destroy(&pool.cond_attente);
+    return statut;
+}
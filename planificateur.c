@@ -0,0 +1,291 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "generate_words.h"
+
+// Planificateur de generer_mots. La sortie est toujours la même : les mots de longueur
+// <= n triés, chacun écrit autant de fois qu'il a de dérivations. Plusieurs moteurs la
+// produisent, chacun sous ses conditions :
+//   fini      langage fini (fini.c) : les mots sont déjà calculés, avec leurs dérivations ;
+//   automate  grammaire régulière non ambiguë jusqu'à n : parcours de l'automate minimal ;
+//   longueur  comptage des dérivations par longueur (CurseurLex, rang.c) : chaque mot
+//             distinct une fois, écrit autant de fois qu'il a de dérivations ;
+//   dfs       développement récursif des formes sententielles, toujours applicable.
+// Les trois premiers demandent des dérivations bornées (derivations_completes). Le
+// planificateur analyse la grammaire (comptage exact des dérivations par longueur, cycles
+// entre non-terminaux, automate et ambiguïté), estime le coût de chaque moteur applicable
+// et retient le moins cher. Coûts, en opérations sur des lettres, pour L lignes de sortie,
+// D mots distincts et n = longueur_max :
+//   fini L ; automate L·n ; longueur n²·|G| + D·n + L ; dfs au moins L·n², car chacune des
+//   2n - 1 étapes d'une dérivation réécrit une forme de longueur <= n, divisé par le nombre
+//   de threads.
+// Le coût de dfs n'est qu'une borne inférieure : les branches abandonnées à la profondeur
+// maximale, qui n'aboutissent à aucun mot, n'y figurent pas et peuvent le dépasser de
+// plusieurs ordres de grandeur. Il n'est donc pas comparé aux autres : dfs n'est retenu que
+// si aucun autre moteur ne s'applique.
+
+static const char *noms_moteurs[] = { "auto", "dfs", "longueur", "automate", "fini" };
+
+const char *nom_moteur(Moteur moteur) {
+    return noms_moteurs[moteur];
+}
+
+// Moteur nommé, -1 si le nom est inconnu
+int lire_moteur(const char *nom) {
+    for (int m = 0; m < NB_MOTEURS; m++) {
+        if (strcmp(nom, noms_moteurs[m]) == 0) return m;
+    }
+    return -1;
+}
+
+// Forme que generer_mots_recursif développe entièrement : membres gauches distincts (seul le
+// premier est lu), terminaux minuscules, ni règle unité ni E hors de la production "E" de
+// l'axiome, absent alors des membres droits. Chaque dérivation d'un mot de n lettres a au
+// plus 2n - 1 étapes et tient dans la profondeur 2 × longueur_max.
+static int derivations_completes(const Grammaire *grammaire, const GrammaireIndexee *indexee) {
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        for (int j = 0; j < i; j++) {
+            if (strcmp(grammaire->rules[i].non_terminal, grammaire->rules[j].non_terminal) == 0) return 0;
+        }
+    }
+    int vides = 0, axiome_a_droite = 0;
+    for (int p = 0; p < indexee->nb_productions; p++) {
+        const ProductionIndexee *production = &indexee->productions[p];
+        if (production->longueur == 0) {
+            if (production->gauche != indexee->axiome || strcmp(production->texte, "E") != 0 || ++vides > 1) return 0;
+            continue;
+        }
+        if (production->longueur == 1 && !EST_TERMINAL_IDX(production->symboles[0])) return 0;
+        for (int i = 0; production->texte[i] != '\0'; i++) {
+            if (production->texte[i] == 'E' && !isdigit((unsigned char)production->texte[i + 1])) return 0;
+        }
+        for (int j = 0; j < production->longueur; j++) {
+            int symbole = production->symboles[j];
+            if (EST_TERMINAL_IDX(symbole) && !islower((unsigned char)CARACTERE_TERMINAL(symbole))) return 0;
+            if (symbole == indexee->axiome) axiome_a_droite = 1;
+        }
+    }
+    return !(vides && axiome_a_droite);
+}
+
+static int tient_sur_64_bits(const GrandEntier *a) {
+    for (int i = 1; i < GE_LIMBES; i++) {
+        if (a->l[i] != 0) return 0;
+    }
+    return 1;
+}
+
+static double ge_vers_double(const GrandEntier *a) {
+    double valeur = 0.0;
+    for (int i = GE_LIMBES - 1; i >= 0; i--) valeur = valeur * 18446744073709551616.0 + (double)a->l[i];
+    return valeur;
+}
+
+// Automate : 1 si, à chaque longueur <= n, il a autant de mots que la grammaire de
+// dérivations (grammaire non ambiguë jusqu'à n) ; distincts reçoit son nombre de mots
+static int automate_non_ambigu(const Automate *automate, const TableExacte *table, int axiome, int longueur_max,
+                               GrandEntier *distincts) {
+    int n = automate->nb_etats, nb_lettres = automate->nb_lettres, non_ambigu = 1;
+    GrandEntier *nombres = malloc(2 * (size_t)n * sizeof(GrandEntier));
+    if (!nombres) return -1;
+    // nombres[l % 2][q] : mots de l lettres menant de q à un état final
+    for (int q = 0; q < n; q++) ge_depuis_u64(&nombres[q], automate->final[q]);
+    *distincts = nombres[0];
+    for (int l = 0; l <= longueur_max; l++) {
+        GrandEntier *courant = &nombres[(size_t)(l % 2) * n];
+        if (l > 0) {
+            GrandEntier *avant = &nombres[(size_t)((l - 1) % 2) * n];
+            for (int q = 0; q < n; q++) {
+                ge_zero(&courant[q]);
+                for (int k = 0; k < nb_lettres; k++) {
+                    int suivant = automate->transitions[(size_t)q * nb_lettres + k];
+                    if (suivant != -1) ge_ajouter(&courant[q], &courant[q], &avant[suivant]);
+                }
+            }
+            ge_ajouter(distincts, distincts, &courant[0]);
+        }
+        const GrandEntier *derivations = comptage_exact_non_terminal(table, axiome, l);
+        if (ge_est_sature(derivations) || ge_comparer(&courant[0], derivations) != 0) non_ambigu = 0;
+    }
+    free(nombres);
+    return non_ambigu;
+}
+
+// Langage fini : mots de longueur <= n et leurs dérivations, qui doivent tenir sur 64 bits
+// pour être écrits
+static int analyser_langage_fini(Plan *plan, int longueur_max) {
+    const MotsFinis *axiome = plan->langage.langage;
+    ge_zero(&plan->distincts);
+    GrandEntier un;
+    ge_depuis_u64(&un, 1);
+    int derivations_64_bits = 1;
+    for (size_t i = 0; i < axiome->mots.nombre && strlen(axiome->mots.tries[i]) <= (size_t)longueur_max; i++) {
+        ge_ajouter(&plan->distincts, &plan->distincts, &un);
+        if (!tient_sur_64_bits(&axiome->derivations[i])) derivations_64_bits = 0;
+    }
+    plan->distincts_connus = 1;
+    return derivations_64_bits;
+}
+
+// Analyser la grammaire et choisir le moteur : le moins cher des moteurs applicables, ou
+// `force` s'il n'est pas MOTEUR_AUTO. Renvoie 0, -1 en cas d'erreur ou si le moteur
+// imposé ne s'applique pas. Le plan garde l'automate ou le langage fini pour l'exécution.
+int planifier(const Grammaire *grammaire, int longueur_max, int nb_threads, Moteur force, Plan *plan) {
+    memset(plan, 0, sizeof(*plan));
+    plan->longueur_max = longueur_max;
+    plan->nb_threads = nb_threads;
+    for (int m = 0; m < NB_MOTEURS; m++) plan->couts[m] = -1.0;
+    plan->raisons[MOTEUR_AUTO] = "";
+    const char *raison = NULL;
+    int statut = 0;
+
+    if (indexer_grammaire(grammaire, &plan->indexee) == -1) {
+        raison = "grammaire non indexable";
+    } else {
+        plan->indexee_valide = 1;
+        plan->derivations_completes = derivations_completes(grammaire, &plan->indexee);
+        if (!plan->derivations_completes) {
+            raison = "dérivations non bornées (membres gauches répétés, règle unité, E ou terminal non minuscule)";
+        }
+    }
+
+    if (plan->derivations_completes) {
+        TableExacte table;
+        if (comptage_exact_construire(&table, &plan->indexee, longueur_max) == -1) {
+            perror("Erreur d'allocation");
+            plan_liberer(plan);
+            return -1;
+        }
+        ge_zero(&plan->lignes);
+        for (int l = 0; l <= longueur_max; l++) {
+            ge_ajouter(&plan->lignes, &plan->lignes, comptage_exact_non_terminal(&table, plan->indexee.axiome, l));
+        }
+        plan->lignes_connues = 1;
+
+        plan->fini = langage_fini_construire(&plan->langage, &plan->indexee);
+        if (plan->fini == 1) {
+            if (!analyser_langage_fini(plan, longueur_max)) plan->raisons[MOTEUR_FINI] = "plus de 2^64 dérivations pour un mot";
+        } else if (plan->fini == 0) {
+            plan->raisons[MOTEUR_FINI] = "langage infini (cycle entre non-terminaux utiles) ou trop grand";
+        } else {
+            statut = -1;
+        }
+
+        if (statut == 0) plan->reguliere = automate_grammaire_indexee(&plan->indexee, &plan->automate);
+        if (plan->reguliere == 1) {
+            plan->etats = plan->automate.nb_etats;
+            GrandEntier distincts;
+            plan->non_ambigue = automate_non_ambigu(&plan->automate, &table, plan->indexee.axiome, longueur_max, &distincts);
+            if (plan->non_ambigue == -1) statut = -1;
+            if (!plan->distincts_connus) {
+                plan->distincts = distincts;
+                plan->distincts_connus = 1;
+            }
+            if (!plan->non_ambigue) plan->raisons[MOTEUR_AUTOMATE] = "grammaire ambiguë : moins de mots que de dérivations";
+        } else if (plan->reguliere == 0) {
+            plan->raisons[MOTEUR_AUTOMATE] = "grammaire non régulière (auto-enchâssement) ou automate trop grand";
+        } else {
+            statut = -1;
+        }
+        comptage_exact_liberer(&table);
+        if (statut == -1) {
+            perror("Erreur d'allocation");
+            plan_liberer(plan);
+            return -1;
+        }
+
+        if (ge_est_sature(&plan->lignes) || !tient_sur_64_bits(&plan->lignes)) {
+            plan->raisons[MOTEUR_LONGUEUR] = "plus de 2^64 lignes de sortie";
+        }
+    } else {
+        plan->raisons[MOTEUR_FINI] = plan->raisons[MOTEUR_AUTOMATE] = plan->raisons[MOTEUR_LONGUEUR] = raison;
+    }
+
+    // Coûts des moteurs applicables
+    double n = longueur_max > 0 ? longueur_max : 1;
+    double lignes = plan->lignes_connues ? ge_vers_double(&plan->lignes) : 0.0;
+    double distincts = plan->distincts_connus ? ge_vers_double(&plan->distincts) : lignes;
+    double taille = 0.0;
+    for (int p = 0; plan->indexee_valide && p < plan->indexee.nb_productions; p++) {
+        taille += plan->indexee.productions[p].longueur + 1;
+    }
+    if (plan->fini == 1 && !plan->raisons[MOTEUR_FINI]) plan->couts[MOTEUR_FINI] = lignes;
+    if (plan->reguliere == 1 && plan->non_ambigue == 1) plan->couts[MOTEUR_AUTOMATE] = lignes * n;
+    if (plan->derivations_completes && !plan->raisons[MOTEUR_LONGUEUR]) {
+        plan->couts[MOTEUR_LONGUEUR] = n * n * taille + distincts * n + lignes;
+    }
+    plan->couts[MOTEUR_DFS] = plan->lignes_connues ? lignes * n * n / (nb_threads > 1 ? nb_threads : 1) : 0.0;
+
+    if (force != MOTEUR_AUTO) {
+        if (plan->couts[force] < 0.0) {
+            fprintf(stderr, "Erreur : le moteur %s ne s'applique pas à cette grammaire : %s.\n", nom_moteur(force),
+                    plan->raisons[force]);
+            plan_liberer(plan);
+            return -1;
+        }
+        plan->moteur = force;
+        plan->impose = 1;
+        return 0;
+    }
+    // Les estimations de fini, automate et longueur sont comparables entre elles ; la borne de
+    // dfs ne l'est pas
+    plan->moteur = MOTEUR_DFS;
+    for (int m = MOTEUR_LONGUEUR; m < NB_MOTEURS; m++) {
+        if (plan->couts[m] >= 0.0 && (plan->moteur == MOTEUR_DFS || plan->couts[m] <= plan->couts[plan->moteur])) {
+            plan->moteur = m;
+        }
+    }
+    return 0;
+}
+
+// Décrire l'analyse et le choix (--explain)
+void expliquer_plan(FILE *flux, const Plan *plan) {
+    char texte[200];
+    fprintf(flux, "Plan pour les mots de longueur <= %d :\n", plan->longueur_max);
+    fprintf(flux, "  dérivations : %s\n", plan->derivations_completes ? "bornées (au plus 2n - 1 étapes)"
+                                                                     : plan->raisons[MOTEUR_LONGUEUR]);
+    if (plan->derivations_completes) {
+        fprintf(flux, "  langage : %s\n", plan->fini == 1 ? "fini (non-terminaux utiles sans cycle)"
+                                                          : "infini (cycle entre non-terminaux utiles) ou trop grand");
+        if (plan->reguliere == 1) {
+            fprintf(flux, "  régulière : oui, automate minimal de %d états, %s jusqu'à n\n", plan->etats,
+                    plan->non_ambigue ? "non ambiguë" : "ambiguë");
+        } else {
+            fprintf(flux, "  régulière : non reconnue\n");
+        }
+        ge_ecrire(&plan->lignes, texte, sizeof(texte));
+        fprintf(flux, "  sortie : %s lignes (dérivations)", texte);
+        if (plan->distincts_connus) {
+            ge_ecrire(&plan->distincts, texte, sizeof(texte));
+            fprintf(flux, ", %s mots distincts", texte);
+        }
+        fprintf(flux, "\n");
+    } else {
+        fprintf(flux, "  sortie : taille inconnue (comptage impossible sans dérivations bornées)\n");
+    }
+    fprintf(flux, "  moteurs :\n");
+    for (int m = MOTEUR_FINI; m >= MOTEUR_DFS; m--) {
+        if (plan->couts[m] < 0.0) {
+            fprintf(flux, "    %-9s inapplicable : %s\n", nom_moteur(m), plan->raisons[m]);
+        } else if (m == MOTEUR_DFS && !plan->lignes_connues) {
+            fprintf(flux, "    %-9s coût inconnu%s\n", nom_moteur(m), plan->nb_threads > 1 ? ", en parallèle" : "");
+        } else if (m == MOTEUR_DFS) {
+            fprintf(flux, "    %-9s coût >= %.3g (borne inférieure, non comparée)%s\n", nom_moteur(m), plan->couts[m],
+                    plan->nb_threads > 1 ? ", en parallèle" : "");
+        } else {
+            fprintf(flux, "    %-9s coût ~ %.3g\n", nom_moteur(m), plan->couts[m]);
+        }
+    }
+    fprintf(flux, "  choix : %s (%s)\n", nom_moteur(plan->moteur),
+            plan->impose ? "imposé par --moteur" : plan->moteur == MOTEUR_DFS ? "seul moteur applicable"
+                                                                              : "moteur borné le moins cher");
+}
+
+void plan_liberer(Plan *plan) {
+    if (plan->fini == 1) langage_fini_liberer(&plan->langage);
+    if (plan->reguliere == 1) liberer_automate(&plan->automate);
+    if (plan->indexee_valide) liberer_grammaire_indexee(&plan->indexee);
+    memset(plan, 0, sizeof(*plan));
+}
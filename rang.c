@@ -0,0 +1,458 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "generate_words.h"
+
+// Rang et dé-rang dans l'ordre des mots d'une longueur donnée (ordre de strcmp).
+//
+// Un mot se lit lettre par lettre en suivant les dérivations gauches : après un préfixe,
+// une dérivation est dans une configuration, la pile des symboles qui restent à dériver.
+// Les piles sont partagées (une pile = un symbole au sommet + la pile du dessous) et
+// chacune connaît, pour chaque longueur r, le nombre de façons de dériver r lettres.
+// La fermeture d'une pile pour r lettres restantes développe le non-terminal du sommet
+// jusqu'à faire apparaître une lettre, en ne gardant que les piles qui peuvent encore
+// produire exactement r lettres ; elle est mémorisée par (pile, r).
+//
+// Les rangs comptent des dérivations : pour une grammaire non ambiguë, ce sont les rangs
+// des mots. Pour une grammaire ambiguë, un mot à d dérivations occupe les rangs
+// [debut, debut + d), et curseur_lex_positionner renvoie le mot qui contient le rang demandé.
+
+typedef struct Pile Pile;
+
+typedef struct {
+    unsigned char lettre;
+    Pile *reste;               // Pile après lecture de la lettre
+    GrandEntier multiplicite;  // Nombre de dérivations qui mènent à cette transition
+} Transition;
+
+typedef struct {
+    Transition *transitions;   // Triées par lettre puis par pile, sans doublon
+    int nombre;
+    int etat;                  // 0 = à calculer, 1 = en cours, 2 = calculée
+} Fermeture;
+
+struct Pile {
+    int symbole;               // Sommet (-1 - c pour un terminal c) ; inutilisé pour la pile vide
+    Pile *dessous;
+    GrandEntier *comptes;      // [r] = nombre de dérivations de r lettres, r <= longueur_max
+    Fermeture *fermetures;     // [r], alloué au premier besoin
+    Pile *suivante;            // Chaînage de la table de hachage
+};
+
+// Transitions d'une position du mot, et plage [choix, fin_choix) de la lettre retenue
+typedef struct {
+    Transition *transitions;
+    int nombre;
+    int capacite;
+    int choix;
+    int fin_choix;
+} Niveau;
+
+struct CurseurLex {
+    TableExacte table;
+    int longueur_max;
+    Pile *vide;
+    Pile *axiome;
+    Pile **alveoles;
+    size_t nb_alveoles;
+    size_t nb_piles;
+
+    int longueur;              // Longueur du mot courant, -1 si aucun
+    Niveau *niveaux;           // [0..longueur_max)
+    char *mot;
+    GrandEntier debut;         // Premier rang du mot courant
+    GrandEntier multiplicite;  // Nombre de dérivations du mot courant
+};
+
+static const GrandEntier *compte_symbole_exact(const CurseurLex *curseur, int symbole, int longueur) {
+    static const GrandEntier un = {{1}};
+    static const GrandEntier zero = {{0}};
+    if (EST_TERMINAL_IDX(symbole)) return longueur == 1 ? &un : &zero;
+    return comptage_exact_non_terminal(&curseur->table, symbole, longueur);
+}
+
+static size_t hacher_pile(int symbole, const Pile *dessous) {
+    size_t h = (size_t)(unsigned)symbole * 0x9E3779B97F4A7C15ULL;
+    h ^= (size_t)dessous + (h << 6) + (h >> 2);
+    return h;
+}
+
+static int agrandir_table_piles(CurseurLex *curseur) {
+    size_t nb = curseur->nb_alveoles ? curseur->nb_alveoles * 2 : 1024;
+    Pile **alveoles = calloc(nb, sizeof(Pile *));
+    if (!alveoles) return -1;
+    for (size_t i = 0; i < curseur->nb_alveoles; i++) {
+        Pile *pile = curseur->alveoles[i];
+        while (pile) {
+            Pile *suivante = pile->suivante;
+            size_t h = hacher_pile(pile->symbole, pile->dessous) & (nb - 1);
+            pile->suivante = alveoles[h];
+            alveoles[h] = pile;
+            pile = suivante;
+        }
+    }
+    free(curseur->alveoles);
+    curseur->alveoles = alveoles;
+    curseur->nb_alveoles = nb;
+    return 0;
+}
+
+static Pile *nouvelle_pile(CurseurLex *curseur) {
+    Pile *pile = calloc(1, sizeof(Pile));
+    if (!pile) return NULL;
+    pile->comptes = calloc(curseur->longueur_max + 1, sizeof(GrandEntier));
+    if (!pile->comptes) {
+        free(pile);
+        return NULL;
+    }
+    return pile;
+}
+
+// Retrouver ou créer la pile (symbole au-dessus de dessous)
+static Pile *empiler(CurseurLex *curseur, int symbole, Pile *dessous) {
+    if (curseur->nb_piles >= curseur->nb_alveoles && agrandir_table_piles(curseur) == -1) return NULL;
+    size_t h = hacher_pile(symbole, dessous) & (curseur->nb_alveoles - 1);
+    for (Pile *pile = curseur->alveoles[h]; pile; pile = pile->suivante) {
+        if (pile->symbole == symbole && pile->dessous == dessous) return pile;
+    }
+
+    Pile *pile = nouvelle_pile(curseur);
+    if (!pile) return NULL;
+    pile->symbole = symbole;
+    pile->dessous = dessous;
+    for (int l = 0; l <= curseur->longueur_max; l++) {
+        for (int i = 0; i <= l; i++) {
+            const GrandEntier *bas = &dessous->comptes[l - i];
+            if (!ge_est_zero(bas)) ge_ajouter_produit(&pile->comptes[l], compte_symbole_exact(curseur, symbole, i), bas);
+        }
+    }
+    pile->suivante = curseur->alveoles[h];
+    curseur->alveoles[h] = pile;
+    curseur->nb_piles++;
+    return pile;
+}
+
+static int comparer_transitions(const void *a, const void *b) {
+    const Transition *ta = a, *tb = b;
+    if (ta->lettre != tb->lettre) return ta->lettre < tb->lettre ? -1 : 1;
+    if (ta->reste != tb->reste) return ta->reste < tb->reste ? -1 : 1;
+    return 0;
+}
+
+// Trier par (lettre, pile) et additionner les multiplicités des doublons
+static int normaliser_transitions(Transition *transitions, int nombre) {
+    if (nombre == 0) return 0;
+    qsort(transitions, nombre, sizeof(Transition), comparer_transitions);
+    int ecrit = 0;
+    for (int i = 1; i < nombre; i++) {
+        if (comparer_transitions(&transitions[ecrit], &transitions[i]) == 0) {
+            ge_ajouter(&transitions[ecrit].multiplicite, &transitions[ecrit].multiplicite, &transitions[i].multiplicite);
+        } else {
+            transitions[++ecrit] = transitions[i];
+        }
+    }
+    return ecrit + 1;
+}
+
+static int ajouter_transition(Transition **transitions, int *nombre, int *capacite, const Transition *transition) {
+    if (*nombre == *capacite) {
+        int nouvelle_capacite = *capacite ? *capacite * 2 : 8;
+        Transition *tab = realloc(*transitions, nouvelle_capacite * sizeof(Transition));
+        if (!tab) return -1;
+        *transitions = tab;
+        *capacite = nouvelle_capacite;
+    }
+    (*transitions)[(*nombre)++] = *transition;
+    return 0;
+}
+
+// Fermeture de `pile` quand il reste r >= 1 lettres à lire
+static const Fermeture *fermeture(CurseurLex *curseur, Pile *pile, int r) {
+    if (!pile->fermetures) {
+        pile->fermetures = calloc(curseur->longueur_max + 1, sizeof(Fermeture));
+        if (!pile->fermetures) return NULL;
+    }
+    Fermeture *resultat = &pile->fermetures[r];
+    if (resultat->etat == 2) return resultat;
+    if (resultat->etat == 1) {
+        fprintf(stderr, "Erreur : nombre infini de dérivations (cycle de règles unité ou epsilon).\n");
+        return NULL;
+    }
+    resultat->etat = 1;
+
+    Transition *transitions = NULL;
+    int nombre = 0, capacite = 0;
+    if (pile == curseur->vide || ge_est_zero(&pile->comptes[r])) {
+        // Rien à lire
+    } else if (EST_TERMINAL_IDX(pile->symbole)) {
+        Transition transition = { (unsigned char)CARACTERE_TERMINAL(pile->symbole), pile->dessous, {{1}} };
+        if (ajouter_transition(&transitions, &nombre, &capacite, &transition) == -1) goto erreur;
+    } else {
+        const GrammaireIndexee *grammaire = curseur->table.grammaire;
+        int debut = grammaire->premiere_production[pile->symbole];
+        for (int p = debut; p < debut + grammaire->nb_productions_nt[pile->symbole]; p++) {
+            const ProductionIndexee *production = &grammaire->productions[p];
+            Pile *suite = pile->dessous;
+            for (int j = production->longueur - 1; j >= 0 && suite; j--) {
+                suite = empiler(curseur, production->symboles[j], suite);
+            }
+            if (!suite) goto erreur;
+            if (ge_est_zero(&suite->comptes[r])) continue;
+
+            const Fermeture *enfant = fermeture(curseur, suite, r);
+            if (!enfant) goto erreur;
+            for (int i = 0; i < enfant->nombre; i++) {
+                if (ajouter_transition(&transitions, &nombre, &capacite, &enfant->transitions[i]) == -1) goto erreur;
+            }
+        }
+        nombre = normaliser_transitions(transitions, nombre);
+    }
+
+    resultat->transitions = transitions;
+    resultat->nombre = nombre;
+    resultat->etat = 2;
+    return resultat;
+
+erreur:
+    free(transitions);
+    resultat->etat = 0;
+    return NULL;
+}
+
+// Calculer les transitions de la position `position` à partir des configurations retenues
+// à la position précédente (ou de l'axiome pour la première lettre)
+static int calculer_niveau(CurseurLex *curseur, int position) {
+    Niveau *niveau = &curseur->niveaux[position];
+    int r = curseur->longueur - position;
+    niveau->nombre = 0;
+
+    Transition depart = { 0, curseur->axiome, {{1}} };
+    const Transition *configurations = &depart;
+    int nb_configurations = 1;
+    if (position > 0) {
+        const Niveau *precedent = &curseur->niveaux[position - 1];
+        configurations = precedent->transitions + precedent->choix;
+        nb_configurations = precedent->fin_choix - precedent->choix;
+    }
+
+    for (int c = 0; c < nb_configurations; c++) {
+        const Fermeture *f = fermeture(curseur, configurations[c].reste, r);
+        if (!f) return -1;
+        for (int i = 0; i < f->nombre; i++) {
+            Transition transition = f->transitions[i];
+            ge_multiplier(&transition.multiplicite, &transition.multiplicite, &configurations[c].multiplicite);
+            if (ajouter_transition(&niveau->transitions, &niveau->nombre, &niveau->capacite, &transition) == -1) return -1;
+        }
+    }
+    niveau->nombre = normaliser_transitions(niveau->transitions, niveau->nombre);
+    niveau->choix = niveau->fin_choix = 0;
+    return 0;
+}
+
+// Nombre de dérivations qui complètent le mot si l'on choisit les transitions [debut, fin)
+static void compter_plage(const CurseurLex *curseur, const Niveau *niveau, int debut, int fin, int r, GrandEntier *total) {
+    (void)curseur;
+    ge_zero(total);
+    for (int i = debut; i < fin; i++) {
+        ge_ajouter_produit(total, &niveau->transitions[i].multiplicite, &niveau->transitions[i].reste->comptes[r - 1]);
+    }
+}
+
+static int fin_lettre(const Niveau *niveau, int debut) {
+    int fin = debut;
+    while (fin < niveau->nombre && niveau->transitions[fin].lettre == niveau->transitions[debut].lettre) fin++;
+    return fin;
+}
+
+static void choisir(CurseurLex *curseur, int position, int debut) {
+    Niveau *niveau = &curseur->niveaux[position];
+    niveau->choix = debut;
+    niveau->fin_choix = fin_lettre(niveau, debut);
+    curseur->mot[position] = (char)niveau->transitions[debut].lettre;
+}
+
+// Multiplicité du mot complet : dérivations qui aboutissent à une pile effaçable
+static void calculer_multiplicite(CurseurLex *curseur) {
+    int n = curseur->longueur;
+    if (n == 0) {
+        curseur->multiplicite = curseur->axiome->comptes[0];
+        return;
+    }
+    const Niveau *dernier = &curseur->niveaux[n - 1];
+    compter_plage(curseur, dernier, dernier->choix, dernier->fin_choix, 1, &curseur->multiplicite);
+}
+
+CurseurLex *curseur_lex_creer(const GrammaireIndexee *grammaire, int longueur_max) {
+    CurseurLex *curseur = calloc(1, sizeof(CurseurLex));
+    if (!curseur) {
+        perror("Erreur d'allocation");
+        return NULL;
+    }
+    curseur->longueur_max = longueur_max;
+    curseur->longueur = -1;
+    if (comptage_exact_construire(&curseur->table, grammaire, longueur_max) == -1) {
+        free(curseur);
+        return NULL;
+    }
+    curseur->vide = nouvelle_pile(curseur);
+    curseur->niveaux = calloc(longueur_max + 1, sizeof(Niveau));
+    curseur->mot = malloc(longueur_max + 1);
+    if (!curseur->vide || !curseur->niveaux || !curseur->mot) {
+        perror("Erreur d'allocation");
+        curseur_lex_liberer(curseur);
+        return NULL;
+    }
+    curseur->vide->symbole = -1;
+    curseur->vide->comptes[0].l[0] = 1;
+    curseur->axiome = empiler(curseur, grammaire->axiome, curseur->vide);
+    if (!curseur->axiome) {
+        perror("Erreur d'allocation");
+        curseur_lex_liberer(curseur);
+        return NULL;
+    }
+    return curseur;
+}
+
+void curseur_lex_liberer(CurseurLex *curseur) {
+    if (!curseur) return;
+    for (size_t i = 0; i < curseur->nb_alveoles; i++) {
+        Pile *pile = curseur->alveoles[i];
+        while (pile) {
+            Pile *suivante = pile->suivante;
+            if (pile->fermetures) {
+                for (int r = 0; r <= curseur->longueur_max; r++) free(pile->fermetures[r].transitions);
+                free(pile->fermetures);
+            }
+            free(pile->comptes);
+            free(pile);
+            pile = suivante;
+        }
+    }
+    if (curseur->vide) {
+        free(curseur->vide->fermetures);
+        free(curseur->vide->comptes);
+        free(curseur->vide);
+    }
+    if (curseur->niveaux) {
+        for (int i = 0; i <= curseur->longueur_max; i++) free(curseur->niveaux[i].transitions);
+        free(curseur->niveaux);
+    }
+    free(curseur->alveoles);
+    free(curseur->mot);
+    comptage_exact_liberer(&curseur->table);
+    free(curseur);
+}
+
+int curseur_lex_longueur_max(const CurseurLex *curseur) {
+    return curseur->longueur_max;
+}
+
+// Nombre de dérivations de mots de longueur `longueur` (nombre de mots si non ambiguë)
+const GrandEntier *curseur_lex_total(const CurseurLex *curseur, int longueur) {
+    return comptage_exact_non_terminal(&curseur->table, curseur->table.grammaire->axiome, longueur);
+}
+
+// Se placer sur le mot de longueur `longueur` qui contient le rang k.
+// Renvoie 1 si ce mot existe, 0 si k dépasse le nombre de dérivations, -1 en cas d'erreur.
+int curseur_lex_positionner(CurseurLex *curseur, int longueur, const GrandEntier *k) {
+    curseur->longueur = -1;
+    if (longueur < 0 || longueur > curseur->longueur_max) return 0;
+    if (ge_comparer(k, &curseur->axiome->comptes[longueur]) >= 0) return 0;
+
+    curseur->longueur = longueur;
+    GrandEntier reste = *k;
+    for (int position = 0; position < longueur; position++) {
+        if (calculer_niveau(curseur, position) == -1) return -1;
+        Niveau *niveau = &curseur->niveaux[position];
+        int r = longueur - position;
+        int debut = 0;
+        for (;;) {
+            if (debut >= niveau->nombre) return -1; // Incohérence entre comptes et fermetures
+            int fin = fin_lettre(niveau, debut);
+            GrandEntier nombre;
+            compter_plage(curseur, niveau, debut, fin, r, &nombre);
+            if (ge_comparer(&reste, &nombre) < 0) break;
+            ge_soustraire(&reste, &reste, &nombre);
+            debut = fin;
+        }
+        choisir(curseur, position, debut);
+    }
+    curseur->mot[longueur] = '\0';
+    calculer_multiplicite(curseur);
+    ge_soustraire(&curseur->debut, k, &reste);
+    return 1;
+}
+
+// Passer au mot suivant de même longueur. Renvoie 1, 0 s'il n'y en a plus, -1 en cas d'erreur.
+int curseur_lex_suivant(CurseurLex *curseur) {
+    int n = curseur->longueur;
+    if (n < 0) return 0;
+    GrandEntier debut;
+    ge_ajouter(&debut, &curseur->debut, &curseur->multiplicite);
+
+    int position = n - 1;
+    while (position >= 0 && curseur->niveaux[position].fin_choix >= curseur->niveaux[position].nombre) position--;
+    if (position < 0) {
+        curseur->longueur = -1;
+        return 0;
+    }
+    choisir(curseur, position, curseur->niveaux[position].fin_choix);
+    for (position++; position < n; position++) {
+        if (calculer_niveau(curseur, position) == -1) return -1;
+        if (curseur->niveaux[position].nombre == 0) return -1;
+        choisir(curseur, position, 0);
+    }
+    calculer_multiplicite(curseur);
+    curseur->debut = debut;
+    return 1;
+}
+
+const char *curseur_lex_mot(const CurseurLex *curseur) {
+    return curseur->longueur < 0 ? NULL : curseur->mot;
+}
+
+// Premier rang et nombre de dérivations du mot courant
+void curseur_lex_rangs(const CurseurLex *curseur, GrandEntier *debut, GrandEntier *multiplicite) {
+    if (debut) *debut = curseur->debut;
+    if (multiplicite) *multiplicite = curseur->multiplicite;
+}
+
+// Rang de `mot` parmi les mots de sa longueur. Renvoie 1 si le mot est engendré
+// (rang et multiplicite sont alors remplis), 0 sinon, -1 en cas d'erreur.
+// Le curseur reste placé sur le mot.
+int curseur_lex_rang(CurseurLex *curseur, const char *mot, GrandEntier *rang, GrandEntier *multiplicite) {
+    int longueur = (int)strlen(mot);
+    curseur->longueur = -1;
+    if (longueur > curseur->longueur_max || ge_est_zero(&curseur->axiome->comptes[longueur])) return 0;
+
+    curseur->longueur = longueur;
+    ge_zero(rang);
+    for (int position = 0; position < longueur; position++) {
+        if (calculer_niveau(curseur, position) == -1) return -1;
+        Niveau *niveau = &curseur->niveaux[position];
+        int r = longueur - position;
+        int debut = 0;
+        while (debut < niveau->nombre && niveau->transitions[debut].lettre < (unsigned char)mot[position]) {
+            int fin = fin_lettre(niveau, debut);
+            GrandEntier nombre;
+            compter_plage(curseur, niveau, debut, fin, r, &nombre);
+            ge_ajouter(rang, rang, &nombre);
+            debut = fin;
+        }
+        if (debut >= niveau->nombre || niveau->transitions[debut].lettre != (unsigned char)mot[position]) {
+            curseur->longueur = -1;
+            return 0;
+        }
+        choisir(curseur, position, debut);
+    }
+    curseur->mot[longueur] = '\0';
+    calculer_multiplicite(curseur);
+    if (ge_est_zero(&curseur->multiplicite)) {
+        curseur->longueur = -1;
+        return 0;
+    }
+    curseur->debut = *rang;
+    *multiplicite = curseur->multiplicite;
+    return 1;
+}
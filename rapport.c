@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rapport.h"
+
+void enregistrer_mesure(void *donnees, const MesureEtape *mesure) {
+    MesuresConversion *mesures = donnees;
+    if (mesures->nb_etapes == mesures->capacite) {
+        int capacite = mesures->capacite ? mesures->capacite * 2 : 16;
+        MesureEtape *tab = realloc(mesures->etapes, capacite * sizeof(MesureEtape));
+        if (!tab) {
+            mesures->echec_allocation = 1;
+            return;
+        }
+        mesures->etapes = tab;
+        mesures->capacite = capacite;
+    }
+    // Les noms d'étapes sont des chaînes constantes : le pointeur suffit
+    mesures->etapes[mesures->nb_etapes++] = *mesure;
+}
+
+void liberer_mesures(MesuresConversion *mesures) {
+    free(mesures->etapes);
+    mesures->etapes = NULL;
+    mesures->nb_etapes = mesures->capacite = 0;
+}
+
+static const char *nom_forme(FormeNormale forme) {
+    return forme == FORME_GREIBACH ? "greibach" : "chomsky";
+}
+
+static void ecrire_chaine_json(FILE *sortie, const char *texte) {
+    fputc('"', sortie);
+    for (const unsigned char *c = (const unsigned char *)texte; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(sortie, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(sortie, "\\u%04x", *c);
+        } else {
+            fputc(*c, sortie);
+        }
+    }
+    fputc('"', sortie);
+}
+
+// Un champ CSV est entre guillemets s'il contient une virgule, un guillemet ou un saut de ligne
+static void ecrire_champ_csv(FILE *sortie, const char *texte) {
+    if (strpbrk(texte, ",\"\r\n") == NULL) {
+        fputs(texte, sortie);
+        return;
+    }
+    fputc('"', sortie);
+    for (const char *c = texte; *c; c++) {
+        if (*c == '"') fputc('"', sortie);
+        fputc(*c, sortie);
+    }
+    fputc('"', sortie);
+}
+
+static void ecrire_json(FILE *sortie, const ConversionRapport *conversions, int nb_conversions) {
+    fprintf(sortie, "{\n  \"version\": \"%s\",\n  \"conversions\": [", LIBGRAMMAIRE_VERSION);
+    for (int i = 0; i < nb_conversions; i++) {
+        const ConversionRapport *conversion = &conversions[i];
+        fprintf(sortie, "%s\n    {\"fichier\": ", i ? "," : "");
+        ecrire_chaine_json(sortie, conversion->fichier);
+        fprintf(sortie, ", \"forme\": \"%s\", \"statut\": %d, \"cache\": %s, \"etapes\": [",
+                nom_forme(conversion->forme), conversion->statut, conversion->depuis_cache ? "true" : "false");
+        for (int j = 0; conversion->mesures && j < conversion->mesures->nb_etapes; j++) {
+            const MesureEtape *m = &conversion->mesures->etapes[j];
+            fprintf(sortie, "%s\n      {\"numero\": %d, \"etape\": ", j ? "," : "", m->numero);
+            ecrire_chaine_json(sortie, m->etape);
+            fprintf(sortie, ", \"secondes\": %.6f, \"regles\": %d, \"productions\": %d, \"symboles\": %ld, "
+                    "\"nouveaux_non_terminaux\": %d}",
+                    m->secondes, m->regles, m->productions, m->symboles, m->nouveaux_non_terminaux);
+        }
+        fprintf(sortie, "%s]}", conversion->mesures && conversion->mesures->nb_etapes ? "\n    " : "");
+    }
+    fprintf(sortie, "%s]\n}\n", nb_conversions ? "\n  " : "");
+}
+
+static void ecrire_csv(FILE *sortie, const ConversionRapport *conversions, int nb_conversions) {
+    fprintf(sortie, "fichier,forme,statut,cache,numero,etape,secondes,regles,productions,symboles,nouveaux_non_terminaux\n");
+    for (int i = 0; i < nb_conversions; i++) {
+        const ConversionRapport *conversion = &conversions[i];
+        for (int j = 0; conversion->mesures && j < conversion->mesures->nb_etapes; j++) {
+            const MesureEtape *m = &conversion->mesures->etapes[j];
+            ecrire_champ_csv(sortie, conversion->fichier);
+            fprintf(sortie, ",%s,%d,%d,%d,", nom_forme(conversion->forme), conversion->statut,
+                    conversion->depuis_cache, m->numero);
+            ecrire_champ_csv(sortie, m->etape);
+            fprintf(sortie, ",%.6f,%d,%d,%ld,%d\n", m->secondes, m->regles, m->productions, m->symboles,
+                    m->nouveaux_non_terminaux);
+        }
+    }
+}
+
+// Écrire le rapport : CSV si le nom se termine par .csv, JSON sinon
+int ecrire_rapport(const char *chemin, const ConversionRapport *conversions, int nb_conversions) {
+    FILE *sortie = fopen(chemin, "w");
+    if (sortie == NULL) {
+        perror("Erreur lors de l'ouverture du rapport");
+        return -1;
+    }
+    size_t longueur = strlen(chemin);
+    if (longueur > 4 && strcmp(chemin + longueur - 4, ".csv") == 0) {
+        ecrire_csv(sortie, conversions, nb_conversions);
+    } else {
+        ecrire_json(sortie, conversions, nb_conversions);
+    }
+    if (fclose(sortie) != 0) {
+        perror("Erreur lors de l'écriture du rapport");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,30 @@
+#ifndef RAPPORT_H
+#define RAPPORT_H
+
+#include "libgrammaire.h"
+
+// Rapport des conversions : pour chaque (fichier, forme), les mesures de chaque étape
+// (durée, taille de la grammaire obtenue, nouveaux non-terminaux), écrites en JSON ou,
+// si le nom du rapport se termine par .csv, en CSV avec une ligne par étape.
+
+typedef struct {
+    MesureEtape *etapes;
+    int nb_etapes;
+    int capacite;
+    int echec_allocation;
+} MesuresConversion;
+
+typedef struct {
+    const char *fichier;
+    FormeNormale forme;
+    int statut;                    // GRAMMAIRE_OK ou le code d'erreur de la conversion
+    int depuis_cache;
+    const MesuresConversion *mesures;
+} ConversionRapport;
+
+// MesureGrammaire qui ajoute la mesure au MesuresConversion passé en données
+void enregistrer_mesure(void *donnees, const MesureEtape *mesure);
+void liberer_mesures(MesuresConversion *mesures);
+int ecrire_rapport(const char *chemin, const ConversionRapport *conversions, int nb_conversions);
+
+#endif
@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrammaire.h"
+
+// Reconnaissance en temps linéaire par une table LL(1) (voir ll1.c) ou LALR(1) (lalr.c).
+// Une grammaire régulière donnée sans --lalr est reconnue par son automate minimal
+// (automate.c), qu'elle soit LL(1) ou non.
+// Usage : reconnaitre [--tous] [--lalr] table.ll1|table.lalr|grammaire [fichier_mots]
+// Les mots sont lus un par ligne (entrée standard par défaut, E pour le mot vide), par
+// exemple depuis generate_words. Les mots refusés sont écrits sur la sortie standard, ou
+// chaque mot suivi de " oui" ou " non" avec --tous ; le bilan va sur la sortie d'erreur.
+// Code de retour : 0 si tous les mots sont reconnus, 1 sinon.
+
+typedef struct {
+    int lalr;
+    TableLL1 table_ll1;
+    TableLALR table_lalr;
+    int reguliere;
+    Automate automate;
+} Reconnaisseur;
+
+// Charger une table écrite par grammaire --ll1 (fichier .ll1) ou --lalr (fichier .lalr), ou la
+// construire depuis une grammaire, qui doit être régulière ou LL(1) (LALR(1) avec --lalr)
+int charger_table(const char *fichier, Reconnaisseur *r) {
+    ContexteGrammaire ctx;
+    contexte_grammaire_init(&ctx);
+    size_t longueur = strlen(fichier);
+    int statut, conflits = 0;
+    char conflit[512] = "";
+    if (!r->lalr && longueur > 4 && strcmp(fichier + longueur - 4, ".ll1") == 0) {
+        statut = lire_table_ll1(&ctx, &r->table_ll1, fichier);
+    } else if (longueur > 5 && strcmp(fichier + longueur - 5, ".lalr") == 0) {
+        r->lalr = 1;
+        statut = lire_table_lalr(&ctx, &r->table_lalr, fichier);
+    } else {
+        Grammaire *grammaire = malloc(sizeof(Grammaire));
+        if (!grammaire) {
+            perror("Erreur d'allocation");
+            return -1;
+        }
+        statut = lire_grammaire(&ctx, grammaire, fichier);
+        if (statut == GRAMMAIRE_OK) statut = rewriter_grammaire(&ctx, grammaire);
+        if (statut == GRAMMAIRE_OK && r->lalr) {
+            statut = construire_table_lalr(&ctx, grammaire, &r->table_lalr);
+            if (statut == GRAMMAIRE_OK && (conflits = r->table_lalr.nb_conflits) > 0) {
+                decrire_conflit_lalr(&r->table_lalr, &r->table_lalr.conflits[0], conflit, sizeof(conflit));
+                liberer_table_lalr(&r->table_lalr);
+            }
+        } else if (statut == GRAMMAIRE_OK) {
+            statut = compiler_grammaire_reguliere(&ctx, grammaire, AUTOMATE_MAX_SOUS_ENSEMBLES, &r->automate, &r->reguliere);
+        }
+        if (statut == GRAMMAIRE_OK && !r->lalr && !r->reguliere) {
+            statut = construire_table_ll1(&ctx, grammaire, &r->table_ll1);
+            if (statut == GRAMMAIRE_OK && (conflits = r->table_ll1.nb_conflits) > 0) {
+                decrire_conflit_ll1(&r->table_ll1, &r->table_ll1.conflits[0], conflit, sizeof(conflit));
+                liberer_table_ll1(&r->table_ll1);
+            }
+        }
+        free(grammaire);
+    }
+    if (statut != GRAMMAIRE_OK) {
+        fprintf(stderr, "Erreur : %s\n", contexte_grammaire_message(&ctx));
+        return -1;
+    }
+    if (conflits > 0) {
+        fprintf(stderr, "Erreur : %s n'est pas %s (%d conflit%s, dont %s).\n", fichier, r->lalr ? "LALR(1)" : "LL(1)",
+                conflits, conflits > 1 ? "s" : "", conflit);
+        return -1;
+    }
+    return 0;
+}
+
+void liberer_reconnaisseur(Reconnaisseur *r) {
+    if (r->lalr) liberer_table_lalr(&r->table_lalr);
+    else if (r->reguliere) liberer_automate(&r->automate);
+    else liberer_table_ll1(&r->table_ll1);
+}
+
+int main(int argc, char *argv[]) {
+    int tous = 0;
+    Reconnaisseur reconnaisseur;
+    memset(&reconnaisseur, 0, sizeof(reconnaisseur));
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-' && argv[arg][1] == '-'; arg++) {
+        if (strcmp(argv[arg], "--tous") == 0) {
+            tous = 1;
+        } else if (strcmp(argv[arg], "--lalr") == 0) {
+            reconnaisseur.lalr = 1;
+        } else {
+            break;
+        }
+    }
+    if (arg >= argc || arg + 2 < argc || argv[arg][0] == '-') {
+        fprintf(stderr, "Usage : %s [--tous] [--lalr] table.ll1|table.lalr|grammaire [fichier_mots]\n", argv[0]);
+        return -1;
+    }
+
+    if (charger_table(argv[arg], &reconnaisseur) == -1) return -1;
+    FILE *entree = stdin;
+    if (arg + 1 < argc && (entree = fopen(argv[arg + 1], "r")) == NULL) {
+        perror("Erreur lors de l'ouverture des mots");
+        liberer_reconnaisseur(&reconnaisseur);
+        return -1;
+    }
+
+    static char tampon_sortie[1 << 20];
+    setvbuf(stdout, tampon_sortie, _IOFBF, sizeof(tampon_sortie));
+
+    PileAnalyse pile = { NULL, 0 };
+    char *ligne = NULL;
+    size_t taille = 0;
+    ssize_t lus;
+    unsigned long long mots = 0, reconnus = 0;
+    int statut = 0;
+    while ((lus = getline(&ligne, &taille, entree)) != -1) {
+        while (lus > 0 && (ligne[lus - 1] == '\n' || ligne[lus - 1] == '\r')) ligne[--lus] = '\0';
+        size_t longueur = strcmp(ligne, "E") == 0 ? 0 : (size_t)lus;
+        int reconnu;
+        if (reconnaisseur.lalr) reconnu = reconnaitre_lalr(&reconnaisseur.table_lalr, ligne, longueur, &pile);
+        else if (reconnaisseur.reguliere) reconnu = automate_reconnait(&reconnaisseur.automate, ligne, longueur);
+        else reconnu = reconnaitre_ll1(&reconnaisseur.table_ll1, ligne, longueur, &pile);
+        if (reconnu == -1) {
+            perror("Erreur d'allocation");
+            statut = -1;
+            break;
+        }
+        mots++;
+        reconnus += reconnu;
+        if (tous) printf("%s %s\n", ligne, reconnu ? "oui" : "non");
+        else if (!reconnu) printf("%s\n", ligne);
+    }
+    if (statut == 0 && ferror(entree)) {
+        perror("Erreur de lecture des mots");
+        statut = -1;
+    }
+    fprintf(stderr, "%llu mots, %llu reconnus\n", mots, reconnus);
+    if (statut == 0 && reconnus < mots) statut = 1;
+
+    free(ligne);
+    liberer_pile_analyse(&pile);
+    liberer_reconnaisseur(&reconnaisseur);
+    if (entree != stdin) fclose(entree);
+    return statut;
+}
@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libgrammaire.h"
+
+// Grammaires régulières, voir libgrammaire.h et automate.h. Les formes normales sont lues
+// sur l'automate minimal : un état q devient un non-terminal, et sa transition par a vers
+// r donne q -> a R (Greibach) ou q -> Xa R avec Xa -> a (Chomsky) si r a des transitions,
+// plus q -> a si r est final.
+
+static int signaler_memoire(ContexteGrammaire *ctx) {
+    return contexte_grammaire_signaler(ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+}
+
+int compiler_grammaire_reguliere(ContexteGrammaire *ctx, const Grammaire *grammaire, int max_etats, Automate *automate,
+                                 int *reguliere) {
+    *reguliere = 0;
+    int nb_productions = 0;
+    size_t total = 1;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        nb_productions += grammaire->rules[i].production_count;
+        for (int j = 0; j < grammaire->rules[i].production_count; j++) total += strlen(grammaire->rules[i].productions[j]);
+    }
+    int *gauche = malloc((nb_productions + 1) * sizeof(int)), *debut = malloc((nb_productions + 1) * sizeof(int));
+    int *longueur = malloc((nb_productions + 1) * sizeof(int)), *symboles = malloc(total * sizeof(int));
+    if (!gauche || !debut || !longueur || !symboles) {
+        free(gauche);
+        free(debut);
+        free(longueur);
+        free(symboles);
+        return signaler_memoire(ctx);
+    }
+
+    // Un non-terminal sans règle laisse la grammaire au chemin ordinaire, qui le signalera
+    int p = 0, position = 0, connus = 1;
+    for (int i = 0; i < grammaire->rule_count && connus; i++) {
+        for (int j = 0; j < grammaire->rules[i].production_count && connus; j++, p++) {
+            const char *production = grammaire->rules[i].productions[j];
+            gauche[p] = i;
+            debut[p] = position;
+            for (int k = 0, taille; production[k] != '\0' && connus; k += taille) {
+                int symbole = lire_symbole(grammaire, production + k, &taille);
+                connus = symbole != SYMBOLE_INCONNU;
+                if (connus && symbole != SYMBOLE_EPSILON) symboles[position++] = symbole;
+            }
+            longueur[p] = position - debut[p];
+        }
+    }
+
+    int statut = 0;
+    if (connus && grammaire->rule_count > 0) {
+        GrammaireSymboles description = { grammaire->rule_count, 0, nb_productions, gauche, debut, longueur, symboles };
+        statut = compiler_automate(&description, max_etats, automate);
+    }
+    free(gauche);
+    free(debut);
+    free(longueur);
+    free(symboles);
+    if (statut == -1) return signaler_memoire(ctx);
+    *reguliere = statut;
+    return GRAMMAIRE_OK;
+}
+
+// Nouvelle règle, sans production, au nom donné ou généré (nom NULL)
+static int ajouter_regle_vide(ContexteGrammaire *ctx, Grammaire *grammaire, const char *nom) {
+    Rule *rule = &grammaire->rules[grammaire->rule_count];
+    rule->production_count = 0;
+    if (nom) {
+        snprintf(rule->non_terminal, MAX_SYMBOLS, "%s", nom);
+    } else if (generate_non_terminal(ctx, rule->non_terminal, grammaire) != GRAMMAIRE_OK) {
+        return ctx->erreur;
+    }
+    grammaire->rule_count++;
+    return GRAMMAIRE_OK;
+}
+
+// Productions de l'état q ; regle[r] est la règle de l'état r (-1 sans transition), terminal[k]
+// celle de la lettre k en forme de Chomsky
+static void productions_etat(const Automate *automate, int q, const int *regle, const int *terminal, FormeNormale forme,
+                             Grammaire *grammaire, Rule *rule) {
+    for (int k = 0; k < automate->nb_lettres; k++) {
+        int r = automate->transitions[(size_t)q * automate->nb_lettres + k];
+        if (r == -1) continue;
+        char production[MAX_SYMBOLS];
+        if (regle[r] != -1) {
+            const char *suite = grammaire->rules[regle[r]].non_terminal;
+            if (forme == FORME_GREIBACH) {
+                snprintf(production, sizeof(production), "%c%s", automate->lettres[k], suite);
+            } else {
+                snprintf(production, sizeof(production), "%s%s", grammaire->rules[terminal[k]].non_terminal, suite);
+            }
+            ajouter_production(rule, production);
+        }
+        if (automate->final[r]) {
+            snprintf(production, sizeof(production), "%c", automate->lettres[k]);
+            ajouter_production(rule, production);
+        }
+    }
+}
+
+// Forme normale de l'automate ; *ecrite vaut 0 si elle dépasse les limites de Grammaire
+static int grammaire_de_automate(ContexteGrammaire *ctx, const Automate *automate, const char *axiome, FormeNormale forme,
+                                 Grammaire *resultat, int *ecrite) {
+    int n = automate->nb_etats, nb_lettres = automate->nb_lettres;
+    *ecrite = 0;
+    int *regle = malloc(n * sizeof(int)), terminal[256];
+    if (!regle) return signaler_memoire(ctx);
+
+    // Un état a une règle s'il a des transitions ; l'état initial a la sienne, distincte
+    // de l'axiome, si une transition y revient
+    int regles = 1, entrant_initial = 0, utilisees[256] = {0};
+    for (int q = 0; q < n; q++) {
+        regle[q] = -1;
+        for (int k = 0; k < nb_lettres; k++) {
+            int r = automate->transitions[(size_t)q * nb_lettres + k];
+            if (r == -1) continue;
+            regle[q] = 0;
+            entrant_initial |= r == 0;
+        }
+    }
+    for (int q = 0; q < n; q++) {
+        for (int k = 0; k < nb_lettres; k++) {
+            int r = automate->transitions[(size_t)q * nb_lettres + k];
+            if (r != -1 && regle[r] != -1) utilisees[k] = 1;
+        }
+    }
+    for (int q = 0; q < n; q++) regles += regle[q] != -1 && (q != 0 || entrant_initial);
+    for (int k = 0; k < nb_lettres; k++) regles += forme == FORME_CHOMSKY && utilisees[k];
+    if (regles > MAX_RULES || 2 * nb_lettres + 1 > MAX_RULES) {
+        free(regle);
+        return GRAMMAIRE_OK;
+    }
+
+    resultat->rule_count = 0;
+    int statut = ajouter_regle_vide(ctx, resultat, axiome);
+    if (regle[0] != -1) regle[0] = 0;
+    for (int q = 0; q < n && statut == GRAMMAIRE_OK; q++) {
+        if (regle[q] == -1 || (q == 0 && !entrant_initial)) continue;
+        regle[q] = resultat->rule_count;
+        statut = ajouter_regle_vide(ctx, resultat, NULL);
+    }
+    for (int k = 0; k < nb_lettres && statut == GRAMMAIRE_OK; k++) {
+        if (forme != FORME_CHOMSKY || !utilisees[k]) continue;
+        terminal[k] = resultat->rule_count;
+        statut = ajouter_regle_vide(ctx, resultat, NULL);
+        if (statut == GRAMMAIRE_OK) {
+            char lettre[2] = { automate->lettres[k], '\0' };
+            ajouter_production(&resultat->rules[terminal[k]], lettre);
+        }
+    }
+    if (statut == GRAMMAIRE_OK) {
+        if (automate->final[0]) ajouter_production(&resultat->rules[0], "E");
+        productions_etat(automate, 0, regle, terminal, forme, resultat, &resultat->rules[0]);
+        for (int q = 0; q < n; q++) {
+            if (regle[q] > 0) productions_etat(automate, q, regle, terminal, forme, resultat, &resultat->rules[regle[q]]);
+        }
+        *ecrite = 1;
+    }
+    free(regle);
+    return statut;
+}
+
+int normaliser_reguliere(ContexteGrammaire *ctx, Grammaire *grammaire, const char *axiome, FormeNormale forme, int *etats) {
+    *etats = 0;
+    double depart = ctx->mesure ? horloge_grammaire() : 0;
+    int generes = ctx->non_terminaux_generes, reguliere;
+    Automate automate;
+    int statut = compiler_grammaire_reguliere(ctx, grammaire, MAX_RULES, &automate, &reguliere);
+    if (statut != GRAMMAIRE_OK || !reguliere) return statut;
+
+    // Un langage vide reste au chemin ordinaire
+    int vide = !automate.final[0];
+    for (int k = 0; k < automate.nb_lettres && vide; k++) vide = automate.transitions[k] == -1;
+    Grammaire *resultat = vide ? NULL : malloc(sizeof(Grammaire));
+    if (!vide && !resultat) statut = signaler_memoire(ctx);
+    int ecrite = 0;
+    if (resultat) statut = grammaire_de_automate(ctx, &automate, axiome, forme, resultat, &ecrite);
+    if (statut == GRAMMAIRE_OK && ecrite) {
+        *grammaire = *resultat;
+        *etats = automate.nb_etats;
+        contexte_grammaire_mesurer(ctx, "Automate minimal", 1, depart, generes, grammaire);
+        contexte_grammaire_tracer_etape(ctx, 1, "Automate minimal", grammaire);
+        if (ctx->journal) ctx->journal(ctx->donnees_journal, "Automate minimal", grammaire);
+        TRACER(ctx, TRACE_RESUME, TRACE_VALIDATION, "validation %s : %s (automate minimal de %d états)",
+               forme == FORME_GREIBACH ? "greibach" : "chomsky",
+               (forme == FORME_GREIBACH ? isGreibach(grammaire) : isChomsky(grammaire)) ? "conforme" : "échec",
+               automate.nb_etats);
+    }
+    free(resultat);
+    liberer_automate(&automate);
+    return statut;
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "generate_words.h"
+
+// Points de reprise de l'écriture au fil de l'itérateur. Un point de reprise décrit un
+// état cohérent : les mots déjà écrits (leur nombre et la taille du fichier de sortie) et
+// l'état de l'itérateur juste après le dernier d'entre eux (iterateur_sauvegarder). Il est
+// écrit dans un fichier temporaire puis renommé, après que la sortie a été vidée sur
+// disque : un arrêt brutal laisse toujours le point précédent, complet. À la reprise, la
+// sortie est tronquée à la taille enregistrée, ce qui efface les mots écrits après.
+// Format (texte) :
+//   generate_words reprise 1
+//   empreinte <hachage de la grammaire, 16 chiffres hexadécimaux>
+//   longueur_max <n>
+//   ordre hierarchique|derivation
+//   mots <mots écrits>
+//   octets <taille de la sortie>
+//   <état de l'itérateur>
+
+#define REPRISE_VERSION 1
+
+// Empreinte de la grammaire (FNV-1a) : une reprise n'est valable que pour la même grammaire
+static uint64_t empreinte_grammaire(const Grammaire *grammaire) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < grammaire->rule_count; i++) {
+        const Rule *regle = &grammaire->rules[i];
+        for (int j = -1; j < regle->production_count; j++) {
+            const char *texte = j < 0 ? regle->non_terminal : regle->productions[j];
+            for (const char *c = texte; ; c++) {
+                h ^= (unsigned char)*c;
+                h *= 0x100000001b3ULL;
+                if (*c == '\0') break;
+            }
+        }
+    }
+    return h;
+}
+
+static const char *nom_ordre(OrdreIteration ordre) {
+    return ordre == ORDRE_HIERARCHIQUE ? "hierarchique" : "derivation";
+}
+
+// Vider la sortie sur disque puis écrire le point de reprise. Renvoie 0, -1 en cas d'erreur
+// (le point précédent reste alors en place).
+int reprise_ecrire(const char *fichier, const Grammaire *grammaire, int longueur_max, OrdreIteration ordre,
+                   const IterateurMots *iterateur, SortieMots *sortie, unsigned long long mots) {
+    if (fflush(sortie->fichier) == EOF || fsync(fileno(sortie->fichier)) == -1) {
+        perror("Erreur d'écriture du fichier de sortie");
+        return -1;
+    }
+    long octets = ftell(sortie->fichier);
+    if (octets < 0) {
+        perror("Erreur d'écriture du fichier de sortie");
+        return -1;
+    }
+
+    char temporaire[4096];
+    if (snprintf(temporaire, sizeof(temporaire), "%s.tmp", fichier) >= (int)sizeof(temporaire)) {
+        fprintf(stderr, "Erreur : chemin du point de reprise trop long : %s\n", fichier);
+        return -1;
+    }
+    FILE *flux = fopen(temporaire, "w");
+    if (!flux) {
+        perror("Erreur d'écriture du point de reprise");
+        return -1;
+    }
+    int statut = fprintf(flux, "generate_words reprise %d\nempreinte %016llx\nlongueur_max %d\nordre %s\nmots %llu\noctets %ld\n",
+                         REPRISE_VERSION, (unsigned long long)empreinte_grammaire(grammaire), longueur_max,
+                         nom_ordre(ordre), mots, octets) < 0 ? -1 : 0;
+    if (statut == 0) statut = iterateur_sauvegarder(iterateur, flux);
+    if (statut == 0 && (fflush(flux) == EOF || fsync(fileno(flux)) == -1)) statut = -1;
+    if (fclose(flux) == EOF) statut = -1;
+    if (statut == 0 && rename(temporaire, fichier) == -1) statut = -1;
+    if (statut == -1) {
+        perror("Erreur d'écriture du point de reprise");
+        remove(temporaire);
+    }
+    return statut;
+}
+
+// Lire un point de reprise et y replacer l'itérateur, tout juste ouvert avec la même
+// grammaire, la même longueur et le même ordre. Renvoie 0, -1 en cas d'erreur.
+int reprise_lire(const char *fichier, const Grammaire *grammaire, int longueur_max, OrdreIteration ordre,
+                 IterateurMots *iterateur, unsigned long long *mots, long *octets) {
+    FILE *flux = fopen(fichier, "r");
+    if (!flux) {
+        perror("Erreur d'ouverture du point de reprise");
+        return -1;
+    }
+    int version, longueur;
+    unsigned long long empreinte;
+    char texte_ordre[32];
+    int statut = fscanf(flux, "generate_words reprise %d empreinte %llx longueur_max %d ordre %31s mots %llu octets %ld",
+                        &version, &empreinte, &longueur, texte_ordre, mots, octets) == 6 && getc(flux) == '\n' ? 0 : -1;
+    if (statut == 0 && version != REPRISE_VERSION) statut = -1;
+    if (statut == -1) {
+        fprintf(stderr, "Erreur : point de reprise illisible : %s\n", fichier);
+    } else if (empreinte != empreinte_grammaire(grammaire) || longueur != longueur_max ||
+               strcmp(texte_ordre, nom_ordre(ordre)) != 0 || *octets < 0) {
+        fprintf(stderr, "Erreur : le point de reprise %s a été écrit pour une autre grammaire, longueur ou ordre.\n",
+                fichier);
+        statut = -1;
+    } else if (iterateur_restaurer(iterateur, flux) == -1) {
+        fprintf(stderr, "Erreur : état de l'itérateur invalide dans %s\n", fichier);
+        statut = -1;
+    }
+    fclose(flux);
+    return statut;
+}
@@ -0,0 +1,631 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <arpa/inet.h>
+
+#include "generate_words.h"
+
+// Service de grammaires sur une socket Unix (generate_words --service). Les grammaires
+// compilées restent en mémoire : une requête ne paie ni le démarrage d'un processus, ni
+// la lecture, ni la normalisation, ni le comptage déjà faits pour une requête précédente.
+//
+// Protocole : chaque trame est une longueur sur 4 octets (ordre réseau) suivie d'autant
+// d'octets. Une requête est une trame de champs séparés par des sauts de ligne :
+//   commande \n forme \n chemin \n argument
+// commande : normaliser (la grammaire obtenue), appartient (argument : un mot, E pour le
+// mot vide ; réponse "1 <dérivations>" ou "0 0"), compter (argument : n ; réponse : le
+// nombre de dérivations des mots de longueur <= n, puis une ligne par longueur) ou enumerer
+// (argument : n ; les mots distincts de longueur <= n dans l'ordre hiérarchique, un par
+// ligne). forme : aucune (grammaire déjà normalisée), greibach ou chomsky. chemin : fichier
+// de la grammaire, de préférence absolu (le service ne partage pas le répertoire du client).
+// La réponse est une trame "ok\n<résultat>" ou "erreur\n<message>" ; pour enumerer, les mots
+// suivent dans des trames de données, terminées par une trame vide.
+//
+// Une grammaire compilée est rangée sous son contenu et sa forme (l'empreinte du texte
+// choisit l'alvéole, le texte gardé tranche les collisions) : deux chemins vers le même
+// texte la partagent, et un fichier modifié (taille, date ou inode différents) est relu et
+// recompilé. Une grammaire qu'aucun chemin ne désigne plus est libérée à la fin de sa
+// dernière requête : la mémoire est bornée par les couples (chemin, forme) servis, pas
+// par le nombre de versions de chaque fichier. Chaque connexion a son thread ; chaque
+// grammaire a son verrou, si bien que des requêtes sur des grammaires différentes sont
+// servies en même temps.
+
+#define SERVICE_MAX_TRAME (1u << 20)      // Taille maximale d'une requête
+#define SERVICE_TAMPON 65536              // Taille des trames de données d'enumerer
+#define SERVICE_ALVEOLES 1024             // Alvéoles des tables de grammaires et de chemins
+
+typedef struct EntreeService {
+    uint64_t empreinte;                   // FNV-1a du contenu du fichier
+    Normalisation forme;
+    int references;                       // Chemins et requêtes en cours (verrou du service)
+    pthread_mutex_t verrou;               // Compilation et usage du curseur
+    int compilee;                         // 0 : pas encore, 1 : prête, -1 : erreur (message)
+    char *contenu;                        // Texte lu, clé de l'entrée
+    size_t taille_contenu;
+    char message[256];
+    char *texte;                          // Grammaire compilée, au format d'ecrire_grammaire
+    size_t taille_texte;
+    GrammaireIndexee indexee;
+    CurseurLex *curseur;                  // Comptes et rangs, étendu à la demande
+    struct EntreeService *suivante;
+} EntreeService;
+
+typedef struct CheminService {
+    char *chemin;
+    Normalisation forme;
+    dev_t peripherique;
+    ino_t inode;
+    off_t taille;
+    struct timespec modification;
+    EntreeService *entree;
+    struct CheminService *suivant;
+} CheminService;
+
+typedef struct {
+    pthread_mutex_t verrou;               // Les deux tables
+    EntreeService *entrees[SERVICE_ALVEOLES];
+    CheminService *chemins[SERVICE_ALVEOLES];
+} Service;
+
+typedef struct {
+    Service *service;
+    int descripteur;
+} Connexion;
+
+static volatile sig_atomic_t arret_demande = 0;
+
+static void demander_arret(int numero) {
+    (void)numero;
+    arret_demande = 1;
+}
+
+static const char *nom_normalisation(Normalisation forme) {
+    return forme == NORMALISATION_GREIBACH ? "greibach" : forme == NORMALISATION_CHOMSKY ? "chomsky" : "aucune";
+}
+
+static int lire_normalisation(const char *nom, Normalisation *forme) {
+    if (strcmp(nom, "aucune") == 0) *forme = NORMALISATION_AUCUNE;
+    else if (strcmp(nom, "greibach") == 0) *forme = NORMALISATION_GREIBACH;
+    else if (strcmp(nom, "chomsky") == 0) *forme = NORMALISATION_CHOMSKY;
+    else return -1;
+    return 0;
+}
+
+static uint64_t fnv1a(const void *donnees, size_t taille, uint64_t h) {
+    const unsigned char *octets = donnees;
+    for (size_t i = 0; i < taille; i++) {
+        h ^= octets[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// Trames
+
+// Lire exactement `taille` octets. Renvoie 1, 0 si la connexion est fermée avant le
+// premier octet, -1 en cas d'erreur ou de trame tronquée.
+static int lire_exactement(int descripteur, void *tampon, size_t taille) {
+    size_t lus = 0;
+    while (lus < taille) {
+        ssize_t n = recv(descripteur, (char *)tampon + lus, taille - lus, 0);
+        if (n == 0) return lus == 0 ? 0 : -1;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        lus += (size_t)n;
+    }
+    return 1;
+}
+
+static int envoyer_tout(int descripteur, const void *donnees, size_t taille) {
+    size_t envoyes = 0;
+    while (envoyes < taille) {
+        ssize_t n = send(descripteur, (const char *)donnees + envoyes, taille - envoyes, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        envoyes += (size_t)n;
+    }
+    return 0;
+}
+
+static int envoyer_trame(int descripteur, const char *donnees, size_t taille) {
+    uint32_t entete = htonl((uint32_t)taille);
+    if (envoyer_tout(descripteur, &entete, sizeof(entete)) == -1) return -1;
+    return taille ? envoyer_tout(descripteur, donnees, taille) : 0;
+}
+
+// Lire une trame (terminée par un octet nul ajouté). Renvoie 1, 0 en fin de connexion, -1
+// en cas d'erreur.
+static int lire_trame(int descripteur, char **donnees, size_t *taille, size_t taille_max) {
+    uint32_t entete;
+    int statut = lire_exactement(descripteur, &entete, sizeof(entete));
+    if (statut <= 0) return statut;
+    *taille = ntohl(entete);
+    if (*taille > taille_max) return -1;
+    *donnees = malloc(*taille + 1);
+    if (!*donnees) return -1;
+    if (*taille && lire_exactement(descripteur, *donnees, *taille) != 1) {
+        free(*donnees);
+        return -1;
+    }
+    (*donnees)[*taille] = '\0';
+    return 1;
+}
+
+static int repondre_erreur(int descripteur, const char *message) {
+    char trame[512];
+    int taille = snprintf(trame, sizeof(trame), "erreur\n%s", message);
+    return envoyer_trame(descripteur, trame, taille < (int)sizeof(trame) ? (size_t)taille : sizeof(trame) - 1);
+}
+
+// Grammaires
+
+static char *lire_fichier(const char *chemin, size_t *taille) {
+    int descripteur = open(chemin, O_RDONLY);
+    if (descripteur == -1) return NULL;
+    size_t capacite = 4096;
+    char *contenu = malloc(capacite);
+    *taille = 0;
+    while (contenu) {
+        if (*taille == capacite) {
+            char *plus = realloc(contenu, capacite *= 2);
+            if (!plus) {
+                free(contenu);
+                contenu = NULL;
+                break;
+            }
+            contenu = plus;
+        }
+        ssize_t n = read(descripteur, contenu + *taille, capacite - *taille);
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            free(contenu);
+            contenu = NULL;
+            break;
+        }
+        *taille += (size_t)n;
+    }
+    close(descripteur);
+    return contenu;
+}
+
+static int meme_fichier(const CheminService *chemin, const struct stat *etat) {
+    return chemin->peripherique == etat->st_dev && chemin->inode == etat->st_ino && chemin->taille == etat->st_size &&
+           chemin->modification.tv_sec == etat->st_mtim.tv_sec && chemin->modification.tv_nsec == etat->st_mtim.tv_nsec;
+}
+
+static void liberer_entree(EntreeService *entree) {
+    if (entree->compilee == 1) liberer_grammaire_indexee(&entree->indexee);
+    curseur_lex_liberer(entree->curseur);
+    pthread_mutex_destroy(&entree->verrou);
+    free(entree->contenu);
+    free(entree->texte);
+    free(entree);
+}
+
+// Retirer une référence (verrou du service tenu). Renvoie l'entrée si c'était la dernière :
+// elle est alors sortie de la table, à libérer par l'appelant hors du verrou.
+static EntreeService *retirer_reference(Service *service, EntreeService *entree) {
+    if (--entree->references > 0) return NULL;
+    EntreeService **e = &service->entrees[entree->empreinte % SERVICE_ALVEOLES];
+    while (*e != entree) e = &(*e)->suivante;
+    *e = entree->suivante;
+    return entree;
+}
+
+// Fin d'une requête sur l'entrée
+static void relacher_entree(Service *service, EntreeService *entree) {
+    pthread_mutex_lock(&service->verrou);
+    EntreeService *orpheline = retirer_reference(service, entree);
+    pthread_mutex_unlock(&service->verrou);
+    if (orpheline) liberer_entree(orpheline);
+}
+
+// Entrée de la grammaire `chemin` sous la forme demandée, créée (non compilée) si son
+// contenu n'a jamais été vu, avec une référence pour la requête (relacher_entree). Renvoie
+// NULL avec un message si le fichier est illisible.
+static EntreeService *trouver_entree(Service *service, const char *chemin, Normalisation forme, char *message,
+                                     size_t taille_message) {
+    struct stat etat;
+    if (stat(chemin, &etat) == -1) {
+        snprintf(message, taille_message, "%s : %s", chemin, strerror(errno));
+        return NULL;
+    }
+    uint64_t cle = fnv1a(chemin, strlen(chemin), 0xcbf29ce484222325ULL) ^ (uint64_t)forme;
+    CheminService **alveole_chemin = &service->chemins[cle % SERVICE_ALVEOLES];
+
+    pthread_mutex_lock(&service->verrou);
+    for (CheminService *c = *alveole_chemin; c; c = c->suivant) {
+        if (c->forme == forme && strcmp(c->chemin, chemin) == 0 && meme_fichier(c, &etat)) {
+            EntreeService *entree = c->entree;
+            entree->references++;
+            pthread_mutex_unlock(&service->verrou);
+            return entree;
+        }
+    }
+    pthread_mutex_unlock(&service->verrou);
+
+    // Fichier nouveau ou modifié : son contenu désigne la grammaire compilée
+    size_t taille;
+    char *contenu = lire_fichier(chemin, &taille);
+    if (!contenu) {
+        snprintf(message, taille_message, "%s : %s", chemin, strerror(errno));
+        return NULL;
+    }
+    uint64_t empreinte = fnv1a(contenu, taille, 0xcbf29ce484222325ULL);
+
+    pthread_mutex_lock(&service->verrou);
+    EntreeService **alveole = &service->entrees[empreinte % SERVICE_ALVEOLES];
+    EntreeService *entree = *alveole;
+    while (entree && (entree->empreinte != empreinte || entree->forme != forme || entree->taille_contenu != taille ||
+                      memcmp(entree->contenu, contenu, taille) != 0)) {
+        entree = entree->suivante;
+    }
+    if (!entree && (entree = calloc(1, sizeof(EntreeService)))) {
+        entree->empreinte = empreinte;
+        entree->forme = forme;
+        pthread_mutex_init(&entree->verrou, NULL);
+        entree->contenu = contenu;
+        entree->taille_contenu = taille;
+        contenu = NULL;
+        entree->suivante = *alveole;
+        *alveole = entree;
+    }
+    EntreeService *remplacee = NULL;
+    if (entree) {
+        entree->references++;
+        CheminService *c = *alveole_chemin;
+        while (c && (c->forme != forme || strcmp(c->chemin, chemin) != 0)) c = c->suivant;
+        if (!c && (c = calloc(1, sizeof(CheminService)))) {
+            if ((c->chemin = strdup(chemin))) {
+                c->forme = forme;
+                c->suivant = *alveole_chemin;
+                *alveole_chemin = c;
+            } else {
+                free(c);
+                c = NULL;
+            }
+        }
+        if (c) {
+            c->peripherique = etat.st_dev;
+            c->inode = etat.st_ino;
+            c->taille = etat.st_size;
+            c->modification = etat.st_mtim;
+            if (c->entree != entree) {
+                // L'ancienne version du fichier est libérée si plus rien ne la désigne
+                if (c->entree) remplacee = retirer_reference(service, c->entree);
+                c->entree = entree;
+                entree->references++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&service->verrou);
+    free(contenu);
+    if (remplacee) liberer_entree(remplacee);
+    if (!entree) snprintf(message, taille_message, "Mémoire insuffisante.");
+    return entree;
+}
+
+// Compiler une entrée (verrou de l'entrée tenu) : lecture, forme normale, indexation
+static void compiler_entree(EntreeService *entree) {
+    ContexteGrammaire ctx;
+    contexte_grammaire_init(&ctx);
+    Grammaire *grammaire = malloc(sizeof(Grammaire));
+    FILE *flux = entree->taille_contenu ? fmemopen(entree->contenu, entree->taille_contenu, "r") : NULL;
+    int statut;
+    if (!grammaire || (entree->taille_contenu && !flux)) {
+        statut = contexte_grammaire_signaler(&ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+    } else {
+        statut = flux ? lire_grammaire_flux(&ctx, grammaire, flux) : (grammaire->rule_count = 0, GRAMMAIRE_OK);
+        if (statut == GRAMMAIRE_OK) statut = preparer_grammaire(&ctx, grammaire, entree->forme);
+    }
+    if (flux) fclose(flux);
+    if (statut == GRAMMAIRE_OK) {
+        FILE *texte = open_memstream(&entree->texte, &entree->taille_texte);
+        if (!texte || ecrire_grammaire(texte, grammaire) != GRAMMAIRE_OK || fclose(texte) != 0) {
+            statut = contexte_grammaire_signaler(&ctx, GRAMMAIRE_ERREUR_MEMOIRE, "Mémoire insuffisante.");
+        } else if (indexer_grammaire(grammaire, &entree->indexee) == -1) {
+            statut = contexte_grammaire_signaler(&ctx, GRAMMAIRE_ERREUR_FORMAT, "Grammaire trop grande pour être indexée.");
+        }
+    }
+    if (statut == GRAMMAIRE_OK) {
+        entree->compilee = 1;
+    } else {
+        snprintf(entree->message, sizeof(entree->message), "%s", contexte_grammaire_message(&ctx));
+        free(entree->texte);
+        entree->texte = NULL;
+        entree->compilee = -1;
+    }
+    free(grammaire);
+}
+
+// Requêtes (verrou de l'entrée tenu). Chacune renvoie 0, ou -1 si la connexion est perdue.
+
+static int repondre_appartient(int descripteur, EntreeService *entree, const char *argument) {
+    const char *mot = strcmp(argument, "E") == 0 ? "" : argument;
+    int longueur = (int)strlen(mot);
+    if (longueur >= MAX_WORD_LEN) return repondre_erreur(descripteur, "Mot trop long.");
+    if (!(entree->curseur = curseur_pour_longueur(entree->curseur, &entree->indexee, longueur))) {
+        return repondre_erreur(descripteur, "Mémoire insuffisante.");
+    }
+    GrandEntier rang, multiplicite;
+    int statut = curseur_lex_rang(entree->curseur, mot, &rang, &multiplicite);
+    if (statut == -1) return repondre_erreur(descripteur, "Mémoire insuffisante.");
+    char reponse[256] = "ok\n0 0\n";
+    if (statut == 1) {
+        char texte[200];
+        ge_ecrire(&multiplicite, texte, sizeof(texte));
+        snprintf(reponse, sizeof(reponse), "ok\n1 %s\n", texte);
+    }
+    return envoyer_trame(descripteur, reponse, strlen(reponse));
+}
+
+static int repondre_compter(int descripteur, EntreeService *entree, int longueur_max) {
+    if (!(entree->curseur = curseur_pour_longueur(entree->curseur, &entree->indexee, longueur_max))) {
+        return repondre_erreur(descripteur, "Mémoire insuffisante.");
+    }
+    GrandEntier total;
+    ge_zero(&total);
+    for (int l = 0; l <= longueur_max; l++) ge_ajouter(&total, &total, curseur_lex_total(entree->curseur, l));
+    char *reponse = NULL;
+    size_t taille = 0;
+    FILE *flux = open_memstream(&reponse, &taille);
+    if (!flux) return repondre_erreur(descripteur, "Mémoire insuffisante.");
+    char texte[200];
+    ge_ecrire(&total, texte, sizeof(texte));
+    fprintf(flux, "ok\n%s\n", texte);
+    for (int l = 0; l <= longueur_max; l++) {
+        ge_ecrire(curseur_lex_total(entree->curseur, l), texte, sizeof(texte));
+        fprintf(flux, "%d %s\n", l, texte);
+    }
+    int statut = fclose(flux) == 0 ? envoyer_trame(descripteur, reponse, taille)
+                                    : repondre_erreur(descripteur, "Mémoire insuffisante.");
+    free(reponse);
+    return statut;
+}
+
+// Les mots distincts de chaque longueur, dans l'ordre de strcmp, par le curseur (rang.c)
+static int repondre_enumerer(int descripteur, EntreeService *entree, int longueur_max) {
+    if (!(entree->curseur = curseur_pour_longueur(entree->curseur, &entree->indexee, longueur_max))) {
+        return repondre_erreur(descripteur, "Mémoire insuffisante.");
+    }
+    if (envoyer_trame(descripteur, "ok\n", 3) == -1) return -1;
+    char tampon[SERVICE_TAMPON];
+    size_t rempli = 0;
+    GrandEntier zero;
+    ge_zero(&zero);
+    for (int l = 0; l <= longueur_max; l++) {
+        int place = curseur_lex_positionner(entree->curseur, l, &zero);
+        while (place == 1) {
+            // Le mot vide s'écrit E
+            const char *mot = l == 0 ? "E" : curseur_lex_mot(entree->curseur);
+            size_t longueur = l == 0 ? 1 : (size_t)l;
+            if (rempli + longueur + 1 > sizeof(tampon)) {
+                if (envoyer_trame(descripteur, tampon, rempli) == -1) return -1;
+                rempli = 0;
+            }
+            memcpy(tampon + rempli, mot, longueur);
+            rempli += longueur;
+            tampon[rempli++] = '\n';
+            place = curseur_lex_suivant(entree->curseur);
+        }
+        // L'erreur ne peut plus être signalée par le statut : la connexion est coupée
+        if (place == -1) return -1;
+    }
+    if (rempli && envoyer_trame(descripteur, tampon, rempli) == -1) return -1;
+    return envoyer_trame(descripteur, NULL, 0);
+}
+
+static int lire_longueur(const char *texte, int *longueur) {
+    char *fin;
+    long valeur = strtol(texte, &fin, 10);
+    if (fin == texte || *fin != '\0' || valeur < 0 || valeur >= MAX_WORD_LEN) return -1;
+    *longueur = (int)valeur;
+    return 0;
+}
+
+static int traiter_requete(Service *service, int descripteur, char *requete) {
+    char *champs[4] = { NULL, NULL, NULL, "" };
+    int nb_champs = 0;
+    for (char *suite = requete; suite && nb_champs < 4; nb_champs++) {
+        champs[nb_champs] = suite;
+        suite = strchr(suite, '\n');
+        if (suite) *suite++ = '\0';
+    }
+    Normalisation forme;
+    if (nb_champs < 3 || lire_normalisation(champs[1], &forme) == -1) {
+        return repondre_erreur(descripteur, "Requête invalide : commande, forme, chemin [, argument] attendus.");
+    }
+    const char *commande = champs[0], *argument = champs[3];
+    int normaliser = strcmp(commande, "normaliser") == 0, appartient = strcmp(commande, "appartient") == 0;
+    int compter = strcmp(commande, "compter") == 0, enumerer = strcmp(commande, "enumerer") == 0;
+    int longueur_max = 0;
+    if (!normaliser && !appartient && !compter && !enumerer) return repondre_erreur(descripteur, "Commande inconnue.");
+    if ((compter || enumerer) && lire_longueur(argument, &longueur_max) == -1) {
+        return repondre_erreur(descripteur, "Longueur invalide.");
+    }
+
+    char message[512];
+    EntreeService *entree = trouver_entree(service, champs[2], forme, message, sizeof(message));
+    if (!entree) return repondre_erreur(descripteur, message);
+
+    pthread_mutex_lock(&entree->verrou);
+    if (entree->compilee == 0) compiler_entree(entree);
+    int statut;
+    if (entree->compilee == -1) {
+        statut = repondre_erreur(descripteur, entree->message);
+    } else if (normaliser) {
+        // "ok\n" suivi du texte, envoyé sans copie
+        uint32_t entete = htonl((uint32_t)(entree->taille_texte + 3));
+        statut = envoyer_tout(descripteur, &entete, sizeof(entete)) == 0 && envoyer_tout(descripteur, "ok\n", 3) == 0
+                 ? envoyer_tout(descripteur, entree->texte, entree->taille_texte) : -1;
+    } else if (appartient) {
+        statut = repondre_appartient(descripteur, entree, argument);
+    } else if (compter) {
+        statut = repondre_compter(descripteur, entree, longueur_max);
+    } else {
+        statut = repondre_enumerer(descripteur, entree, longueur_max);
+    }
+    pthread_mutex_unlock(&entree->verrou);
+    relacher_entree(service, entree);
+    return statut;
+}
+
+static void *servir_connexion(void *argument) {
+    Connexion *connexion = argument;
+    char *requete;
+    size_t taille;
+    while (lire_trame(connexion->descripteur, &requete, &taille, SERVICE_MAX_TRAME) == 1) {
+        int statut = traiter_requete(connexion->service, connexion->descripteur, requete);
+        free(requete);
+        if (statut == -1) break;
+    }
+    close(connexion->descripteur);
+    free(connexion);
+    return NULL;
+}
+
+// Servir les requêtes sur la socket `chemin` jusqu'à SIGINT ou SIGTERM. Renvoie 0, -1 en
+// cas d'erreur.
+int servir(const char *chemin) {
+    struct sockaddr_un adresse = { .sun_family = AF_UNIX };
+    if (strlen(chemin) >= sizeof(adresse.sun_path)) {
+        fprintf(stderr, "Erreur : chemin de socket trop long : %s\n", chemin);
+        return -1;
+    }
+    strcpy(adresse.sun_path, chemin);
+
+    // Une socket restée d'un service arrêté est remplacée, jamais un autre fichier
+    struct stat etat;
+    if (lstat(chemin, &etat) == 0 && S_ISSOCK(etat.st_mode)) unlink(chemin);
+
+    int ecoute = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (ecoute == -1 || bind(ecoute, (struct sockaddr *)&adresse, sizeof(adresse)) == -1 || listen(ecoute, 128) == -1) {
+        perror("Erreur lors de l'ouverture de la socket");
+        if (ecoute != -1) close(ecoute);
+        return -1;
+    }
+
+    // Sans SA_RESTART : accept est interrompu par le signal d'arrêt
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = demander_arret;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    Service *service = calloc(1, sizeof(Service));
+    if (!service) {
+        perror("Erreur d'allocation");
+        close(ecoute);
+        unlink(chemin);
+        return -1;
+    }
+    pthread_mutex_init(&service->verrou, NULL);
+    pthread_attr_t attributs;
+    pthread_attr_init(&attributs);
+    pthread_attr_setdetachstate(&attributs, PTHREAD_CREATE_DETACHED);
+
+    printf("Service à l'écoute sur %s\n", chemin);
+    fflush(stdout);
+    int statut = 0;
+    while (!arret_demande) {
+        int descripteur = accept(ecoute, NULL, NULL);
+        if (descripteur == -1) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            perror("Erreur lors de l'acceptation d'une connexion");
+            statut = -1;
+            break;
+        }
+        Connexion *connexion = malloc(sizeof(Connexion));
+        pthread_t thread;
+        if (connexion) {
+            connexion->service = service;
+            connexion->descripteur = descripteur;
+        }
+        if (!connexion || pthread_create(&thread, &attributs, servir_connexion, connexion) != 0) {
+            fprintf(stderr, "Erreur : connexion refusée, ressources insuffisantes.\n");
+            free(connexion);
+            close(descripteur);
+        }
+    }
+    // Les connexions en cours se terminent avec le processus ; les grammaires ne sont pas libérées
+    pthread_attr_destroy(&attributs);
+    close(ecoute);
+    unlink(chemin);
+    return statut;
+}
+
+// Envoyer une requête au service et écrire le résultat sur la sortie standard. Renvoie 0,
+// -1 si le service répond par une erreur ou ne répond pas.
+int interroger_service(const char *chemin, const char *commande, const char *grammaire, const char *argument,
+                       Normalisation forme) {
+    struct sockaddr_un adresse = { .sun_family = AF_UNIX };
+    if (strlen(chemin) >= sizeof(adresse.sun_path)) {
+        fprintf(stderr, "Erreur : chemin de socket trop long : %s\n", chemin);
+        return -1;
+    }
+    strcpy(adresse.sun_path, chemin);
+    // Le service ne partage pas le répertoire courant du client
+    char absolu[PATH_MAX];
+    if (!realpath(grammaire, absolu)) snprintf(absolu, sizeof(absolu), "%s", grammaire);
+
+    int descripteur = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descripteur == -1 || connect(descripteur, (struct sockaddr *)&adresse, sizeof(adresse)) == -1) {
+        perror("Erreur de connexion au service");
+        if (descripteur != -1) close(descripteur);
+        return -1;
+    }
+    char *requete = NULL;
+    size_t taille = 0;
+    FILE *flux = open_memstream(&requete, &taille);
+    if (!flux) {
+        perror("Erreur d'allocation");
+        close(descripteur);
+        return -1;
+    }
+    fprintf(flux, "%s\n%s\n%s\n%s", commande, nom_normalisation(forme), absolu, argument ? argument : "");
+    int statut = fclose(flux) == 0 ? envoyer_trame(descripteur, requete, taille) : -1;
+    free(requete);
+
+    char *reponse = NULL;
+    if (statut == 0 && lire_trame(descripteur, &reponse, &taille, UINT32_MAX) != 1) statut = -1;
+    if (statut == -1) {
+        fprintf(stderr, "Erreur : pas de réponse du service.\n");
+    } else if (strncmp(reponse, "ok\n", 3) != 0) {
+        fprintf(stderr, "Erreur : %s\n", strncmp(reponse, "erreur\n", 7) == 0 ? reponse + 7 : reponse);
+        statut = -1;
+    } else {
+        fwrite(reponse + 3, 1, taille - 3, stdout);
+        // Les mots d'enumerer suivent, jusqu'à une trame vide
+        while (strcmp(commande, "enumerer") == 0) {
+            free(reponse);
+            reponse = NULL;
+            if (lire_trame(descripteur, &reponse, &taille, UINT32_MAX) != 1) {
+                fprintf(stderr, "Erreur : réponse du service interrompue.\n");
+                statut = -1;
+                break;
+            }
+            if (taille == 0) break;
+            fwrite(reponse, 1, taille, stdout);
+        }
+        if (statut == 0 && fflush(stdout) == EOF) statut = -1;
+    }
+    free(reponse);
+    close(descripteur);
+    return statut;
+}
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "generate_words.h"
+
+// Instrumentation de generer_mots (--stats) : compteurs de l'énumération, ligne de
+// progression périodique sur la sortie d'erreur et résumé JSON final. Le résumé permet de
+// voir si le temps part dans des branches mortes (formes développées, élaguées), dans les
+// doublons (dérivations multiples d'un même mot), dans le tri ou dans les entrées-sorties
+// (déversements, écriture).
+
+double secondes_depuis(const struct timespec *debut) {
+    struct timespec maintenant;
+    clock_gettime(CLOCK_MONOTONIC, &maintenant);
+    return (double)(maintenant.tv_sec - debut->tv_sec) + (maintenant.tv_nsec - debut->tv_nsec) / 1e9;
+}
+
+void compteurs_init(CompteursGeneration *compteurs) {
+    memset(compteurs, 0, sizeof(*compteurs));
+    atomic_init(&compteurs->formes, 0);
+    atomic_init(&compteurs->elaguees_profondeur, 0);
+    atomic_init(&compteurs->elaguees_longueur, 0);
+    atomic_init(&compteurs->derivations, 0);
+    atomic_init(&compteurs->deversements, 0);
+    atomic_init(&compteurs->ecrits, 0);
+    atomic_init(&compteurs->nanosecondes_tri, 0);
+    atomic_init(&compteurs->phase, PHASE_DERIVATION);
+    clock_gettime(CLOCK_MONOTONIC, &compteurs->debut);
+}
+
+// Compter `nombre` lignes écrites du mot (appelé par le seul thread qui écrit)
+void compter_ecriture(CompteursGeneration *compteurs, const char *mot, size_t longueur, unsigned long long nombre) {
+    // Le mot vide est écrit E
+    size_t l = longueur == 1 && mot[0] == 'E' ? 0 : longueur;
+    compteurs->mots_longueur[l] += nombre;
+    compteurs->distincts_longueur[l]++;
+    atomic_fetch_add_explicit(&compteurs->ecrits, nombre, memory_order_relaxed);
+}
+
+static unsigned long long lire(const atomic_ullong *compteur) {
+    return atomic_load_explicit(compteur, memory_order_relaxed);
+}
+
+static void afficher_progression(const CompteursGeneration *compteurs) {
+    double ecoule = secondes_depuis(&compteurs->debut);
+    unsigned long long formes = lire(&compteurs->formes), derivations = lire(&compteurs->derivations);
+    if (atomic_load(&compteurs->phase) == PHASE_DERIVATION) {
+        fprintf(stderr, "[%.0f s] dérivation : %llu formes (%.0f/s), élaguées %llu (profondeur) %llu (longueur), "
+                "%llu mots, %llu déversements\n",
+                ecoule, formes, ecoule > 0 ? formes / ecoule : 0.0, lire(&compteurs->elaguees_profondeur),
+                lire(&compteurs->elaguees_longueur), derivations, lire(&compteurs->deversements));
+    } else {
+        unsigned long long ecrits = lire(&compteurs->ecrits);
+        fprintf(stderr, "[%.0f s] fusion : %llu / %llu mots écrits (%.1f %%)\n", ecoule, ecrits, derivations,
+                derivations ? 100.0 * ecrits / derivations : 100.0);
+    }
+}
+
+static void *boucle_progression(void *argument) {
+    Progression *progression = argument;
+    pthread_mutex_lock(&progression->verrou);
+    while (!progression->arreter) {
+        struct timespec echeance;
+        clock_gettime(CLOCK_REALTIME, &echeance);
+        echeance.tv_sec += PROGRESSION_INTERVALLE;
+        int attente = 0;
+        while (!progression->arreter && attente != ETIMEDOUT) {
+            attente = pthread_cond_timedwait(&progression->condition, &progression->verrou, &echeance);
+        }
+        if (!progression->arreter) afficher_progression(progression->compteurs);
+    }
+    pthread_mutex_unlock(&progression->verrou);
+    return NULL;
+}
+
+int progression_demarrer(Progression *progression, const CompteursGeneration *compteurs) {
+    progression->compteurs = compteurs;
+    progression->arreter = 0;
+    pthread_mutex_init(&progression->verrou, NULL);
+    pthread_cond_init(&progression->condition, NULL);
+    int erreur = pthread_create(&progression->thread, NULL, boucle_progression, progression);
+    if (erreur != 0) {
+        fprintf(stderr, "Erreur : création de thread impossible : %s\n", strerror(erreur));
+        pthread_mutex_destroy(&progression->verrou);
+        pthread_cond_destroy(&progression->condition);
+        return -1;
+    }
+    return 0;
+}
+
+void progression_arreter(Progression *progression) {
+    pthread_mutex_lock(&progression->verrou);
+    progression->arreter = 1;
+    pthread_cond_signal(&progression->condition);
+    pthread_mutex_unlock(&progression->verrou);
+    pthread_join(progression->thread, NULL);
+    pthread_mutex_destroy(&progression->verrou);
+    pthread_cond_destroy(&progression->condition);
+}
+
+static void ecrire_chaine_json(FILE *sortie, const char *texte) {
+    fputc('"', sortie);
+    for (const unsigned char *c = (const unsigned char *)texte; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(sortie, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(sortie, "\\u%04x", *c);
+        } else {
+            fputc(*c, sortie);
+        }
+    }
+    fputc('"', sortie);
+}
+
+// Écrire le résumé JSON dans chemin ("-" : sortie d'erreur)
+int ecrire_statistiques(const char *chemin, const CompteursGeneration *compteurs, int longueur_max, int nb_threads,
+                        const char *sortie) {
+    FILE *flux = strcmp(chemin, "-") == 0 ? stderr : fopen(chemin, "w");
+    if (!flux) {
+        perror("Erreur lors de l'ouverture des statistiques");
+        return -1;
+    }
+    unsigned long long ecrits = 0, distincts = 0;
+    for (int l = 0; l < MAX_WORD_LEN; l++) {
+        ecrits += compteurs->mots_longueur[l];
+        distincts += compteurs->distincts_longueur[l];
+    }
+    fprintf(flux, "{\n  \"sortie\": ");
+    ecrire_chaine_json(flux, sortie);
+    fprintf(flux, ",\n  \"longueur_max\": %d,\n  \"methode\": \"%s\",\n  \"threads\": %d,\n", longueur_max,
+            compteurs->methode ? compteurs->methode : "recursif", nb_threads);
+    fprintf(flux, "  \"formes_developpees\": %llu,\n  \"elaguees_profondeur\": %llu,\n  \"elaguees_longueur\": %llu,\n",
+            lire(&compteurs->formes), lire(&compteurs->elaguees_profondeur), lire(&compteurs->elaguees_longueur));
+    fprintf(flux, "  \"derivations\": %llu,\n  \"mots_ecrits\": %llu,\n  \"mots_distincts\": %llu,\n"
+            "  \"doublons\": %llu,\n  \"deversements\": %llu,\n",
+            lire(&compteurs->derivations), ecrits, distincts, ecrits - distincts, lire(&compteurs->deversements));
+    fprintf(flux, "  \"secondes\": {\"derivation\": %.6f, \"tri\": %.6f, \"fusion\": %.6f, \"ecriture\": %.6f, "
+            "\"totale\": %.6f},\n",
+            compteurs->duree_derivation, lire(&compteurs->nanosecondes_tri) / 1e9, compteurs->duree_fusion,
+            compteurs->duree_ecriture, secondes_depuis(&compteurs->debut));
+    fprintf(flux, "  \"par_longueur\": [");
+    int premier = 1;
+    for (int l = 0; l < MAX_WORD_LEN; l++) {
+        if (compteurs->mots_longueur[l] == 0) continue;
+        fprintf(flux, "%s\n    {\"longueur\": %d, \"mots\": %llu, \"distincts\": %llu}", premier ? "" : ",", l,
+                compteurs->mots_longueur[l], compteurs->distincts_longueur[l]);
+        premier = 0;
+    }
+    fprintf(flux, "%s]\n}\n", premier ? "" : "\n  ");
+    if (flux == stderr) return fflush(stderr) == EOF ? -1 : 0;
+    if (fclose(flux) != 0) {
+        perror("Erreur lors de l'écriture des statistiques");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "synthese.h"
+
+#define MAX_NOMS 250
+#define MAX_PRODUCTION 512
+
+typedef struct {
+    unsigned long long etat;
+} Tirage;
+
+// splitmix64
+static unsigned long long tirer(Tirage *tirage) {
+    unsigned long long z = (tirage->etat += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Entier uniforme dans [0, n)
+static int tirer_entier(Tirage *tirage, int n) {
+    return (int)(tirer(tirage) % (unsigned long long)n);
+}
+
+static double tirer_reel(Tirage *tirage) {
+    return (tirer(tirage) >> 11) * 0x1.0p-53;
+}
+
+static void nom_regle(int i, char *nom) {
+    static const char lettres[] = "ABCDFGHIJKLMNOPQRSTUVWXYZ";
+    nom[0] = lettres[i % 25];
+    nom[1] = (char)('0' + i / 25);
+    nom[2] = '\0';
+}
+
+void parametres_synthese_defaut(ParametresSynthese *parametres) {
+    parametres->graine = 1;
+    parametres->regles = 8;
+    parametres->productions = 2;
+    parametres->longueur = 3;
+    parametres->terminaux = 3;
+    parametres->epsilon = 0.2;
+    parametres->unites = 1;
+    parametres->recursivite = 1;
+}
+
+// Ajouter à la production un terminal, ou la règle cible si elle est >= 0
+static void ajouter_symbole(char *production, Tirage *tirage, int terminaux, int cible) {
+    size_t longueur = strlen(production);
+    if (cible >= 0) {
+        nom_regle(cible, production + longueur);
+    } else {
+        production[longueur] = (char)('a' + tirer_entier(tirage, terminaux));
+        production[longueur + 1] = '\0';
+    }
+}
+
+// Ajouter la production si elle n'est pas déjà dans la liste ; renvoie le nouveau nombre
+static int ajouter_unique(char (*productions)[MAX_PRODUCTION], int nb, const char *production) {
+    for (int m = 0; m < nb; m++) {
+        if (strcmp(productions[m], production) == 0) return nb;
+    }
+    strcpy(productions[nb], production);
+    return nb + 1;
+}
+
+// Productions de la règle i, séparées par " | "
+static void ecrire_regle(FILE *sortie, const ParametresSynthese *p, Tirage *tirage, int i) {
+    int n = p->regles;
+    int debut_cycle = n - p->recursivite;
+    int dans_cycle = p->recursivite > 0 && i >= debut_cycle;
+    char productions[MAX_NOMS + 8][MAX_PRODUCTION];
+    int nb = 0;
+
+    char production[MAX_PRODUCTION];
+    for (int k = 0; k < p->productions; k++) {
+        production[0] = '\0';
+        int longueur = 1 + tirer_entier(tirage, p->longueur);
+        for (int j = 0; j < longueur; j++) {
+            int cible = -1;
+            if (k == 0) {
+                // Base : un terminal en tête, puis seulement des règles suivantes
+                if (j > 0 && i + 1 < n && tirer_entier(tirage, 2) == 0) cible = i + 1 + tirer_entier(tirage, n - i - 1);
+            } else if (tirer_entier(tirage, 5) < 2) {
+                // En tête, une règle suivante hors du cycle : pas de récursivité gauche imprévue
+                if (j > 0) {
+                    cible = tirer_entier(tirage, n);
+                } else if (!dans_cycle && i + 1 < n) {
+                    cible = i + 1 + tirer_entier(tirage, n - i - 1);
+                }
+            }
+            ajouter_symbole(production, tirage, p->terminaux, cible);
+        }
+        nb = ajouter_unique(productions, nb, production);
+    }
+    if (i < p->unites) {
+        nom_regle(i + 1, production);
+        nb = ajouter_unique(productions, nb, production);
+    }
+    if (dans_cycle) {
+        nom_regle(i + 1 < n ? i + 1 : debut_cycle, production);
+        ajouter_symbole(production, tirage, p->terminaux, -1);
+        nb = ajouter_unique(productions, nb, production);
+    }
+    if (tirer_reel(tirage) < p->epsilon) nb = ajouter_unique(productions, nb, "E");
+
+    char nom[3];
+    nom_regle(i, nom);
+    fprintf(sortie, "%s : ", nom);
+    for (int m = 0; m < nb; m++) fprintf(sortie, "%s%s", m ? " | " : "", productions[m]);
+    fprintf(sortie, "\n");
+}
+
+int verifier_parametres_synthese(const ParametresSynthese *p) {
+    if (p->regles < 1 || p->regles > MAX_NOMS || p->productions < 1 || p->productions > MAX_NOMS ||
+        p->longueur < 1 || p->longueur * 2 >= MAX_PRODUCTION || p->terminaux < 1 || p->terminaux > 26 ||
+        !(p->epsilon >= 0 && p->epsilon <= 1) || p->unites < 0 || p->unites >= p->regles ||
+        p->recursivite < 0 || p->recursivite > p->regles) {
+        fprintf(stderr, "Erreur : paramètres de grammaire synthétique invalides.\n");
+        return -1;
+    }
+    return 0;
+}
+
+int generer_grammaire_synthetique(FILE *sortie, const ParametresSynthese *p) {
+    if (verifier_parametres_synthese(p) == -1) return -1;
+    Tirage tirage = { p->graine };
+    for (int i = 0; i < p->regles; i++) ecrire_regle(sortie, p, &tirage, i);
+    return ferror(sortie) ? -1 : 0;
+}
@@ -0,0 +1,31 @@
+#ifndef SYNTHESE_H
+#define SYNTHESE_H
+
+#include <stdio.h>
+
+// Grammaires synthétiques pour les mesures de performance. Pour une même graine et les
+// mêmes paramètres, la grammaire produite est toujours la même (générateur pseudo-aléatoire
+// propre, indépendant de la bibliothèque C).
+//
+// Les non-terminaux sont A0, B0, ... (sans E), l'axiome est le premier. Chaque règle a une
+// production de base qui commence par un terminal et ne cite que des règles suivantes :
+// toutes les règles sont productives. La seule récursivité gauche est celle demandée.
+
+typedef struct {
+    unsigned long long graine;
+    int regles;            // Nombre de non-terminaux (1 à 250)
+    int productions;       // Productions par règle, base comprise, hors unités, ε et récursivité
+    int longueur;          // Longueur maximale d'une production, en symboles
+    int terminaux;         // Terminaux a, b, ... (1 à 26)
+    double epsilon;        // Probabilité qu'une règle ait une production ε
+    int unites;            // Chaîne d'unités X0 -> X1 -> ... -> X<unites>
+    int recursivite;       // Cycle de récursivité gauche entre les dernières règles (1 : directe, 0 : aucune)
+} ParametresSynthese;
+
+void parametres_synthese_defaut(ParametresSynthese *parametres);
+// 0 si les paramètres sont acceptés, -1 (avec un message) sinon
+int verifier_parametres_synthese(const ParametresSynthese *parametres);
+// Écrire la grammaire au format des fichiers .general ; renvoie -1 si les paramètres sont invalides
+int generer_grammaire_synthetique(FILE *sortie, const ParametresSynthese *parametres);
+
+#endif
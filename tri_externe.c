@@ -0,0 +1,284 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "generate_words.h"
+
+// Tri externe. Les mots s'accumulent dans des tampons (ListeMots) ; un tampon qui dépasse
+// son budget est trié et déversé dans une série, fichier temporaire (répertoire TMPDIR,
+// /tmp par défaut) effacé dès sa création. Dans une série, chaque mot distinct n'apparaît
+// qu'une fois, suivi de son nombre d'exemplaires. La sortie est une fusion k-voies, par un
+// tas, des séries et des tampons restants : les exemplaires d'un même mot venus de sources
+// différentes sont regroupés, puis écrits autant de fois qu'il y en a, comme le tri en
+// mémoire. Chaque série a un niveau : dès que TRI_EXTERNE_MAX_SERIES séries d'un même niveau
+// se suivent, elles sont fusionnées en une seule du niveau suivant. Chaque mot est ainsi
+// réécrit un nombre logarithmique de fois et le nombre de fichiers ouverts reste petit.
+// Format d'une série : longueur (uint16_t), nombre d'exemplaires (uint64_t), puis les octets.
+
+typedef struct {
+    FILE *serie;                   // NULL : tampon trié
+    const ListeMots *tampon;
+    size_t position;
+    char mot[MAX_WORD_LEN];
+    size_t longueur;
+    uint64_t nombre;               // Exemplaires du mot en cours
+} SourceFusion;
+
+int tri_externe_init(TriExterne *tri, size_t budget) {
+    memset(tri, 0, sizeof(*tri));
+    tri->budget = budget;
+    return pthread_mutex_init(&tri->verrou, NULL) == 0 ? 0 : -1;
+}
+
+static FILE *ouvrir_serie(void) {
+    const char *repertoire = getenv("TMPDIR");
+    char chemin[4096];
+    snprintf(chemin, sizeof(chemin), "%s/generate_words.XXXXXX", repertoire && *repertoire ? repertoire : "/tmp");
+    int descripteur = mkstemp(chemin);
+    if (descripteur == -1) {
+        perror("Erreur de création d'un fichier temporaire");
+        return NULL;
+    }
+    unlink(chemin);
+    FILE *serie = fdopen(descripteur, "w+b");
+    if (!serie) {
+        perror("Erreur de création d'un fichier temporaire");
+        close(descripteur);
+    }
+    return serie;
+}
+
+static int ecrire_enregistrement(FILE *serie, const char *mot, size_t longueur, uint64_t nombre) {
+    uint16_t l = (uint16_t)longueur;
+    if (fwrite(&l, sizeof(l), 1, serie) != 1 || fwrite(&nombre, sizeof(nombre), 1, serie) != 1 ||
+        fwrite(mot, 1, longueur, serie) != longueur) {
+        return -1;
+    }
+    return 0;
+}
+
+// Mot suivant de la source : 1, 0 à la fin, -1 en cas d'erreur de lecture
+static int source_avancer(SourceFusion *source) {
+    if (source->serie) {
+        uint16_t l;
+        if (fread(&l, sizeof(l), 1, source->serie) != 1) return ferror(source->serie) ? -1 : 0;
+        if (l >= MAX_WORD_LEN || fread(&source->nombre, sizeof(source->nombre), 1, source->serie) != 1 ||
+            fread(source->mot, 1, l, source->serie) != l) {
+            return -1;
+        }
+        source->longueur = l;
+        source->mot[l] = '\0';
+        return 1;
+    }
+    const ListeMots *tampon = source->tampon;
+    if (source->position >= tampon->nombre) return 0;
+    const char *mot = tampon->tries[source->position];
+    source->longueur = strlen(mot);
+    memcpy(source->mot, mot, source->longueur + 1);
+    // Les copies d'un mot sont voisines dans un tampon trié
+    source->nombre = 0;
+    while (source->position < tampon->nombre && strcmp(tampon->tries[source->position], mot) == 0) {
+        source->position++;
+        source->nombre++;
+    }
+    return 1;
+}
+
+// Ordre court-lexicographique, comme comparer_mots_shortlex
+static int comparer_sources(const SourceFusion *a, const SourceFusion *b) {
+    if (a->longueur != b->longueur) return a->longueur < b->longueur ? -1 : 1;
+    return memcmp(a->mot, b->mot, a->longueur);
+}
+
+static void tamiser(SourceFusion *sources, int *tas, int taille, int i) {
+    for (;;) {
+        int plus_petit = i, gauche = 2 * i + 1, droite = 2 * i + 2;
+        if (gauche < taille && comparer_sources(&sources[tas[gauche]], &sources[tas[plus_petit]]) < 0) plus_petit = gauche;
+        if (droite < taille && comparer_sources(&sources[tas[droite]], &sources[tas[plus_petit]]) < 0) plus_petit = droite;
+        if (plus_petit == i) return;
+        int t = tas[i];
+        tas[i] = tas[plus_petit];
+        tas[plus_petit] = t;
+        i = plus_petit;
+    }
+}
+
+// Fusionner les sources dans une série (chaque mot une fois, avec son nombre) ou dans
+// la sortie (chaque mot autant de fois qu'il a d'exemplaires), en tenant alors les comptes
+// par longueur et la durée d'écriture si compteurs n'est pas NULL
+static int fusionner(SourceFusion *sources, int nb_sources, FILE *serie, SortieMots *sortie,
+                     CompteursGeneration *compteurs) {
+    int *tas = malloc((nb_sources ? nb_sources : 1) * sizeof(int));
+    if (!tas) return -1;
+    int taille = 0, statut = 0;
+    for (int s = 0; s < nb_sources && statut == 0; s++) {
+        int lu = source_avancer(&sources[s]);
+        if (lu == -1) statut = -1;
+        else if (lu == 1) tas[taille++] = s;
+    }
+    for (int i = taille / 2 - 1; i >= 0; i--) tamiser(sources, tas, taille, i);
+
+    char mot[MAX_WORD_LEN];
+    while (taille > 0 && statut == 0) {
+        SourceFusion *premiere = &sources[tas[0]];
+        size_t longueur = premiere->longueur;
+        uint64_t nombre = 0;
+        memcpy(mot, premiere->mot, longueur + 1);
+        // Regrouper les exemplaires du mot, toutes sources confondues
+        while (taille > 0 && statut == 0) {
+            SourceFusion *source = &sources[tas[0]];
+            if (source->longueur != longueur || memcmp(source->mot, mot, longueur) != 0) break;
+            nombre += source->nombre;
+            int lu = source_avancer(source);
+            if (lu == -1) statut = -1;
+            else if (lu == 0) tas[0] = tas[--taille];
+            tamiser(sources, tas, taille, 0);
+        }
+        if (statut != 0) break;
+        if (serie) {
+            statut = ecrire_enregistrement(serie, mot, longueur, nombre);
+        } else if (!compteurs) {
+            for (uint64_t k = 0; k < nombre && statut == 0; k++) statut = sortie_ecrire(sortie, mot, longueur);
+        } else {
+            struct timespec debut;
+            clock_gettime(CLOCK_MONOTONIC, &debut);
+            for (uint64_t k = 0; k < nombre && statut == 0; k++) statut = sortie_ecrire(sortie, mot, longueur);
+            compteurs->duree_ecriture += secondes_depuis(&debut);
+            compter_ecriture(compteurs, mot, longueur, nombre);
+        }
+    }
+    free(tas);
+    return statut;
+}
+
+// Fusionner les séries debut .. nb_series - 1 en une seule, du niveau suivant (appelé
+// sous le verrou)
+static int regrouper_series(TriExterne *tri, int debut) {
+    int nb = tri->nb_series - debut;
+    SourceFusion *sources = calloc(nb, sizeof(SourceFusion));
+    FILE *serie = ouvrir_serie();
+    int statut = sources && serie ? 0 : -1;
+    for (int s = 0; s < nb && statut == 0; s++) {
+        sources[s].serie = tri->series[debut + s];
+        if (fseek(sources[s].serie, 0, SEEK_SET) != 0) statut = -1;
+    }
+    if (statut == 0) statut = fusionner(sources, nb, serie, NULL, NULL);
+    if (statut == 0 && fflush(serie) == EOF) statut = -1;
+    free(sources);
+    if (statut != 0) {
+        if (serie) fclose(serie);
+        return -1;
+    }
+    for (int s = debut; s < tri->nb_series; s++) fclose(tri->series[s]);
+    tri->series[debut] = serie;
+    tri->niveaux[debut]++;
+    tri->nb_series = debut + 1;
+    return 0;
+}
+
+// Trier le tampon et le déverser dans une nouvelle série ; le tampon est vidé, sa
+// mémoire gardée pour la suite
+static int deverser(TriExterne *tri, ListeMots *tampon) {
+    if (tri_externe_trier(tri, tampon) == -1) return -1;
+    COMPTER(tri->compteurs, deversements);
+    FILE *serie = ouvrir_serie();
+    if (!serie) return -1;
+    SourceFusion source = { NULL, tampon, 0, "", 0, 0 };
+    int statut = 0, lu;
+    while (statut == 0 && (lu = source_avancer(&source)) == 1) {
+        statut = ecrire_enregistrement(serie, source.mot, source.longueur, source.nombre);
+    }
+    if (statut == 0 && fflush(serie) == EOF) statut = -1;
+    if (statut != 0) {
+        perror("Erreur d'écriture d'un fichier temporaire");
+        fclose(serie);
+        return -1;
+    }
+    free(tampon->tries);
+    tampon->tries = NULL;
+    tampon->nombre = 0;
+    tampon->taille = 0;
+
+    pthread_mutex_lock(&tri->verrou);
+    if (tri->nb_series == tri->capacite_series) {
+        int capacite = tri->capacite_series ? tri->capacite_series * 2 : TRI_EXTERNE_MAX_SERIES;
+        FILE **series = realloc(tri->series, capacite * sizeof(FILE *));
+        if (series) tri->series = series;
+        int *niveaux = series ? realloc(tri->niveaux, capacite * sizeof(int)) : NULL;
+        if (niveaux) tri->niveaux = niveaux;
+        if (!series || !niveaux) statut = -1;
+        else tri->capacite_series = capacite;
+    }
+    if (statut == 0) {
+        tri->niveaux[tri->nb_series] = 0;
+        tri->series[tri->nb_series++] = serie;
+        // Les niveaux décroissent le long de la liste : seules les dernières séries peuvent
+        // former un groupe complet
+        while (statut == 0 && tri->nb_series >= TRI_EXTERNE_MAX_SERIES) {
+            int debut = tri->nb_series - TRI_EXTERNE_MAX_SERIES;
+            if (tri->niveaux[debut] != tri->niveaux[tri->nb_series - 1]) break;
+            statut = regrouper_series(tri, debut);
+        }
+    } else {
+        fclose(serie);
+    }
+    pthread_mutex_unlock(&tri->verrou);
+    return statut;
+}
+
+// Trier un tampon (liste_mots_trier), en comptant la durée du tri
+int tri_externe_trier(TriExterne *tri, ListeMots *tampon) {
+    if (!tri->compteurs) return liste_mots_trier(tampon);
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    int statut = liste_mots_trier(tampon);
+    atomic_fetch_add_explicit(&tri->compteurs->nanosecondes_tri, (unsigned long long)(secondes_depuis(&debut) * 1e9),
+                              memory_order_relaxed);
+    return statut;
+}
+
+// Ajouter un mot au tampon, déversé d'abord s'il a atteint son budget. Les pointeurs de
+// tri et la croissance par doublement comptent : le tampon est déversé à la moitié.
+int tri_externe_ajouter(TriExterne *tri, ListeMots *tampon, const char *mot, size_t longueur) {
+    size_t occupe = tampon->taille + tampon->nombre * (sizeof(size_t) + sizeof(char *));
+    if (tri->budget > 0 && occupe >= tri->budget / 2 && tampon->nombre > 0 && deverser(tri, tampon) == -1) {
+        tri->erreur = 1;
+        return -1;
+    }
+    if (liste_mots_ajouter(tampon, mot, longueur) == -1) {
+        tri->erreur = 1;
+        return -1;
+    }
+    COMPTER(tri->compteurs, derivations);
+    return 0;
+}
+
+// Écrire dans la sortie la fusion des séries et des tampons. Un tampon dont tries est
+// rempli est supposé déjà trié (par exemple par le thread qui l'a rempli).
+int tri_externe_ecrire(TriExterne *tri, ListeMots *tampons, int nb_tampons, SortieMots *sortie) {
+    int nb_sources = tri->nb_series + nb_tampons;
+    SourceFusion *sources = calloc(nb_sources ? nb_sources : 1, sizeof(SourceFusion));
+    if (!sources) return -1;
+    int statut = 0;
+    for (int s = 0; s < tri->nb_series && statut == 0; s++) {
+        sources[s].serie = tri->series[s];
+        if (fseek(tri->series[s], 0, SEEK_SET) != 0) statut = -1;
+    }
+    for (int t = 0; t < nb_tampons && statut == 0; t++) {
+        if (!tampons[t].tries && tri_externe_trier(tri, &tampons[t]) == -1) statut = -1;
+        sources[tri->nb_series + t].tampon = &tampons[t];
+    }
+    if (statut == 0) statut = fusionner(sources, nb_sources, NULL, sortie, tri->compteurs);
+    free(sources);
+    return statut;
+}
+
+void tri_externe_liberer(TriExterne *tri) {
+    for (int s = 0; s < tri->nb_series; s++) fclose(tri->series[s]);
+    free(tri->series);
+    free(tri->niveaux);
+    pthread_mutex_destroy(&tri->verrou);
+    memset(tri, 0, sizeof(*tri));
+}